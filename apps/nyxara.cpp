@@ -1,5 +1,12 @@
-﻿#include <iostream>
+﻿#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include "nyxara/nyxara.h"
 #include "vulkan/vulkan_raii.hpp"
 
@@ -15,46 +22,287 @@ public:
 	}
 
 private:
-	nyxara::platform::Window* Window;
+	/**
+	 * @brief What the render thread reads from an updated frame.
+	 */
+	struct FrameState
+	{
+		uint64_t FrameIndex = 0;
+	};
+
+	// Frame rate while focused (zero for unlimited) and while in the background.
+	static constexpr double BackgroundFps = 10.0;
+	double TargetFps = 120.0;
+
+	nyxara::platform::WindowHandle Window;
+	std::unique_ptr<nyxara::renderer::VulkanDevice> Device;
+	std::unique_ptr<nyxara::renderer::DeviceAllocator> Allocator;
+	std::unique_ptr<nyxara::renderer::PipelineCache> PipelineCache;
+	std::unique_ptr<nyxara::renderer::StagingUploader> Uploader;
+	nyxara::frame::FrameStats FrameStats;
+	nyxara::frame::FrameLimiter FrameLimiter;
+	bool bIsMinimized = false;
+	bool bIsFocused = true;
+	bool bIsHeadless = false;
+
+	// The main thread counts every wake-up of its event pump, so a minimized update loop can sleep until input.
+	std::mutex EventMutex;
+	std::condition_variable EventsPumped;
+	uint64_t PumpCount = 0;		// Guarded by EventMutex.
+	std::atomic<bool> bIsClosing{ false };
+	std::atomic<bool> bIsUpdateDone{ false };
 
 	void InitWindow()
 	{
 		nyxara::platform::WindowCreateInfo info{};
 		info.Title = "Vulkan";
 
+		// Display-less runs, e.g. benchmarks on the build farm: NYXARA_HEADLESS_FRAMES=<frame count>.
+		if (const char* frames = std::getenv("NYXARA_HEADLESS_FRAMES"))
+		{
+			info.Backend = nyxara::platform::WindowBackend::Headless;
+			info.HeadlessFrameCount = std::strtoull(frames, nullptr, 10);
+			TargetFps = 0.0;
+			bIsHeadless = true;
+		}
+
 		Window = nyxara::platform::Window::Create(info);
 	}
 
 	void InitVulkan()
 	{
+		nyxara::renderer::VulkanDeviceCreateInfo info{};
+		info.ApplicationName = "Vulkan";
+
+		// Forces a device by name, e.g. NYXARA_VULKAN_DEVICE=llvmpipe for lavapipe on display-less machines.
+		info.PreferredDevice = std::getenv("NYXARA_VULKAN_DEVICE");
 
+		Device = std::make_unique<nyxara::renderer::VulkanDevice>(info);
+		Allocator = std::make_unique<nyxara::renderer::DeviceAllocator>(*Device);
+		Uploader = std::make_unique<nyxara::renderer::StagingUploader>(*Device, *Allocator);
+
+		nyxara::renderer::PipelineCacheOptions cacheOptions{};
+		cacheOptions.Path = "nyxara_pipeline_cache.bin";
+
+		PipelineCache = std::make_unique<nyxara::renderer::PipelineCache>(*Device, cacheOptions);
 	}
 
 	void MainLoop()
 	{
-		while (!Window->ShouldClose())
+		nyxara::platform::Window& window = *nyxara::platform::Window::Get(Window);
+
+		// Headless windows script their events per PollEvents() call: update in lockstep with them.
+		if (bIsHeadless)
+		{
+			UpdateLoop(window);
+			return;
+		}
+
+		// The update loop runs on its own thread and frames render on the pipeline's, so this thread
+		// only pumps events: they are stamped and queued as they arrive, however long frames take.
+		std::exception_ptr updateError;
+		std::thread updateThread([this, &window, &updateError, callDepth = nyxara::logging::CallDepthManager::GetState()]()
+		{
+			nyxara::logging::CallDepthManager::ExchangeState(callDepth);
+			nyxara::jobs::JobSystem::AttachThread();
+
+			try
+			{
+				UpdateLoop(window);
+			}
+			catch (...)
+			{
+				updateError = std::current_exception();
+			}
+
+			nyxara::jobs::JobSystem::DetachThread();
+			bIsUpdateDone.store(true, std::memory_order_release);
+			window.Wake();
+		});
+
+		auto stopUpdates = [&]()
+		{
+			{
+				std::lock_guard lock(EventMutex);
+				bIsClosing.store(true, std::memory_order_release);
+			}
+			EventsPumped.notify_one();
+			updateThread.join();
+		};
+
+		try
+		{
+			while (!bIsUpdateDone.load(std::memory_order_acquire) && !window.ShouldClose())
+			{
+				window.WaitEvents(std::chrono::nanoseconds::max());
+
+				{
+					std::lock_guard lock(EventMutex);
+					++PumpCount;
+				}
+				EventsPumped.notify_one();
+			}
+		}
+		catch (...)
+		{
+			stopUpdates();
+			throw;
+		}
+
+		stopUpdates();
+
+		if (updateError)
+		{
+			std::rethrow_exception(updateError);
+		}
+	}
+
+	/**
+	 * @brief Updates frames until the window closes; runs on the update thread, or the main thread when headless.
+	 */
+	void UpdateLoop(nyxara::platform::Window& window)
+	{
+		// Frames are rendered on the pipeline's render thread; allocation stats are per thread, so it measures its own.
+		nyxara::frame::FramePipeline<FrameState> pipeline({}, [this](FrameState& state, uint64_t frameIndex)
+		{
+			nyxara::memory::AllocationScope renderAllocations;
+			RenderFrame(state, frameIndex);
+
+			nyxara::memory::AllocationStats allocations = renderAllocations.GetStats();
+
+			if (allocations.AllocationCount > 0)
+			{
+				NYX_LOG_EVERY_MS(Core, nyxara::logging::Verbosity::Warn, 1000, "Frame {} render allocated {} time(s), {} bytes",
+					frameIndex, allocations.AllocationCount, allocations.AllocatedBytes);
+			}
+		});
+
+		while (bIsHeadless ? !window.ShouldClose() : !bIsClosing.load(std::memory_order_acquire))
 		{
-			Window->PollEvents();
+			nyxara::memory::AllocationScope frameAllocations;
+
+			FrameStats.BeginFrame();
+			nyxara::memory::FrameArena::BeginFrame(FrameStats.GetFrameCount());
+
+			FrameState& state = pipeline.BeginUpdate();
+			uint64_t pumpCount = 0;
+			{
+				nyxara::frame::FramePhaseScope phase(FrameStats, nyxara::frame::FramePhase::Events);
+
+				if (bIsHeadless)
+				{
+					window.PollEvents();
+				}
+
+				// Read before draining: events pumped after this wake a minimized loop up.
+				{
+					std::lock_guard lock(EventMutex);
+					pumpCount = PumpCount;
+				}
+
+				// Input is consumed in bulk at the start of the update, in the order and with the timing it arrived.
+				std::array<nyxara::platform::WindowEvent, 64> events;
+
+				while (size_t count = window.DrainEvents(events))
+				{
+					for (size_t i = 0; i < count; ++i)
+					{
+						HandleEvent(events[i]);
+					}
+				}
+			}
+			{
+				nyxara::frame::FramePhaseScope phase(FrameStats, nyxara::frame::FramePhase::Update);
+				state.FrameIndex = pipeline.GetFrameIndex();
+			}
+			pipeline.EndUpdate();
+
+			// The update loop must not allocate; measured before EndFrame() so periodic summaries are not counted.
+			nyxara::memory::AllocationStats allocations = frameAllocations.GetStats();
+			FrameStats.EndFrame();
+
+			if (allocations.AllocationCount > 0)
+			{
+				NYX_LOG_EVERY_MS(Core, nyxara::logging::Verbosity::Warn, 1000, "Frame {} update allocated {} time(s), {} bytes",
+					FrameStats.GetFrameCount() - 1, allocations.AllocationCount, allocations.AllocatedBytes);
+			}
+
+			nyxara::frame::FrameIdleScope idle(FrameStats);
+
+			if (bIsMinimized && !bIsHeadless)
+			{
+				// Nothing is visible: render on demand, sleeping until an event (e.g. the restore) arrives.
+				std::unique_lock lock(EventMutex);
+				EventsPumped.wait(lock, [&]
+				{
+					return PumpCount != pumpCount || bIsClosing.load(std::memory_order_relaxed);
+				});
+			}
+			else
+			{
+				FrameLimiter.SetTargetFps(bIsFocused ? TargetFps : BackgroundFps);
+				FrameLimiter.Wait();
+			}
+		}
+
+		pipeline.Flush();
+
+		const nyxara::frame::FramePacingStats pacing = FrameLimiter.GetStats();
+		NYX_LOG_INFO(Core, "Frame pacing: {} limited frame(s), {} missed, mean error {} us, max error {} us",
+			pacing.FrameCount, pacing.MissedCount,
+			std::chrono::duration_cast<std::chrono::microseconds>(pacing.MeanError).count(),
+			std::chrono::duration_cast<std::chrono::microseconds>(pacing.MaxError).count());
+	}
+
+	void HandleEvent(const nyxara::platform::WindowEvent& event)
+	{
+		switch (event.Type)
+		{
+		case nyxara::platform::WindowEventType::Resize:
+			NYX_LOG_DEBUG(Platform, "Framebuffer resized to {}x{}", event.Width, event.Height);
+			bIsMinimized = event.Width == 0 || event.Height == 0;
+			break;
+		case nyxara::platform::WindowEventType::Focus:
+			bIsFocused = event.bFocused;
+			break;
+		default:
+			break;
 		}
 	}
 
+	/**
+	 * @brief Records and submits a frame; runs on the render thread.
+	 */
+	void RenderFrame(FrameState& state, uint64_t frameIndex)
+	{
+		(void)state;
+		(void)frameIndex;
+	}
+
 	void CleanUp()
 	{
-		delete Window;
+		Device->GetDevice().waitIdle();
+		Uploader.reset();
+		PipelineCache.reset();
+		Allocator.reset();
+		Device.reset();
+
+		nyxara::platform::Window::Destroy(Window);
 	}
 };
 
-void *operator new(size_t size)
-{
-  std::cout << "Allocating " << size << " bytes.\n";
-  return malloc(size);
-}
-
 int main()
 {
   NYX_SET_LOG_LEVEL(Platform, nyxara::logging::Verbosity::Trace);
   NYX_SET_LOG_LEVEL(Core, nyxara::logging::Verbosity::Trace);
   NYX_LOG_ENABLE_CALL_DEPTH();
+  // Recording a message filtered out by its category costs ~55 ns instead of ~2 ns, so Trace,
+  // which hot paths use, is only recorded on request: NYXARA_FLIGHT_RECORDER_TRACE=1.
+  nyxara::logging::FlightRecorderOptions recorderOptions{};
+  recorderOptions.Level = std::getenv("NYXARA_FLIGHT_RECORDER_TRACE")
+	  ? nyxara::logging::Verbosity::Trace : nyxara::logging::Verbosity::Debug;
+  nyxara::logging::FlightRecorder::Enable(recorderOptions);
+  nyxara::jobs::JobSystem::Init();
 
   try
   {
@@ -64,8 +312,13 @@ int main()
   catch (const std::exception& e)
   {
 	  NYX_LOG_CRITICAL(Core, "{}", e.what());
+	  nyxara::jobs::JobSystem::Shutdown();
 	  return EXIT_FAILURE;
   }
 
+  nyxara::jobs::JobSystem::Shutdown();
+
+  nyxara::memory::AllocationTracker::ReportLeaks();
+
   return EXIT_SUCCESS;
 }
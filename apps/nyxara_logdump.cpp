@@ -0,0 +1,328 @@
+/**
+ * @file nyxara_logdump.cpp
+ * @brief Converts binary log captures back to text.
+ *
+ * Messages are printed with the same pattern as the engine's console output.
+ * Each argument is either a binary log file or the base path given to
+ * nyxara::logging::BinaryLogOptions::Path, in which case every file of the
+ * capture still on disk is decoded in rotation order.
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/sinks/stdout_sinks.h>
+#include "nyxara/core/logging/binary_log.h"
+#include "nyxara/core/logging/logger.h"
+
+namespace
+{
+	using nyxara::logging::BinaryLogEntry;
+	using nyxara::logging::BinaryLogReader;
+	using nyxara::logging::Verbosity;
+
+	struct DumpOptions
+	{
+		std::vector<std::filesystem::path> Inputs;
+		std::unordered_set<std::string> Categories;
+		Verbosity MaxLevel = Verbosity::Trace;
+		std::optional<double> From;
+		std::optional<double> To;
+		std::string Pattern = nyxara::logging::Logger::DefaultPattern;
+		bool bUseColors = true;
+	};
+
+	void PrintUsage()
+	{
+		std::cout <<
+			"Usage: nyxara_logdump [options] <file|capture>...\n"
+			"\n"
+			"Options:\n"
+			"  -c, --category NAME    Only show messages of this category (repeatable)\n"
+			"  -l, --level LEVEL      Most verbose level shown: critical, error, warn, info, debug, trace\n"
+			"      --from SECONDS     Skip messages logged less than SECONDS after the first one\n"
+			"      --to SECONDS       Skip messages logged more than SECONDS after the first one\n"
+			"  -p, --pattern PATTERN  spdlog pattern used for each line; %s, %# and %! show the call site\n"
+			"      --no-color         Never color the output\n"
+			"  -h, --help             Show this help\n";
+	}
+
+	std::optional<Verbosity> ParseLevel(std::string_view name)
+	{
+		static constexpr std::pair<std::string_view, Verbosity> Levels[] = {
+			{ "critical", Verbosity::Critical },
+			{ "error", Verbosity::Error },
+			{ "warn", Verbosity::Warn },
+			{ "info", Verbosity::Info },
+			{ "debug", Verbosity::Debug },
+			{ "trace", Verbosity::Trace }
+		};
+
+		for (const auto& [levelName, level] : Levels)
+		{
+			if (levelName == name)
+			{
+				return level;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional<double> ParseSeconds(std::string_view text)
+	{
+		double value = 0.0;
+		auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+
+		if (error != std::errc() || end != text.data() + text.size())
+		{
+			return std::nullopt;
+		}
+
+		return value;
+	}
+
+	/**
+	 * @brief Lists the files of a capture in rotation order.
+	 */
+	std::vector<std::filesystem::path> ExpandCapture(const std::filesystem::path& path)
+	{
+		if (std::filesystem::is_regular_file(path))
+		{
+			return { path };
+		}
+
+		std::filesystem::path directory = path.parent_path().empty() ? "." : path.parent_path();
+		std::string stem = path.stem().string();
+		std::string extension = path.extension().string();
+
+		std::vector<std::pair<uint64_t, std::filesystem::path>> files;
+		std::error_code error;
+
+		for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+		{
+			std::string name = entry.path().filename().string();
+
+			if (name.size() <= stem.size() + 1 + extension.size()
+				|| !name.starts_with(stem) || name[stem.size()] != '.' || !name.ends_with(extension))
+			{
+				continue;
+			}
+
+			const char* first = name.data() + stem.size() + 1;
+			const char* last = name.data() + name.size() - extension.size();
+			uint64_t index = 0;
+			auto [end, parseError] = std::from_chars(first, last, index);
+
+			if (parseError == std::errc() && end == last)
+			{
+				files.emplace_back(index, entry.path());
+			}
+		}
+
+		std::sort(files.begin(), files.end());
+
+		std::vector<std::filesystem::path> paths;
+		for (auto& [index, file] : files)
+		{
+			paths.push_back(std::move(file));
+		}
+
+		return paths;
+	}
+
+	bool ParseArguments(int argc, char** argv, DumpOptions& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string_view arg = argv[i];
+
+			auto value = [&]() -> std::optional<std::string_view>
+			{
+				if (i + 1 >= argc)
+				{
+					std::cerr << "Missing value for " << arg << "\n";
+					return std::nullopt;
+				}
+				return std::string_view(argv[++i]);
+			};
+
+			if (arg == "-h" || arg == "--help")
+			{
+				PrintUsage();
+				std::exit(EXIT_SUCCESS);
+			}
+			else if (arg == "-c" || arg == "--category")
+			{
+				auto name = value();
+				if (!name)
+				{
+					return false;
+				}
+				options.Categories.emplace(*name);
+			}
+			else if (arg == "-l" || arg == "--level")
+			{
+				auto name = value();
+				auto level = name ? ParseLevel(*name) : std::nullopt;
+				if (!level)
+				{
+					std::cerr << "Invalid level\n";
+					return false;
+				}
+				options.MaxLevel = *level;
+			}
+			else if (arg == "--from" || arg == "--to")
+			{
+				auto text = value();
+				auto seconds = text ? ParseSeconds(*text) : std::nullopt;
+				if (!seconds)
+				{
+					std::cerr << "Invalid time for " << arg << "\n";
+					return false;
+				}
+				(arg == "--from" ? options.From : options.To) = *seconds;
+			}
+			else if (arg == "-p" || arg == "--pattern")
+			{
+				auto pattern = value();
+				if (!pattern)
+				{
+					return false;
+				}
+				options.Pattern = *pattern;
+			}
+			else if (arg == "--no-color")
+			{
+				options.bUseColors = false;
+			}
+			else if (arg.starts_with("-"))
+			{
+				std::cerr << "Unknown option " << arg << "\n";
+				return false;
+			}
+			else
+			{
+				std::vector<std::filesystem::path> files = ExpandCapture(std::filesystem::path(arg));
+				if (files.empty())
+				{
+					std::cerr << "No binary log found at " << arg << "\n";
+					return false;
+				}
+				options.Inputs.insert(options.Inputs.end(), files.begin(), files.end());
+			}
+		}
+
+		if (options.Inputs.empty())
+		{
+			PrintUsage();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool IsSelected(const DumpOptions& options, const BinaryLogEntry& entry, int64_t firstTimestamp)
+	{
+		if (entry.Level == Verbosity::None || entry.Level > options.MaxLevel)
+		{
+			return false;
+		}
+
+		if (!options.Categories.empty() && !options.Categories.contains(std::string(entry.Category)))
+		{
+			return false;
+		}
+
+		double seconds = static_cast<double>(entry.Timestamp - firstTimestamp) * 1e-9;
+
+		return (!options.From || seconds >= *options.From) && (!options.To || seconds <= *options.To);
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	DumpOptions options;
+
+	if (!ParseArguments(argc, argv, options))
+	{
+		return EXIT_FAILURE;
+	}
+
+	std::unique_ptr<spdlog::sinks::sink> sink;
+	if (options.bUseColors)
+	{
+		sink = std::make_unique<spdlog::sinks::stdout_color_sink_st>();
+	}
+	else
+	{
+		sink = std::make_unique<spdlog::sinks::stdout_sink_st>();
+	}
+	sink->set_pattern(options.Pattern);
+
+	std::optional<int64_t> firstTimestamp;
+	spdlog::memory_buf_t buffer;
+
+	// spdlog expects null-terminated source locations.
+	std::string file;
+	std::string function;
+
+	try
+	{
+		for (const auto& input : options.Inputs)
+		{
+			BinaryLogReader reader(input);
+			BinaryLogEntry entry;
+
+			while (reader.Next(entry))
+			{
+				if (!firstTimestamp)
+				{
+					firstTimestamp = entry.Timestamp;
+				}
+
+				if (!IsSelected(options, entry, *firstTimestamp))
+				{
+					continue;
+				}
+
+				buffer.clear();
+				entry.FormatMessage(buffer);
+
+				auto time = spdlog::log_clock::time_point(std::chrono::duration_cast<spdlog::log_clock::duration>(
+					std::chrono::nanoseconds(entry.Timestamp)));
+
+				file.assign(entry.File);
+				function.assign(entry.Function);
+				spdlog::source_loc location{ file.c_str(), static_cast<int>(entry.Line), function.c_str() };
+
+				spdlog::details::log_msg message(time, entry.Line > 0 ? location : spdlog::source_loc{},
+					spdlog::string_view_t(entry.Category.data(), entry.Category.size()),
+					nyxara::logging::to_spdlog_level(entry.Level),
+					spdlog::string_view_t(buffer.data(), buffer.size()));
+				message.thread_id = static_cast<size_t>(entry.ThreadId);
+
+				sink->log(message);
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		sink->flush();
+		std::cerr << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+
+	sink->flush();
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,265 @@
+/**
+ * @file command_recording_bench.cpp
+ * @brief Command buffer recording time of a synthetic scene against the number of recording threads.
+ *
+ * Usage: nyxara_command_recording_bench [--draws=<n>] [--max-threads=<n>] [--frames=<n>] [--device=<name substring>]
+ *
+ * Every frame records one push constant and one draw per object into secondary command
+ * buffers through ::nyxara::renderer::CommandRecorder, then submits the primary command
+ * buffer. The pipeline discards rasterization and renders to no attachment, so the GPU
+ * work is negligible and the numbers measure recording on the CPU. Runs on any Vulkan 1.3
+ * implementation, including lavapipe (`--device=llvmpipe`) on machines without a GPU.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "nyxara/core/jobs/job_system.h"
+#include "nyxara/core/logging/categories.h"
+#include "nyxara/renderer/vulkan/command_recorder.h"
+#include "nyxara/renderer/vulkan/device.h"
+
+namespace
+{
+	constexpr uint32_t FramesInFlight = 2;
+	constexpr uint32_t WarmUpFrames = 4;
+	constexpr uint32_t MinDrawsPerBatch = 256;
+
+	/**
+	 * @brief Assembles an empty vertex shader; nothing reaches the rasterizer anyway.
+	 */
+	std::vector<uint32_t> MakeVertexShader()
+	{
+		return {
+			0x07230203, 0x00010000, 0, 5, 0,	// Magic, SPIR-V 1.0, generator, id bound, schema
+			0x00020011, 1,						// OpCapability Shader
+			0x0003000E, 0, 1,					// OpMemoryModel Logical GLSL450
+			0x0005000F, 0, 1, 0x6E69616D, 0,	// OpEntryPoint Vertex %1 "main"
+			0x00020013, 2,						// %2 = OpTypeVoid
+			0x00030021, 3, 2,					// %3 = OpTypeFunction %2
+			0x00050036, 2, 1, 0, 3,				// %1 = OpFunction %2 None %3
+			0x000200F8, 4,						// %4 = OpLabel
+			0x000100FD,							// OpReturn
+			0x00010038,							// OpFunctionEnd
+		};
+	}
+
+	struct Scene
+	{
+		vk::raii::PipelineLayout Layout{ nullptr };
+		vk::raii::Pipeline Pipeline{ nullptr };
+	};
+
+	Scene CreateScene(const nyxara::renderer::VulkanDevice& device)
+	{
+		Scene scene;
+
+		// Per-draw object index, as a real scene would push a transform or material index.
+		vk::PushConstantRange pushConstants;
+		pushConstants.stageFlags = vk::ShaderStageFlagBits::eVertex;
+		pushConstants.size = sizeof(uint32_t);
+
+		vk::PipelineLayoutCreateInfo layoutInfo;
+		layoutInfo.setPushConstantRanges(pushConstants);
+		scene.Layout = vk::raii::PipelineLayout(device.GetDevice(), layoutInfo);
+
+		const std::vector<uint32_t> code = MakeVertexShader();
+
+		vk::ShaderModuleCreateInfo moduleInfo;
+		moduleInfo.codeSize = code.size() * sizeof(uint32_t);
+		moduleInfo.pCode = code.data();
+		const vk::raii::ShaderModule module(device.GetDevice(), moduleInfo);
+
+		vk::PipelineShaderStageCreateInfo stage;
+		stage.stage = vk::ShaderStageFlagBits::eVertex;
+		stage.module = *module;
+		stage.pName = "main";
+
+		const vk::PipelineVertexInputStateCreateInfo vertexInput;
+		const vk::PipelineInputAssemblyStateCreateInfo inputAssembly({}, vk::PrimitiveTopology::eTriangleList);
+
+		vk::PipelineRasterizationStateCreateInfo rasterization;
+		rasterization.rasterizerDiscardEnable = VK_TRUE;
+		rasterization.lineWidth = 1.0f;
+
+		const vk::PipelineRenderingCreateInfo rendering;
+
+		vk::GraphicsPipelineCreateInfo createInfo;
+		createInfo.pNext = &rendering;
+		createInfo.setStages(stage);
+		createInfo.pVertexInputState = &vertexInput;
+		createInfo.pInputAssemblyState = &inputAssembly;
+		createInfo.pRasterizationState = &rasterization;
+		createInfo.layout = *scene.Layout;
+
+		scene.Pipeline = vk::raii::Pipeline(device.GetDevice(), nullptr, createInfo);
+		return scene;
+	}
+
+	/**
+	 * @brief Records and submits @p frameCount frames of @p drawCount draws.
+	 *
+	 * @return Mean recording time per frame, warm-up frames excluded.
+	 */
+	std::chrono::duration<double, std::milli> RecordFrames(const nyxara::renderer::VulkanDevice& device,
+		const Scene& scene, uint32_t drawCount, uint32_t frameCount)
+	{
+		const vk::raii::Device& logicalDevice = device.GetDevice();
+		nyxara::renderer::CommandRecorder recorder(device, FramesInFlight);
+
+		std::vector<vk::raii::Fence> fences;
+
+		for (uint32_t slot = 0; slot < FramesInFlight; ++slot)
+		{
+			fences.emplace_back(logicalDevice, vk::FenceCreateInfo(vk::FenceCreateFlagBits::eSignaled));
+		}
+
+		vk::RenderingInfo renderingInfo;
+		renderingInfo.flags = vk::RenderingFlagBits::eContentsSecondaryCommandBuffers;
+		renderingInfo.renderArea.extent = vk::Extent2D(1, 1);
+		renderingInfo.layerCount = 1;
+
+		vk::CommandBufferInheritanceRenderingInfo inheritance;
+		inheritance.rasterizationSamples = vk::SampleCountFlagBits::e1;
+
+		std::chrono::nanoseconds recordingTime{};
+
+		for (uint32_t frame = 0; frame < WarmUpFrames + frameCount; ++frame)
+		{
+			const uint32_t slot = frame % FramesInFlight;
+			const vk::Fence fence = *fences[slot];
+
+			(void)logicalDevice.waitForFences(fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+			logicalDevice.resetFences(fence);
+
+			const auto start = std::chrono::steady_clock::now();
+
+			vk::raii::CommandBuffer& primary = recorder.BeginFrame(slot);
+			primary.beginRendering(renderingInfo);
+
+			recorder.RecordParallel(drawCount, MinDrawsPerBatch, inheritance,
+				[&](vk::raii::CommandBuffer& commands, uint32_t begin, uint32_t end)
+			{
+				commands.bindPipeline(vk::PipelineBindPoint::eGraphics, *scene.Pipeline);
+
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					commands.pushConstants<uint32_t>(*scene.Layout, vk::ShaderStageFlagBits::eVertex, 0, i);
+					commands.draw(3, 1, 0, 0);
+				}
+			});
+
+			primary.endRendering();
+			recorder.EndFrame();
+
+			if (frame >= WarmUpFrames)
+			{
+				recordingTime += std::chrono::steady_clock::now() - start;
+			}
+
+			const vk::CommandBuffer commandBuffer = *primary;
+
+			vk::SubmitInfo submitInfo;
+			submitInfo.setCommandBuffers(commandBuffer);
+			device.GetGraphicsQueue().submit(submitInfo, fence);
+		}
+
+		logicalDevice.waitIdle();
+		return recordingTime / frameCount;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t drawCount = 100000;
+	uint32_t maxThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	uint32_t frameCount = 32;
+	const char* deviceName = nullptr;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+
+		if (arg.starts_with("--draws="))
+		{
+			drawCount = static_cast<uint32_t>(std::max(std::atoi(argv[i] + std::strlen("--draws=")), 1));
+		}
+		else if (arg.starts_with("--max-threads="))
+		{
+			maxThreadCount = static_cast<uint32_t>(std::clamp(std::atoi(argv[i] + std::strlen("--max-threads=")), 1, 256));
+		}
+		else if (arg.starts_with("--frames="))
+		{
+			frameCount = static_cast<uint32_t>(std::max(std::atoi(argv[i] + std::strlen("--frames=")), 1));
+		}
+		else if (arg.starts_with("--device="))
+		{
+			deviceName = argv[i] + std::strlen("--device=");
+		}
+		else
+		{
+			std::fprintf(stderr, "Usage: %s [--draws=<n>] [--max-threads=<n>] [--frames=<n>] [--device=<name substring>]\n",
+				argv[0]);
+			return 1;
+		}
+	}
+
+	NYX_SET_LOG_LEVEL(Renderer, nyxara::logging::Verbosity::Warn);
+
+	nyxara::renderer::VulkanDeviceCreateInfo deviceInfo;
+	deviceInfo.ApplicationName = "nyxara_command_recording_bench";
+	deviceInfo.bEnableValidation = false;
+	deviceInfo.PreferredDevice = deviceName;
+
+	const nyxara::renderer::VulkanDevice device(deviceInfo);
+	const Scene scene = CreateScene(device);
+
+	std::printf("device: %s, %u draws, %u frames\n", device.GetProperties().deviceName.data(), drawCount, frameCount);
+	std::printf("%-8s %14s %14s %10s\n", "threads", "ms/frame", "ns/draw", "speedup");
+
+	std::vector<uint32_t> threadCounts;
+
+	for (uint32_t threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+	{
+		threadCounts.push_back(threadCount);
+	}
+
+	threadCounts.push_back(maxThreadCount);
+
+	double singleThreadMilliseconds = 0.0;
+
+	for (uint32_t threadCount : threadCounts)
+	{
+		// A single thread records inline: the job system cannot run without workers.
+		if (threadCount > 1)
+		{
+			nyxara::jobs::JobSystemOptions options;
+			options.WorkerCount = threadCount - 1;
+			nyxara::jobs::JobSystem::Init(options);
+		}
+
+		const double milliseconds = RecordFrames(device, scene, drawCount, frameCount).count();
+
+		if (nyxara::jobs::JobSystem::IsRunning())
+		{
+			nyxara::jobs::JobSystem::Shutdown();
+		}
+
+		if (threadCount == 1)
+		{
+			singleThreadMilliseconds = milliseconds;
+		}
+
+		std::printf("%-8u %14.3f %14.2f %9.2fx\n", threadCount, milliseconds, milliseconds * 1e6 / drawCount,
+			singleThreadMilliseconds / milliseconds);
+	}
+
+	return 0;
+}
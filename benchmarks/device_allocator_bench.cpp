@@ -0,0 +1,256 @@
+/**
+ * @file device_allocator_bench.cpp
+ * @brief Buffer creation with one device memory allocation per buffer against the sub-allocator.
+ *
+ * Usage: nyxara_device_allocator_bench [--buffers=<n>] [--device=<name substring>]
+ *
+ * Creates the same set of buffers, of sizes spread from 256 bytes to 256 KiB, first with
+ * a `VkDeviceMemory` each, then through ::nyxara::renderer::DeviceAllocator. The allocator
+ * then frees and reallocates random halves of the buffers to report fragmentation, and a
+ * ::nyxara::renderer::FrameRingBuffer serves per-frame uniforms. Runs on any Vulkan 1.3
+ * implementation, including lavapipe (`--device=llvmpipe`) on machines without a GPU.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string_view>
+#include <vector>
+#include "nyxara/core/logging/categories.h"
+#include "nyxara/renderer/vulkan/device.h"
+#include "nyxara/renderer/vulkan/device_allocator.h"
+
+namespace
+{
+	constexpr uint32_t ChurnRounds = 4;
+	constexpr uint32_t RingFrames = 256;
+	constexpr uint32_t UniformsPerFrame = 1024;
+
+	struct alignas(16) ObjectUniforms
+	{
+		float Transform[16];
+		float Color[4];
+	};
+
+	std::vector<vk::DeviceSize> MakeSizes(uint32_t count)
+	{
+		std::mt19937 random(42);
+		std::uniform_real_distribution<double> exponent(8.0, 18.0);
+
+		std::vector<vk::DeviceSize> sizes(count);
+
+		for (vk::DeviceSize& size : sizes)
+		{
+			size = static_cast<vk::DeviceSize>(std::exp2(exponent(random)));
+		}
+
+		return sizes;
+	}
+
+	vk::BufferCreateInfo MakeBufferInfo(vk::DeviceSize size)
+	{
+		vk::BufferCreateInfo createInfo;
+		createInfo.size = size;
+		createInfo.usage = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst;
+		return createInfo;
+	}
+
+	double GetMilliseconds(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	double CreateSeparately(const nyxara::renderer::VulkanDevice& device, const std::vector<vk::DeviceSize>& sizes)
+	{
+		const vk::PhysicalDeviceMemoryProperties memoryProperties = device.GetPhysicalDevice().getMemoryProperties();
+
+		std::vector<vk::raii::Buffer> buffers;
+		std::vector<vk::raii::DeviceMemory> memories;
+		buffers.reserve(sizes.size());
+		memories.reserve(sizes.size());
+
+		const auto start = std::chrono::steady_clock::now();
+
+		for (vk::DeviceSize size : sizes)
+		{
+			vk::raii::Buffer& buffer = buffers.emplace_back(device.GetDevice(), MakeBufferInfo(size));
+			const vk::MemoryRequirements requirements = buffer.getMemoryRequirements();
+
+			uint32_t memoryType = 0;
+
+			while (!(requirements.memoryTypeBits & (1u << memoryType))
+				|| !(memoryProperties.memoryTypes[memoryType].propertyFlags & vk::MemoryPropertyFlagBits::eDeviceLocal))
+			{
+				++memoryType;
+			}
+
+			vk::raii::DeviceMemory& memory = memories.emplace_back(device.GetDevice(),
+				vk::MemoryAllocateInfo(requirements.size, memoryType));
+			buffer.bindMemory(*memory, 0);
+		}
+
+		const double milliseconds = GetMilliseconds(start);
+
+		// Buffers before their memory.
+		buffers.clear();
+		return milliseconds;
+	}
+
+	void PrintStats(const char* label, const nyxara::renderer::DeviceAllocatorStats& stats)
+	{
+		std::printf("%-10s %6u blocks %6u memory objects %8.1f / %8.1f MiB used %6u free ranges %6.1f%% fragmented\n",
+			label, stats.BlockCount, stats.DeviceMemoryCount, stats.UsedBytes / 1048576.0, stats.BlockBytes / 1048576.0,
+			stats.FreeRangeCount, stats.Fragmentation * 100.0);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t bufferCount = 2048;
+	const char* deviceName = nullptr;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+
+		if (arg.starts_with("--buffers="))
+		{
+			bufferCount = static_cast<uint32_t>(std::max(std::atoi(argv[i] + std::strlen("--buffers=")), 1));
+		}
+		else if (arg.starts_with("--device="))
+		{
+			deviceName = argv[i] + std::strlen("--device=");
+		}
+		else
+		{
+			std::fprintf(stderr, "Usage: %s [--buffers=<n>] [--device=<name substring>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	NYX_SET_LOG_LEVEL(Renderer, nyxara::logging::Verbosity::Warn);
+
+	nyxara::renderer::VulkanDeviceCreateInfo deviceInfo;
+	deviceInfo.ApplicationName = "nyxara_device_allocator_bench";
+	deviceInfo.bEnableValidation = false;
+	deviceInfo.PreferredDevice = deviceName;
+
+	const nyxara::renderer::VulkanDevice device(deviceInfo);
+	const std::vector<vk::DeviceSize> sizes = MakeSizes(bufferCount);
+
+	std::printf("device: %s, %u buffers, maxMemoryAllocationCount %u\n", device.GetProperties().deviceName.data(),
+		bufferCount, device.GetProperties().limits.maxMemoryAllocationCount);
+
+	// One allocation per buffer cannot go past the driver's limit, so compare on what fits under it.
+	const uint32_t separateCount = std::min<uint32_t>(bufferCount,
+		device.GetProperties().limits.maxMemoryAllocationCount / 2);
+	const std::vector<vk::DeviceSize> separateSizes(sizes.begin(), sizes.begin() + separateCount);
+
+	const double separateMilliseconds = CreateSeparately(device, separateSizes);
+	std::printf("%-16s %8u buffers %10.3f ms %10.3f us/buffer\n", "memory/buffer", separateCount, separateMilliseconds,
+		separateMilliseconds * 1000.0 / separateCount);
+
+	nyxara::renderer::DeviceAllocator allocator(device);
+	std::vector<vk::raii::Buffer> buffers;
+	std::vector<nyxara::renderer::DeviceAllocation> allocations(sizes.size());
+	buffers.reserve(sizes.size());
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < sizes.size(); ++i)
+	{
+		buffers.push_back(allocator.CreateBuffer(MakeBufferInfo(sizes[i]), vk::MemoryPropertyFlagBits::eDeviceLocal, {},
+			allocations[i]));
+	}
+
+	const double subAllocatedMilliseconds = GetMilliseconds(start);
+	std::printf("%-16s %8u buffers %10.3f ms %10.3f us/buffer\n", "sub-allocated", bufferCount, subAllocatedMilliseconds,
+		subAllocatedMilliseconds * 1000.0 / bufferCount);
+
+	PrintStats("filled", allocator.GetStats());
+
+	// Free a random half, then refill it with buffers of other sizes.
+	std::mt19937 random(7);
+	std::vector<uint32_t> order(sizes.size());
+
+	for (uint32_t round = 0; round < ChurnRounds; ++round)
+	{
+		for (uint32_t i = 0; i < order.size(); ++i)
+		{
+			order[i] = i;
+		}
+
+		std::shuffle(order.begin(), order.end(), random);
+		order.resize(sizes.size() / 2);
+
+		for (uint32_t i : order)
+		{
+			buffers[i].clear();
+			allocator.Free(allocations[i]);
+		}
+
+		PrintStats("freed half", allocator.GetStats());
+
+		for (uint32_t i : order)
+		{
+			buffers[i] = allocator.CreateBuffer(MakeBufferInfo(sizes[(i + round + 1) % sizes.size()]),
+				vk::MemoryPropertyFlagBits::eDeviceLocal, {}, allocations[i]);
+		}
+
+		order.resize(sizes.size());
+	}
+
+	PrintStats("refilled", allocator.GetStats());
+
+	for (size_t i = 0; i < buffers.size(); ++i)
+	{
+		buffers[i].clear();
+		allocator.Free(allocations[i]);
+	}
+
+	{
+		nyxara::renderer::FrameRingBuffer ring(allocator, device, vk::DeviceSize(4) << 20,
+			vk::BufferUsageFlagBits::eUniformBuffer, 3);
+
+		const auto ringStart = std::chrono::steady_clock::now();
+
+		for (uint32_t frame = 0; frame < RingFrames; ++frame)
+		{
+			ring.BeginFrame();
+
+			for (uint32_t i = 0; i < UniformsPerFrame; ++i)
+			{
+				ObjectUniforms uniforms{};
+				uniforms.Color[0] = static_cast<float>(i);
+
+				if (!ring.Push(uniforms))
+				{
+					std::fprintf(stderr, "Frame ring buffer full\n");
+					return 1;
+				}
+			}
+		}
+
+		const double ringMilliseconds = GetMilliseconds(ringStart);
+		std::printf("%-16s %8u uniforms %9.3f ms %10.3f ns/uniform, peak %.1f KiB\n", "frame ring",
+			RingFrames * UniformsPerFrame, ringMilliseconds, ringMilliseconds * 1e6 / (RingFrames * UniformsPerFrame),
+			ring.GetPeakBytes() / 1024.0);
+	}
+
+	const nyxara::renderer::DeviceAllocatorStats stats = allocator.GetStats();
+
+	for (size_t heap = 0; heap < stats.Heaps.size(); ++heap)
+	{
+		const nyxara::renderer::MemoryHeapStats& heapStats = stats.Heaps[heap];
+		std::printf("heap %zu: %10.1f MiB, budget %10.1f MiB (%s), usage %8.1f MiB, this allocator %8.1f MiB\n", heap,
+			heapStats.Size / 1048576.0, heapStats.Budget / 1048576.0, stats.bHasMemoryBudget ? "queried" : "estimated",
+			heapStats.Usage / 1048576.0, heapStats.AllocatedBytes / 1048576.0);
+	}
+
+	return 0;
+}
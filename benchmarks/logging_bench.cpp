@@ -0,0 +1,355 @@
+/**
+ * @file logging_bench.cpp
+ * @brief Micro-benchmarks of the logging hot paths.
+ *
+ * Usage: nyxara_logging_bench [--filter=<substring>] [--max-threads=<n>] [--json=<path>]
+ *
+ * Results are printed as a table; `--json` also writes them to a file ("-" for stdout)
+ * so runs from two commits can be diffed to catch regressions.
+ *
+ * Heap allocations are counted on the benchmark threads after one warm-up iteration.
+ * The run fails if a case expected to be allocation-free allocates.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <spdlog/sinks/null_sink.h>
+#include "nyxara/core/logging/flight_recorder.h"
+#include "nyxara/core/logging/function_tracer.h"
+#include "nyxara/core/logging/macros.h"
+#include "nyxara/core/memory/allocation_tracker.h"
+
+NYX_DECLARE_LOG_CATEGORY(Bench);
+NYX_DEFINE_LOG_CATEGORY(Bench);
+
+namespace
+{
+	using nyxara::logging::Verbosity;
+
+	/**
+	 * @brief A benchmark case, run once per thread count if multi-threaded.
+	 */
+	struct BenchmarkCase
+	{
+		const char* Name;
+		uint64_t IterationsPerThread;
+		bool bIsMultiThreaded;
+		bool bMustNotAllocate;
+		void (*SetUp)();
+		void (*TearDown)();
+		void (*Body)(uint64_t iterations);
+	};
+
+	struct BenchmarkResult
+	{
+		std::string Name;
+		unsigned Threads;
+		uint64_t IterationsPerThread;
+		double NanosecondsPerCall;
+		double AllocationsPerCall;
+	};
+
+	/**
+	 * @brief Keeps the compiler from discarding a value computed by a benchmark.
+	 */
+	template<typename Type>
+	void DoNotOptimize(const Type& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile Type sink;
+		sink = value;
+#endif
+	}
+
+	struct RunResult
+	{
+		double NanosecondsPerCall;
+		double AllocationsPerCall;
+	};
+
+	/**
+	 * @brief Runs @p body from @p threadCount threads started together.
+	 *
+	 * @return The average cost of a single iteration in nanoseconds, as seen by one thread,
+	 *         and the average number of heap allocations per iteration.
+	 */
+	RunResult RunThreads(unsigned threadCount, uint64_t iterations, void (*body)(uint64_t))
+	{
+		std::barrier start(threadCount + 1);
+		std::atomic<uint64_t> allocations{ 0 };
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount);
+
+		for (unsigned t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&start, &allocations, iterations, body]()
+			{
+				// First use of thread-local state (flight recorder ring, ...) may allocate once.
+				body(1);
+
+				start.arrive_and_wait();
+
+				nyxara::memory::AllocationScope scope;
+				body(iterations);
+				allocations.fetch_add(scope.GetStats().AllocationCount, std::memory_order_relaxed);
+			});
+		}
+
+		start.arrive_and_wait();
+		auto begin = std::chrono::steady_clock::now();
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin);
+		double calls = static_cast<double>(iterations) * threadCount;
+
+		return { elapsed.count() / static_cast<double>(iterations), static_cast<double>(allocations.load()) / calls };
+	}
+
+	void RestoreBenchLevel()
+	{
+		NYX_SET_LOG_LEVEL(Bench, Verbosity::Info);
+	}
+
+	void EnableBenchTrace()
+	{
+		NYX_SET_LOG_LEVEL(Bench, Verbosity::Trace);
+	}
+
+	void EnableCallDepth()
+	{
+		NYX_LOG_ENABLE_CALL_DEPTH();
+	}
+
+	void DisableCallDepth()
+	{
+		NYX_LOG_DISABLE_CALL_DEPTH();
+	}
+
+	void EnableFlightRecorder()
+	{
+		nyxara::logging::FlightRecorderOptions options;
+		options.bInstallCrashHandlers = false;
+		nyxara::logging::FlightRecorder::Enable(options);
+	}
+
+	void DisableFlightRecorder()
+	{
+		nyxara::logging::FlightRecorder::Disable();
+	}
+
+	void LogFilteredOut(uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			NYX_LOG_TRACE(Bench, "filtered out {} {}", i, 3.5f);
+		}
+	}
+
+	void LogEnabled(uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			NYX_LOG_INFO(Bench, "enabled {} {}", i, 3.5f);
+		}
+	}
+
+	void LogLongMessage(uint64_t iterations)
+	{
+		static const std::string Padding(600, '.');
+
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			NYX_LOG_INFO(Bench, "long message {} {}", i, Padding);
+		}
+	}
+
+#if defined(_MSC_VER)
+	__declspec(noinline)
+#else
+	__attribute__((noinline))
+#endif
+	void TracedFunction()
+	{
+		NYX_TRACE_FUNCTION(Bench);
+	}
+
+	void TraceFunction(uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			TracedFunction();
+		}
+	}
+
+	void ReadCategoryLevel(uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			DoNotOptimize(Bench.GetLevel());
+		}
+	}
+
+	void NoOp() {}
+
+	constexpr BenchmarkCase Cases[] = {
+		// Trace statement below the category level: the cost every disabled log pays.
+		{ "log_disabled_path", 20'000'000, true, true, NoOp, NoOp, LogFilteredOut },
+		// Formatting and spdlog dispatch up to a sink that discards the message.
+		{ "log_null_sink", 1'000'000, false, true, NoOp, NoOp, LogEnabled },
+		// Same, with the "[depth: N]" prefix formatted into the message buffer.
+		{ "log_call_depth", 1'000'000, false, true, EnableCallDepth, DisableCallDepth, LogEnabled },
+		// A message longer than the inline buffer, grown into the thread's message resource.
+		{ "log_long_message", 500'000, false, true, NoOp, NoOp, LogLongMessage },
+		// Entry and exit messages of NYX_TRACE_FUNCTION, with call depth tracking.
+		{ "function_tracer", 500'000, false, true, EnableBenchTrace, RestoreBenchLevel, TraceFunction },
+		// Filtered out of the sinks but serialized into the flight recorder.
+		{ "log_flight_recorder", 5'000'000, false, true, EnableFlightRecorder, DisableFlightRecorder, LogFilteredOut },
+		// Relaxed load of the category level slot shared by all threads.
+		{ "category_get_level", 100'000'000, true, true, NoOp, NoOp, ReadCategoryLevel },
+	};
+
+	/**
+	 * @brief Writes the results as JSON, one benchmark per line so runs diff cleanly.
+	 */
+	bool WriteJson(const std::vector<BenchmarkResult>& results, const char* path)
+	{
+		bool bIsStdout = std::strcmp(path, "-") == 0;
+		std::FILE* file = bIsStdout ? stdout : std::fopen(path, "w");
+
+		if (!file)
+		{
+			std::fprintf(stderr, "Failed to open %s\n", path);
+			return false;
+		}
+
+		char date[32] = {};
+		std::time_t now = std::time(nullptr);
+		std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+#if defined(NDEBUG)
+		const char* buildType = "release";
+#else
+		const char* buildType = "debug";
+#endif
+
+		std::fprintf(file, "{\n");
+		std::fprintf(file, "  \"context\": {\"date\": \"%s\", \"num_cpus\": %u, \"build_type\": \"%s\"},\n",
+			date, std::thread::hardware_concurrency(), buildType);
+		std::fprintf(file, "  \"benchmarks\": [\n");
+
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			const BenchmarkResult& result = results[i];
+			std::fprintf(file, "    {\"name\": \"%s/threads:%u\", \"threads\": %u, \"iterations\": %llu, "
+				"\"real_time\": %.3f, \"time_unit\": \"ns\", \"allocs_per_iteration\": %.6f}%s\n",
+				result.Name.c_str(), result.Threads, result.Threads,
+				static_cast<unsigned long long>(result.IterationsPerThread), result.NanosecondsPerCall,
+				result.AllocationsPerCall, i + 1 < results.size() ? "," : "");
+		}
+
+		std::fprintf(file, "  ]\n}\n");
+
+		if (!bIsStdout)
+		{
+			std::fclose(file);
+		}
+
+		return true;
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	std::string_view filter;
+	const char* jsonPath = nullptr;
+	unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+
+		if (arg.starts_with("--filter="))
+		{
+			filter = arg.substr(std::strlen("--filter="));
+		}
+		else if (arg.starts_with("--json="))
+		{
+			jsonPath = argv[i] + std::strlen("--json=");
+		}
+		else if (arg.starts_with("--max-threads="))
+		{
+			maxThreads = std::max(1, std::atoi(argv[i] + std::strlen("--max-threads=")));
+		}
+		else
+		{
+			std::fprintf(stderr, "Usage: %s [--filter=<substring>] [--max-threads=<n>] [--json=<path>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// Enabled messages go through formatting and spdlog, then are discarded.
+	auto& sinks = Bench.GetLogger()->sinks();
+	sinks.clear();
+	sinks.push_back(std::make_shared<spdlog::sinks::null_sink_mt>());
+
+	RestoreBenchLevel();
+
+	// Keep the table off stdout when the JSON goes there.
+	std::FILE* table = jsonPath && std::strcmp(jsonPath, "-") == 0 ? stderr : stdout;
+	std::vector<BenchmarkResult> results;
+
+	std::fprintf(table, "%-24s %8s %12s %12s\n", "benchmark", "threads", "ns/call", "allocs/call");
+	bool bHasUnexpectedAllocations = false;
+
+	for (const BenchmarkCase& benchmark : Cases)
+	{
+		if (!filter.empty() && std::string_view(benchmark.Name).find(filter) == std::string_view::npos)
+		{
+			continue;
+		}
+
+		benchmark.SetUp();
+
+		for (unsigned threads = 1; threads <= (benchmark.bIsMultiThreaded ? maxThreads : 1); threads *= 2)
+		{
+			RunResult run = RunThreads(threads, benchmark.IterationsPerThread, benchmark.Body);
+			results.push_back({ benchmark.Name, threads, benchmark.IterationsPerThread, run.NanosecondsPerCall,
+				run.AllocationsPerCall });
+			std::fprintf(table, "%-24s %8u %12.3f %12.6f\n", benchmark.Name, threads, run.NanosecondsPerCall,
+				run.AllocationsPerCall);
+
+			if (benchmark.bMustNotAllocate && run.AllocationsPerCall > 0.0)
+			{
+				std::fprintf(stderr, "%s allocated on the heap in steady state\n", benchmark.Name);
+				bHasUnexpectedAllocations = true;
+			}
+		}
+
+		benchmark.TearDown();
+	}
+
+	if (jsonPath && !WriteJson(results, jsonPath))
+	{
+		return 1;
+	}
+
+	return bHasUnexpectedAllocations ? 1 : 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file pipeline_cache_bench.cpp
+ * @brief Pipeline creation time with a cold and a warm on-disk pipeline cache.
+ *
+ * Usage: nyxara_pipeline_cache_bench [--pipelines=<n>] [--device=<name substring>]
+ *
+ * Creates the same set of compute pipelines twice: first with no cache file, which is
+ * then saved, and again with a cache seeded from that file. Runs on any Vulkan 1.3
+ * implementation, including lavapipe (`--device=llvmpipe`) on machines without a GPU.
+ *
+ * The run fails if the second pass did not start from the saved cache.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+#include "nyxara/core/logging/categories.h"
+#include "nyxara/renderer/vulkan/device.h"
+#include "nyxara/renderer/vulkan/pipeline_cache.h"
+
+namespace
+{
+	/**
+	 * @brief Assembles an empty compute shader; every @p localSizeX gives a distinct pipeline.
+	 */
+	std::vector<uint32_t> MakeComputeShader(uint32_t localSizeX)
+	{
+		return {
+			0x07230203, 0x00010000, 0, 5, 0,		// Magic, SPIR-V 1.0, generator, id bound, schema
+			0x00020011, 1,							// OpCapability Shader
+			0x0003000E, 0, 1,						// OpMemoryModel Logical GLSL450
+			0x0005000F, 5, 1, 0x6E69616D, 0,		// OpEntryPoint GLCompute %1 "main"
+			0x00060010, 1, 17, localSizeX, 1, 1,	// OpExecutionMode %1 LocalSize x 1 1
+			0x00020013, 2,							// %2 = OpTypeVoid
+			0x00030021, 3, 2,						// %3 = OpTypeFunction %2
+			0x00050036, 2, 1, 0, 3,					// %1 = OpFunction %2 None %3
+			0x000200F8, 4,							// %4 = OpLabel
+			0x000100FD,								// OpReturn
+			0x00010038,								// OpFunctionEnd
+		};
+	}
+
+	nyxara::renderer::PipelineCacheStats CreatePipelines(const nyxara::renderer::VulkanDevice& device,
+		const std::filesystem::path& path, uint32_t count)
+	{
+		const vk::raii::PipelineLayout layout(device.GetDevice(), vk::PipelineLayoutCreateInfo{});
+
+		nyxara::renderer::PipelineCacheOptions options;
+		options.Path = path;
+		options.SaveInterval = std::chrono::seconds::zero();
+
+		// Saved to the file when it goes out of scope.
+		nyxara::renderer::PipelineCache cache(device, options);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const std::vector<uint32_t> code = MakeComputeShader(i + 1);
+
+			vk::ShaderModuleCreateInfo moduleInfo;
+			moduleInfo.codeSize = code.size() * sizeof(uint32_t);
+			moduleInfo.pCode = code.data();
+			const vk::raii::ShaderModule module(device.GetDevice(), moduleInfo);
+
+			vk::ComputePipelineCreateInfo createInfo;
+			createInfo.stage.stage = vk::ShaderStageFlagBits::eCompute;
+			createInfo.stage.module = *module;
+			createInfo.stage.pName = "main";
+			createInfo.layout = *layout;
+
+			cache.CreateComputePipeline(createInfo);
+		}
+
+		return cache.GetStats();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t pipelineCount = 64;
+	const char* deviceName = nullptr;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+
+		if (arg.starts_with("--pipelines="))
+		{
+			pipelineCount = static_cast<uint32_t>(std::clamp(std::atoi(argv[i] + std::strlen("--pipelines=")), 1, 128));
+		}
+		else if (arg.starts_with("--device="))
+		{
+			deviceName = argv[i] + std::strlen("--device=");
+		}
+		else
+		{
+			std::fprintf(stderr, "Usage: %s [--pipelines=<n>] [--device=<name substring>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	NYX_SET_LOG_LEVEL(Renderer, nyxara::logging::Verbosity::Warn);
+
+	nyxara::renderer::VulkanDeviceCreateInfo deviceInfo;
+	deviceInfo.ApplicationName = "nyxara_pipeline_cache_bench";
+	deviceInfo.bEnableValidation = false;
+	deviceInfo.PreferredDevice = deviceName;
+
+	const nyxara::renderer::VulkanDevice device(deviceInfo);
+
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "nyxara_pipeline_cache_bench.bin";
+	std::filesystem::remove(path);
+
+	std::printf("device: %s, %u pipelines\n", device.GetProperties().deviceName.data(), pipelineCount);
+	std::printf("%-8s %12s %14s %10s\n", "cache", "total ms", "us/pipeline", "hits");
+
+	bool bIsWarmRunWarm = false;
+
+	for (const char* run : { "cold", "warm" })
+	{
+		const nyxara::renderer::PipelineCacheStats stats = CreatePipelines(device, path, pipelineCount);
+		const double milliseconds = std::chrono::duration<double, std::milli>(stats.CreationTime).count();
+
+		std::printf("%-8s %12.3f %14.3f %10llu\n", run, milliseconds, milliseconds * 1000.0 / stats.PipelineCount,
+			static_cast<unsigned long long>(stats.CacheHitCount));
+
+		bIsWarmRunWarm = stats.bIsWarm;
+	}
+
+	std::filesystem::remove(path);
+
+	if (!bIsWarmRunWarm)
+	{
+		std::fprintf(stderr, "The second run did not load the saved pipeline cache\n");
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+/**
+ * @file frame_limiter.h
+ * @brief Frame rate limiter with a high-precision hybrid sleep/spin wait.
+ *
+ * ::nyxara::frame::FrameLimiter keeps a deadline per frame at the target rate. Wait()
+ * sleeps while the deadline is far, then spins the last stretch (FrameLimiterOptions::SpinThreshold),
+ * since the OS wakes sleeping threads late by up to a scheduler tick. The deadlines
+ * advance by exactly one period, so rounding errors do not accumulate; after a frame
+ * that overran a whole period the schedule restarts from now instead of bursting to
+ * catch up.
+ *
+ * How late each Wait() returns is recorded as the pacing error, reported by GetStats().
+ *
+ * @code
+ * nyxara::frame::FrameLimiter limiter({ .TargetFps = 120.0 });
+ * while (running)
+ * {
+ *     limiter.SetTargetFps(bIsFocused ? 120.0 : 10.0);
+ *     RunFrame();
+ *     limiter.Wait();
+ * }
+ * @endcode
+ */
+
+#include <chrono>
+#include <cstdint>
+
+namespace nyxara::frame
+{
+	/**
+	 * @brief Options of FrameLimiter.
+	 */
+	struct FrameLimiterOptions
+	{
+		/**
+		 * @brief Frames per second; zero disables the limit.
+		 */
+		double TargetFps = 0.0;
+
+		/**
+		 * @brief Time before the deadline at which Wait() stops sleeping and spins.
+		 *
+		 * Larger values burn more CPU but absorb late wake-ups from the OS scheduler.
+		 */
+		std::chrono::microseconds SpinThreshold{ 1'000 };
+	};
+
+	/**
+	 * @brief How accurately the deadlines were met.
+	 */
+	struct FramePacingStats
+	{
+		uint64_t FrameCount = 0;					///< Wait() calls with a limit.
+		uint64_t MissedCount = 0;					///< Frames that overran their deadline before Wait().
+		std::chrono::nanoseconds MeanError{};		///< Average lateness of Wait() on met deadlines.
+		std::chrono::nanoseconds MaxError{};		///< Worst lateness of Wait() on met deadlines.
+		std::chrono::nanoseconds SleepTime{};		///< Time spent sleeping.
+		std::chrono::nanoseconds SpinTime{};		///< Time spent spinning.
+	};
+
+	/**
+	 * @brief Paces a loop to a target frame rate.
+	 *
+	 * Not thread-safe: the thread running the loop owns the instance.
+	 */
+	class FrameLimiter
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		explicit FrameLimiter(const FrameLimiterOptions& options = {});
+
+		/**
+		 * @brief Changes the target rate; the next deadline is one new period after the last frame.
+		 *
+		 * @param fps Frames per second; zero disables the limit.
+		 */
+		void SetTargetFps(double fps) noexcept;
+
+		double GetTargetFps() const noexcept { return TargetFps; }
+
+		/**
+		 * @brief Gets the time left until the current frame's deadline; zero if unlimited or passed.
+		 *
+		 * Useful as a timeout for waiting on window events instead of sleeping.
+		 */
+		std::chrono::nanoseconds GetTimeUntilDeadline() const noexcept;
+
+		/**
+		 * @brief Waits until the current frame's deadline and starts the next frame.
+		 *
+		 * Returns immediately if the limit is disabled or the deadline has passed.
+		 */
+		void Wait() noexcept;
+
+		/**
+		 * @brief Gets the pacing statistics since the last ResetStats().
+		 */
+		FramePacingStats GetStats() const noexcept;
+
+		void ResetStats() noexcept;
+
+		/**
+		 * @brief Sleeps, then spins, until @p deadline.
+		 *
+		 * @param spinThreshold Time before the deadline at which to stop sleeping.
+		 */
+		static void WaitUntil(Clock::time_point deadline, std::chrono::nanoseconds spinThreshold) noexcept;
+
+	private:
+		const std::chrono::nanoseconds SpinThreshold;
+		double TargetFps = 0.0;
+		std::chrono::nanoseconds Period{};
+
+		// Start of the current frame's period; its deadline is one period later.
+		Clock::time_point FrameStart;
+
+		uint64_t FrameCount = 0;
+		uint64_t MissedCount = 0;
+		std::chrono::nanoseconds TotalError{};
+		std::chrono::nanoseconds MaxError{};
+		std::chrono::nanoseconds SleepTime{};
+		std::chrono::nanoseconds SpinTime{};
+	};
+} // namespace nyxara::frame
@@ -0,0 +1,208 @@
+#pragma once
+
+/**
+ * @file frame_pipeline.h
+ * @brief Pipelined frame execution: the update of frame N+1 overlaps the rendering of frame N.
+ *
+ * ::nyxara::frame::FramePipeline owns FramePipelineOptions::Depth frame states used in
+ * turn. The main thread fills one per frame between BeginUpdate() and EndUpdate() (events,
+ * simulation, building what the renderer needs), then hands it to a dedicated render
+ * thread that records and submits it while the main thread goes on with the next frame.
+ *
+ * A state is never shared: the main thread gets it back only once the render thread is
+ * done with it, and the render thread only sees it after EndUpdate(). BeginUpdate()
+ * blocks while all states are in flight, which bounds the latency added by the pipeline
+ * to Depth - 1 frames.
+ *
+ * @code
+ * struct FrameState { Camera View; std::vector<DrawItem> Draws; };
+ *
+ * nyxara::frame::FramePipeline<FrameState> pipeline({}, [&](FrameState& state, uint64_t frameIndex)
+ * {
+ *     renderer.Record(state.View, state.Draws);
+ *     renderer.Submit(frameIndex);
+ * });
+ *
+ * while (running)
+ * {
+ *     FrameState& state = pipeline.BeginUpdate();
+ *     window.PollEvents();
+ *     world.Update(state);
+ *     pipeline.EndUpdate();
+ * }
+ * @endcode
+ *
+ * @details
+ * Data allocated from a ::nyxara::memory::FrameArena during the update of a frame stays
+ * valid while the frame is rendered as long as Depth is lower than the arena's buffer count.
+ *
+ * An exception thrown by the render callback is rethrown by the next BeginUpdate() or Flush().
+ *
+ * While the job system runs, the render thread is attached to it (see
+ * ::nyxara::jobs::JobSystem::AttachThread()) for its whole life, so the pipeline must be
+ * destroyed before ::nyxara::jobs::JobSystem::Shutdown().
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nyxara::frame
+{
+	/**
+	 * @brief Options of a frame pipeline.
+	 */
+	struct FramePipelineOptions
+	{
+		/**
+		 * @brief Number of frame states; 1 runs update and render in lockstep, 2 overlaps one frame.
+		 */
+		uint32_t Depth = 2;
+
+		/**
+		 * @brief If false, EndUpdate() renders the frame on the calling thread, e.g. for debugging.
+		 */
+		bool bUseRenderThread = true;
+	};
+
+	/**
+	 * @brief Time each side of a pipeline spent waiting for the other.
+	 */
+	struct FramePipelineStats
+	{
+		uint64_t RenderedFrameCount = 0;			///< Frames the render callback returned from.
+		std::chrono::nanoseconds UpdateStallTime{};	///< Update thread waiting for a free state: render bound.
+		std::chrono::nanoseconds RenderIdleTime{};	///< Render thread waiting for a frame: update bound.
+	};
+
+	/**
+	 * @brief Hands frame state slots from the update thread to the render thread.
+	 *
+	 * The type-independent part of FramePipeline, which adds the states themselves.
+	 */
+	class FrameScheduler
+	{
+	public:
+		/**
+		 * @brief Renders the frame in state slot @p slot.
+		 */
+		using RenderCallback = std::function<void(uint32_t slot, uint64_t frameIndex)>;
+
+		/**
+		 * @brief Starts the render thread, unless disabled in @p options.
+		 *
+		 * @throws std::runtime_error If the depth is zero.
+		 */
+		FrameScheduler(const FramePipelineOptions& options, RenderCallback render);
+
+		/**
+		 * @brief Renders the frames already handed over, then stops the render thread.
+		 */
+		~FrameScheduler();
+
+		FrameScheduler(const FrameScheduler&) = delete;
+		FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+		/**
+		 * @brief Waits for a free state slot and returns it for the next frame's update.
+		 */
+		uint32_t AcquireUpdateSlot();
+
+		/**
+		 * @brief Hands the slot returned by AcquireUpdateSlot() to the render thread.
+		 */
+		void SubmitUpdateSlot();
+
+		/**
+		 * @brief Waits until every submitted frame has been rendered.
+		 */
+		void Flush();
+
+		uint32_t GetDepth() const noexcept { return Depth; }
+
+		/**
+		 * @brief Gets the index of the next frame to be submitted. Update thread only.
+		 */
+		uint64_t GetFrameIndex() const noexcept { return SubmittedCount; }
+
+		FramePipelineStats GetStats() const;
+
+	private:
+		void RenderThreadMain();
+		void RenderFrame(uint64_t frameIndex);
+		void RethrowRenderError();
+
+		const uint32_t Depth;
+		const RenderCallback Render;
+
+		mutable std::mutex Mutex;
+		std::condition_variable FrameSubmitted;
+		std::condition_variable FrameRendered;
+
+		// Guarded by Mutex; SubmittedCount is only written by the update thread.
+		uint64_t SubmittedCount = 0;
+		uint64_t RenderedCount = 0;
+		bool bIsStopping = false;
+		std::exception_ptr RenderError;
+		FramePipelineStats Stats;
+
+		std::thread RenderThread;
+	};
+
+	/**
+	 * @brief Pipeline of @p FrameState objects from the update thread to the render thread.
+	 *
+	 * @tparam FrameState Everything the renderer reads from a frame; default-constructible.
+	 */
+	template<typename FrameState>
+	class FramePipeline
+	{
+	public:
+		/**
+		 * @brief Renders one frame from the render thread.
+		 */
+		using RenderFunction = std::function<void(FrameState& state, uint64_t frameIndex)>;
+
+		FramePipeline(const FramePipelineOptions& options, RenderFunction render)
+			: States(options.Depth),
+			  Render(std::move(render)),
+			  Scheduler(options, [this](uint32_t slot, uint64_t frameIndex) { Render(States[slot], frameIndex); })
+		{}
+
+		/**
+		 * @brief Waits for a free frame state and returns it; its previous contents are left as is.
+		 */
+		FrameState& BeginUpdate() { return States[Scheduler.AcquireUpdateSlot()]; }
+
+		/**
+		 * @brief Hands the state returned by BeginUpdate() to the render thread.
+		 */
+		void EndUpdate() { Scheduler.SubmitUpdateSlot(); }
+
+		/**
+		 * @brief Waits until every frame handed over has been rendered, e.g. before resizing.
+		 */
+		void Flush() { Scheduler.Flush(); }
+
+		uint32_t GetDepth() const noexcept { return Scheduler.GetDepth(); }
+
+		/**
+		 * @brief Gets the index of the frame being updated, or of the next one outside an update. Update thread only.
+		 */
+		uint64_t GetFrameIndex() const noexcept { return Scheduler.GetFrameIndex(); }
+
+		FramePipelineStats GetStats() const { return Scheduler.GetStats(); }
+
+	private:
+		std::vector<FrameState> States;
+		RenderFunction Render;
+
+		// Declared last: joins the render thread before the states are destroyed.
+		FrameScheduler Scheduler;
+	};
+} // namespace nyxara::frame
@@ -0,0 +1,278 @@
+#pragma once
+
+/**
+ * @file frame_stats.h
+ * @brief Frame timing statistics and frame-pacing diagnostics for the main loop.
+ *
+ * ::nyxara::frame::FrameStats stamps every frame and its phases (events, update,
+ * record, submit, present) with a monotonic clock and keeps the last frames in a
+ * rolling window. From this window it reports percentiles of two durations:
+ * - the frame interval, from one BeginFrame() to the next, which includes frame pacing,
+ *   sleeping and anything else the loop does between frames: the stutter a user sees;
+ * - the frame time, from BeginFrame() to EndFrame(), the work of the frame alone.
+ *
+ * Hitches are frames whose frame time, or interval less the idle waits the loop marks
+ * with FrameIdleScope (frame limiting, sleeping until an event), exceeds a threshold:
+ * throttled and on-demand frames are not hitches.
+ *
+ * A summary is periodically logged to the `Core` category and/or appended to a CSV
+ * file, so hitches and regressions can be spotted in long soak runs without a profiler.
+ *
+ * @code
+ * nyxara::frame::FrameStats stats;
+ * while (running)
+ * {
+ *     stats.BeginFrame();
+ *     {
+ *         nyxara::frame::FramePhaseScope phase(stats, nyxara::frame::FramePhase::Events);
+ *         window->PollEvents();
+ *     }
+ *     stats.EndFrame();
+ * }
+ * @endcode
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace nyxara::frame
+{
+	/**
+	 * @brief Parts of a frame timed separately.
+	 */
+	enum class FramePhase : uint8_t
+	{
+		Events = 0,	///< Polling and dispatching window events
+		Update,		///< Simulation and game logic
+		Record,		///< Command buffer recording
+		Submit,		///< Queue submission
+		Present,	///< Presentation, including waiting for the swapchain
+		Count
+	};
+
+	/**
+	 * @brief Number of frame phases.
+	 */
+	inline constexpr size_t FramePhaseCount = static_cast<size_t>(FramePhase::Count);
+
+	/**
+	 * @brief Gets the lowercase name of a phase, as used in summaries and CSV headers.
+	 */
+	const char* GetFramePhaseName(FramePhase phase) noexcept;
+
+	/**
+	 * @brief Options of FrameStats.
+	 */
+	struct FrameStatsOptions
+	{
+		/**
+		 * @brief Number of most recent frames kept for the percentiles.
+		 */
+		size_t HistorySize = 1024;
+
+		/**
+		 * @brief Frames with a longer frame time, or interval without idle waits, count as hitches.
+		 */
+		std::chrono::microseconds HitchThreshold{ 33'333 };
+
+		/**
+		 * @brief Interval between two summaries; zero disables periodic summaries.
+		 */
+		std::chrono::milliseconds SummaryInterval{ 10'000 };
+
+		/**
+		 * @brief If true, periodic summaries are logged to the `Core` category.
+		 */
+		bool bLogSummary = true;
+
+		/**
+		 * @brief CSV file periodic summaries are appended to; empty to disable.
+		 */
+		std::filesystem::path CsvPath;
+	};
+
+	/**
+	 * @brief Distribution of a duration over a set of frames, in milliseconds.
+	 */
+	struct FrameTimeDistribution
+	{
+		double Average = 0.0;
+		double P50 = 0.0;
+		double P95 = 0.0;
+		double P99 = 0.0;
+		double Max = 0.0;
+	};
+
+	/**
+	 * @brief Statistics over a set of consecutive frames.
+	 */
+	struct FrameStatsSummary
+	{
+		uint64_t FrameCount = 0;	///< Number of frames summarized.
+		uint64_t HitchCount = 0;	///< Frames longer than the hitch threshold among them.
+		FrameTimeDistribution FrameInterval;	///< From the previous frame's start, pacing and sleep included.
+		FrameTimeDistribution FrameTime;		///< From BeginFrame() to EndFrame().
+		std::array<FrameTimeDistribution, FramePhaseCount> PhaseTimes;
+	};
+
+	/**
+	 * @brief Collects frame and phase timings of a main loop.
+	 *
+	 * Not thread-safe: the thread running the loop owns the instance. Recording a frame
+	 * does not allocate; only summaries do work proportional to the window size.
+	 */
+	class FrameStats
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/**
+		 * @brief Creates the statistics and opens the CSV file if one is configured.
+		 *
+		 * @param options History size, hitch threshold and summary destinations.
+		 * @throws std::runtime_error If the CSV file cannot be opened.
+		 */
+		explicit FrameStats(const FrameStatsOptions& options = {});
+
+		/**
+		 * @brief Marks the start of a frame, and the end of the previous frame's interval.
+		 */
+		void BeginFrame() noexcept;
+
+		/**
+		 * @brief Marks the end of the current frame, records it and emits a summary if due.
+		 */
+		void EndFrame();
+
+		/**
+		 * @brief Marks the start of a phase of the current frame.
+		 *
+		 * A phase entered several times in a frame accumulates its durations.
+		 */
+		void BeginPhase(FramePhase phase) noexcept;
+
+		/**
+		 * @brief Marks the end of a phase started by BeginPhase().
+		 */
+		void EndPhase(FramePhase phase) noexcept;
+
+		/**
+		 * @brief Marks the start of an idle wait between two frames, such as frame limiting.
+		 *
+		 * Idle time still counts in the next frame's interval, but not towards its hitch.
+		 */
+		void BeginIdle() noexcept;
+
+		/**
+		 * @brief Marks the end of an idle wait started by BeginIdle().
+		 */
+		void EndIdle() noexcept;
+
+		/**
+		 * @brief Summarizes the frames of the rolling window.
+		 */
+		FrameStatsSummary GetSummary() const;
+
+		/**
+		 * @brief Gets the number of frames recorded since creation.
+		 */
+		uint64_t GetFrameCount() const noexcept { return FrameCount; }
+
+		/**
+		 * @brief Gets the number of hitches recorded since creation.
+		 */
+		uint64_t GetTotalHitchCount() const noexcept { return TotalHitchCount; }
+
+	private:
+		struct FrameRecord
+		{
+			int64_t FrameTime = 0;		///< Nanoseconds.
+			int64_t FrameInterval = 0;	///< Nanoseconds since the previous frame started; 0 for the first frame.
+			int64_t IdleTime = 0;		///< Nanoseconds of the interval in idle waits.
+			std::array<int64_t, FramePhaseCount> PhaseTimes{};	///< Nanoseconds.
+		};
+
+		bool IsHitch(const FrameRecord& record) const noexcept;
+
+		/**
+		 * @brief Summarizes the @p count most recent frames.
+		 */
+		FrameStatsSummary Summarize(size_t count) const;
+
+		/**
+		 * @brief Logs and/or writes to CSV the frames recorded since the last summary.
+		 */
+		void EmitSummary(Clock::time_point now);
+
+		FrameStatsOptions Options;
+		std::vector<FrameRecord> History;	///< Ring of the most recent frames.
+		mutable std::vector<int64_t> SortScratch;
+		std::ofstream Csv;
+
+		FrameRecord Current;
+		Clock::time_point FrameStart;
+		std::array<Clock::time_point, FramePhaseCount> PhaseStarts{};
+		Clock::time_point IdleStart;
+		int64_t PendingIdleTime = 0;	///< Nanoseconds of idle waits since the current frame started.
+
+		uint64_t FrameCount = 0;
+		uint64_t TotalHitchCount = 0;
+		uint64_t FramesSinceSummary = 0;
+		Clock::time_point CreationTime;
+		Clock::time_point LastSummaryTime;
+	};
+
+	/**
+	 * @brief Times a phase for the lifetime of the scope.
+	 */
+	class FramePhaseScope
+	{
+	public:
+		FramePhaseScope(FrameStats& stats, FramePhase phase) noexcept
+			: Stats(stats), Phase(phase)
+		{
+			Stats.BeginPhase(Phase);
+		}
+
+		~FramePhaseScope()
+		{
+			Stats.EndPhase(Phase);
+		}
+
+		FramePhaseScope(const FramePhaseScope&) = delete;
+		FramePhaseScope& operator=(const FramePhaseScope&) = delete;
+
+	private:
+		FrameStats& Stats;
+		FramePhase Phase;
+	};
+
+	/**
+	 * @brief Marks an idle wait between two frames for the lifetime of the scope.
+	 */
+	class FrameIdleScope
+	{
+	public:
+		explicit FrameIdleScope(FrameStats& stats) noexcept
+			: Stats(stats)
+		{
+			Stats.BeginIdle();
+		}
+
+		~FrameIdleScope()
+		{
+			Stats.EndIdle();
+		}
+
+		FrameIdleScope(const FrameIdleScope&) = delete;
+		FrameIdleScope& operator=(const FrameIdleScope&) = delete;
+
+	private:
+		FrameStats& Stats;
+	};
+} // namespace nyxara::frame
@@ -0,0 +1,279 @@
+#pragma once
+
+/**
+ * @file job_system.h
+ * @brief Work-stealing job system running engine work on a fixed pool of worker threads.
+ *
+ * ::nyxara::jobs::JobSystem starts one worker per remaining core, each optionally pinned
+ * to its core. The thread calling JobSystem::Init() becomes participant 0 and every worker
+ * participant 1..N. Each participant owns a Chase-Lev deque: it pushes and pops its own
+ * jobs at the bottom (LIFO, cache-warm) while idle participants steal from the top (FIFO).
+ *
+ * Jobs are small callables copied into fixed 128-byte job slots, so submitting a job
+ * does not allocate. Completion is tracked with ::nyxara::jobs::JobCounter: submitting
+ * increments the counter, finishing decrements it, and JobSystem::Wait() runs other jobs
+ * until it reaches zero. Waiting inside a job is therefore safe and is how dependencies
+ * are expressed.
+ *
+ * @code
+ * nyxara::jobs::JobCounter culled;
+ * nyxara::jobs::JobSystem::ParallelFor(objects.size(), 64, [&](uint32_t i) { Cull(objects[i]); }, &culled);
+ * nyxara::jobs::JobSystem::Run([&] { SortDraws(); }, &sorted);
+ * nyxara::jobs::JobSystem::Wait(culled);
+ * @endcode
+ *
+ * @details
+ * A job runs with the call depth state (see ::nyxara::logging::CallDepthManager) of the
+ * thread that submitted it, so logs of worker threads keep the depth and the call-depth
+ * setting of the code that spawned them. Other logging state (flight recorder rings,
+ * asynchronous queues, message buffers) is per thread and set up lazily on each worker.
+ *
+ * Threads the application creates itself, such as a render thread, can take one of
+ * JobSystemOptions::AttachableThreadCount extra participant slots with AttachThread().
+ * They then submit to their own deque and job slots like workers do; other threads go
+ * through a shared, locked queue and allocate every job.
+ *
+ * Jobs must not throw. When the job system is not running, Run() executes the job
+ * immediately on the calling thread.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "nyxara/core/logging/call_depth_manager.h"
+
+namespace nyxara::jobs
+{
+	/**
+	 * @brief Options of the job system.
+	 */
+	struct JobSystemOptions
+	{
+		/**
+		 * @brief Number of worker threads; 0 uses one per core besides the calling thread, at least one.
+		 */
+		uint32_t WorkerCount = 0;
+
+		/**
+		 * @brief If true, worker N is pinned to core N modulo the core count; the calling thread is left alone.
+		 */
+		bool bPinWorkers = true;
+
+		/**
+		 * @brief Participant slots for threads started by the application; see JobSystem::AttachThread().
+		 */
+		uint32_t AttachableThreadCount = 2;
+	};
+
+	/**
+	 * @brief Number of jobs submitted with it that have not finished yet.
+	 */
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		/**
+		 * @brief Gets the number of unfinished jobs.
+		 */
+		uint32_t GetValue() const noexcept { return Value.load(std::memory_order_acquire); }
+
+		/**
+		 * @brief Checks if all jobs finished; their effects are then visible to the caller.
+		 */
+		bool IsDone() const noexcept { return GetValue() == 0; }
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<uint32_t> Value{ 0 };
+	};
+
+	/**
+	 * @brief Fixed pool of work-stealing worker threads.
+	 */
+	class JobSystem
+	{
+	public:
+		/**
+		 * @brief Maximum size of a job's callable, captures included.
+		 */
+		static constexpr size_t MaxJobSize = 96;
+
+		/**
+		 * @brief Jobs a thread can have in flight before further jobs are allocated from the heap.
+		 */
+		static constexpr uint32_t MaxJobsPerThread = 4096;
+
+		/**
+		 * @brief Value of GetThreadIndex() on threads that are not part of the job system.
+		 */
+		static constexpr uint32_t ExternalThreadIndex = ~0u;
+
+		/**
+		 * @brief Starts the worker threads; the calling thread becomes participant 0.
+		 *
+		 * @throws std::runtime_error If the job system is already running.
+		 */
+		static void Init(const JobSystemOptions& options = {});
+
+		/**
+		 * @brief Runs the remaining jobs, then stops and joins the worker threads.
+		 *
+		 * Must be called from the thread that called Init(), once attached threads have detached.
+		 */
+		static void Shutdown();
+
+		/**
+		 * @brief Checks if Init() was called and Shutdown() was not.
+		 */
+		static bool IsRunning() noexcept { return bIsRunning.load(std::memory_order_acquire); }
+
+		/**
+		 * @brief Gets the number of worker threads, excluding the thread that called Init().
+		 */
+		static uint32_t GetWorkerCount() noexcept;
+
+		/**
+		 * @brief Gets the number of participants: the thread that called Init(), workers and attachable slots.
+		 */
+		static uint32_t GetParticipantCount() noexcept;
+
+		/**
+		 * @brief Gets the calling thread's participant index.
+		 *
+		 * @return 0 for the thread that called Init(), 1 to GetWorkerCount() for workers,
+		 *         above for attached threads, ExternalThreadIndex otherwise.
+		 */
+		static uint32_t GetThreadIndex() noexcept;
+
+		/**
+		 * @brief Makes the calling thread a participant until DetachThread().
+		 *
+		 * @return True if the thread is a participant, false if the job system is not running
+		 *         or every attachable slot is taken.
+		 */
+		static bool AttachThread();
+
+		/**
+		 * @brief Runs the jobs left in the calling thread's deque and gives its slot back.
+		 *
+		 * Does nothing unless the thread was attached with AttachThread().
+		 */
+		static void DetachThread();
+
+		/**
+		 * @brief Submits a job.
+		 *
+		 * Jobs submitted by threads outside the job system go through a shared queue.
+		 *
+		 * @param function Callable invoked without arguments; at most MaxJobSize bytes.
+		 * @param counter Counter incremented now and decremented when the job finishes; may be null.
+		 */
+		template<typename Function>
+		static void Run(Function&& function, JobCounter* counter = nullptr)
+		{
+			using Callable = std::decay_t<Function>;
+
+			static_assert(sizeof(Callable) <= MaxJobSize, "Job callable too large: capture by reference or pointer");
+			static_assert(alignof(Callable) <= alignof(std::max_align_t), "Job callable over-aligned");
+			static_assert(std::is_invocable_v<Callable&>, "Jobs take no arguments");
+
+			if (!IsRunning())
+			{
+				function();
+				return;
+			}
+
+			Job& job = AllocateJob();
+			new (job.Storage) Callable(std::forward<Function>(function));
+			job.Execute = [](Job& self) noexcept
+			{
+				Callable& callable = *std::launder(reinterpret_cast<Callable*>(self.Storage));
+				callable();
+				callable.~Callable();
+			};
+
+			Submit(job, counter);
+		}
+
+		/**
+		 * @brief Calls @p function for every index in [0, @p count) from jobs, then waits for them.
+		 *
+		 * The range is split into batches of at least @p minBatchSize indices, a few per
+		 * participant so faster threads can steal the remainder.
+		 *
+		 * @param count Number of indices.
+		 * @param minBatchSize Smallest number of indices worth a job.
+		 * @param function Callable taking a `uint32_t` index, called concurrently.
+		 */
+		template<typename Function>
+		static void ParallelFor(uint32_t count, uint32_t minBatchSize, const Function& function)
+		{
+			JobCounter counter;
+			ParallelFor(count, minBatchSize, function, &counter);
+			Wait(counter);
+		}
+
+		/**
+		 * @brief Calls @p function for every index in [0, @p count) from jobs without waiting.
+		 *
+		 * @p function must stay alive until @p counter reaches zero.
+		 *
+		 * @param counter Counter tracking the batches.
+		 */
+		template<typename Function>
+		static void ParallelFor(uint32_t count, uint32_t minBatchSize, const Function& function, JobCounter* counter)
+		{
+			const uint32_t batchSize = GetBatchSize(count, minBatchSize);
+
+			for (uint32_t begin = 0; begin < count; begin += batchSize)
+			{
+				const uint32_t end = count - begin > batchSize ? begin + batchSize : count;
+
+				Run([&function, begin, end]()
+				{
+					for (uint32_t i = begin; i < end; ++i)
+					{
+						function(i);
+					}
+				}, counter);
+			}
+		}
+
+		/**
+		 * @brief Runs jobs on the calling thread until @p counter reaches zero.
+		 *
+		 * Threads outside the job system have no deque of their own: they run jobs from the shared
+		 * queue, steal from the workers' deques like an idle worker, and yield when nothing is found.
+		 */
+		static void Wait(const JobCounter& counter);
+
+	private:
+		struct alignas(64) Job
+		{
+			alignas(std::max_align_t) std::byte Storage[MaxJobSize];
+			void (*Execute)(Job& self) noexcept = nullptr;
+			JobCounter* Counter = nullptr;
+			logging::CallDepthManager::State CallDepth;
+			std::atomic<bool> bIsPending{ false };
+			bool bIsHeapAllocated = false;
+		};
+
+		friend struct WorkerState;
+		friend class JobSystemImpl;
+
+		static Job& AllocateJob();
+		static void Submit(Job& job, JobCounter* counter);
+		static void ExecuteJob(Job& job) noexcept;
+		static uint32_t GetBatchSize(uint32_t count, uint32_t minBatchSize) noexcept;
+
+		static inline std::atomic<bool> bIsRunning{ false };
+	};
+} // namespace nyxara::jobs
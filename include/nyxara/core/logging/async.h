@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ * @file async.h
+ * @brief Configuration and hot-path entry points of the asynchronous logging backend.
+ *
+ * When asynchronous logging is enabled with ::nyxara::logging::Logger::EnableAsync(),
+ * log calls no longer format or write on the calling thread. Instead, each thread
+ * serializes the format string pointer and its arguments (see ::nyxara::logging::RecordCodec)
+ * into its own lock-free single-producer single-consumer ring. A background thread
+ * drains all rings in timestamp order, formats messages, adds the `[depth: N]` prefix
+ * and writes them to the category sinks.
+ *
+ * @details
+ * - ::nyxara::logging::Verbosity::Critical messages flush the backend before returning.
+ * - ::nyxara::logging::Logger::DisableAsync() drains every queue before returning and
+ *   is called automatically when the logging system shuts down.
+ * - Format strings must have static storage duration (string literals), since they
+ *   are read by the background thread after the call returns.
+ *
+ * @see nyxara::logging::Logger
+ * @see nyxara::logging::RecordCodec
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "nyxara/core/logging/verbosity.h"
+
+namespace nyxara::logging
+{
+	class CallSite;
+	class Category;
+
+	/**
+	 * @brief Behavior of a producing thread when its queue is full.
+	 */
+	enum class OverflowPolicy
+	{
+		Block,			///< Wait until the background thread frees enough space.
+		Drop,			///< Silently discard the message.
+		DropAndCount	///< Discard the message and report the number of dropped messages.
+	};
+
+	/**
+	 * @brief Options for the asynchronous logging backend.
+	 */
+	struct AsyncOptions
+	{
+		/**
+		 * @brief Size in bytes of each thread's queue (rounded up to a power of two).
+		 */
+		size_t QueueCapacity = 1024 * 1024;
+
+		/**
+		 * @brief What to do with a message when the calling thread's queue is full.
+		 */
+		OverflowPolicy Overflow = OverflowPolicy::Block;
+
+		/**
+		 * @brief Longest time the background thread sleeps when all queues are empty.
+		 */
+		std::chrono::microseconds MaxIdleWait{ 1000 };
+	};
+
+	/**
+	 * @brief Per-thread record queue feeding the asynchronous backend.
+	 *
+	 * Used internally by Logger::Log; application code should not need it.
+	 */
+	class AsyncQueue
+	{
+	public:
+		/**
+		 * @brief Reserves a record in the calling thread's queue and fills its header.
+		 *
+		 * Applies the configured OverflowPolicy when the queue is full.
+		 *
+		 * @param category Category of the message.
+		 * @param site Descriptor of the log statement, or nullptr if unknown.
+		 * @param level Verbosity of the message.
+		 * @param format Format string, with static storage duration.
+		 * @param flags Combination of RecordFlags.
+		 * @param argCount Number of serialized arguments.
+		 * @param argsSize Size in bytes of the serialized arguments.
+		 * @return Where to serialize the arguments, or nullptr if the message is dropped.
+		 */
+		static std::byte* Reserve(const Category& category, const CallSite* site, Verbosity level,
+			std::string_view format, uint16_t flags, uint32_t argCount, size_t argsSize) noexcept;
+
+		/**
+		 * @brief Publishes the record returned by the last Reserve() on this thread.
+		 */
+		static void Commit() noexcept;
+
+		/**
+		 * @brief Largest serialized argument payload that fits in a queue.
+		 *
+		 * Larger messages are logged synchronously.
+		 */
+		static size_t GetMaxArgsSize() noexcept;
+	};
+} // namespace nyxara::logging
@@ -0,0 +1,245 @@
+#pragma once
+
+/**
+ * @file binary_log.h
+ * @brief Compact binary log files and their reader.
+ *
+ * When enabled with ::nyxara::logging::Logger::EnableBinaryLog(), every message
+ * that passes its category filter is appended, unformatted, to a preallocated
+ * memory-mapped file. Files rotate once full, keeping the most recent
+ * ::nyxara::logging::BinaryLogOptions::MaxFiles captures on disk.
+ *
+ * Binary files are turned back into text with ::nyxara::logging::BinaryLogReader,
+ * which is what the `nyxara_logdump` tool uses.
+ *
+ * @details
+ * A file starts with a ::nyxara::logging::BinaryFileHeader followed by a sequence
+ * of 8-byte aligned chunks, each introduced by a ::nyxara::logging::BinaryChunkHeader:
+ * - BinaryChunkType::Category maps a category id to its name.
+ * - BinaryChunkType::CallSite maps a call-site id to its format string and source location.
+ *   Statements logged through the macros use the stable CallSite::GetId(); other
+ *   messages get an identifier with the high bit set, only meaningful within a capture.
+ * - BinaryChunkType::Record holds one message: a ::nyxara::logging::BinaryRecord
+ *   followed by its arguments, serialized by ::nyxara::logging::RecordCodec.
+ *
+ * Definitions are written before the first record that uses them in every file,
+ * so each file can be decoded on its own. A chunk size of zero marks the end of
+ * the data; chunk headers are written last, so a crash never exposes a partial record.
+ *
+ * Console output is controlled separately with Logger::SetConsoleVerbosity(), which
+ * allows capturing Trace messages to disk while only printing warnings.
+ *
+ * @see nyxara::logging::Logger
+ * @see nyxara::logging::RecordCodec
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "nyxara/core/logging/verbosity.h"
+
+namespace nyxara::logging
+{
+	class CallSite;
+	class Category;
+
+	/**
+	 * @brief Options of the binary log files.
+	 */
+	struct BinaryLogOptions
+	{
+		/**
+		 * @brief Base path of the capture; files are named `<stem>.<index><extension>`.
+		 */
+		std::filesystem::path Path = "nyxara.nyxlog";
+
+		/**
+		 * @brief Size in bytes each file is preallocated to before rotating.
+		 */
+		uint64_t FileSize = 64ull * 1024 * 1024;
+
+		/**
+		 * @brief Number of most recent files kept on disk.
+		 */
+		uint32_t MaxFiles = 8;
+	};
+
+	/**
+	 * @brief Kind of a chunk in a binary log file.
+	 */
+	enum class BinaryChunkType : uint16_t
+	{
+		Category = 1,	///< BinaryCategoryDefinition followed by the name
+		CallSite = 2,	///< BinaryCallSiteDefinition followed by the format, file and function strings
+		Record = 3		///< BinaryRecord followed by the serialized arguments
+	};
+
+	/**
+	 * @brief Header at the start of every binary log file.
+	 */
+	struct BinaryFileHeader
+	{
+		static constexpr char ExpectedMagic[8] = { 'N', 'Y', 'X', 'L', 'O', 'G', '\0', '\0' };
+		static constexpr uint32_t CurrentVersion = 2;
+
+		char Magic[8];			///< Always ExpectedMagic.
+		uint32_t Version;		///< Format version, CurrentVersion when written.
+		uint32_t HeaderSize;	///< Size of this header, offset of the first chunk.
+		int64_t CreatedAt;		///< Nanoseconds since the system clock epoch.
+		uint64_t FileIndex;		///< Position of the file in the rotation sequence.
+	};
+
+	/**
+	 * @brief Header of every chunk; Size includes this header and padding.
+	 */
+	struct BinaryChunkHeader
+	{
+		uint32_t Size;			///< Size of the chunk in bytes, or 0 for the end of the data.
+		BinaryChunkType Type;	///< Kind of the chunk.
+		uint16_t Reserved;		///< Always zero.
+	};
+
+	/**
+	 * @brief Payload of a BinaryChunkType::Category chunk.
+	 */
+	struct BinaryCategoryDefinition
+	{
+		uint32_t Id;			///< Category identifier used by records.
+		uint32_t NameSize;		///< Length of the name following this struct.
+	};
+
+	/**
+	 * @brief Payload of a BinaryChunkType::CallSite chunk.
+	 */
+	struct BinaryCallSiteDefinition
+	{
+		uint64_t Id;			///< Call-site identifier used by records.
+		uint32_t Line;			///< Source line, or 0 if unknown.
+		uint32_t FormatSize;	///< Length of the format string following this struct.
+		uint32_t FileSize;		///< Length of the source file name following the format string.
+		uint32_t FunctionSize;	///< Length of the function name following the file name.
+	};
+
+	/**
+	 * @brief Payload of a BinaryChunkType::Record chunk.
+	 */
+	struct BinaryRecord
+	{
+		int64_t Timestamp;		///< Nanoseconds since the system clock epoch.
+		uint64_t ThreadId;		///< Operating system identifier of the logging thread.
+		uint64_t CallSiteId;	///< Call site of the message.
+		uint32_t CategoryId;	///< Category of the message.
+		int32_t CallDepth;		///< Call depth of the logging thread.
+		uint32_t ArgsSize;		///< Size of the serialized arguments following this struct.
+		uint8_t Level;			///< Verbosity of the message.
+		uint8_t ArgCount;		///< Number of serialized arguments.
+		uint16_t Flags;			///< Combination of RecordFlags.
+	};
+
+	/**
+	 * @brief Hot-path entry points of the binary log.
+	 *
+	 * Used internally by Logger::Log; application code should not need it.
+	 */
+	class BinaryLogQueue
+	{
+	public:
+		/**
+		 * @brief Reserves space for a record in the current file and writes its metadata.
+		 *
+		 * On success the binary log stays locked until Commit() is called.
+		 *
+		 * @return Where to serialize the arguments, or nullptr if the record cannot be written.
+		 */
+		static std::byte* Reserve(const Category& category, const CallSite* site, Verbosity level,
+			std::string_view format, uint16_t flags, uint32_t argCount, size_t argsSize) noexcept;
+
+		/**
+		 * @brief Publishes the record returned by the last Reserve() and unlocks the binary log.
+		 */
+		static void Commit() noexcept;
+
+		/**
+		 * @brief Largest serialized argument payload that fits in a file.
+		 */
+		static size_t GetMaxArgsSize() noexcept;
+	};
+
+	/**
+	 * @brief A decoded message read from a binary log file.
+	 *
+	 * Views stay valid until the reader is destroyed.
+	 */
+	struct BinaryLogEntry
+	{
+		int64_t Timestamp = 0;			///< Nanoseconds since the system clock epoch.
+		uint64_t ThreadId = 0;			///< Operating system identifier of the logging thread.
+		uint32_t CategoryId = 0;		///< Category identifier.
+		uint64_t CallSiteId = 0;		///< Call-site identifier.
+		std::string_view Category;		///< Category name.
+		std::string_view Format;		///< Format string of the call site.
+		std::string_view File;			///< Source file of the call site, empty if unknown.
+		uint32_t Line = 0;				///< Source line of the call site, 0 if unknown.
+		std::string_view Function;		///< Function containing the call site, empty if unknown.
+		Verbosity Level = Verbosity::None; ///< Verbosity of the message.
+		int32_t CallDepth = 0;			///< Call depth of the logging thread.
+		uint16_t Flags = 0;				///< Combination of RecordFlags.
+		uint32_t ArgCount = 0;			///< Number of serialized arguments.
+		const std::byte* Args = nullptr; ///< Serialized arguments.
+		uint32_t ArgsSize = 0;			///< Size of the serialized arguments.
+
+		/**
+		 * @brief Formats the message the same way the console output does, without the pattern prefix.
+		 *
+		 * @param out Buffer the formatted text is appended to.
+		 */
+		void FormatMessage(spdlog::memory_buf_t& out) const;
+	};
+
+	/**
+	 * @brief Sequential reader for one binary log file.
+	 */
+	class BinaryLogReader
+	{
+	public:
+		/**
+		 * @brief Loads a binary log file.
+		 *
+		 * @param path The file to read.
+		 * @throws std::runtime_error If the file cannot be read or is not a binary log.
+		 */
+		explicit BinaryLogReader(const std::filesystem::path& path);
+
+		/**
+		 * @brief Gets the header of the file.
+		 */
+		const BinaryFileHeader& GetHeader() const noexcept { return Header; }
+
+		/**
+		 * @brief Reads the next message.
+		 *
+		 * @param entry Receives the message.
+		 * @return True if a message was read, false at the end of the file.
+		 */
+		bool Next(BinaryLogEntry& entry);
+
+	private:
+		struct CallSiteInfo
+		{
+			std::string_view Format;
+			std::string_view File;
+			uint32_t Line;
+			std::string_view Function;
+		};
+
+		std::vector<std::byte> Data;
+		size_t Offset = 0;
+		BinaryFileHeader Header{};
+		std::unordered_map<uint32_t, std::string_view> Categories;
+		std::unordered_map<uint64_t, CallSiteInfo> CallSites;
+	};
+} // namespace nyxara::logging
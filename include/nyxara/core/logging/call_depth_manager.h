@@ -70,6 +70,37 @@ namespace nyxara::logging
 		 */
 		static bool IsEnabled() noexcept { return bIsEnabled; }
 
+		/**
+		 * @brief Call depth state of a thread, carried over to the threads running its jobs.
+		 */
+		struct State
+		{
+			int Depth = 0;
+			bool bIsEnabled = false;
+		};
+
+		/**
+		 * @brief Gets the calling thread's call depth state.
+		 */
+		static State GetState() noexcept { return { CallDepth, bIsEnabled }; }
+
+		/**
+		 * @brief Replaces the calling thread's call depth state.
+		 * 
+		 * Lets work executed on behalf of another thread log with that thread's depth,
+		 * then restore its own state afterwards.
+		 * 
+		 * @param state The state to install.
+		 * @return The state the thread had before the call.
+		 */
+		static State ExchangeState(State state) noexcept
+		{
+			State previous = GetState();
+			CallDepth = state.Depth;
+			bIsEnabled = state.bIsEnabled;
+			return previous;
+		}
+
 	private:
 		static thread_local int CallDepth;		///< Per-thread call depth counter.
 		static thread_local bool bIsEnabled;	///< Whether the call depth tracking is enabled.
@@ -0,0 +1,332 @@
+#pragma once
+
+/**
+ * @file call_site.h
+ * @brief Static descriptors of log statements and runtime per-site filtering.
+ *
+ * Every @ref NYX_LOG expansion (and every macro built on it, as well as
+ * @ref NYX_TRACE_FUNCTION) owns a constant-initialized ::nyxara::logging::CallSite
+ * describing the statement: verbosity, file, line, function and format string.
+ *
+ * A site registers itself into ::nyxara::logging::CallSiteRegistry the first time it
+ * is reached. From then on it can be enumerated and forced on or off individually,
+ * regardless of its category level. This allows enabling a single Trace statement
+ * without enabling the whole category.
+ *
+ * @details
+ * - Overrides are a per-site atomic flag: a site without override costs one extra
+ *   relaxed load compared to the category and flight recorder checks alone.
+ * - Rules matching file and function glob patterns apply to registered sites and to
+ *   sites registered later, so sites that have not run yet can be targeted too.
+ * - Site identifiers are a hash of the file name (without directories), the line and
+ *   the format string, computed at compile time. They are stable across runs and
+ *   machines as long as the statement is not edited, and are written to binary logs.
+ *
+ * @see nyxara::logging::Logger
+ * @see NYX_LOG
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include "nyxara/core/logging/category.h"
+#include "nyxara/core/logging/flight_recorder.h"
+#include "nyxara/core/logging/verbosity.h"
+
+namespace nyxara::logging
+{
+	/**
+	 * @brief Bit flags describing where an accepted message goes.
+	 */
+	enum LogTargets : uint8_t
+	{
+		LogTargetNone			= 0,		///< The message is discarded.
+		LogTargetSinks			= 1 << 0,	///< Text sinks, binary log and asynchronous backend.
+		LogTargetFlightRecorder	= 1 << 1	///< The calling thread's flight recorder ring.
+	};
+
+	/**
+	 * @brief Gets the targets of a message from its category level and the flight recorder level.
+	 *
+	 * @param category Category of the message.
+	 * @param level Verbosity of the message.
+	 * @return A combination of LogTargets.
+	 */
+	inline uint8_t GetLogTargets(const Category& category, Verbosity level) noexcept
+	{
+		return (category.IsEnabled(level) ? LogTargetSinks : LogTargetNone)
+			| (FlightRecorder::IsRecording(level) ? LogTargetFlightRecorder : LogTargetNone);
+	}
+
+	/**
+	 * @brief Runtime override of a call site's filtering.
+	 */
+	enum class CallSiteOverride : uint8_t
+	{
+		Default = 0,	///< Follow the category level.
+		ForceOn,		///< Always log, whatever the category level.
+		ForceOff		///< Never log.
+	};
+
+	/**
+	 * @brief Constant-initialized descriptor of a single log statement.
+	 *
+	 * Created by the logging macros as a function-local `static constinit` object.
+	 */
+	class CallSite
+	{
+	public:
+		/**
+		 * @brief Describes a log statement.
+		 *
+		 * @param level Verbosity of the statement.
+		 * @param file Source file (`__FILE__`).
+		 * @param line Source line (`__LINE__`).
+		 * @param function Enclosing function name.
+		 * @param format Format string literal.
+		 */
+		constexpr CallSite(Verbosity level, const char* file, uint32_t line, const char* function,
+			const char* format) noexcept
+			: Level(level), File(file), Line(line), Function(function), Format(format),
+			  Id(ComputeId(file, line, format))
+		{}
+
+		CallSite(const CallSite&) = delete;
+		CallSite& operator=(const CallSite&) = delete;
+
+		/**
+		 * @brief Gets where the statement should log.
+		 *
+		 * Registers the site on its first call. Sites forced off log nowhere; sites forced
+		 * on always reach the sinks; other sites follow GetLogTargets().
+		 *
+		 * @param category Category of the statement.
+		 * @return A combination of LogTargets.
+		 */
+		uint8_t GetTargets(const Category& category) noexcept;
+
+		/**
+		 * @brief Checks whether the statement should log anywhere.
+		 *
+		 * @param category Category of the statement.
+		 * @return True if GetTargets() is not LogTargetNone.
+		 */
+		bool IsEnabled(const Category& category) noexcept { return GetTargets(category) != LogTargetNone; }
+
+		/**
+		 * @brief Gets the stable identifier of the site.
+		 */
+		constexpr uint64_t GetId() const noexcept { return Id; }
+
+		/**
+		 * @brief Gets the verbosity of the statement.
+		 */
+		constexpr Verbosity GetLevel() const noexcept { return Level; }
+
+		/**
+		 * @brief Gets the source file of the statement.
+		 */
+		constexpr const char* GetFile() const noexcept { return File; }
+
+		/**
+		 * @brief Gets the source line of the statement.
+		 */
+		constexpr uint32_t GetLine() const noexcept { return Line; }
+
+		/**
+		 * @brief Gets the name of the function containing the statement.
+		 */
+		constexpr const char* GetFunction() const noexcept { return Function; }
+
+		/**
+		 * @brief Gets the format string of the statement.
+		 */
+		constexpr const char* GetFormat() const noexcept { return Format; }
+
+		/**
+		 * @brief Gets the category of the statement, or nullptr until the site is registered.
+		 */
+		const Category* GetCategory() const noexcept { return LogCategory; }
+
+		/**
+		 * @brief Gets the current override of the site.
+		 */
+		CallSiteOverride GetOverride() const noexcept;
+
+		/**
+		 * @brief Computes the identifier of a statement from its file name, line and format string.
+		 *
+		 * Uses 64-bit FNV-1a; directories are ignored so identifiers do not depend on the build location.
+		 */
+		static constexpr uint64_t ComputeId(const char* file, uint32_t line, const char* format) noexcept
+		{
+			const char* name = file;
+			for (const char* c = file; *c; ++c)
+			{
+				if (*c == '/' || *c == '\\')
+				{
+					name = c + 1;
+				}
+			}
+
+			uint64_t hash = 14695981039346656037ull;
+			auto mix = [&](char c)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 1099511628211ull;
+			};
+
+			for (const char* c = name; *c; ++c)
+			{
+				mix(*c);
+			}
+
+			mix(':');
+			char digits[10] = {};
+			int count = 0;
+			do
+			{
+				digits[count++] = static_cast<char>('0' + line % 10);
+				line /= 10;
+			} while (line > 0);
+			while (count > 0)
+			{
+				mix(digits[--count]);
+			}
+
+			mix(':');
+			for (const char* c = format; *c; ++c)
+			{
+				mix(*c);
+			}
+
+			// The high bit is reserved for identifiers assigned at runtime to statements without a site.
+			return hash & ~(uint64_t{ 1 } << 63);
+		}
+
+	private:
+		friend class CallSiteRegistry;
+
+		// Values of State; Unregistered until the site is first reached.
+		static constexpr uint8_t StateUnregistered = 0;
+		static constexpr uint8_t StateDefault = 1;
+		static constexpr uint8_t StateForceOn = 2;
+		static constexpr uint8_t StateForceOff = 3;
+
+		static constexpr uint8_t ToState(CallSiteOverride value) noexcept
+		{
+			switch (value)
+			{
+			case CallSiteOverride::ForceOn: return StateForceOn;
+			case CallSiteOverride::ForceOff: return StateForceOff;
+			default: return StateDefault;
+			}
+		}
+
+		const Verbosity Level;
+		const char* const File;
+		const uint32_t Line;
+		const char* const Function;
+		const char* const Format;
+		const uint64_t Id;
+
+		const Category* LogCategory = nullptr;		///< Set on registration.
+		CallSite* Next = nullptr;					///< Next registered site.
+		std::atomic<uint8_t> State{ StateUnregistered };
+	};
+
+	/**
+	 * @brief Selects call sites by file, line and function.
+	 *
+	 * Patterns support `*` (any sequence of characters, including `/`) and `?` (any character).
+	 */
+	struct CallSiteRule
+	{
+		std::string File = "*";			///< Glob matched against the full source path.
+		uint32_t Line = 0;				///< Line to match, or 0 for any line.
+		std::string Function = "*";		///< Glob matched against the function name.
+		CallSiteOverride Override = CallSiteOverride::ForceOn; ///< Override applied to matching sites.
+	};
+
+	/**
+	 * @brief Enumerates registered call sites and controls their overrides.
+	 */
+	class CallSiteRegistry
+	{
+	public:
+		/**
+		 * @brief Calls @p callback for every registered site, in registration order.
+		 *
+		 * The registry is locked during the enumeration; the callback must not log.
+		 */
+		static void ForEach(const std::function<void(const CallSite&)>& callback);
+
+		/**
+		 * @brief Sets the override of the registered site with the given identifier.
+		 *
+		 * @return True if a registered site has this identifier.
+		 */
+		static bool SetOverride(uint64_t id, CallSiteOverride value);
+
+		/**
+		 * @brief Applies a rule to all matching registered sites and to matching sites registered later.
+		 *
+		 * Rules are applied in the order they were added; the last matching rule wins.
+		 * Sites not matched by @p rule keep their current override.
+		 */
+		static void AddRule(const CallSiteRule& rule);
+
+		/**
+		 * @brief Removes all rules and resets every registered site to CallSiteOverride::Default.
+		 */
+		static void ClearRules();
+
+		/**
+		 * @brief Matches a string against a glob pattern using `*` and `?`.
+		 */
+		static bool MatchesGlob(std::string_view pattern, std::string_view text) noexcept;
+
+	private:
+		friend class CallSite;
+
+		/**
+		 * @brief Registers a site on its first use and applies the matching rules.
+		 */
+		static void Register(CallSite& site, const Category& category) noexcept;
+	};
+
+	inline uint8_t CallSite::GetTargets(const Category& category) noexcept
+	{
+		uint8_t state = State.load(std::memory_order_relaxed);
+
+		if (state == StateUnregistered) [[unlikely]]
+		{
+			CallSiteRegistry::Register(*this, category);
+			state = State.load(std::memory_order_relaxed);
+		}
+
+		if (state == StateDefault) [[likely]]
+		{
+			return GetLogTargets(category, Level);
+		}
+
+		if (state == StateForceOn)
+		{
+			return LogTargetSinks | (FlightRecorder::IsRecording(Level) ? LogTargetFlightRecorder : LogTargetNone);
+		}
+
+		return LogTargetNone;
+	}
+
+	inline CallSiteOverride CallSite::GetOverride() const noexcept
+	{
+		switch (State.load(std::memory_order_relaxed))
+		{
+		case StateForceOn: return CallSiteOverride::ForceOn;
+		case StateForceOff: return CallSiteOverride::ForceOff;
+		default: return CallSiteOverride::Default;
+		}
+	}
+} // namespace nyxara::logging
@@ -27,3 +27,11 @@ NYX_DECLARE_LOG_CATEGORY(Core);
 * input handling, and OS integration.
 */
 NYX_DECLARE_LOG_CATEGORY(Platform);
+
+/**
+* @brief Renderer logging category.
+*
+* Covers GPU device setup, pipeline caching, resource management
+* and frame submission.
+*/
+NYX_DECLARE_LOG_CATEGORY(Renderer);
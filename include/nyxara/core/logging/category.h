@@ -22,8 +22,12 @@
  * @see nyxara::logging::Verbosity
  */
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <string>
+#include <string_view>
+#include <type_traits>
+#include "nyxara/core/logging/verbosity.h"
 
 // forward declarations
 namespace spdlog { class logger; }
@@ -45,40 +49,115 @@ namespace nyxara::logging
         /**
          * @brief Constructs a new logging category with the given name.
          *
-         * This constructor initializes the category by copying the provided name,
-         * then caches the associated logger pointer to avoid repeated lookups.
+         * This constructor registers the name to obtain the category identifier and
+         * verbosity slot, then caches the associated logger pointer to avoid repeated
+         * lookups. The name is copied once into the logger's registry; categories sharing
+         * a name share that copy.
          *
          * @param name The unique name of the logging category.
          */
-        explicit Category(const std::string& name);
+        explicit Category(std::string_view name);
 
         /**
-         * @brief Constructs a new logging category by moving the given name.
+         * @brief Gets the name of the logging category.
+         * 
+         * @return The category name, valid for the lifetime of the program.
+         */
+        inline std::string_view GetName() const noexcept { return Name; }
+
+        /**
+         * @brief Gets the dense numeric identifier of the logging category.
          *
-         * This constructor initializes the category by moving the provided name,
-         * then caches the associated logger pointer to avoid repeated lookups.
+         * Identifiers are assigned in registration order, starting at zero. Categories
+         * sharing the same name share the same identifier and verbosity slot.
          *
-         * @param name The unique name of the logging category (moved).
+         * @return The category identifier.
          */
-        explicit Category(std::string&& name);
+        inline uint32_t GetId() const noexcept { return Id; }
 
         /**
-         * @brief Gets the name of the logging category.
-         * 
-         * @return The category name.
+         * @brief Gets the current runtime verbosity of the category.
+         *
+         * This is a single relaxed atomic load; it never locks.
+         *
+         * @return The configured verbosity level.
          */
-        inline const std::string& GetName() const noexcept { return Name; }
+        inline Verbosity GetLevel() const noexcept { return LevelSlot->load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Checks whether a message at the given verbosity would be emitted.
+         *
+         * @param level The verbosity of the message.
+         * @return True if the message passes the category filter, false otherwise.
+         */
+        inline bool IsEnabled(Verbosity level) const noexcept
+        {
+            return level != Verbosity::None && level <= GetLevel();
+        }
 
         /**
          * @brief Gets the spdlog logger associated with this category.
          * 
-         * @return A shared pointer to the logger.
+         * @return A reference to the shared pointer holding the logger.
          */
-        inline std::shared_ptr<spdlog::logger> GetLogger() const noexcept { return Logger; }
+        inline const std::shared_ptr<spdlog::logger>& GetLogger() const noexcept { return Logger; }
 
     private:
-        std::string Name;                       ///< Name of the logging category.
+        uint32_t Id;                            ///< Dense identifier shared by categories with the same name.
+        std::string_view Name;                  ///< Name of the logging category, owned by the logger.
+        std::atomic<Verbosity>* LevelSlot;      ///< Verbosity slot owned by the logger, indexed by Id.
         std::shared_ptr<spdlog::logger> Logger; ///< Logger instance associated with this category.
     };
+
+    /**
+     * @brief Logging category with its own compile-time verbosity floor.
+     *
+     * Behaves exactly like Category at runtime. The template argument replaces
+     * GlobalCompileTimeVerbosity when the logging macros decide whether a call is compiled in.
+     *
+     * @tparam CompileTimeLevel The most verbose level compiled in for this category.
+     */
+    template<Verbosity CompileTimeLevel>
+    class CompiledCategory : public Category
+    {
+    public:
+        using Category::Category;
+
+        static constexpr Verbosity CompileTimeVerbosity = CompileTimeLevel; ///< Compile-time floor of the category.
+    };
+
+    /**
+     * @brief Gets the compile-time verbosity floor of a category type.
+     *
+     * @tparam CategoryType Category or CompiledCategory, possibly cv/ref-qualified.
+     * @return The category's own floor, or GlobalCompileTimeVerbosity if it has none.
+     */
+    template<typename CategoryType>
+    constexpr Verbosity GetCompileTimeVerbosity() noexcept
+    {
+        using Type = std::remove_cvref_t<CategoryType>;
+
+        if constexpr (requires { Type::CompileTimeVerbosity; })
+        {
+            return Type::CompileTimeVerbosity;
+        }
+        else
+        {
+            return GlobalCompileTimeVerbosity;
+        }
+    }
+
+    /**
+     * @brief Checks whether messages at the given level are compiled in for a category type.
+     *
+     * @tparam CategoryType Category or CompiledCategory, possibly cv/ref-qualified.
+     * @param level The verbosity of the message.
+     * @return True if the message must be kept in the binary, false if it is stripped.
+     */
+    template<typename CategoryType>
+    constexpr bool IsCompiledIn(Verbosity level) noexcept
+    {
+        return level != Verbosity::None && level <= GetCompileTimeVerbosity<CategoryType>();
+    }
 } // namespace nyxara::logging
 
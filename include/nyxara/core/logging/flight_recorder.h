@@ -0,0 +1,169 @@
+#pragma once
+
+/**
+ * @file flight_recorder.h
+ * @brief Always-on in-memory history of recent log messages, dumped on fatal errors.
+ *
+ * When enabled with ::nyxara::logging::FlightRecorder::Enable(), every message at or
+ * above the recorder level (Debug by default) is kept, unformatted, in a fixed-size
+ * ring owned by the logging thread. This works even when its category filters it out
+ * of the sinks. The most recent messages of all threads are formatted and written
+ * to stderr (and optionally a file):
+ * - after a ::nyxara::logging::Verbosity::Critical message,
+ * - from `std::terminate`,
+ * - from fatal signals (SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL).
+ *
+ * @details
+ * Recording copies a record header and the serialized arguments (see
+ * ::nyxara::logging::RecordCodec) into a preallocated slot: no lock, no heap
+ * allocation and no formatting. Each thread allocates its ring on first use; rings of
+ * exited threads are reused by new threads.
+ *
+ * Dumps from signal handlers only use async-signal-safe operations. Messages are
+ * formatted by a reduced formatter that substitutes arguments but ignores format
+ * specifications.
+ *
+ * @see nyxara::logging::Logger
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include "nyxara/core/logging/verbosity.h"
+
+namespace nyxara::logging
+{
+	class CallSite;
+	class Category;
+
+	/**
+	 * @brief Options of the flight recorder.
+	 */
+	struct FlightRecorderOptions
+	{
+		/**
+		 * @brief Most verbose level recorded, whatever the category levels.
+		 *
+		 * Trace is left out by default: hot paths log at Trace, and recording a message its
+		 * category filters out costs far more than skipping it.
+		 */
+		Verbosity Level = Verbosity::Debug;
+
+		/**
+		 * @brief Number of messages kept per thread; applies to rings created after the call.
+		 */
+		size_t EntriesPerThread = 1024;
+
+		/**
+		 * @brief Number of most recent messages, across all threads, written by a dump.
+		 */
+		size_t DumpCount = 256;
+
+		/**
+		 * @brief File dumps are appended to, in addition to stderr; empty for stderr only.
+		 */
+		std::filesystem::path DumpPath;
+
+		/**
+		 * @brief Whether to dump from `std::terminate` and fatal signals.
+		 */
+		bool bInstallCrashHandlers = true;
+	};
+
+	/**
+	 * @brief Controls the flight recorder.
+	 */
+	class FlightRecorder
+	{
+	public:
+		/**
+		 * @brief Maximum number of threads recording at the same time.
+		 */
+		static constexpr size_t MaxThreads = 256;
+
+		/**
+		 * @brief Starts recording messages and installs the crash handlers if requested.
+		 *
+		 * Calling it again updates the options.
+		 *
+		 * @param options Level, capacity and dump destination.
+		 * @throws std::runtime_error If the dump file cannot be opened.
+		 */
+		static void Enable(const FlightRecorderOptions& options = {});
+
+		/**
+		 * @brief Stops recording and restores the previous crash handlers.
+		 *
+		 * Recorded messages are kept and can still be dumped.
+		 */
+		static void Disable();
+
+		/**
+		 * @brief Checks if messages are currently recorded.
+		 */
+		static bool IsEnabled() noexcept { return GetLevel() != Verbosity::None; }
+
+		/**
+		 * @brief Gets the most verbose level recorded, Verbosity::None when disabled.
+		 */
+		static Verbosity GetLevel() noexcept { return RecordLevel.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Checks if a message of the given level is recorded.
+		 *
+		 * This is a single relaxed atomic load.
+		 */
+		static bool IsRecording(Verbosity level) noexcept { return level != Verbosity::None && level <= GetLevel(); }
+
+		/**
+		 * @brief Formats and writes the most recent messages of all threads.
+		 *
+		 * Called automatically after critical messages and from the crash handlers.
+		 * Concurrent dumps wait for each other.
+		 *
+		 * @param reason Short description printed in the dump heading.
+		 */
+		static void Dump(std::string_view reason) noexcept;
+
+	private:
+		static inline std::atomic<Verbosity> RecordLevel{ Verbosity::None }; ///< Most verbose level recorded.
+	};
+
+	/**
+	 * @brief Per-thread record ring of the flight recorder.
+	 *
+	 * Used internally by Logger::Log; application code should not need it.
+	 */
+	class FlightRecorderQueue
+	{
+	public:
+		/**
+		 * @brief Claims the oldest slot of the calling thread's ring and fills its header.
+		 *
+		 * @param category Category of the message.
+		 * @param site Descriptor of the log statement, or nullptr if unknown.
+		 * @param level Verbosity of the message.
+		 * @param format Format string, with static storage duration.
+		 * @param flags Combination of RecordFlags.
+		 * @param argCount Number of serialized arguments.
+		 * @param argsSize Size in bytes of the serialized arguments.
+		 * @return Where to serialize the arguments, or nullptr if the thread cannot record.
+		 */
+		static std::byte* Reserve(const Category& category, const CallSite* site, Verbosity level,
+			std::string_view format, uint16_t flags, uint32_t argCount, size_t argsSize) noexcept;
+
+		/**
+		 * @brief Publishes the record returned by the last Reserve() on this thread.
+		 */
+		static void Commit() noexcept;
+
+		/**
+		 * @brief Largest serialized argument payload that fits in a slot.
+		 *
+		 * Larger messages are recorded formatted and truncated.
+		 */
+		static size_t GetMaxArgsSize() noexcept;
+	};
+} // namespace nyxara::logging
@@ -11,6 +11,7 @@
  * - Logs a formatted "Entering" message on construction
  * - Logs a "Leaving" message on destruction
  * - Integrates with the call-depth manager to provide structured, nested output
+ * - Records begin/end events while a ::nyxara::logging::Timeline capture is running
  *
  * The result is a detailed trace of function calls that reflects call stack depth,
  * aiding in debugging complex control flows or recursive functions.
@@ -21,12 +22,16 @@
  *
  * @see nyxara::logging::Logger
  * @see nyxara::logging::CallDepthManager
+ * @see nyxara::logging::Timeline
  * @see NYX_TRACE_FUNCTION
  */
 
+#include <type_traits>
 #include "nyxara/core/logging/call_depth_manager.h"
+#include "nyxara/core/logging/call_site.h"
 #include "nyxara/core/logging/category.h"
 #include "nyxara/core/logging/logger.h"
+#include "nyxara/core/logging/timeline.h"
 #include "nyxara/core/logging/verbosity.h"
 
 namespace nyxara::logging
@@ -37,22 +42,39 @@ namespace nyxara::logging
      * Logs entering and leaving messages at Verbosity::Trace level, using
      * call depth to add depth information to nested calls for better readability.
      * 
+     * Whether the messages are logged is decided once on entry by the entering call
+     * site, which follows the category level unless it is overridden at runtime. The
+     * leaving message has a call site of its own, which binary logs decode it with.
+     * Independently of that, the scope is recorded on the timeline while a capture
+     * is running. All checks are relaxed atomic loads, so a tracer whose category
+     * is filtered out and with no capture running is nearly free.
+     * 
      * Typically instantiated at the start of a function scope to automatically
      * log an entry and exit.
      */
     class FunctionTracer 
     {
     public:
+        static constexpr char EnteringFormat[] = "\033[96m=> Entering: {}()\033[0m";
+        static constexpr char LeavingFormat[] = "\033[95m<= Leaving:  {}()\033[0m";
+
         /**
          * @brief Constructs a FunctionTracer and logs the function entry.
          * 
+         * @param site The call site of the entering message, which decides for both messages.
+         * @param leaveSite The call site of the leaving message.
          * @param category The logging category to use.
          * @param functionName The name of the function being traced.
          */
-        FunctionTracer(const Category& category, const char* functionName)
-            : Category(category), FunctionName(functionName)
+        FunctionTracer(CallSite& site, const CallSite& leaveSite, const Category& category, const char* functionName)
+            : LeaveSite(leaveSite), LogCategory(category), FunctionName(functionName),
+              Targets(site.GetTargets(category))
         {
-            Logger::Log(Category, Verbosity::Trace, "\033[96m=> Entering: {}()\033[0m", FunctionName);
+            Timeline::BeginScope(FunctionName);
+            if (Targets)
+            {
+                Logger::Dispatch(&site, LogCategory, Verbosity::Trace, Targets, EnteringFormat, FunctionName);
+            }
             CallDepthManager::Increment();
         }
 
@@ -62,12 +84,39 @@ namespace nyxara::logging
         ~FunctionTracer()
         {
             CallDepthManager::Decrement();
-            Logger::Log(Category, Verbosity::Trace, "\033[95m<= Leaving:  {}()\033[0m", FunctionName);
+            if (Targets)
+            {
+                Logger::Dispatch(&LeaveSite, LogCategory, Verbosity::Trace, Targets, LeavingFormat, FunctionName);
+            }
+            Timeline::EndScope();
         }
 
     private:
-        const Category& Category;   ///< Logging category used for messages.
-        const char* FunctionName;   ///< Name of the function being traced.
+        const CallSite& LeaveSite;      ///< Call site of the leaving message.
+        const Category& LogCategory;    ///< Logging category used for messages.
+        const char* FunctionName;       ///< Name of the function being traced.
+        const uint8_t Targets;          ///< LogTargets chosen by the call site on entry.
     };
+
+    /**
+     * @brief Empty stand-in for FunctionTracer when Trace is stripped at compile time.
+     *
+     * Has the same constructor signature as FunctionTracer but holds no state and
+     * does nothing, so the optimizer removes it entirely.
+     */
+    class NullFunctionTracer
+    {
+    public:
+        constexpr NullFunctionTracer(CallSite&, const CallSite&, const Category&, const char*) noexcept {}
+    };
+
+    /**
+     * @brief Selects the tracer type for a category based on its compile-time verbosity.
+     *
+     * @tparam CategoryType The (possibly cv-qualified) type of the category being traced.
+     */
+    template<typename CategoryType>
+    using FunctionTracerFor = std::conditional_t<IsCompiledIn<CategoryType>(Verbosity::Trace),
+        FunctionTracer, NullFunctionTracer>;
 } // namespace nyxara::logging
 
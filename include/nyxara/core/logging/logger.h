@@ -22,6 +22,21 @@
  * EnableCallDepth() and DisableCallDepth(), providing insight into nested
  * function calls or recursive logic.
  *
+ * Formatting and sink I/O can be moved off the calling thread with EnableAsync()
+ * (see async.h).
+ *
+ * Messages can also be captured unformatted to rotating binary files with
+ * EnableBinaryLog() (see binary_log.h). SetConsoleVerbosity() limits what reaches
+ * the text sinks independently of the category levels, so verbose categories can
+ * be recorded to disk without flooding the console.
+ *
+ * The flight recorder (see flight_recorder.h) keeps recent messages of any level in
+ * memory and writes them out on critical errors and crashes.
+ *
+ * Messages formatted on the calling thread are built in buffers drawn from a per-thread
+ * `std::pmr::memory_resource` (see SetThreadMessageResource()), so logging in steady state
+ * does not touch the global heap.
+ *
  * The Logger uses the spdlog backend for high-performance logging.
  *
  * @see nyxara::logging::Verbosity
@@ -29,12 +44,20 @@
  * @see nyxara::logging::CallDepthManager
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <shared_mutex>
+#include <memory_resource>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include "nyxara/core/logging/async.h"
+#include "nyxara/core/logging/binary_log.h"
 #include "nyxara/core/logging/call_depth_manager.h"
+#include "nyxara/core/logging/call_site.h"
 #include "nyxara/core/logging/category.h"
+#include "nyxara/core/logging/flight_recorder.h"
+#include "nyxara/core/logging/record.h"
 #include "nyxara/core/logging/verbosity.h"
 
 // forward declarations
@@ -42,6 +65,14 @@ namespace spdlog { class logger; }
 
 namespace nyxara::logging
 {
+	/**
+	 * @brief Buffer receiving a message formatted on the calling thread.
+	 *
+	 * Messages up to the inline capacity stay on the stack; longer ones grow into the
+	 * thread's message resource.
+	 */
+	using MessageBuffer = fmt::basic_memory_buffer<char, 250, std::pmr::polymorphic_allocator<char>>;
+
 	/**
 	 * @brief Core logging utility for the Nyxara engine.
 	 *
@@ -67,9 +98,23 @@ namespace nyxara::logging
 		 */
 		static void Init();
 
+		/**
+		 * @brief Maximum number of distinct category names that can be registered.
+		 */
+		static constexpr uint32_t MaxCategories = 1024;
+
+		/**
+		 * @brief Pattern of the text sinks, also used by tools decoding binary logs.
+		 */
+		static constexpr const char* DefaultPattern = "[%H:%M:%S %z] [%n] [%^%L%$] %v";
+
 		/**
 		 * @brief Sets the verbosity level for a specific logging category.
 		 * 
+		 * The new level is published to the category's atomic slot and takes effect
+		 * immediately on all threads. Categories sharing the same name are updated together.
+		 * Call sites forced on or off with CallSiteRegistry ignore the category level.
+		 * 
 		 * @param category The logging category.
 		 * @param level The verbosity to assign.
 		 */
@@ -81,6 +126,15 @@ namespace nyxara::logging
 		 * Automatically checks the category's current verbosity level and skips logging
 		 * if the level is too low. Also adds call depth information if call depth logging is enabled.
 		 * 
+		 * A filtered-out message costs two relaxed atomic loads, the category's level slot and
+		 * the flight recorder level: no lock, no hash lookup and no reference counting on the
+		 * underlying logger.
+		 *
+		 * The NYX_LOG macros check more, in this order: the compile-time floor, which removes
+		 * statements below it entirely; then the call site's state, one relaxed load that
+		 * registers the site on first use and applies CallSiteRegistry overrides; then, for
+		 * sites without an override, the same two loads as this function.
+		 * 
 		 * @tparam Args Variadic template arguments used for formatting.
 		 * @param category The category under which to log the message.
 		 * @param level The severity/verbosity level of the log.
@@ -90,39 +144,57 @@ namespace nyxara::logging
 		template<typename... Args>
 		static void Log(const Category& category, Verbosity level, fmt::format_string<Args...> fmtStr, Args&&... args)
 		{
-			if (level == Verbosity::None)
+			if (uint8_t targets = GetLogTargets(category, level))
 			{
-				return;
+				Dispatch(nullptr, category, level, targets, fmtStr, std::forward<Args>(args)...);
 			}
+		}
 
-			Verbosity categoryLevel = GetCategoryLevel(category.GetName());
-
-			if (level > categoryLevel)
+		/**
+		 * @brief Sends a message to the given targets without checking any level.
+		 * 
+		 * Used by the logging macros once CallSite::GetTargets() accepted the statement,
+		 * which lets a single call site be forced on while its category is filtered out.
+		 * Critical messages flush the sinks and dump the flight recorder.
+		 * 
+		 * @tparam Args Variadic template arguments used for formatting.
+		 * @param site Descriptor of the log statement, recorded in binary logs; may be nullptr.
+		 * @param category The category under which to log the message.
+		 * @param level The severity/verbosity level of the log.
+		 * @param targets A combination of LogTargets.
+		 * @param fmtStr A fmtlib-compatible format string.
+		 * @param args Arguments to be formatted into the string.
+		 */
+		template<typename... Args>
+		static void Dispatch(const CallSite* site, const Category& category, Verbosity level, uint8_t targets,
+			fmt::format_string<Args...> fmtStr, Args&&... args)
+		{
+			if (targets & LogTargetFlightRecorder)
 			{
-				return;
+				LogFlightRecorder(site, category, level, fmtStr, std::forward<Args>(args)...);
 			}
 
-			auto loggerPtr = category.GetLogger();
-
-			if (!loggerPtr->should_log(to_spdlog_level(level)))
+			if (targets & LogTargetSinks)
 			{
-				return;
+				if (IsAsyncEnabled())
+				{
+					LogAsync(site, category, level, fmtStr, std::forward<Args>(args)...);
+				}
+				else
+				{
+					LogDirect(site, category, level, fmtStr, std::forward<Args>(args)...);
+				}
+
+				if (level == Verbosity::Critical && (IsAsyncEnabled() || IsBinaryLogEnabled()))
+				{
+					Flush();
+				}
 			}
 
-			if (!CallDepthManager::IsEnabled())
+			if (level == Verbosity::Critical && FlightRecorder::IsEnabled())
 			{
-				loggerPtr->log(to_spdlog_level(level), fmtStr, std::forward<Args>(args)...);
-				return;
+				FlightRecorder::Dump("critical error");
 			}
-
-			// Format the depth prefix and message directly into buffer
-			spdlog::memory_buf_t buffer;
-
-			auto appender = fmt::appender(buffer);
-			fmt::format_to(appender, "[depth: {}] ", CallDepthManager::GetDepth());
-			fmt::format_to(appender, fmtStr, std::forward<Args>(args)...);
-
-			loggerPtr->log(to_spdlog_level(level), fmt::string_view(buffer.data(), buffer.size()));
 		}
 
 		/**
@@ -135,6 +207,23 @@ namespace nyxara::logging
 		 */
 		static std::shared_ptr<spdlog::logger> GetOrCreateLogger(const std::string& name);
 
+		/**
+		 * @brief Sets the memory resource of the calling thread's formatting buffers.
+		 *
+		 * By default, each thread uses a 4 KiB thread-local monotonic buffer rewound after
+		 * every message, falling back to the heap only for messages that outgrow it. A custom
+		 * resource, e.g. a ::nyxara::memory::FrameMemoryResource, is never rewound by the
+		 * logger and must outlive its use.
+		 *
+		 * @param resource The resource, or nullptr to restore the default.
+		 */
+		static void SetThreadMessageResource(std::pmr::memory_resource* resource) noexcept;
+
+		/**
+		 * @brief Gets the memory resource of the calling thread's formatting buffers.
+		 */
+		static std::pmr::memory_resource* GetThreadMessageResource() noexcept;
+
 		/**
 		 * @brief Enables call-depth information for logging output.
 		 */
@@ -152,14 +241,294 @@ namespace nyxara::logging
 		 */
 		static bool IsCallDepthEnabled() { return CallDepthManager::IsEnabled(); }
 
+		/**
+		 * @brief Moves message formatting and sink output to a background thread.
+		 * 
+		 * Has no effect if asynchronous logging is already enabled.
+		 * 
+		 * @param options Queue capacity and overflow behavior.
+		 */
+		static void EnableAsync(const AsyncOptions& options = {});
+
+		/**
+		 * @brief Drains all pending messages and returns to synchronous logging.
+		 * 
+		 * Called automatically when the logging system shuts down.
+		 */
+		static void DisableAsync();
+
+		/**
+		 * @brief Checks if asynchronous logging is currently enabled.
+		 * 
+		 * @return True if log calls are queued to the background thread, false otherwise.
+		 */
+		static bool IsAsyncEnabled() noexcept { return bIsAsyncEnabled.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Starts recording messages to rotating binary log files.
+		 * 
+		 * Every message passing its category level is recorded, regardless of the console verbosity.
+		 * Files from a previous capture with the same path are deleted.
+		 * Has no effect if the binary log is already enabled.
+		 * 
+		 * @param options Location, file size and number of files kept.
+		 * @throws std::runtime_error If the first file cannot be created.
+		 */
+		static void EnableBinaryLog(const BinaryLogOptions& options = {});
+
+		/**
+		 * @brief Writes pending messages and closes the current binary log file.
+		 */
+		static void DisableBinaryLog();
+
+		/**
+		 * @brief Checks if messages are currently recorded to binary log files.
+		 * 
+		 * @return True if the binary log is enabled, false otherwise.
+		 */
+		static bool IsBinaryLogEnabled() noexcept { return bIsBinaryLogEnabled.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Sets the most verbose level written to the text sinks.
+		 * 
+		 * Category levels still apply; this only filters the console output, not the binary log.
+		 * 
+		 * @param level The most verbose level printed, Verbosity::Trace by default.
+		 */
+		static void SetConsoleVerbosity(Verbosity level) noexcept { ConsoleVerbosity.store(level, std::memory_order_relaxed); }
+
+		/**
+		 * @brief Gets the most verbose level written to the text sinks.
+		 */
+		static Verbosity GetConsoleVerbosity() noexcept { return ConsoleVerbosity.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Checks if a message of the given level is written to the text sinks.
+		 */
+		static bool IsConsoleEnabled(Verbosity level) noexcept { return level != Verbosity::None && level <= GetConsoleVerbosity(); }
+
+		/**
+		 * @brief Blocks until every message logged before the call has been written and flushed.
+		 */
+		static void Flush();
+
+		/**
+		 * @brief Gets the number of messages discarded under OverflowPolicy::DropAndCount.
+		 * 
+		 * @return The total number of dropped messages since startup.
+		 */
+		static uint64_t GetDroppedMessageCount();
+
 	private:
+		friend class Category;
+
+		/**
+		 * @brief Registers a category name and returns its dense identifier.
+		 * 
+		 * Registering an already known name returns the existing identifier.
+		 * 
+		 * @param name The name of the category.
+		 * @return The identifier of the category.
+		 * @throws std::runtime_error If more than MaxCategories names are registered.
+		 */
+		static uint32_t RegisterCategory(std::string_view name);
+
+		/**
+		 * @brief Gets the name of a registered category.
+		 * 
+		 * @param id The identifier returned by RegisterCategory().
+		 * @return The name, stored by the logger for the lifetime of the program.
+		 */
+		static std::string_view GetCategoryName(uint32_t id) noexcept;
+
+		/**
+		 * @brief Retrieves the atomic verbosity slot of a registered category.
+		 * 
+		 * @param id The identifier returned by RegisterCategory().
+		 * @return The verbosity slot, valid for the lifetime of the program.
+		 */
+		static std::atomic<Verbosity>& GetLevelSlot(uint32_t id) noexcept;
+
+		/**
+		 * @brief Marks the lifetime of the MessageBuffer instances of one message.
+		 * 
+		 * The default thread resource is rewound when the outermost scope ends, so a message
+		 * logged while formatting another one does not free the outer message's buffer.
+		 * Declare it before the buffers so they are destroyed first.
+		 */
+		class MessageScope
+		{
+		public:
+			MessageScope() noexcept
+				: Resource(AcquireMessageResource())
+			{}
+
+			~MessageScope() { ReleaseMessageResource(); }
+
+			MessageScope(const MessageScope&) = delete;
+			MessageScope& operator=(const MessageScope&) = delete;
+
+			/**
+			 * @brief Gets an allocator for the message buffers of this scope.
+			 */
+			std::pmr::polymorphic_allocator<char> GetAllocator() const noexcept { return Resource; }
+
+		private:
+			std::pmr::memory_resource* Resource;
+		};
+
+		static std::pmr::memory_resource* AcquireMessageResource() noexcept;
+		static void ReleaseMessageResource() noexcept;
+
 		/**
-		 * @brief Retrieves the configured verbosity level for a given category name.
+		 * @brief Formats and writes a message on the calling thread.
 		 * 
-		 * @param cat_name The name of the category.
-		 * @return The configured verbosity level.
+		 * The message is formatted here rather than by spdlog so long messages grow into the
+		 * thread's message resource instead of the heap.
 		 */
-		static Verbosity GetCategoryLevel(const std::string& cat_name);
+		template<typename... Args>
+		static void LogSync(const Category& category, Verbosity level, fmt::format_string<Args...> fmtStr, Args&&... args)
+		{
+			MessageScope scope;
+			MessageBuffer buffer(scope.GetAllocator());
+
+			auto appender = fmt::appender(buffer);
+
+			if (CallDepthManager::IsEnabled())
+			{
+				fmt::format_to(appender, "[depth: {}] ", CallDepthManager::GetDepth());
+			}
+
+			fmt::format_to(appender, fmtStr, std::forward<Args>(args)...);
+
+			category.GetLogger()->log(to_spdlog_level(level), fmt::string_view(buffer.data(), buffer.size()));
+		}
+
+		/**
+		 * @brief Writes a message to the binary log and the text sinks from the calling thread.
+		 */
+		template<typename... Args>
+		static void LogDirect(const CallSite* site, const Category& category, Verbosity level,
+			fmt::format_string<Args...> fmtStr, Args&&... args)
+		{
+			if (IsBinaryLogEnabled())
+			{
+				EnqueueRecord<BinaryLogQueue, Args...>(site, category, level, fmtStr, std::forward<Args>(args)...);
+			}
+
+			if (IsConsoleEnabled(level))
+			{
+				LogSync(category, level, fmtStr, std::forward<Args>(args)...);
+			}
+		}
+
+		/**
+		 * @brief Records a message in the calling thread's flight recorder ring.
+		 * 
+		 * Messages too large for a slot are formatted and truncated.
+		 */
+		template<typename... Args>
+		static void LogFlightRecorder(const CallSite* site, const Category& category, Verbosity level,
+			fmt::format_string<Args...> fmtStr, Args&&... args)
+		{
+			if (EnqueueRecord<FlightRecorderQueue, Args...>(site, category, level, fmtStr, std::forward<Args>(args)...))
+			{
+				return;
+			}
+
+			MessageScope scope;
+			MessageBuffer buffer(scope.GetAllocator());
+			fmt::format_to(fmt::appender(buffer), fmtStr, std::forward<Args>(args)...);
+
+			size_t maxSize = FlightRecorderQueue::GetMaxArgsSize() - RecordCodec::ArgsSize(std::string_view());
+			std::string_view message(buffer.data(), std::min(buffer.size(), maxSize));
+
+			std::byte* dst = FlightRecorderQueue::Reserve(category, site, level, RecordCodec::PreformattedFormat,
+				RecordFlagPreformatted, 1, RecordCodec::ArgsSize(message));
+
+			if (dst)
+			{
+				RecordCodec::EncodeArgs(dst, message);
+				FlightRecorderQueue::Commit();
+			}
+		}
+
+		/**
+		 * @brief Serializes a message into the calling thread's asynchronous queue.
+		 * 
+		 * Messages too large for the queue are written from the calling thread instead.
+		 */
+		template<typename... Args>
+		static void LogAsync(const CallSite* site, const Category& category, Verbosity level,
+			fmt::format_string<Args...> fmtStr, Args&&... args)
+		{
+			if (!EnqueueRecord<AsyncQueue, Args...>(site, category, level, fmtStr, std::forward<Args>(args)...))
+			{
+				LogDirect(site, category, level, fmtStr, std::forward<Args>(args)...);
+			}
+		}
+
+		/**
+		 * @brief Serializes a message into a record queue (AsyncQueue, BinaryLogQueue or FlightRecorderQueue).
+		 * 
+		 * Messages whose arguments cannot be serialized are formatted here and stored as text.
+		 * Arguments are only read, never moved, so the caller may pass them on afterwards.
+		 * 
+		 * @return False if the message is too large for the queue, true otherwise (even if it was dropped).
+		 */
+		template<typename Queue, typename... Args>
+		static bool EnqueueRecord(const CallSite* site, const Category& category, Verbosity level,
+			fmt::format_string<Args...> fmtStr, Args&&... args)
+		{
+			if constexpr (RecordCodec::IsEncodable<Args...>())
+			{
+				size_t argsSize = RecordCodec::ArgsSize(args...);
+
+				if (argsSize > Queue::GetMaxArgsSize())
+				{
+					return false;
+				}
+
+				fmt::string_view format = fmtStr;
+				std::byte* dst = Queue::Reserve(category, site, level, std::string_view(format.data(), format.size()),
+					RecordFlagNone, sizeof...(Args), argsSize);
+
+				if (dst)
+				{
+					RecordCodec::EncodeArgs(dst, args...);
+					Queue::Commit();
+				}
+			}
+			else
+			{
+				MessageScope scope;
+				MessageBuffer buffer(scope.GetAllocator());
+				fmt::format_to(fmt::appender(buffer), fmtStr, std::forward<Args>(args)...);
+
+				std::string_view message(buffer.data(), buffer.size());
+				size_t argsSize = RecordCodec::ArgsSize(message);
+
+				if (argsSize > Queue::GetMaxArgsSize())
+				{
+					return false;
+				}
+
+				std::byte* dst = Queue::Reserve(category, site, level, RecordCodec::PreformattedFormat,
+					RecordFlagPreformatted, 1, argsSize);
+
+				if (dst)
+				{
+					RecordCodec::EncodeArgs(dst, message);
+					Queue::Commit();
+				}
+			}
+
+			return true;
+		}
+
+		static inline std::atomic<bool> bIsAsyncEnabled{ false }; ///< Whether log calls go to the background thread.
+		static inline std::atomic<bool> bIsBinaryLogEnabled{ false }; ///< Whether messages are recorded to binary files.
+		static inline std::atomic<Verbosity> ConsoleVerbosity{ Verbosity::Trace }; ///< Most verbose level sent to text sinks.
 	};
 } // namespace nyxara::logging
 
@@ -9,7 +9,9 @@
  * 
  * It provides macro interfaces for:
  * - Declaring and defining logging categories
- * - Logging messages with verbosity levels
+ * - Logging messages with verbosity levels, each statement registering a call site
+ *   that can be toggled at runtime (see call_site.h)
+ * - Sampling and rate-limiting noisy log statements
  * - Automatically tracing function entry and exit
  * - Managing call depth tracking in logs
  * 
@@ -25,8 +27,10 @@
  * @see nyxara::logging::FunctionTracer
  */
 
+#include "nyxara/core/logging/call_site.h"
 #include "nyxara/core/logging/function_tracer.h"
 #include "nyxara/core/logging/logger.h"
+#include "nyxara/core/logging/rate_limit.h"
 
 /**
  * @defgroup LoggingMacros Nyxara Logging Macros 
@@ -40,6 +44,7 @@
  * 
  * This macro should be used in header files to declare a logging category
  * that is defined in a source file using NYX_DEFINE_LOG_CATEGORY.
+ * The category uses the global compile-time verbosity (NYX_LOG_COMPILE_TIME_VERBOSITY).
  * 
  * @code
  * NYX_DECLARE_LOG_CATEGORY(Renderer);
@@ -48,19 +53,35 @@
 #define NYX_DECLARE_LOG_CATEGORY(Name) \
     extern const ::nyxara::logging::Category Name
 
+/**
+ * @def NYX_DECLARE_LOG_CATEGORY_EX(Name, CompileTimeVerbosity)
+ * @brief Declares a logging category with its own compile-time verbosity.
+ * 
+ * Messages more verbose than @p CompileTimeVerbosity are removed from the binary
+ * for this category, regardless of the global NYX_LOG_COMPILE_TIME_VERBOSITY.
+ * 
+ * @code
+ * NYX_DECLARE_LOG_CATEGORY_EX(Renderer, ::nyxara::logging::Verbosity::Info);
+ * @endcode
+ */
+#define NYX_DECLARE_LOG_CATEGORY_EX(Name, CompileTimeVerbosity) \
+    extern const ::nyxara::logging::CompiledCategory<CompileTimeVerbosity> Name
+
 /**
  * @def NYX_DEFINE_LOG_CATEGORY(Name)
  * @brief Defines a logging category with the given name.
  * 
  * This macro creates a const instance of a logging category that can be used
  * throughout the application. The category is initialized once per translation unit.
+ * The category must have been declared with NYX_DECLARE_LOG_CATEGORY or
+ * NYX_DECLARE_LOG_CATEGORY_EX first; the definition reuses the declared type.
  * 
  * @code
  * NYX_DEFINE_LOG_CATEGORY(Renderer)
  * @endcode
  */
 #define NYX_DEFINE_LOG_CATEGORY(Name) \
-    const ::nyxara::logging::Category Name(#Name)
+    decltype(Name) Name(#Name)
 
 /**
  * @def NYX_SET_LOG_LEVEL(CAT, LEVEL)
@@ -72,16 +93,57 @@
 #define NYX_SET_LOG_LEVEL(CAT, LEVEL) \
             ::nyxara::logging::Logger::SetCategoryLevel(CAT, LEVEL)
 
+#if defined(__GNUC__) || defined(__clang__)
+#define NYX_FUNCTION_NAME __PRETTY_FUNCTION__
+#elif defined(_MSC_VER)
+#define NYX_FUNCTION_NAME __FUNCSIG__
+#else
+#define NYX_FUNCTION_NAME __func__
+#endif
+
+// Expands to the first argument of a variadic list; the extra pass is needed by MSVC's traditional preprocessor.
+#define NYX_EXPAND(X) X
+#define NYX_FIRST_ARG(...) NYX_EXPAND(NYX_FIRST_ARG_IMPL(__VA_ARGS__, unused))
+#define NYX_FIRST_ARG_IMPL(FIRST, ...) FIRST
+
+/**
+ * @def NYX_DEFINE_CALL_SITE(NAME, LEVEL, FORMAT)
+ * @brief Defines the constant-initialized descriptor of the enclosing log statement.
+ * 
+ * @param NAME Name of the function-local static descriptor.
+ * @param LEVEL Verbosity level of the statement.
+ * @param FORMAT Format string literal of the statement.
+ */
+#define NYX_DEFINE_CALL_SITE(NAME, LEVEL, FORMAT) \
+            static constinit ::nyxara::logging::CallSite NAME(LEVEL, __FILE__, __LINE__, NYX_FUNCTION_NAME, FORMAT)
+
 /**
  * @def NYX_LOG(CAT, LEVEL, ...)
  * @brief Logs a message at the specified verbosity level under the given category.
  * 
+ * If @p LEVEL is more verbose than the category's compile-time verbosity, the call
+ * compiles to nothing: arguments are not evaluated and the format string is not
+ * emitted into the binary.
+ * 
+ * Otherwise the statement owns a ::nyxara::logging::CallSite, registered the first
+ * time it runs, which can force the statement on or off regardless of the category level.
+ * 
  * @param CAT The logging category.
- * @param LEVEL Verbosity level (e.g., Verbosity::Warn).
- * @param ... Format string and arguments (fmt-style).
+ * @param LEVEL Verbosity level (e.g., Verbosity::Warn). Must be a constant expression.
+ * @param ... Format string literal and arguments (fmt-style).
  */
 #define NYX_LOG(CAT, LEVEL, ...) \
-            ::nyxara::logging::Logger::Log(CAT, LEVEL, __VA_ARGS__)
+            do \
+            { \
+                if constexpr (::nyxara::logging::IsCompiledIn<decltype(CAT)>(LEVEL)) \
+                { \
+                    NYX_DEFINE_CALL_SITE(nyxCallSite, LEVEL, NYX_FIRST_ARG(__VA_ARGS__)); \
+                    if (const uint8_t nyxTargets = nyxCallSite.GetTargets(CAT)) \
+                    { \
+                        ::nyxara::logging::Logger::Dispatch(&nyxCallSite, CAT, LEVEL, nyxTargets, __VA_ARGS__); \
+                    } \
+                } \
+            } while (false)
 
 
 // ----------------------------------------------------------------------------
@@ -118,11 +180,114 @@
  */
 #define NYX_LOG_TRACE(CAT, ...) NYX_LOG(CAT, ::nyxara::logging::Verbosity::Trace, __VA_ARGS__)
 
+
+// ----------------------------------------------------------------------------
+// Sampled and rate-limited logging
+// ----------------------------------------------------------------------------
+
+/**
+ * @def NYX_LOG_ONCE(CAT, LEVEL, ...)
+ * @brief Logs a message the first time the statement is reached and enabled.
+ * 
+ * @param CAT The logging category.
+ * @param LEVEL Verbosity level. Must be a constant expression.
+ * @param ... Format string and arguments (fmt-style).
+ */
+#define NYX_LOG_ONCE(CAT, LEVEL, ...) \
+            do \
+            { \
+                if constexpr (::nyxara::logging::IsCompiledIn<decltype(CAT)>(LEVEL)) \
+                { \
+                    NYX_DEFINE_CALL_SITE(nyxCallSite, LEVEL, NYX_FIRST_ARG(__VA_ARGS__)); \
+                    static ::nyxara::logging::LogOnceState nyxLogState; \
+                    if (const uint8_t nyxTargets = nyxCallSite.GetTargets(CAT); nyxTargets && nyxLogState.ShouldLog()) \
+                    { \
+                        ::nyxara::logging::Logger::Dispatch(&nyxCallSite, CAT, LEVEL, nyxTargets, __VA_ARGS__); \
+                    } \
+                } \
+            } while (false)
+
+/**
+ * @def NYX_LOG_RATE_LIMITED_IMPL(CAT, LEVEL, STATE_TYPE, SHOULD_LOG_ARGS, ...)
+ * @brief Shared implementation of the rate-limited logging macros.
+ * 
+ * Declares a per-call-site state of type @p STATE_TYPE and logs, preceded by a
+ * suppression summary, when its `ShouldLog(SHOULD_LOG_ARGS, suppressed)` accepts the call.
+ */
+#define NYX_LOG_RATE_LIMITED_IMPL(CAT, LEVEL, STATE_TYPE, SHOULD_LOG_ARGS, ...) \
+            do \
+            { \
+                if constexpr (::nyxara::logging::IsCompiledIn<decltype(CAT)>(LEVEL)) \
+                { \
+                    NYX_DEFINE_CALL_SITE(nyxCallSite, LEVEL, NYX_FIRST_ARG(__VA_ARGS__)); \
+                    NYX_DEFINE_CALL_SITE(nyxSummarySite, LEVEL, ::nyxara::logging::SuppressedSummaryFormat); \
+                    static STATE_TYPE nyxLogState; \
+                    uint64_t nyxSuppressed = 0; \
+                    const uint8_t nyxTargets = nyxCallSite.GetTargets(CAT); \
+                    if (nyxTargets && nyxLogState.ShouldLog(SHOULD_LOG_ARGS, nyxSuppressed)) \
+                    { \
+                        ::nyxara::logging::LogSuppressedSummary(nyxCallSite, nyxSummarySite, CAT, nyxTargets, \
+                            nyxSuppressed); \
+                        ::nyxara::logging::Logger::Dispatch(&nyxCallSite, CAT, LEVEL, nyxTargets, __VA_ARGS__); \
+                    } \
+                } \
+            } while (false)
+
+/**
+ * @def NYX_LOG_EVERY_N(CAT, LEVEL, N, ...)
+ * @brief Logs the first message and then one out of every @p N.
+ * 
+ * @code
+ * NYX_LOG_EVERY_N(Platform, ::nyxara::logging::Verbosity::Warn, 100, "Dropped event {}", id);
+ * @endcode
+ * 
+ * @param CAT The logging category.
+ * @param LEVEL Verbosity level. Must be a constant expression.
+ * @param N Sampling period.
+ * @param ... Format string and arguments (fmt-style).
+ */
+#define NYX_LOG_EVERY_N(CAT, LEVEL, N, ...) \
+            NYX_LOG_RATE_LIMITED_IMPL(CAT, LEVEL, ::nyxara::logging::LogEveryNState, \
+                static_cast<uint64_t>(N), __VA_ARGS__)
+
+/**
+ * @def NYX_LOG_EVERY_MS(CAT, LEVEL, MS, ...)
+ * @brief Logs at most one message every @p MS milliseconds.
+ * 
+ * @param CAT The logging category.
+ * @param LEVEL Verbosity level. Must be a constant expression.
+ * @param MS Minimum interval between two messages, in milliseconds.
+ * @param ... Format string and arguments (fmt-style).
+ */
+#define NYX_LOG_EVERY_MS(CAT, LEVEL, MS, ...) \
+            NYX_LOG_RATE_LIMITED_IMPL(CAT, LEVEL, ::nyxara::logging::LogEveryIntervalState, \
+                std::chrono::milliseconds(MS), __VA_ARGS__)
+
+/**
+ * @def NYX_LOG_THROTTLED(CAT, LEVEL, RATE, BURST, ...)
+ * @brief Logs through a token bucket refilled at @p RATE messages per second.
+ * 
+ * Up to @p BURST messages can be logged back to back before the rate applies.
+ * 
+ * @param CAT The logging category.
+ * @param LEVEL Verbosity level. Must be a constant expression.
+ * @param RATE Sustained number of messages per second.
+ * @param BURST Maximum number of messages logged in a burst.
+ * @param ... Format string and arguments (fmt-style).
+ */
+#define NYX_LOG_THROTTLED(CAT, LEVEL, RATE, BURST, ...) \
+            NYX_LOG_RATE_LIMITED_IMPL(CAT, LEVEL, ::nyxara::logging::LogThrottleState, \
+                ::nyxara::logging::LogThrottleRate(static_cast<double>(RATE), static_cast<uint32_t>(BURST)), __VA_ARGS__)
+
 /**
  * @def NYX_TRACE_FUNCTION(CAT)
  * @brief Logs entry and exit of the current function using FunctionTracer.
  * 
- * Useful for tracing function calls automatically.
+ * Useful for tracing function calls automatically. If Trace is stripped at compile
+ * time for the category, the tracer is an empty object with no side effects.
+ * 
+ * The call site of the entering message decides for both messages, so a single
+ * function can be traced by forcing that site on while the category stays above Trace.
  * 
  * @param CAT The logging category to log under.
  * 
@@ -134,15 +299,13 @@
  * }
  * @endcode
  */
-#if defined(__GNUC__) || defined(__clang__)
-#define NYX_FUNCTION_NAME __PRETTY_FUNCTION__
-#elif defined(_MSC_VER)
-#define NYX_FUNCTION_NAME __FUNCSIG__
-#else
-#define NYX_FUNCTION_NAME __func__
-#endif
-
-#define NYX_TRACE_FUNCTION(CAT) ::nyxara::logging::FunctionTracer tracer(CAT, NYX_FUNCTION_NAME)
+#define NYX_TRACE_FUNCTION(CAT) \
+            NYX_DEFINE_CALL_SITE(nyxTraceSite, ::nyxara::logging::Verbosity::Trace, \
+                ::nyxara::logging::FunctionTracer::EnteringFormat); \
+            NYX_DEFINE_CALL_SITE(nyxTraceLeaveSite, ::nyxara::logging::Verbosity::Trace, \
+                ::nyxara::logging::FunctionTracer::LeavingFormat); \
+            ::nyxara::logging::FunctionTracerFor<decltype(CAT)> tracer(nyxTraceSite, nyxTraceLeaveSite, CAT, \
+                NYX_FUNCTION_NAME)
 
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,226 @@
+#pragma once
+
+/**
+ * @file rate_limit.h
+ * @brief Per-call-site state for sampled and rate-limited logging.
+ *
+ * This header defines the state objects behind @ref NYX_LOG_ONCE, @ref NYX_LOG_EVERY_N,
+ * @ref NYX_LOG_EVERY_MS and @ref NYX_LOG_THROTTLED. Each macro expansion owns one
+ * function-local static instance, constant-initialized so no guard variable is involved.
+ *
+ * @details
+ * The states only use relaxed atomics: a suppressed message costs one or two atomic
+ * operations (plus a steady clock read for the time-based variants), with no lock and
+ * no formatting. When a site fires again after suppressing messages, the macros log a
+ * "suppressed N messages" summary just before the message.
+ *
+ * The call site (see call_site.h) is checked before the state is touched, so messages
+ * filtered out by their category or call site are neither counted nor reported as suppressed.
+ *
+ * @see nyxara::logging::Logger
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "nyxara/core/logging/call_site.h"
+#include "nyxara/core/logging/category.h"
+#include "nyxara/core/logging/logger.h"
+#include "nyxara/core/logging/verbosity.h"
+
+namespace nyxara::logging
+{
+	/**
+	 * @brief Lets a single message through, ever.
+	 */
+	class LogOnceState
+	{
+	public:
+		constexpr LogOnceState() noexcept = default;
+
+		/**
+		 * @brief Checks whether the call site should log.
+		 *
+		 * @return True the first time only.
+		 */
+		bool ShouldLog() noexcept
+		{
+			return !bHasFired.load(std::memory_order_relaxed) && !bHasFired.exchange(true, std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<bool> bHasFired{ false };
+	};
+
+	/**
+	 * @brief Lets the first message and then every N-th message through.
+	 */
+	class LogEveryNState
+	{
+	public:
+		constexpr LogEveryNState() noexcept = default;
+
+		/**
+		 * @brief Checks whether the call site should log.
+		 *
+		 * @param n Sampling period; values below 1 behave as 1.
+		 * @param suppressed Receives the number of messages skipped since the last one logged.
+		 * @return True for calls 1, N + 1, 2N + 1, ...
+		 */
+		bool ShouldLog(uint64_t n, uint64_t& suppressed) noexcept
+		{
+			n = n > 0 ? n : 1;
+			uint64_t count = Count.fetch_add(1, std::memory_order_relaxed);
+
+			if (count % n != 0)
+			{
+				return false;
+			}
+
+			suppressed = count == 0 ? 0 : n - 1;
+			return true;
+		}
+
+	private:
+		std::atomic<uint64_t> Count{ 0 };
+	};
+
+	/**
+	 * @brief Lets at most one message through per time interval.
+	 */
+	class LogEveryIntervalState
+	{
+	public:
+		constexpr LogEveryIntervalState() noexcept = default;
+
+		/**
+		 * @brief Checks whether the call site should log.
+		 *
+		 * @param interval Minimum time between two logged messages.
+		 * @param suppressed Receives the number of messages skipped since the last one logged.
+		 * @return True if at least @p interval elapsed since the last logged message.
+		 */
+		bool ShouldLog(std::chrono::nanoseconds interval, uint64_t& suppressed) noexcept
+		{
+			int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+			int64_t next = NextAllowed.load(std::memory_order_relaxed);
+
+			if (now < next || !NextAllowed.compare_exchange_strong(next, now + interval.count(), std::memory_order_relaxed))
+			{
+				SuppressedCount.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			suppressed = SuppressedCount.exchange(0, std::memory_order_relaxed);
+			return true;
+		}
+
+	private:
+		std::atomic<int64_t> NextAllowed{ 0 };			///< Steady clock time at which the site may log again.
+		std::atomic<uint64_t> SuppressedCount{ 0 };	///< Messages skipped since the last one logged.
+	};
+
+	/**
+	 * @brief Parameters of a LogThrottleState.
+	 */
+	struct LogThrottleRate
+	{
+		static constexpr double MinRatePerSecond = 1e-3;	///< One token every ~17 minutes.
+		static constexpr double MaxRatePerSecond = 1e9;		///< One token per nanosecond.
+		static constexpr uint32_t MaxBurst = 1'000'000;		///< Keeps the bucket's tolerance within int64 nanoseconds.
+
+		/**
+		 * @brief Clamps the rate to [MinRatePerSecond, MaxRatePerSecond] and the burst to [1, MaxBurst].
+		 *
+		 * A zero, negative or NaN rate becomes MinRatePerSecond.
+		 */
+		constexpr LogThrottleRate(double ratePerSecond, uint32_t burst) noexcept
+			: RatePerSecond(!(ratePerSecond >= MinRatePerSecond) ? MinRatePerSecond
+				: ratePerSecond > MaxRatePerSecond ? MaxRatePerSecond : ratePerSecond),
+			  Burst(burst < 1 ? 1 : burst > MaxBurst ? MaxBurst : burst)
+		{}
+
+		double RatePerSecond;	///< Tokens added to the bucket per second.
+		uint32_t Burst;			///< Bucket capacity.
+	};
+
+	/**
+	 * @brief Token bucket: sustains a rate of messages per second with bursts up to a capacity.
+	 *
+	 * Implemented as the generic cell rate algorithm, which keeps the whole bucket in a
+	 * single atomic: the theoretical arrival time of the next message.
+	 */
+	class LogThrottleState
+	{
+	public:
+		constexpr LogThrottleState() noexcept = default;
+
+		/**
+		 * @brief Checks whether the call site should log, consuming a token if it does.
+		 *
+		 * @param rate Refill rate and capacity of the bucket.
+		 * @param suppressed Receives the number of messages skipped since the last one logged.
+		 * @return True if a token was available.
+		 */
+		bool ShouldLog(const LogThrottleRate& rate, uint64_t& suppressed) noexcept
+		{
+			const int64_t increment = static_cast<int64_t>(1e9 / rate.RatePerSecond);
+			const int64_t tolerance = increment * static_cast<int64_t>(rate.Burst - 1);
+			const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+
+			int64_t arrival = TheoreticalArrival.load(std::memory_order_relaxed);
+
+			for (;;)
+			{
+				int64_t start = arrival > now ? arrival : now;
+
+				if (start - now > tolerance)
+				{
+					SuppressedCount.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				if (TheoreticalArrival.compare_exchange_weak(arrival, start + increment, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+
+			suppressed = SuppressedCount.exchange(0, std::memory_order_relaxed);
+			return true;
+		}
+
+	private:
+		std::atomic<int64_t> TheoreticalArrival{ 0 };	///< When the bucket would be full again, in steady clock nanoseconds.
+		std::atomic<uint64_t> SuppressedCount{ 0 };	///< Messages skipped since the last one logged.
+	};
+
+	/**
+	 * @brief Format of the "suppressed N messages" summary of a rate-limited call site.
+	 */
+	inline constexpr char SuppressedSummaryFormat[] = "Suppressed {} message(s) from {}:{}";
+
+	/**
+	 * @brief Logs the "suppressed N messages" summary of a rate-limited call site.
+	 *
+	 * Does nothing if @p suppressed is zero. The summary goes where the rate-limited
+	 * message goes, as decided by @p site.
+	 *
+	 * @param site The call site.
+	 * @param summarySite The call site of the summary, with SuppressedSummaryFormat.
+	 * @param category The category of the call site.
+	 * @param targets The targets returned by CallSite::GetTargets().
+	 * @param suppressed Number of messages skipped since the site last logged.
+	 */
+	inline void LogSuppressedSummary(const CallSite& site, const CallSite& summarySite, const Category& category,
+		uint8_t targets, uint64_t suppressed)
+	{
+		if (suppressed > 0)
+		{
+			Logger::Dispatch(&summarySite, category, site.GetLevel(), targets, SuppressedSummaryFormat,
+				suppressed, site.GetFile(), site.GetLine());
+		}
+	}
+} // namespace nyxara::logging
@@ -0,0 +1,287 @@
+#pragma once
+
+/**
+ * @file record.h
+ * @brief Compact, unformatted representation of a log message.
+ *
+ * This header defines ::nyxara::logging::RecordHeader and ::nyxara::logging::RecordCodec,
+ * which capture a log call as a fixed header followed by its arguments serialized
+ * into a tagged byte stream. Formatting is deferred until the record is consumed,
+ * which lets the calling thread pay only for a few memory copies.
+ *
+ * @details
+ * Supported argument types are booleans, characters, integers, `float`, `double`,
+ * `void` pointers and strings (`const char*`, `std::string`, `std::string_view`,
+ * character arrays). Calls with any other argument type are formatted eagerly and
+ * stored as a single preformatted string (see ::nyxara::logging::RecordFlagPreformatted).
+ *
+ * The layout of a record is:
+ * - a ::nyxara::logging::RecordHeader
+ * - `ArgCount` arguments, each a ::nyxara::logging::RecordArgType tag byte followed
+ *   by its payload (strings are prefixed by a 32-bit length and are not null terminated)
+ *
+ * Payloads are unaligned and must be read with `std::memcpy`.
+ *
+ * @see nyxara::logging::Logger
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "nyxara/core/logging/verbosity.h"
+
+namespace nyxara::logging
+{
+	class CallSite;
+
+	/**
+	 * @brief Type tag preceding every serialized argument.
+	 */
+	enum class RecordArgType : uint8_t
+	{
+		Bool = 0,	///< 1-byte boolean
+		Char,		///< 1-byte character
+		Int64,		///< Signed integer widened to 64 bits
+		UInt64,		///< Unsigned integer widened to 64 bits
+		Float,		///< 32-bit floating point value
+		Double,		///< 64-bit floating point value
+		Pointer,	///< Pointer value, formatted as `const void*`
+		String		///< 32-bit length followed by the characters
+	};
+
+	/**
+	 * @brief Bit flags stored in RecordHeader::Flags.
+	 */
+	enum RecordFlags : uint16_t
+	{
+		RecordFlagNone			= 0,		///< No flag set
+		RecordFlagCallDepth		= 1 << 0,	///< Prefix the message with the call depth
+		RecordFlagPreformatted	= 1 << 1	///< The message was formatted on the calling thread
+	};
+
+	/**
+	 * @brief Fixed-size header describing a serialized log message.
+	 */
+	struct RecordHeader
+	{
+		uint32_t Size;			///< Total size of the record in bytes, header included.
+		uint32_t CategoryId;	///< Identifier of the category (see Category::GetId()).
+		uint32_t ArgsSize;		///< Size of the serialized arguments in bytes.
+		const CallSite* Site;	///< Descriptor of the log statement, or nullptr if unknown.
+		int64_t Timestamp;		///< Nanoseconds since the system clock epoch.
+		uint64_t ThreadId;		///< Operating system identifier of the calling thread.
+		const char* Format;		///< Format string; must outlive the record.
+		uint32_t FormatSize;	///< Length of the format string.
+		int32_t CallDepth;		///< Call depth of the calling thread.
+		uint8_t Level;			///< Verbosity of the message.
+		uint8_t ArgCount;		///< Number of serialized arguments.
+		uint16_t Flags;			///< Combination of RecordFlags.
+	};
+
+	/**
+	 * @brief Serialization traits for a single log argument type.
+	 *
+	 * @tparam T The argument type as passed to the logging call.
+	 */
+	template<typename T>
+	struct RecordArg
+	{
+		using Type = std::remove_cvref_t<T>;
+		using Decayed = std::decay_t<T>;
+
+		static constexpr bool bIsCString = std::is_same_v<Decayed, const char*> || std::is_same_v<Decayed, char*>;
+		static constexpr bool bIsString = bIsCString || std::is_same_v<Type, std::string> || std::is_same_v<Type, std::string_view>;
+		static constexpr bool bIsBool = std::is_same_v<Type, bool>;
+		static constexpr bool bIsChar = std::is_same_v<Type, char>;
+		static constexpr bool bIsInteger = std::is_integral_v<Type> && !bIsBool && !bIsChar
+			&& (sizeof(Type) <= sizeof(uint64_t));
+		static constexpr bool bIsFloat = std::is_same_v<Type, float>;
+		static constexpr bool bIsDouble = std::is_same_v<Type, double>;
+		static constexpr bool bIsPointer = !bIsCString && (std::is_pointer_v<Decayed> || std::is_null_pointer_v<Type>);
+
+		/**
+		 * @brief Whether the type can be serialized without formatting it first.
+		 */
+		static constexpr bool bIsSupported = bIsString || bIsBool || bIsChar || bIsInteger
+			|| bIsFloat || bIsDouble || bIsPointer;
+
+		/**
+		 * @brief Gets the string held by a string-like argument.
+		 */
+		static std::string_view AsString(const Type& value) noexcept
+		{
+			if constexpr (bIsCString && std::is_array_v<Type>)
+			{
+				return std::string_view(value);
+			}
+			else if constexpr (bIsCString)
+			{
+				return value ? std::string_view(value) : std::string_view("(null)");
+			}
+			else
+			{
+				return std::string_view(value);
+			}
+		}
+
+		/**
+		 * @brief Gets the number of bytes needed to serialize the value, tag included.
+		 */
+		static size_t Size(const Type& value) noexcept
+		{
+			if constexpr (bIsString)
+			{
+				return 1 + sizeof(uint32_t) + AsString(value).size();
+			}
+			else if constexpr (bIsBool || bIsChar)
+			{
+				return 1 + 1;
+			}
+			else if constexpr (bIsFloat)
+			{
+				return 1 + sizeof(float);
+			}
+			else
+			{
+				return 1 + sizeof(uint64_t);
+			}
+		}
+
+		/**
+		 * @brief Serializes the value at @p dst.
+		 *
+		 * @return Pointer one past the last written byte.
+		 */
+		static std::byte* Encode(std::byte* dst, const Type& value) noexcept
+		{
+			if constexpr (bIsString)
+			{
+				std::string_view str = AsString(value);
+				uint32_t length = static_cast<uint32_t>(str.size());
+				*dst++ = static_cast<std::byte>(RecordArgType::String);
+				std::memcpy(dst, &length, sizeof(length));
+				std::memcpy(dst + sizeof(length), str.data(), str.size());
+				return dst + sizeof(length) + str.size();
+			}
+			else if constexpr (bIsBool || bIsChar)
+			{
+				*dst++ = static_cast<std::byte>(bIsBool ? RecordArgType::Bool : RecordArgType::Char);
+				*dst++ = static_cast<std::byte>(value);
+				return dst;
+			}
+			else if constexpr (bIsFloat)
+			{
+				return EncodeScalar(dst, RecordArgType::Float, value);
+			}
+			else if constexpr (bIsDouble)
+			{
+				return EncodeScalar(dst, RecordArgType::Double, value);
+			}
+			else if constexpr (bIsPointer)
+			{
+				return EncodeScalar(dst, RecordArgType::Pointer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(
+					static_cast<const void*>(value))));
+			}
+			else if constexpr (std::is_signed_v<Type>)
+			{
+				return EncodeScalar(dst, RecordArgType::Int64, static_cast<int64_t>(value));
+			}
+			else
+			{
+				return EncodeScalar(dst, RecordArgType::UInt64, static_cast<uint64_t>(value));
+			}
+		}
+
+	private:
+		template<typename Stored>
+		static std::byte* EncodeScalar(std::byte* dst, RecordArgType type, Stored value) noexcept
+		{
+			*dst++ = static_cast<std::byte>(type);
+			std::memcpy(dst, &value, sizeof(Stored));
+			return dst + sizeof(Stored);
+		}
+	};
+
+	/**
+	 * @brief Serializes log arguments and formats serialized records.
+	 */
+	class RecordCodec
+	{
+	public:
+		/**
+		 * @brief Format string used for records flagged RecordFlagPreformatted.
+		 */
+		static constexpr std::string_view PreformattedFormat = "{}";
+
+		/**
+		 * @brief Builds the header of a record logged by the calling thread.
+		 *
+		 * Captures the current time, the thread identifier and, if enabled, the call depth.
+		 *
+		 * @param categoryId Identifier of the category (see Category::GetId()).
+		 * @param site Descriptor of the log statement, or nullptr if unknown.
+		 * @param level Verbosity of the message.
+		 * @param format Format string; must outlive the record.
+		 * @param flags Combination of RecordFlags.
+		 * @param argCount Number of serialized arguments.
+		 * @param argsSize Size of the serialized arguments in bytes.
+		 */
+		static RecordHeader MakeHeader(uint32_t categoryId, const CallSite* site, Verbosity level,
+			std::string_view format, uint16_t flags, uint32_t argCount, size_t argsSize) noexcept;
+
+		/**
+		 * @brief Checks whether all argument types can be serialized as-is.
+		 */
+		template<typename... Args>
+		static constexpr bool IsEncodable() noexcept
+		{
+			return (RecordArg<Args>::bIsSupported && ...);
+		}
+
+		/**
+		 * @brief Gets the number of bytes needed to serialize all arguments.
+		 */
+		template<typename... Args>
+		static size_t ArgsSize(const Args&... args) noexcept
+		{
+			return (size_t{ 0 } + ... + RecordArg<Args>::Size(args));
+		}
+
+		/**
+		 * @brief Serializes all arguments at @p dst, which must hold ArgsSize() bytes.
+		 *
+		 * @return Pointer one past the last written byte.
+		 */
+		template<typename... Args>
+		static std::byte* EncodeArgs(std::byte* dst, const Args&... args) noexcept
+		{
+			((dst = RecordArg<Args>::Encode(dst, args)), ...);
+			return dst;
+		}
+
+		/**
+		 * @brief Formats serialized arguments with the given format string.
+		 *
+		 * Formatting errors are reported inline in the output instead of throwing.
+		 *
+		 * @param format The fmt-style format string.
+		 * @param args Pointer to the serialized arguments.
+		 * @param argsSize Size of the serialized arguments in bytes.
+		 * @param argCount Number of serialized arguments.
+		 * @param out Buffer the formatted text is appended to.
+		 */
+		static void FormatArgs(std::string_view format, const std::byte* args, uint32_t argsSize,
+			uint32_t argCount, spdlog::memory_buf_t& out);
+
+		/**
+		 * @brief Formats an in-memory record, including its call-depth prefix if flagged.
+		 *
+		 * @param header The record header; its arguments must directly follow it in memory.
+		 * @param out Buffer the formatted text is appended to.
+		 */
+		static void FormatRecord(const RecordHeader& header, spdlog::memory_buf_t& out);
+	};
+} // namespace nyxara::logging
@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * @file timeline.h
+ * @brief Low-overhead recording of traced scopes for offline timeline viewers.
+ *
+ * This header defines ::nyxara::logging::Timeline, which records begin and end
+ * events of traced scopes (see @ref NYX_TRACE_FUNCTION) while a capture is running.
+ * Captures can be exported as Chrome Trace Event JSON (`chrome://tracing`) or as a
+ * Perfetto protobuf trace (ui.perfetto.dev).
+ *
+ * @details
+ * Each thread appends fixed-size events (timestamp, scope name, call depth) to its
+ * own preallocated buffer; no lock is taken and nothing is formatted while recording.
+ * When no capture is running, a traced scope costs a single relaxed atomic load.
+ *
+ * Scopes still open when the capture stops are closed at the stop time on export,
+ * and scopes that started before the capture are ignored. Events recorded after a
+ * thread's buffer is full are dropped and counted.
+ *
+ * Scope names must have static storage duration, which is the case of function
+ * names provided by @ref NYX_TRACE_FUNCTION.
+ *
+ * @see nyxara::logging::FunctionTracer
+ * @see nyxara::logging::CallDepthManager
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace nyxara::logging
+{
+	/**
+	 * @brief Options of a timeline capture.
+	 */
+	struct TimelineOptions
+	{
+		/**
+		 * @brief Number of events each thread can record before dropping new ones.
+		 */
+		size_t EventsPerThread = 256 * 1024;
+	};
+
+	/**
+	 * @brief Records traced scopes and exports them to timeline formats.
+	 */
+	class Timeline
+	{
+	public:
+		/**
+		 * @brief Discards any previous capture and starts recording.
+		 *
+		 * @param options Per-thread buffer size.
+		 */
+		static void StartCapture(const TimelineOptions& options = {});
+
+		/**
+		 * @brief Stops recording; the capture stays available for export.
+		 */
+		static void StopCapture();
+
+		/**
+		 * @brief Checks whether a capture is running.
+		 *
+		 * @return True if traced scopes are currently recorded, false otherwise.
+		 */
+		static bool IsCapturing() noexcept { return bIsCapturing.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Records the start of a scope on the calling thread if a capture is running.
+		 *
+		 * @param name Name of the scope; must have static storage duration.
+		 */
+		static void BeginScope(const char* name) noexcept
+		{
+			if (IsCapturing())
+			{
+				Record(name, true);
+			}
+		}
+
+		/**
+		 * @brief Records the end of the innermost scope on the calling thread if a capture is running.
+		 */
+		static void EndScope() noexcept
+		{
+			if (IsCapturing())
+			{
+				Record(nullptr, false);
+			}
+		}
+
+		/**
+		 * @brief Writes the last capture as Chrome Trace Event JSON.
+		 *
+		 * @param path The file to write.
+		 * @throws std::runtime_error If the file cannot be written.
+		 */
+		static void WriteChromeTrace(const std::filesystem::path& path);
+
+		/**
+		 * @brief Writes the last capture as a Perfetto protobuf trace.
+		 *
+		 * @param path The file to write.
+		 * @throws std::runtime_error If the file cannot be written.
+		 */
+		static void WritePerfettoTrace(const std::filesystem::path& path);
+
+		/**
+		 * @brief Gets the number of events dropped because a thread's buffer was full.
+		 *
+		 * @return The number of dropped events in the current or last capture.
+		 */
+		static uint64_t GetDroppedEventCount();
+
+	private:
+		/**
+		 * @brief Appends an event to the calling thread's buffer.
+		 */
+		static void Record(const char* name, bool bIsBegin) noexcept;
+
+		static inline std::atomic<bool> bIsCapturing{ false }; ///< Whether scopes are being recorded.
+	};
+} // namespace nyxara::logging
@@ -19,12 +19,28 @@
  * These levels are used to filter which log messages are emitted at runtime,
  * based on the configured verbosity for a logging category or component.
  * 
+ * The most verbose level compiled into the binary is fixed by the
+ * @ref NYX_LOG_COMPILE_TIME_VERBOSITY macro; messages above it are stripped by the
+ * logging macros before any argument is evaluated.
+ *
  * @note if an invalid or ::nyxara::logging::Verbosity::None level is passed to
  * ::nyxara::logging::to_spdlog_level, it default to spdlog::level::off.
  */
 
 #include <spdlog/spdlog.h>
 
+/**
+ * @def NYX_LOG_COMPILE_TIME_VERBOSITY
+ * @brief Name of the most verbose ::nyxara::logging::Verbosity level compiled in by default.
+ *
+ * Usually set from CMake through the `NYXARA_LOG_COMPILE_TIME_VERBOSITY` cache variable,
+ * e.g. `Info` for shipping builds. Individual categories can override it with
+ * @ref NYX_DECLARE_LOG_CATEGORY_EX.
+ */
+#ifndef NYX_LOG_COMPILE_TIME_VERBOSITY
+#define NYX_LOG_COMPILE_TIME_VERBOSITY Trace
+#endif
+
 namespace nyxara::logging
 {
 	/**
@@ -46,6 +62,11 @@ namespace nyxara::logging
 		Trace		///< Very detailed internal state (high-frequency)
 	};
 
+	/**
+	 * @brief Default compile-time verbosity floor for categories that do not override it.
+	 */
+	inline constexpr Verbosity GlobalCompileTimeVerbosity = Verbosity::NYX_LOG_COMPILE_TIME_VERBOSITY;
+
 	/**
 	 * @brief Converts a Verbosity level to its corresponding spdlog level.
 	 * 
@@ -0,0 +1,187 @@
+#pragma once
+
+/**
+ * @file allocation_tracker.h
+ * @brief Counts heap allocations made through the global operator new and delete.
+ *
+ * Linking the `nyxara_core_memory_operators` library into an executable replaces every
+ * global `operator new` and `operator delete` (sized, aligned and nothrow variants) with
+ * versions that count calls and bytes. Counters are kept per thread and written without
+ * read-modify-write operations, so tracking adds no lock and no shared cache line to an
+ * allocation except for the process-wide live and peak byte counts.
+ *
+ * Allocations can be attributed to a subsystem with a ::nyxara::memory::ScopedAllocationTag,
+ * and ::nyxara::memory::AllocationScope counts what the calling thread allocates in a
+ * scope, for instance a frame of the render loop that must not allocate at all.
+ *
+ * @code
+ * static const nyxara::memory::AllocationTag RendererTag("Renderer");
+ *
+ * nyxara::memory::AllocationScope frame;
+ * {
+ *     nyxara::memory::ScopedAllocationTag tag(RendererTag);
+ *     RecordCommands();
+ * }
+ * if (frame.GetStats().AllocationCount > 0) { ... }
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace nyxara::memory
+{
+	/**
+	 * @brief Allocation counters; all values only grow.
+	 */
+	struct AllocationStats
+	{
+		uint64_t AllocationCount = 0;	///< Calls to operator new.
+		uint64_t DeallocationCount = 0;	///< Calls to operator delete with a non-null pointer.
+		uint64_t AllocatedBytes = 0;	///< Bytes requested from operator new.
+		uint64_t FreedBytes = 0;		///< Bytes released by operator delete.
+
+		/**
+		 * @brief Number of allocations not freed yet.
+		 */
+		int64_t GetLiveAllocations() const noexcept { return static_cast<int64_t>(AllocationCount - DeallocationCount); }
+
+		/**
+		 * @brief Number of bytes not freed yet.
+		 */
+		int64_t GetLiveBytes() const noexcept { return static_cast<int64_t>(AllocatedBytes - FreedBytes); }
+
+		/**
+		 * @brief Computes the activity between two snapshots.
+		 */
+		AllocationStats operator-(const AllocationStats& other) const noexcept
+		{
+			return { AllocationCount - other.AllocationCount, DeallocationCount - other.DeallocationCount,
+				AllocatedBytes - other.AllocatedBytes, FreedBytes - other.FreedBytes };
+		}
+	};
+
+	/**
+	 * @brief Named subsystem allocations are attributed to.
+	 *
+	 * Tags are registered by name: two tags with the same name share their counters.
+	 * Instances are meant to be long-lived, typically static.
+	 */
+	class AllocationTag
+	{
+	public:
+		/**
+		 * @brief Registers the tag.
+		 *
+		 * @param name Name shown in reports; truncated to 31 characters.
+		 * @throws std::runtime_error If more than AllocationTracker::MaxTags names are registered.
+		 */
+		explicit AllocationTag(std::string_view name);
+
+		/**
+		 * @brief Gets the identifier of the tag, 0 being reserved for untagged allocations.
+		 */
+		uint16_t GetId() const noexcept { return Id; }
+
+	private:
+		uint16_t Id;
+	};
+
+	/**
+	 * @brief Attributes the calling thread's allocations to a tag for the lifetime of the scope.
+	 *
+	 * Scopes nest: the previous tag is restored on destruction. Memory is always accounted
+	 * to the tag it was allocated under, whichever thread or scope frees it.
+	 */
+	class ScopedAllocationTag
+	{
+	public:
+		explicit ScopedAllocationTag(const AllocationTag& tag) noexcept;
+		~ScopedAllocationTag();
+
+		ScopedAllocationTag(const ScopedAllocationTag&) = delete;
+		ScopedAllocationTag& operator=(const ScopedAllocationTag&) = delete;
+
+	private:
+		uint16_t PreviousTag;
+	};
+
+	/**
+	 * @brief Reads the allocation counters.
+	 */
+	class AllocationTracker
+	{
+	public:
+		/**
+		 * @brief Maximum number of threads with their own counters; others share atomic counters.
+		 */
+		static constexpr size_t MaxThreads = 256;
+
+		/**
+		 * @brief Maximum number of tag names, the untagged one included.
+		 */
+		static constexpr size_t MaxTags = 32;
+
+		/**
+		 * @brief Checks if the replacement operators are linked and have seen an allocation.
+		 */
+		static bool IsActive() noexcept;
+
+		/**
+		 * @brief Gets the counters of the whole process.
+		 */
+		static AllocationStats GetStats() noexcept;
+
+		/**
+		 * @brief Gets the counters of the allocations made under a tag.
+		 */
+		static AllocationStats GetTagStats(const AllocationTag& tag) noexcept;
+
+		/**
+		 * @brief Gets the counters of the calling thread.
+		 *
+		 * Counters of an exited thread are inherited by the next thread reusing its slot,
+		 * so only the difference between two calls is meaningful.
+		 */
+		static AllocationStats GetThreadStats() noexcept;
+
+		/**
+		 * @brief Gets the highest number of live bytes seen so far.
+		 */
+		static int64_t GetPeakLiveBytes() noexcept;
+
+		/**
+		 * @brief Logs the allocations still live to the `Core` category, per tag.
+		 *
+		 * Meant to be called at shutdown; memory owned by static objects still appears live.
+		 */
+		static void ReportLeaks();
+
+	private:
+		friend class AllocationTag;
+		friend class ScopedAllocationTag;
+
+		static uint16_t RegisterTag(std::string_view name);
+		static uint16_t ExchangeThreadTag(uint16_t tag) noexcept;
+	};
+
+	/**
+	 * @brief Counts what the calling thread allocates from construction on.
+	 */
+	class AllocationScope
+	{
+	public:
+		AllocationScope() noexcept
+			: Start(AllocationTracker::GetThreadStats())
+		{}
+
+		/**
+		 * @brief Gets the calling thread's activity since the scope started.
+		 */
+		AllocationStats GetStats() const noexcept { return AllocationTracker::GetThreadStats() - Start; }
+
+	private:
+		AllocationStats Start;
+	};
+} // namespace nyxara::memory
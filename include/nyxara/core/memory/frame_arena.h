@@ -0,0 +1,287 @@
+#pragma once
+
+/**
+ * @file frame_arena.h
+ * @brief Per-thread bump allocator for data that lives at most a few frames.
+ *
+ * Each thread owns a ::nyxara::memory::FrameArena made of FrameArenaOptions::BufferCount
+ * buffers used in turn, one per frame. FrameArena::BeginFrame() advances the frame for
+ * all threads at once; each thread switches to its next buffer, and rewinds it, on its
+ * first allocation of the new frame. Memory allocated during frame N therefore stays
+ * valid until frame N + BufferCount begins: with the default of three buffers, the
+ * engine calls BeginFrame(N) once the GPU is done with frame N - 2 (and thus N - 3).
+ *
+ * Allocation is a pointer bump with no lock and no heap traffic. Allocations that do
+ * not fit fall back to the global heap, are freed when the buffer is rewound, and are
+ * counted in FrameArenaStats; the buffer then grows to the observed peak so the next
+ * frames fit.
+ *
+ * FrameAllocator (STL allocators) and FrameMemoryResource (`std::pmr`) let containers
+ * and `fmt` buffers use the arena:
+ * @code
+ * nyxara::memory::FrameMemoryResource resource;
+ * std::pmr::vector<DrawItem> items(&resource);
+ *
+ * fmt::basic_memory_buffer<char, 250, nyxara::memory::FrameAllocator<char>> text;
+ * @endcode
+ *
+ * Deallocation is a no-op and destructors of objects in the arena are never called.
+ * Memory is owned by the allocating thread and released when it exits.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nyxara::memory
+{
+	/**
+	 * @brief Options of the frame arenas.
+	 */
+	struct FrameArenaOptions
+	{
+		/**
+		 * @brief Initial capacity of each buffer of a thread, in bytes.
+		 */
+		size_t BufferSize = 1024 * 1024;
+
+		/**
+		 * @brief Number of buffers per thread, the number of frames an allocation survives.
+		 */
+		uint32_t BufferCount = 3;
+
+		/**
+		 * @brief If true, a buffer that overflowed grows to its peak usage when rewound.
+		 */
+		bool bGrowOnOverflow = true;
+
+		/**
+		 * @brief If true, allocations are filled with 0xCD and rewound memory with 0xDD.
+		 */
+#if defined(NDEBUG)
+		bool bPoison = false;
+#else
+		bool bPoison = true;
+#endif
+	};
+
+	/**
+	 * @brief Usage of a thread's arena.
+	 */
+	struct FrameArenaStats
+	{
+		size_t Capacity = 0;		///< Capacity of the current buffer in bytes.
+		size_t UsedBytes = 0;		///< Bytes allocated from the current buffer this frame.
+		size_t PeakBytes = 0;		///< Highest bytes requested in a frame, overflow included.
+		uint64_t OverflowCount = 0;	///< Allocations served by the heap since the thread started.
+		uint64_t OverflowBytes = 0;	///< Bytes served by the heap since the thread started.
+	};
+
+	/**
+	 * @brief Bump allocator of one thread, rewound every BufferCount frames.
+	 */
+	class FrameArena
+	{
+	public:
+		/**
+		 * @brief Gets the calling thread's arena, creating it on first use.
+		 */
+		static FrameArena& GetThreadArena();
+
+		/**
+		 * @brief Sets the options of arenas created afterwards.
+		 *
+		 * Call it at startup, before threads allocate from their arena.
+		 */
+		static void Configure(const FrameArenaOptions& options);
+
+		/**
+		 * @brief Starts a new frame on all threads.
+		 *
+		 * The buffers used by frame @p frameIndex - BufferCount are reused: call it only
+		 * once nothing references their memory anymore, the GPU included.
+		 *
+		 * @param frameIndex Index of the frame, increasing by one each frame.
+		 */
+		static void BeginFrame(uint64_t frameIndex) noexcept { FrameIndex.store(frameIndex, std::memory_order_release); }
+
+		/**
+		 * @brief Gets the index passed to the last BeginFrame().
+		 */
+		static uint64_t GetFrameIndex() noexcept { return FrameIndex.load(std::memory_order_acquire); }
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		~FrameArena();
+
+		/**
+		 * @brief Allocates memory valid until BufferCount frames later.
+		 *
+		 * @param size Size in bytes.
+		 * @param alignment Alignment, a power of two.
+		 * @throws std::bad_alloc If the heap fallback fails.
+		 */
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+		{
+			if (CurrentFrame != FrameIndex.load(std::memory_order_acquire))
+			{
+				SwitchFrame();
+			}
+
+			uintptr_t base = reinterpret_cast<uintptr_t>(Current->Memory.get());
+			uintptr_t aligned = (base + Current->Offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+			size_t end = static_cast<size_t>(aligned - base) + size;
+
+			if (end > Current->Capacity)
+			{
+				return AllocateOverflow(size, alignment);
+			}
+
+			Current->Offset = end;
+			Current->RequestedBytes += size;
+
+			if (bPoison)
+			{
+				Poison(reinterpret_cast<void*>(aligned), size, 0xCD);
+			}
+
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		/**
+		 * @brief Allocates an uninitialized array of @p count elements.
+		 */
+		template<typename T>
+		T* AllocateArray(size_t count)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "Destructors of arena objects are never called");
+			return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+		}
+
+		/**
+		 * @brief Constructs an object in the arena; its destructor will never be called.
+		 */
+		template<typename T, typename... Args>
+		T* New(Args&&... args)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "Destructors of arena objects are never called");
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Gets the usage of this arena.
+		 */
+		FrameArenaStats GetStats() const noexcept;
+
+	private:
+		struct OverflowBlock
+		{
+			OverflowBlock* Next;
+			size_t Size;
+			size_t Alignment;
+		};
+
+		struct Buffer
+		{
+			std::unique_ptr<std::byte[]> Memory;
+			size_t Capacity = 0;
+			size_t Offset = 0;
+			size_t RequestedBytes = 0;		///< Bytes allocated this frame, overflow included.
+			OverflowBlock* Overflow = nullptr;
+		};
+
+		explicit FrameArena(const FrameArenaOptions& options);
+
+		void SwitchFrame();
+		void Rewind(Buffer& buffer);
+		void* AllocateOverflow(size_t size, size_t alignment);
+		static void Poison(void* ptr, size_t size, int value) noexcept;
+
+		std::vector<Buffer> Buffers;
+		Buffer* Current;
+		uint64_t CurrentFrame;
+		bool bPoison;
+		bool bGrowOnOverflow;
+
+		size_t PeakBytes = 0;
+		uint64_t OverflowCount = 0;
+		uint64_t OverflowBytes = 0;
+
+		static inline std::atomic<uint64_t> FrameIndex{ 0 };
+	};
+
+	/**
+	 * @brief STL allocator drawing from a frame arena; deallocation does nothing.
+	 *
+	 * @tparam T Element type.
+	 */
+	template<typename T>
+	class FrameAllocator
+	{
+	public:
+		using value_type = T;
+
+		/**
+		 * @brief Allocates from the calling thread's arena.
+		 */
+		FrameAllocator()
+			: Arena(&FrameArena::GetThreadArena())
+		{}
+
+		explicit FrameAllocator(FrameArena& arena) noexcept
+			: Arena(&arena)
+		{}
+
+		template<typename U>
+		FrameAllocator(const FrameAllocator<U>& other) noexcept
+			: Arena(other.GetArena())
+		{}
+
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(Arena->Allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T*, size_t) noexcept {}
+
+		FrameArena* GetArena() const noexcept { return Arena; }
+
+		template<typename U>
+		bool operator==(const FrameAllocator<U>& other) const noexcept { return Arena == other.GetArena(); }
+
+	private:
+		FrameArena* Arena;
+	};
+
+	/**
+	 * @brief `std::pmr::memory_resource` drawing from a frame arena; deallocation does nothing.
+	 */
+	class FrameMemoryResource : public std::pmr::memory_resource
+	{
+	public:
+		/**
+		 * @brief Allocates from the calling thread's arena.
+		 */
+		FrameMemoryResource()
+			: Arena(FrameArena::GetThreadArena())
+		{}
+
+		explicit FrameMemoryResource(FrameArena& arena) noexcept
+			: Arena(arena)
+		{}
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override { return Arena.Allocate(bytes, alignment); }
+		void do_deallocate(void*, size_t, size_t) override {}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		FrameArena& Arena;
+	};
+} // namespace nyxara::memory
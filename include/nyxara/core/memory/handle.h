@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * @file handle.h
+ * @brief Typed 32-bit generational handle referring to an object in a ::nyxara::memory::HandlePool.
+ *
+ * A handle packs a slot index and the generation of the slot when the object was created.
+ * Destroying the object bumps the generation, so handles kept around afterwards are
+ * detected as stale instead of silently referring to whatever reuses the slot.
+ *
+ * The tag type only distinguishes handle kinds at compile time: a `Handle<Image>` cannot be
+ * passed where a `Handle<Buffer>` is expected.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace nyxara::memory
+{
+	/**
+	 * @brief Generational reference to an object of kind @p Tag.
+	 *
+	 * The default-constructed handle is null; no pool ever returns it.
+	 *
+	 * @tparam Tag Type distinguishing handle kinds, usually the referenced type.
+	 */
+	template<typename Tag>
+	class Handle
+	{
+	public:
+		static constexpr uint32_t IndexBits = 20;
+		static constexpr uint32_t GenerationBits = 32 - IndexBits;
+		static constexpr uint32_t MaxIndex = (1u << IndexBits) - 1;
+		static constexpr uint32_t MaxGeneration = (1u << GenerationBits) - 1;
+
+		constexpr Handle() noexcept = default;
+
+		/**
+		 * @param index Slot index, at most MaxIndex.
+		 * @param generation Slot generation, from 1 to MaxGeneration.
+		 */
+		constexpr Handle(uint32_t index, uint32_t generation) noexcept
+			: Value((generation << IndexBits) | (index & MaxIndex))
+		{}
+
+		/**
+		 * @brief Rebuilds a handle from GetValue(), e.g. after storing it in a GPU buffer.
+		 */
+		static constexpr Handle FromValue(uint32_t value) noexcept
+		{
+			Handle handle;
+			handle.Value = value;
+			return handle;
+		}
+
+		constexpr uint32_t GetIndex() const noexcept { return Value & MaxIndex; }
+		constexpr uint32_t GetGeneration() const noexcept { return Value >> IndexBits; }
+		constexpr uint32_t GetValue() const noexcept { return Value; }
+
+		/**
+		 * @brief Checks if the handle is not null. A non-null handle may still be stale.
+		 */
+		constexpr bool IsValid() const noexcept { return Value != 0; }
+		constexpr explicit operator bool() const noexcept { return IsValid(); }
+
+		constexpr bool operator==(const Handle&) const noexcept = default;
+
+	private:
+		uint32_t Value = 0;
+	};
+} // namespace nyxara::memory
+
+template<typename Tag>
+struct std::hash<nyxara::memory::Handle<Tag>>
+{
+	size_t operator()(const nyxara::memory::Handle<Tag>& handle) const noexcept
+	{
+		return std::hash<uint32_t>{}(handle.GetValue());
+	}
+};
@@ -0,0 +1,238 @@
+#pragma once
+
+/**
+ * @file handle_pool.h
+ * @brief Contiguous object pool addressed through generational handles.
+ *
+ * ::nyxara::memory::HandlePool keeps its live objects packed in one array, so iterating
+ * them is a linear walk, and maps each handle to its object through a slot table:
+ * - Create() reuses a free slot (or appends one) and appends the object: O(1).
+ * - Destroy() moves the last object into the hole and bumps the slot's generation: O(1).
+ * - Get() checks the generation and returns null for stale handles: O(1), two loads.
+ *
+ * Handles are 32-bit, so hot structures can store them instead of pointers. Pointers
+ * and references returned by the pool are only valid until the next Create() or
+ * Destroy(); keep the handle and look it up again.
+ *
+ * A slot whose generation is exhausted is retired rather than reused, so a stale handle
+ * can never match a later object. The pool is not thread-safe.
+ *
+ * @code
+ * nyxara::memory::HandlePool<Mesh> meshes;
+ * nyxara::memory::Handle<Mesh> cube = meshes.Create(vertices, indices);
+ *
+ * if (Mesh* mesh = meshes.Get(cube))
+ * {
+ *      mesh->Upload();
+ * }
+ *
+ * meshes.Destroy(cube);    // meshes.Get(cube) now returns nullptr
+ * @endcode
+ */
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "nyxara/core/memory/handle.h"
+
+namespace nyxara::memory
+{
+	/**
+	 * @brief Pool of objects of type @p T referred to by Handle<Tag>.
+	 *
+	 * @tparam T Stored type; must be move-constructible and move-assignable.
+	 * @tparam Tag Handle tag, @p T by default. Set it when @p T is a wrapper, e.g.
+	 *             `HandlePool<std::unique_ptr<Window>, Window>`.
+	 */
+	template<typename T, typename Tag = T>
+	class HandlePool
+	{
+	public:
+		using HandleType = Handle<Tag>;
+		using Iterator = typename std::vector<T>::iterator;
+		using ConstIterator = typename std::vector<T>::const_iterator;
+
+		/**
+		 * @brief Constructs an object and returns its handle.
+		 *
+		 * @throws std::runtime_error If all Handle::MaxIndex + 1 slots are in use or retired.
+		 */
+		template<typename... Args>
+		HandleType Create(Args&&... args)
+		{
+			if (FreeHead == InvalidIndex && Slots.size() > HandleType::MaxIndex)
+			{
+				throw std::runtime_error("Handle pool is full");
+			}
+
+			Objects.emplace_back(std::forward<Args>(args)...);
+
+			uint32_t slotIndex;
+
+			if (FreeHead != InvalidIndex)
+			{
+				slotIndex = FreeHead;
+				FreeHead = Slots[slotIndex].NextFree;
+			}
+			else
+			{
+				slotIndex = static_cast<uint32_t>(Slots.size());
+				Slots.push_back(Slot{});
+			}
+
+			Slot& slot = Slots[slotIndex];
+			slot.DenseIndex = static_cast<uint32_t>(Objects.size() - 1);
+			slot.NextFree = InvalidIndex;
+			DenseToSlot.push_back(slotIndex);
+
+			return HandleType(slotIndex, slot.Generation);
+		}
+
+		/**
+		 * @brief Destroys the object of @p handle.
+		 *
+		 * @return False if the handle is null or stale, in which case nothing happens.
+		 */
+		bool Destroy(HandleType handle)
+		{
+			Slot* slot = FindSlot(handle);
+
+			if (!slot)
+			{
+				return false;
+			}
+
+			const uint32_t dense = slot->DenseIndex;
+			const uint32_t last = static_cast<uint32_t>(Objects.size() - 1);
+
+			// Keep the objects packed: the last one fills the hole.
+			if (dense != last)
+			{
+				Objects[dense] = std::move(Objects[last]);
+				DenseToSlot[dense] = DenseToSlot[last];
+				Slots[DenseToSlot[dense]].DenseIndex = dense;
+			}
+
+			Objects.pop_back();
+			DenseToSlot.pop_back();
+
+			slot->DenseIndex = InvalidIndex;
+
+			if (slot->Generation < HandleType::MaxGeneration)
+			{
+				++slot->Generation;
+				slot->NextFree = FreeHead;
+				FreeHead = handle.GetIndex();
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Gets the object of @p handle, or null if the handle is null or stale.
+		 */
+		T* Get(HandleType handle) noexcept
+		{
+			const Slot* slot = FindSlot(handle);
+			return slot ? &Objects[slot->DenseIndex] : nullptr;
+		}
+
+		const T* Get(HandleType handle) const noexcept
+		{
+			const Slot* slot = FindSlot(handle);
+			return slot ? &Objects[slot->DenseIndex] : nullptr;
+		}
+
+		/**
+		 * @brief Checks if @p handle refers to a live object.
+		 */
+		bool IsAlive(HandleType handle) const noexcept { return FindSlot(handle) != nullptr; }
+
+		/**
+		 * @brief Gets the handle of the object at @p position in iteration order.
+		 */
+		HandleType GetHandle(size_t position) const noexcept
+		{
+			const uint32_t slotIndex = DenseToSlot[position];
+			return HandleType(slotIndex, Slots[slotIndex].Generation);
+		}
+
+		/**
+		 * @brief Calls @p callback with the handle and object of every live object.
+		 *
+		 * The callback must not create or destroy objects of this pool.
+		 */
+		template<typename Callback>
+		void ForEach(Callback&& callback)
+		{
+			for (size_t i = 0; i < Objects.size(); ++i)
+			{
+				callback(GetHandle(i), Objects[i]);
+			}
+		}
+
+		/**
+		 * @brief Destroys every object; outstanding handles all become stale.
+		 */
+		void Clear()
+		{
+			while (!Objects.empty())
+			{
+				Destroy(GetHandle(Objects.size() - 1));
+			}
+		}
+
+		/**
+		 * @brief Preallocates room for @p capacity objects.
+		 */
+		void Reserve(size_t capacity)
+		{
+			Objects.reserve(capacity);
+			DenseToSlot.reserve(capacity);
+			Slots.reserve(capacity);
+		}
+
+		size_t GetSize() const noexcept { return Objects.size(); }
+		bool IsEmpty() const noexcept { return Objects.empty(); }
+
+		Iterator begin() noexcept { return Objects.begin(); }
+		Iterator end() noexcept { return Objects.end(); }
+		ConstIterator begin() const noexcept { return Objects.begin(); }
+		ConstIterator end() const noexcept { return Objects.end(); }
+
+	private:
+		static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+		struct Slot
+		{
+			uint32_t Generation = 1;			///< Generation of the live or next object; never 0, so null handles never match.
+			uint32_t DenseIndex = InvalidIndex;	///< Position in Objects, or InvalidIndex if free or retired.
+			uint32_t NextFree = InvalidIndex;	///< Next slot of the free list.
+		};
+
+		Slot* FindSlot(HandleType handle) noexcept
+		{
+			return const_cast<Slot*>(std::as_const(*this).FindSlot(handle));
+		}
+
+		const Slot* FindSlot(HandleType handle) const noexcept
+		{
+			const uint32_t index = handle.GetIndex();
+
+			if (index >= Slots.size())
+			{
+				return nullptr;
+			}
+
+			const Slot& slot = Slots[index];
+			return slot.Generation == handle.GetGeneration() && slot.DenseIndex != InvalidIndex ? &slot : nullptr;
+		}
+
+		std::vector<T> Objects;
+		std::vector<uint32_t> DenseToSlot;
+		std::vector<Slot> Slots;
+		uint32_t FreeHead = InvalidIndex;
+	};
+} // namespace nyxara::memory
@@ -0,0 +1,269 @@
+#pragma once
+
+/**
+ * @file perf_counters.h
+ * @brief Hardware performance counters attributed to named code zones.
+ *
+ * A zone is a scope marked with @ref NYX_PERF_SCOPE or @ref NYX_PERF_FUNCTION. While
+ * ::nyxara::profiling::PerfCounters is enabled, every execution of the scope reads the
+ * calling thread's counters on entry and exit and adds the deltas to the zone: call count,
+ * then total, minimum and maximum of each counter. PerfCounters::LogReport() writes the
+ * aggregate of every zone, including IPC, through the `Core` category.
+ *
+ * @details
+ * On Linux, each thread opens one `perf_event_open` group (cycles, instructions, cache
+ * misses, branch misses) the first time it enters a zone, counting user space only, and
+ * reads it with a single `read()` per scope boundary. Zones are therefore meant for
+ * coarse hot paths, not for tight loops.
+ *
+ * If the PMU is shared with other events (another profiler, a hypervisor), the kernel
+ * multiplexes the group and it only counts part of the time. Reads keep the raw values
+ * with the times the group was enabled and running, and each scope scales its raw deltas
+ * by the ratio of those times over the scope, so zones report estimates rather than
+ * undercounts, and a warning is logged once.
+ *
+ * Counters that cannot be opened (other platforms, `perf_event_paranoid`, containers,
+ * virtual machines without a PMU) are reported as unavailable, for each zone, if any thread
+ * that recorded it could not read them. Wall-clock time is always measured, so zones stay
+ * useful without hardware counters.
+ *
+ * A disabled zone costs one relaxed atomic load.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "nyxara/core/logging/macros.h"
+
+namespace nyxara::profiling
+{
+	/**
+	 * @brief Quantities measured for each zone.
+	 */
+	enum class PerfCounter : uint8_t
+	{
+		Time = 0,		///< Wall-clock nanoseconds, always available
+		Cycles,			///< CPU cycles
+		Instructions,	///< Retired instructions
+		CacheMisses,	///< Last-level cache misses
+		BranchMisses,	///< Mispredicted branches
+		Count
+	};
+
+	/**
+	 * @brief Number of measured quantities.
+	 */
+	inline constexpr size_t PerfCounterCount = static_cast<size_t>(PerfCounter::Count);
+
+	/**
+	 * @brief Values of all counters, indexed by PerfCounter.
+	 */
+	using PerfCounterValues = std::array<uint64_t, PerfCounterCount>;
+
+	/**
+	 * @brief One read of the calling thread's counters.
+	 */
+	struct PerfCounterSample
+	{
+		PerfCounterValues Values{};	///< Raw values, not scaled for multiplexing; unavailable counters read as zero.
+		uint64_t TimeEnabled = 0;	///< Nanoseconds the counter group has been enabled.
+		uint64_t TimeRunning = 0;	///< Nanoseconds it has been counting, less than TimeEnabled when multiplexed.
+		uint32_t AvailableMask = 0;	///< Counters read, as returned by PerfCounters::GetAvailableCounters().
+	};
+
+	/**
+	 * @brief Gets the lowercase name of a counter, as used in reports.
+	 */
+	const char* GetPerfCounterName(PerfCounter counter) noexcept;
+
+	/**
+	 * @brief Aggregate of one counter over the executions of a zone.
+	 */
+	struct PerfCounterStats
+	{
+		uint64_t Total = 0;
+		uint64_t Min = 0;
+		uint64_t Max = 0;
+	};
+
+	/**
+	 * @brief Aggregate of a zone.
+	 */
+	struct PerfZoneStats
+	{
+		uint64_t CallCount = 0;
+		std::array<PerfCounterStats, PerfCounterCount> Counters;
+		uint32_t AvailableMask = 0;		///< Counters every recording thread could read, indexed by PerfCounter.
+	};
+
+	/**
+	 * @brief Constant-initialized descriptor and accumulator of one profiled scope.
+	 *
+	 * Created by @ref NYX_PERF_SCOPE; registered with PerfCounters the first time it records.
+	 */
+	class PerfZone
+	{
+	public:
+		constexpr PerfZone(const char* name, const char* file, uint32_t line) noexcept
+			: Name(name), File(file), Line(line)
+		{}
+
+		PerfZone(const PerfZone&) = delete;
+		PerfZone& operator=(const PerfZone&) = delete;
+
+		const char* GetName() const noexcept { return Name; }
+		const char* GetFile() const noexcept { return File; }
+		uint32_t GetLine() const noexcept { return Line; }
+
+		/**
+		 * @brief Reads the aggregate; values recorded concurrently may be partially included.
+		 */
+		PerfZoneStats GetStats() const noexcept;
+
+		/**
+		 * @brief Adds one execution of the zone.
+		 *
+		 * @param deltas Counter increments over the execution.
+		 * @param availableMask Counters the recording thread could read; the others are reported as unavailable.
+		 */
+		void Record(const PerfCounterValues& deltas, uint32_t availableMask) noexcept;
+
+	private:
+		friend class PerfCounters;
+
+		const char* Name;
+		const char* File;
+		uint32_t Line;
+
+		PerfZone* Next = nullptr;
+		std::atomic<bool> bIsRegistered{ false };
+		std::atomic<uint64_t> CallCount{ 0 };
+		std::array<std::atomic<uint64_t>, PerfCounterCount> Totals{};
+		std::array<std::atomic<uint64_t>, PerfCounterCount> Maxima{};
+		std::array<std::atomic<uint64_t>, PerfCounterCount> InvertedMinima{};	///< Bitwise NOT of the minima, so zero means none.
+		std::atomic<uint32_t> MissingMask{ 0 };		///< Counters some recording thread could not read.
+	};
+
+	/**
+	 * @brief Controls the measurement of zones and reports their aggregates.
+	 */
+	class PerfCounters
+	{
+	public:
+		/**
+		 * @brief Starts measuring zones on all threads.
+		 */
+		static void Enable() noexcept { bIsEnabled.store(true, std::memory_order_relaxed); }
+
+		/**
+		 * @brief Stops measuring zones; aggregates are kept.
+		 */
+		static void Disable() noexcept { bIsEnabled.store(false, std::memory_order_relaxed); }
+
+		/**
+		 * @brief Checks if zones are measured. A single relaxed atomic load.
+		 */
+		static bool IsEnabled() noexcept { return bIsEnabled.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Checks which counters the calling thread can read, opening them if needed.
+		 *
+		 * @return A bit mask indexed by PerfCounter; PerfCounter::Time is always set.
+		 */
+		static uint32_t GetAvailableCounters() noexcept;
+
+		/**
+		 * @brief Reads the calling thread's counters.
+		 */
+		static void Read(PerfCounterSample& sample) noexcept;
+
+		/**
+		 * @brief Gets the increments of each counter between two reads on the same thread.
+		 *
+		 * Hardware counters are scaled by the time the group was enabled over the time it was
+		 * running between the two reads, if it was multiplexed in between.
+		 */
+		static PerfCounterValues GetDeltas(const PerfCounterSample& start, const PerfCounterSample& end) noexcept;
+
+		/**
+		 * @brief Calls @p callback for every zone that recorded at least once.
+		 */
+		static void ForEachZone(const std::function<void(const PerfZone&)>& callback);
+
+		/**
+		 * @brief Clears the aggregates of every zone.
+		 */
+		static void Reset() noexcept;
+
+		/**
+		 * @brief Logs the aggregate of every zone to the `Core` category.
+		 */
+		static void LogReport();
+
+	private:
+		friend class PerfZone;
+
+		static void Register(PerfZone& zone) noexcept;
+
+		static inline std::atomic<bool> bIsEnabled{ false };
+	};
+
+	/**
+	 * @brief Measures a zone for the lifetime of the scope.
+	 */
+	class PerfScope
+	{
+	public:
+		explicit PerfScope(PerfZone& zone) noexcept
+			: Zone(PerfCounters::IsEnabled() ? &zone : nullptr)
+		{
+			if (Zone)
+			{
+				PerfCounters::Read(Start);
+			}
+		}
+
+		~PerfScope()
+		{
+			if (Zone)
+			{
+				PerfCounterSample end;
+				PerfCounters::Read(end);
+				Zone->Record(PerfCounters::GetDeltas(Start, end), end.AvailableMask);
+			}
+		}
+
+		PerfScope(const PerfScope&) = delete;
+		PerfScope& operator=(const PerfScope&) = delete;
+
+	private:
+		PerfZone* Zone;
+		PerfCounterSample Start;
+	};
+} // namespace nyxara::profiling
+
+/**
+ * @def NYX_PERF_SCOPE(NAME)
+ * @brief Measures the enclosing scope as the zone @p NAME while PerfCounters is enabled.
+ *
+ * @param NAME Zone name, a string with static storage duration.
+ *
+ * @code
+ * void BuildVisibleSet()
+ * {
+ *      NYX_PERF_SCOPE("Culling");
+ *      // Scope body...
+ * }
+ * @endcode
+ */
+#define NYX_PERF_SCOPE(NAME) \
+            static constinit ::nyxara::profiling::PerfZone nyxPerfZone(NAME, __FILE__, __LINE__); \
+            ::nyxara::profiling::PerfScope nyxPerfScope(nyxPerfZone)
+
+/**
+ * @def NYX_PERF_FUNCTION()
+ * @brief Measures the enclosing function as a zone named after its signature.
+ */
+#define NYX_PERF_FUNCTION() NYX_PERF_SCOPE(NYX_FUNCTION_NAME)
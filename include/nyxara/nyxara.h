@@ -1,13 +1,45 @@
 #pragma once
 
+// Core frame timing
+#include "nyxara/core/frame/frame_limiter.h"
+#include "nyxara/core/frame/frame_pipeline.h"
+#include "nyxara/core/frame/frame_stats.h"
+
+// Core jobs
+#include "nyxara/core/jobs/job_system.h"
+
 // Core logging
+#include "nyxara/core/logging/async.h"
+#include "nyxara/core/logging/binary_log.h"
 #include "nyxara/core/logging/call_depth_manager.h"
+#include "nyxara/core/logging/call_site.h"
 #include "nyxara/core/logging/categories.h"
 #include "nyxara/core/logging/category.h"
+#include "nyxara/core/logging/flight_recorder.h"
 #include "nyxara/core/logging/function_tracer.h"
 #include "nyxara/core/logging/logger.h"
 #include "nyxara/core/logging/macros.h"
+#include "nyxara/core/logging/rate_limit.h"
+#include "nyxara/core/logging/record.h"
+#include "nyxara/core/logging/timeline.h"
 #include "nyxara/core/logging/verbosity.h"
 
+// Core memory
+#include "nyxara/core/memory/allocation_tracker.h"
+#include "nyxara/core/memory/frame_arena.h"
+#include "nyxara/core/memory/handle_pool.h"
+
+// Core profiling
+#include "nyxara/core/profiling/perf_counters.h"
+
 // Platform windowing
-#include "nyxara/platform/window.h"
\ No newline at end of file
+#include "nyxara/platform/window.h"
+
+// Renderer
+#include "nyxara/renderer/vulkan/command_recorder.h"
+#include "nyxara/renderer/vulkan/device.h"
+#include "nyxara/renderer/vulkan/device_allocator.h"
+#include "nyxara/renderer/vulkan/pipeline_cache.h"
+#include "nyxara/renderer/vulkan/render_graph.h"
+#include "nyxara/renderer/vulkan/staging_uploader.h"
+#include "nyxara/renderer/vulkan/sub_allocator.h"
\ No newline at end of file
@@ -1,6 +1,12 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <span>
+#include "nyxara/core/memory/handle.h"
+#include "nyxara/platform/window_event.h"
 
 /**
  * @file window.h
@@ -9,6 +15,14 @@
 
 namespace nyxara::platform
 {
+    class Window;
+    class EventQueue;
+
+    /**
+     * @brief Generational handle to a window created by Window::Create.
+     */
+    using WindowHandle = memory::Handle<Window>;
+
     /**
      * @enum WindowBackend
      * @brief Specifies the underlying windowing system backend.
@@ -18,7 +32,31 @@ namespace nyxara::platform
         /**
          * @brief Use the GLFW library as the backend.
          */
-        GLFW
+        GLFW,
+
+        /**
+         * @brief No display: a fixed-size virtual surface fed by a scripted event source.
+         *
+         * Meant for benchmarks and automated runs on machines without a display server.
+         */
+        Headless
+    };
+
+    /**
+     * @struct ScriptedWindowEvent
+     * @brief Event delivered by a headless window during a given frame.
+     */
+    struct ScriptedWindowEvent
+    {
+        /**
+         * @brief Zero-based index of the PollEvents() call that delivers the event.
+         */
+        uint64_t Frame = 0;
+
+        /**
+         * @brief The event; Resize and Close also update the window's state.
+         */
+        WindowEvent Event;
     };
 
     /**
@@ -58,6 +96,21 @@ namespace nyxara::platform
          * @brief If true, the window will be created in full-screen mode.
          */
         bool FullScreen = false;
+
+        /**
+         * @brief Maximum number of events waiting to be drained; further events are dropped and counted.
+         */
+        uint32_t EventQueueCapacity = 1024;
+
+        /**
+         * @brief Headless backend: number of PollEvents() calls after which ShouldClose() returns true; 0 never closes.
+         */
+        uint64_t HeadlessFrameCount = 0;
+
+        /**
+         * @brief Headless backend: events to deliver, copied at creation; need not be sorted.
+         */
+        std::span<const ScriptedWindowEvent> HeadlessScript;
     };
 
     /**
@@ -66,6 +119,12 @@ namespace nyxara::platform
      *
      * Provides an interface for window operations like event polling and buffer swapping.
      * Implementations will vary depending on the underlying platform/backend.
+     *
+     * PollEvents() collects the backend's events, stamped with the time they were received,
+     * into a lock-free single-producer single-consumer queue owned by the window.
+     * DrainEvents() takes them in bulk at whatever point of the frame suits the caller, and
+     * may run on another thread than PollEvents(): the thread pumping events (which must be
+     * the main thread with GLFW) then never waits for the frame that consumes them.
      */
     class Window
     {
@@ -73,13 +132,33 @@ namespace nyxara::platform
         /**
          * @brief Virtual destructor.
          */
-        virtual ~Window() = default;
+        virtual ~Window();
+
+        Window(const Window&) = delete;
+        Window& operator=(const Window&) = delete;
 
         /**
          * @brief Polls and processes window events (e.g., input, resize).
+         *
+         * Events reported by the backend are queued and retrieved with DrainEvents().
          */
         virtual void PollEvents() = 0;
 
+        /**
+         * @brief Like PollEvents(), but first blocks until an event arrives, Wake() is called or @p timeout elapses.
+         *
+         * Lets a loop with nothing to render, e.g. while minimized, sleep instead of spinning.
+         * The headless backend never blocks, to keep runs deterministic.
+         *
+         * @param timeout Longest wait; `std::chrono::nanoseconds::max()` waits indefinitely.
+         */
+        virtual void WaitEvents(std::chrono::nanoseconds timeout) = 0;
+
+        /**
+         * @brief Makes a pending or upcoming WaitEvents() return. Callable from any thread.
+         */
+        virtual void Wake() = 0;
+
         /**
          * @brief Swaps the front and back buffers, displaying the rendered frame.
          */
@@ -91,16 +170,81 @@ namespace nyxara::platform
          */
         virtual bool ShouldClose() const = 0;
 
+        /**
+         * @brief Gets the width of the framebuffer in pixels.
+         */
+        virtual uint32_t GetWidth() const = 0;
+
+        /**
+         * @brief Gets the height of the framebuffer in pixels.
+         */
+        virtual uint32_t GetHeight() const = 0;
+
+        /**
+         * @brief Takes the oldest queued events, in the order they were received.
+         *
+         * Must always be called from the same thread, which may differ from the one calling PollEvents().
+         *
+         * @param events Receives up to `events.size()` events.
+         * @return Number of events written to @p events.
+         */
+        size_t DrainEvents(std::span<WindowEvent> events);
+
+        /**
+         * @brief Takes the oldest queued event; see DrainEvents().
+         *
+         * @return False if no event is queued.
+         */
+        bool PollEvent(WindowEvent& event) { return DrainEvents({ &event, 1 }) == 1; }
+
+        /**
+         * @brief Gets the number of events dropped because the queue was full.
+         */
+        uint64_t GetDroppedEventCount() const;
+
         /**
          * @brief Creates a platform-specific window instance.
          *
          * This static function chooses the appropriate implementation based on the
-         * backend specified in the WindowCreateInfo.
+         * backend specified in the WindowCreateInfo. The window is owned by the platform
+         * layer until Destroy() is called with the returned handle.
+         *
+         * Windows must be created, used and destroyed on the main thread.
          *
          * @param info Configuration used to create the window.
-         * @return Pointer to a newly created Window instance. Ownership must be managed by the caller.
+         * @return Handle to the newly created window.
+         */
+        static WindowHandle Create(const WindowCreateInfo& info);
+
+        /**
+         * @brief Destroys a window created by Create().
+         *
+         * @param handle Handle of the window; null and stale handles are ignored.
+         */
+        static void Destroy(WindowHandle handle);
+
+        /**
+         * @brief Gets the window of a handle.
+         *
+         * The pointer stays valid until the window is destroyed.
+         *
+         * @param handle Handle returned by Create().
+         * @return The window, or null if the handle is null or its window was destroyed.
          */
-        static Window* Create(const WindowCreateInfo& info);
+        static Window* Get(WindowHandle handle);
+
+    protected:
+        explicit Window(const WindowCreateInfo& info);
+
+        /**
+         * @brief Queues an event for DrainEvents(); called by backends from PollEvents().
+         *
+         * Events without a timestamp are stamped with the current time.
+         */
+        void PushEvent(const WindowEvent& event);
+
+    private:
+        std::unique_ptr<EventQueue> Events;
     };
 
 } // namespace nyxara::platform
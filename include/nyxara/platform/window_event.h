@@ -0,0 +1,55 @@
+#pragma once
+
+/**
+ * @file window_event.h
+ * @brief Window and input events reported by ::nyxara::platform::Window backends.
+ */
+
+#include <chrono>
+#include <cstdint>
+
+namespace nyxara::platform
+{
+	/**
+	 * @brief Kind of a window event; selects the meaningful fields of WindowEvent.
+	 */
+	enum class WindowEventType : uint8_t
+	{
+		Close = 0,		///< The user asked to close the window
+		Resize,			///< Framebuffer resized: Width, Height
+		Focus,			///< Focus gained or lost: bFocused
+		Key,			///< Keyboard key: Code, Action, Mods
+		MouseButton,	///< Mouse button: Code, Action, Mods
+		MouseMove,		///< Cursor moved: X, Y in pixels from the top-left corner
+		Scroll			///< Wheel or touchpad scroll: X, Y offsets
+	};
+
+	/**
+	 * @brief State change of a key or button.
+	 */
+	enum class InputAction : uint8_t
+	{
+		Release = 0,
+		Press,
+		Repeat
+	};
+
+	/**
+	 * @brief Window or input event.
+	 *
+	 * Key codes, mouse button indices and modifier bits use the GLFW values on every backend.
+	 */
+	struct WindowEvent
+	{
+		std::chrono::steady_clock::time_point Timestamp{};	///< When the backend received the event
+		WindowEventType Type = WindowEventType::Close;
+		InputAction Action = InputAction::Release;
+		bool bFocused = false;
+		int32_t Code = 0;
+		int32_t Mods = 0;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		double X = 0.0;
+		double Y = 0.0;
+	};
+} // namespace nyxara::platform
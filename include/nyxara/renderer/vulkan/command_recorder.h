@@ -0,0 +1,179 @@
+#pragma once
+
+/**
+ * @file command_recorder.h
+ * @brief Command buffer recording split across the job system's threads.
+ *
+ * ::nyxara::renderer::CommandRecorder owns, for every frame in flight, one transient
+ * `VkCommandPool` per job system participant, plus a few that threads outside the job
+ * system take while they help from JobSystem::Wait(). RecordParallel() cuts a range of items
+ * (draws, objects) into batches, records every batch into a secondary command buffer
+ * from the pool of the thread that picks it up, then executes the secondaries from the
+ * frame's primary command buffer in batch order, so the result does not depend on
+ * which thread recorded what.
+ *
+ * Command buffers are never freed one by one: BeginFrame() resets the frame's pools in
+ * bulk and their command buffers are reused. RecordParallel() must be called from a job
+ * system participant, such as the frame pipeline's render thread, whose jobs take
+ * preallocated slots, so steady-state frames allocate nothing.
+ *
+ * @code
+ * vk::raii::CommandBuffer& primary = recorder.BeginFrame(frameSlot);
+ * primary.beginRendering(renderingInfo);	// with vk::RenderingFlagBits::eContentsSecondaryCommandBuffers
+ * recorder.RecordParallel(drawCount, 256, inheritance, [&](vk::raii::CommandBuffer& commands, uint32_t begin, uint32_t end)
+ * {
+ *     commands.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipeline);
+ *     for (uint32_t i = begin; i < end; ++i) { commands.draw(3, 1, 0, 0); }
+ * });
+ * primary.endRendering();
+ * recorder.EndFrame();
+ * @endcode
+ */
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "nyxara/core/jobs/job_system.h"
+#include "vulkan/vulkan_raii.hpp"
+
+namespace nyxara::renderer
+{
+	class VulkanDevice;
+
+	/**
+	 * @brief Records a frame's command buffers from the job system's threads.
+	 *
+	 * BeginFrame(), RecordParallel() and EndFrame() are called from one recording thread,
+	 * a job system participant (see ::nyxara::jobs::JobSystem::AttachThread()). The job
+	 * system must not be restarted while the recorder exists.
+	 */
+	class CommandRecorder
+	{
+	public:
+		/**
+		 * @brief Batches per participant, so threads that finish early can take the rest.
+		 */
+		static constexpr uint32_t BatchesPerThread = 4;
+
+		/**
+		 * @brief Pools per frame slot for threads outside the job system that run batches.
+		 */
+		static constexpr uint32_t ExternalPoolCount = 2;
+
+		/**
+		 * @brief Creates the command pools of every frame slot on the graphics queue family.
+		 *
+		 * @param framesInFlight Number of frame slots, e.g. the frame pipeline depth.
+		 */
+		CommandRecorder(const VulkanDevice& device, uint32_t framesInFlight);
+
+		~CommandRecorder();
+
+		CommandRecorder(const CommandRecorder&) = delete;
+		CommandRecorder& operator=(const CommandRecorder&) = delete;
+
+		/**
+		 * @brief Resets the pools of @p frameSlot and begins its primary command buffer.
+		 *
+		 * The GPU must be done with the command buffers last recorded in this slot.
+		 */
+		vk::raii::CommandBuffer& BeginFrame(uint32_t frameSlot);
+
+		/**
+		 * @brief Ends the primary command buffer, ready for submission.
+		 */
+		vk::raii::CommandBuffer& EndFrame();
+
+		/**
+		 * @brief Records [0, @p count) into secondary command buffers in parallel and executes them in order.
+		 *
+		 * @param count Number of items.
+		 * @param minBatchSize Fewest items worth a command buffer.
+		 * @param rendering Attachments of the dynamic rendering instance the secondaries run in.
+		 * @param record Callable taking `(vk::raii::CommandBuffer&, uint32_t begin, uint32_t end)`,
+		 *               called concurrently for disjoint ranges.
+		 *
+		 * @throws std::runtime_error If the calling thread is not a job system participant.
+		 */
+		template<typename Function>
+		void RecordParallel(uint32_t count, uint32_t minBatchSize,
+			const vk::CommandBufferInheritanceRenderingInfo& rendering, const Function& record)
+		{
+			const uint32_t batchCount = BeginBatches(count, minBatchSize);
+			const uint32_t batchSize = batchCount > 0 ? (count + batchCount - 1) / batchCount : 0;
+
+			jobs::JobSystem::ParallelFor(batchCount, 1, [&](uint32_t batch)
+			{
+				const uint32_t begin = batch * batchSize;
+				const uint32_t end = count - begin > batchSize ? begin + batchSize : count;
+
+				// Released even if record throws, or the external pool would stay taken for good.
+				PoolLease lease(*this);
+				vk::raii::CommandBuffer& commands = BeginSecondary(lease.Pool, rendering);
+				record(commands, begin, end);
+				commands.end();
+
+				BatchBuffers[batch] = *commands;
+			});
+
+			ExecuteBatches();
+		}
+
+	private:
+		struct ThreadPool;
+		struct FrameResources;
+
+		/**
+		 * @brief Checks the calling thread and sizes BatchBuffers for a RecordParallel() call.
+		 *
+		 * @return Number of batches to record.
+		 */
+		uint32_t BeginBatches(uint32_t count, uint32_t minBatchSize);
+
+		/**
+		 * @brief Gets the calling participant's pool, or takes a free external pool until ReleasePool().
+		 */
+		ThreadPool& AcquirePool() noexcept;
+
+		void ReleasePool(ThreadPool& pool) noexcept;
+
+		/**
+		 * @brief Holds the pool AcquirePool() returns until the end of the scope.
+		 */
+		struct PoolLease
+		{
+			explicit PoolLease(CommandRecorder& recorder) noexcept
+				: Recorder(recorder),
+				  Pool(recorder.AcquirePool())
+			{}
+
+			~PoolLease() { Recorder.ReleasePool(Pool); }
+
+			PoolLease(const PoolLease&) = delete;
+			PoolLease& operator=(const PoolLease&) = delete;
+
+			CommandRecorder& Recorder;
+			ThreadPool& Pool;
+		};
+
+		/**
+		 * @brief Takes a secondary command buffer from @p pool and begins it.
+		 */
+		vk::raii::CommandBuffer& BeginSecondary(ThreadPool& pool, const vk::CommandBufferInheritanceRenderingInfo& rendering);
+
+		void ExecuteBatches();
+
+		const vk::raii::Device& Device;
+		const uint32_t QueueFamily;
+
+		// One pool per job participant, then ExternalPoolCount for threads outside the job system.
+		const uint32_t ParticipantCount;
+		const uint32_t ThreadPoolCount;
+
+		std::vector<std::unique_ptr<FrameResources>> Frames;
+		FrameResources* CurrentFrame = nullptr;
+
+		// Secondary command buffers of the current RecordParallel() call, in batch order.
+		std::vector<vk::CommandBuffer> BatchBuffers;
+	};
+} // namespace nyxara::renderer
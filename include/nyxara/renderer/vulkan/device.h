@@ -0,0 +1,141 @@
+#pragma once
+
+/**
+ * @file device.h
+ * @brief Vulkan instance, physical device selection, logical device and queues.
+ *
+ * ::nyxara::renderer::VulkanDevice bootstraps Vulkan 1.3 with the features the renderer
+ * relies on (timeline semaphores, synchronization2, dynamic rendering) and picks the
+ * most capable suitable GPU: discrete, then integrated, then virtual, then CPU
+ * implementations such as lavapipe, so display-less machines can run the renderer.
+ *
+ * @code
+ * nyxara::renderer::VulkanDevice device({ .ApplicationName = "Sandbox" });
+ * nyxara::renderer::PipelineCache cache(device, { .Path = "pipeline_cache.bin" });
+ * @endcode
+ */
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include "vulkan/vulkan_raii.hpp"
+
+namespace nyxara::renderer
+{
+	/**
+	 * @brief Options of a VulkanDevice.
+	 */
+	struct VulkanDeviceCreateInfo
+	{
+		const char* ApplicationName = "Nyxara";
+		uint32_t ApplicationVersion = 0;
+
+		/**
+		 * @brief Enables the Khronos validation layer and debug messages, if installed.
+		 */
+#ifdef NDEBUG
+		bool bEnableValidation = false;
+#else
+		bool bEnableValidation = true;
+#endif
+
+		/**
+		 * @brief Instance extensions required on top of the engine's, e.g. for presentation.
+		 */
+		std::span<const char* const> InstanceExtensions;
+
+		/**
+		 * @brief Device extensions required on top of the engine's; devices lacking one are skipped.
+		 */
+		std::span<const char* const> DeviceExtensions;
+
+		/**
+		 * @brief Substring of the name of the device to use when several are suitable; null picks the best.
+		 */
+		const char* PreferredDevice = nullptr;
+	};
+
+	/**
+	 * @brief Vulkan instance and logical device with its queues.
+	 */
+	class VulkanDevice
+	{
+	public:
+		/**
+		 * @brief Minimum Vulkan version of the instance and of the selected device.
+		 */
+		static constexpr uint32_t ApiVersion = VK_API_VERSION_1_3;
+
+		/**
+		 * @brief Creates the instance, selects a physical device and creates the logical device.
+		 *
+		 * @throws std::runtime_error If no device supports Vulkan 1.3 with the required extensions and features.
+		 * @throws vk::SystemError If a Vulkan call fails.
+		 */
+		explicit VulkanDevice(const VulkanDeviceCreateInfo& info = {});
+
+		VulkanDevice(const VulkanDevice&) = delete;
+		VulkanDevice& operator=(const VulkanDevice&) = delete;
+
+		const vk::raii::Instance& GetInstance() const noexcept { return Instance; }
+		const vk::raii::PhysicalDevice& GetPhysicalDevice() const noexcept { return PhysicalDevice; }
+		const vk::raii::Device& GetDevice() const noexcept { return Device; }
+		const vk::PhysicalDeviceProperties& GetProperties() const noexcept { return Properties; }
+
+		/**
+		 * @brief Queue supporting graphics, compute and transfer.
+		 */
+		const vk::raii::Queue& GetGraphicsQueue() const noexcept { return GraphicsQueue; }
+		uint32_t GetGraphicsQueueFamily() const noexcept { return GraphicsQueueFamily; }
+
+		/**
+		 * @brief Queue of a transfer-only family if the device has one, the graphics queue otherwise.
+		 */
+		const vk::raii::Queue& GetTransferQueue() const noexcept { return TransferQueue; }
+		uint32_t GetTransferQueueFamily() const noexcept { return TransferQueueFamily; }
+
+		/**
+		 * @brief Checks if transfers run on a queue of their own family, which then needs ownership transfers.
+		 */
+		bool HasDedicatedTransferQueue() const noexcept { return TransferQueueFamily != GraphicsQueueFamily; }
+
+		/**
+		 * @brief Submits work to the graphics queue, serialized with the other submissions to it.
+		 *
+		 * Queues need external synchronization: threads sharing a queue must submit through these.
+		 */
+		void SubmitGraphics(const vk::SubmitInfo2& submitInfo, vk::Fence fence = {}) const;
+
+		/**
+		 * @brief Submits work to the transfer queue, serialized with the other submissions to it.
+		 */
+		void SubmitTransfer(const vk::SubmitInfo2& submitInfo, vk::Fence fence = {}) const;
+
+		/**
+		 * @brief Checks if `VK_EXT_memory_budget` is enabled, so heap budgets and usage can be queried.
+		 */
+		bool HasMemoryBudget() const noexcept { return bHasMemoryBudget; }
+
+	private:
+		void CreateInstance(const VulkanDeviceCreateInfo& info);
+		void SelectPhysicalDevice(const VulkanDeviceCreateInfo& info);
+		void CreateDevice(const VulkanDeviceCreateInfo& info);
+
+		// Declared in creation order, so queues go before the device and the device before the instance.
+		vk::raii::Context Context;
+		vk::raii::Instance Instance{ nullptr };
+		vk::raii::DebugUtilsMessengerEXT DebugMessenger{ nullptr };
+		vk::raii::PhysicalDevice PhysicalDevice{ nullptr };
+		vk::PhysicalDeviceProperties Properties;
+		vk::raii::Device Device{ nullptr };
+		vk::raii::Queue GraphicsQueue{ nullptr };
+		vk::raii::Queue TransferQueue{ nullptr };
+		uint32_t GraphicsQueueFamily = 0;
+		uint32_t TransferQueueFamily = 0;
+		bool bHasMemoryBudget = false;
+
+		// The transfer queue uses the graphics queue's mutex when it is the same queue.
+		mutable std::mutex GraphicsQueueMutex;
+		mutable std::mutex TransferQueueMutex;
+	};
+} // namespace nyxara::renderer
@@ -0,0 +1,308 @@
+#pragma once
+
+/**
+ * @file device_allocator.h
+ * @brief Device memory sub-allocation from large per-memory-type blocks.
+ *
+ * Drivers cap the number of live `VkDeviceMemory` objects (`maxMemoryAllocationCount`,
+ * often 4096) and each one is costly to create. ::nyxara::renderer::DeviceAllocator
+ * instead allocates blocks of DeviceAllocatorOptions::BlockSize per memory type and
+ * carves resources out of them with a ::nyxara::renderer::TlsfAllocator, honouring each
+ * resource's alignment and `bufferImageGranularity`. Host-visible blocks are mapped once
+ * for their whole lifetime, so allocations come with a CPU pointer.
+ *
+ * ::nyxara::renderer::FrameRingBuffer is a host-visible buffer sub-allocated as a ring
+ * of per-frame regions, for data written every frame such as uniforms.
+ *
+ * @code
+ * nyxara::renderer::DeviceAllocator allocator(device);
+ * nyxara::renderer::DeviceAllocation allocation;
+ * vk::raii::Buffer buffer = allocator.CreateBuffer(bufferInfo, vk::MemoryPropertyFlagBits::eDeviceLocal, {}, allocation);
+ * ...
+ * buffer.clear();
+ * allocator.Free(allocation);
+ * @endcode
+ *
+ * DeviceAllocatorStats reports the heaps' budget and usage (exact with `VK_EXT_memory_budget`)
+ * and how fragmented the blocks are.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include "nyxara/renderer/vulkan/sub_allocator.h"
+#include "vulkan/vulkan_raii.hpp"
+
+namespace nyxara::renderer
+{
+	class VulkanDevice;
+
+	/**
+	 * @brief Options of a DeviceAllocator.
+	 */
+	struct DeviceAllocatorOptions
+	{
+		/**
+		 * @brief Size of the blocks sub-allocated; heaps smaller than eight blocks use an eighth of the heap.
+		 */
+		vk::DeviceSize BlockSize = vk::DeviceSize(64) << 20;
+
+		/**
+		 * @brief Allocations at least this large get device memory of their own instead of a block range.
+		 */
+		vk::DeviceSize SeparateAllocationSize = vk::DeviceSize(32) << 20;
+	};
+
+	/**
+	 * @brief Memory bound to a resource: a range of a block, or device memory of its own.
+	 */
+	struct DeviceAllocation
+	{
+		vk::DeviceMemory Memory;
+		vk::DeviceSize Offset = 0;
+		vk::DeviceSize Size = 0;
+
+		/**
+		 * @brief Address of the range if the memory is host-visible, null otherwise.
+		 */
+		std::byte* MappedData = nullptr;
+
+		uint32_t MemoryTypeIndex = 0;
+
+		// Owned by the allocator.
+		uint32_t BlockIndex = ~0u;
+		uint32_t RangeHandle = TlsfAllocator::InvalidHandle;
+
+		explicit operator bool() const noexcept { return static_cast<bool>(Memory); }
+	};
+
+	/**
+	 * @brief Budget and usage of a memory heap.
+	 */
+	struct MemoryHeapStats
+	{
+		vk::DeviceSize Size = 0;
+		vk::DeviceSize Budget = 0;			///< Memory the process can use before risking eviction or failure.
+		vk::DeviceSize Usage = 0;			///< Memory used by the process, other allocators included with `VK_EXT_memory_budget`.
+		vk::DeviceSize AllocatedBytes = 0;	///< Device memory allocated by this allocator.
+	};
+
+	/**
+	 * @brief State of a DeviceAllocator.
+	 */
+	struct DeviceAllocatorStats
+	{
+		uint32_t BlockCount = 0;
+		uint32_t SeparateCount = 0;				///< Allocations with device memory of their own.
+		uint32_t DeviceMemoryCount = 0;			///< Live `VkDeviceMemory` objects of this allocator.
+		uint32_t MaxDeviceMemoryCount = 0;		///< `maxMemoryAllocationCount`, shared with other allocators.
+		uint32_t AllocationCount = 0;			///< Allocations in blocks.
+		vk::DeviceSize BlockBytes = 0;
+		vk::DeviceSize UsedBytes = 0;			///< Bytes of the blocks covered by allocations.
+		vk::DeviceSize SeparateBytes = 0;
+		uint32_t FreeRangeCount = 0;			///< Free ranges between allocations, over all blocks.
+		vk::DeviceSize LargestFreeRange = 0;
+
+		/**
+		 * @brief Share of the blocks' free memory outside each block's largest free range, from 0 to 1.
+		 */
+		double Fragmentation = 0.0;
+
+		bool bHasMemoryBudget = false;			///< The heap budgets and usage come from `VK_EXT_memory_budget`.
+		std::vector<MemoryHeapStats> Heaps;
+	};
+
+	/**
+	 * @brief Allocates device memory for resources from shared blocks.
+	 *
+	 * Thread-safe.
+	 */
+	class DeviceAllocator
+	{
+	public:
+		explicit DeviceAllocator(const VulkanDevice& device, const DeviceAllocatorOptions& options = {});
+
+		/**
+		 * @brief Frees the blocks; allocations still alive are reported as leaks.
+		 */
+		~DeviceAllocator();
+
+		DeviceAllocator(const DeviceAllocator&) = delete;
+		DeviceAllocator& operator=(const DeviceAllocator&) = delete;
+
+		/**
+		 * @brief Allocates memory for a resource.
+		 *
+		 * Memory types with all @p required flags are tried, those with the most @p preferred
+		 * flags and the fewest other flags first.
+		 *
+		 * @param tiling Optimal for images with optimal tiling, for `bufferImageGranularity`.
+		 * @throws std::runtime_error If no memory type fits or all suitable heaps are exhausted.
+		 */
+		DeviceAllocation Allocate(const vk::MemoryRequirements& requirements, vk::MemoryPropertyFlags required,
+			vk::MemoryPropertyFlags preferred = {}, ResourceTiling tiling = ResourceTiling::Linear);
+
+		/**
+		 * @brief Frees an allocation and resets it; the resource using it must be destroyed first.
+		 */
+		void Free(DeviceAllocation& allocation);
+
+		/**
+		 * @brief Creates a buffer and binds it to memory allocated for it.
+		 *
+		 * @throws std::runtime_error If allocation fails.
+		 * @throws vk::SystemError If creating the buffer fails.
+		 */
+		vk::raii::Buffer CreateBuffer(const vk::BufferCreateInfo& createInfo, vk::MemoryPropertyFlags required,
+			vk::MemoryPropertyFlags preferred, DeviceAllocation& allocation);
+
+		/**
+		 * @brief Creates an image and binds it to memory allocated for it.
+		 *
+		 * @throws std::runtime_error If allocation fails.
+		 * @throws vk::SystemError If creating the image fails.
+		 */
+		vk::raii::Image CreateImage(const vk::ImageCreateInfo& createInfo, vk::MemoryPropertyFlags required,
+			vk::MemoryPropertyFlags preferred, DeviceAllocation& allocation);
+
+		/**
+		 * @brief Makes CPU writes to a mapped allocation visible to the GPU; a no-op on host-coherent memory.
+		 */
+		void Flush(const DeviceAllocation& allocation) const;
+
+		const vk::PhysicalDeviceMemoryProperties& GetMemoryProperties() const noexcept { return MemoryProperties; }
+
+		DeviceAllocatorStats GetStats() const;
+
+	private:
+		struct MemoryBlock
+		{
+			vk::raii::DeviceMemory Memory{ nullptr };
+			vk::DeviceSize Size = 0;
+			uint32_t MemoryTypeIndex = 0;
+			std::byte* MappedData = nullptr;
+
+			// Empty for separate allocations.
+			std::optional<TlsfAllocator> Ranges;
+		};
+
+		/**
+		 * @brief Gets the memory types allowed by @p typeBits with @p required, best first.
+		 */
+		std::vector<uint32_t> GetMemoryTypes(uint32_t typeBits, vk::MemoryPropertyFlags required,
+			vk::MemoryPropertyFlags preferred) const;
+
+		bool AllocateFromType(uint32_t memoryType, const vk::MemoryRequirements& requirements, ResourceTiling tiling,
+			DeviceAllocation& allocation);
+
+		/**
+		 * @return Index of the block, or ~0u if device memory ran out.
+		 */
+		uint32_t CreateBlock(uint32_t memoryType, vk::DeviceSize size, bool bIsSeparate);
+		void DestroyBlock(uint32_t blockIndex);
+
+		bool IsNonCoherent(uint32_t memoryType) const noexcept;
+
+		const vk::raii::Device& Device;
+		const vk::raii::PhysicalDevice& PhysicalDevice;
+		const bool bHasMemoryBudget;
+		const DeviceAllocatorOptions Options;
+
+		vk::PhysicalDeviceMemoryProperties MemoryProperties;
+		vk::DeviceSize BufferImageGranularity;
+		vk::DeviceSize NonCoherentAtomSize;
+		uint32_t MaxDeviceMemoryCount;
+		std::array<vk::DeviceSize, VK_MAX_MEMORY_TYPES> BlockSizes{};
+
+		mutable std::mutex Mutex;
+		std::vector<std::unique_ptr<MemoryBlock>> Blocks;
+		std::vector<uint32_t> UnusedBlockIndices;
+
+		// Sub-allocated blocks of each memory type, in creation order.
+		std::array<std::vector<uint32_t>, VK_MAX_MEMORY_TYPES> TypeBlocks;
+		uint32_t DeviceMemoryCount = 0;
+	};
+
+	/**
+	 * @brief Host-visible buffer handing out per-frame ranges as a ring.
+	 *
+	 * Ranges allocated after a BeginFrame() call stay valid until BeginFrame() is called
+	 * @p framesInFlight more times; call it once the GPU is done with the frame that
+	 * last used the slot. The memory is host-coherent, so writes need no flush.
+	 *
+	 * Not thread-safe.
+	 */
+	class FrameRingBuffer
+	{
+	public:
+		/**
+		 * @brief Range of the buffer for the current frame.
+		 */
+		struct Range
+		{
+			vk::Buffer Buffer;
+			vk::DeviceSize Offset = 0;
+			vk::DeviceSize Size = 0;
+			std::byte* Data = nullptr;
+
+			explicit operator bool() const noexcept { return Data != nullptr; }
+		};
+
+		/**
+		 * @param usage Usage of the buffer; uniform and storage usages raise the alignment of ranges to the device's limits.
+		 * @throws std::runtime_error If allocation fails.
+		 */
+		FrameRingBuffer(DeviceAllocator& allocator, const VulkanDevice& device, vk::DeviceSize size,
+			vk::BufferUsageFlags usage, uint32_t framesInFlight);
+
+		~FrameRingBuffer();
+
+		FrameRingBuffer(const FrameRingBuffer&) = delete;
+		FrameRingBuffer& operator=(const FrameRingBuffer&) = delete;
+
+		void BeginFrame() noexcept { Ring.BeginFrame(); }
+
+		/**
+		 * @brief Allocates a range for the current frame.
+		 *
+		 * @param alignment Alignment on top of the buffer's own, 0 for none.
+		 * @return The range, or an empty range if the ring is full.
+		 */
+		Range Allocate(vk::DeviceSize size, vk::DeviceSize alignment = 0) noexcept;
+
+		/**
+		 * @brief Allocates a range and copies @p value into it.
+		 */
+		template<typename T>
+		Range Push(const T& value) noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Ring buffer data is copied bytewise");
+
+			Range range = Allocate(sizeof(T), alignof(T));
+
+			if (range)
+			{
+				std::memcpy(range.Data, &value, sizeof(T));
+			}
+
+			return range;
+		}
+
+		const vk::raii::Buffer& GetBuffer() const noexcept { return Buffer; }
+
+		uint64_t GetUsedBytes() const noexcept { return Ring.GetUsedBytes(); }
+		uint64_t GetPeakBytes() const noexcept { return Ring.GetPeakBytes(); }
+
+	private:
+		DeviceAllocator& Allocator;
+		DeviceAllocation Allocation;
+		vk::raii::Buffer Buffer{ nullptr };
+		vk::DeviceSize Alignment = 1;
+		RingAllocator Ring;
+	};
+} // namespace nyxara::renderer
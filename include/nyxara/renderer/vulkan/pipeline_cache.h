@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * @file pipeline_cache.h
+ * @brief Vulkan pipeline cache persisted to disk across runs.
+ *
+ * Pipeline compilation dominates startup. ::nyxara::renderer::PipelineCache seeds a
+ * `VkPipelineCache` from a file written by a previous run, so drivers can skip compiling
+ * pipelines they already built, and writes it back on destruction and periodically from
+ * a background thread once new pipelines were created.
+ *
+ * The file starts with a versioned header recording the vendor, device, driver version
+ * and pipeline cache UUID it was produced with, and a hash of the data. A file from
+ * another GPU or driver, or a truncated or corrupted one, is ignored and the cache
+ * starts cold; drivers are not trusted to reject foreign data safely.
+ *
+ * Pipelines created through CreateGraphicsPipeline() and CreateComputePipeline() are
+ * timed, and creation feedback tells which were found in the cache, so cold and warm
+ * startup costs can be compared from PipelineCacheStats.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "vulkan/vulkan_raii.hpp"
+
+namespace nyxara::renderer
+{
+	class VulkanDevice;
+
+	/**
+	 * @brief Options of a PipelineCache.
+	 */
+	struct PipelineCacheOptions
+	{
+		/**
+		 * @brief File the cache is loaded from and saved to; empty keeps the cache in memory only.
+		 */
+		std::filesystem::path Path;
+
+		/**
+		 * @brief Interval between background saves, done only if pipelines were created since the last save; zero disables them.
+		 */
+		std::chrono::seconds SaveInterval{ 30 };
+	};
+
+	/**
+	 * @brief Pipeline creation costs, to compare runs with a cold and a warm cache.
+	 */
+	struct PipelineCacheStats
+	{
+		bool bIsWarm = false;						///< The cache was seeded from a valid file.
+		size_t LoadedBytes = 0;						///< Size of the seed data.
+		uint64_t PipelineCount = 0;					///< Pipelines created through the cache.
+		uint64_t CacheHitCount = 0;					///< Pipelines the driver reported as found in the cache.
+		std::chrono::nanoseconds CreationTime{};	///< Total time spent creating them.
+		uint64_t SaveCount = 0;						///< Times the cache was written to disk.
+	};
+
+	/**
+	 * @brief `VkPipelineCache` loaded from and saved to a file.
+	 *
+	 * Pipelines may be created from several threads at once; the cache is internally synchronized.
+	 */
+	class PipelineCache
+	{
+	public:
+		/**
+		 * @brief Version of the file format; files of other versions are ignored.
+		 */
+		static constexpr uint32_t FileVersion = 1;
+
+		/**
+		 * @brief Creates the cache, seeded from the file in @p options if it is valid for @p device.
+		 *
+		 * @throws vk::SystemError If the cache cannot be created.
+		 */
+		PipelineCache(const VulkanDevice& device, const PipelineCacheOptions& options = {});
+
+		/**
+		 * @brief Stops the background saves and saves the cache one last time.
+		 */
+		~PipelineCache();
+
+		PipelineCache(const PipelineCache&) = delete;
+		PipelineCache& operator=(const PipelineCache&) = delete;
+
+		const vk::raii::PipelineCache& GetCache() const noexcept { return Cache; }
+
+		/**
+		 * @brief Creates a graphics pipeline through the cache, recording its creation time and cache hit.
+		 *
+		 * @throws vk::SystemError If creation fails.
+		 */
+		vk::raii::Pipeline CreateGraphicsPipeline(vk::GraphicsPipelineCreateInfo createInfo);
+
+		/**
+		 * @brief Creates a compute pipeline through the cache, recording its creation time and cache hit.
+		 *
+		 * @throws vk::SystemError If creation fails.
+		 */
+		vk::raii::Pipeline CreateComputePipeline(vk::ComputePipelineCreateInfo createInfo);
+
+		/**
+		 * @brief Writes the cache to its file now, through a temporary file renamed over it.
+		 *
+		 * @return False if there is no file or writing failed; failures are logged.
+		 */
+		bool Save();
+
+		PipelineCacheStats GetStats() const;
+
+	private:
+		template<typename CreateInfo>
+		vk::raii::Pipeline CreatePipeline(CreateInfo& createInfo);
+
+		bool Load(std::vector<uint8_t>& data) const;
+		void SaveThreadMain(std::chrono::seconds interval);
+
+		const vk::raii::Device& Device;
+		const vk::PhysicalDeviceProperties Properties;
+		const std::filesystem::path Path;
+		vk::raii::PipelineCache Cache{ nullptr };
+
+		mutable std::mutex StatsMutex;
+		PipelineCacheStats Stats;
+
+		// Serializes saves from the background thread and Save().
+		std::mutex SaveMutex;
+		std::atomic<uint64_t> SavedPipelineCount{ 0 };
+
+		std::mutex StopMutex;
+		std::condition_variable StopCondition;
+		bool bIsStopping = false;
+		std::thread SaveThread;
+	};
+} // namespace nyxara::renderer
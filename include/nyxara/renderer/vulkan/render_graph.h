@@ -0,0 +1,365 @@
+#pragma once
+
+/**
+ * @file render_graph.h
+ * @brief Frame render graph: passes declare the resources they use, the graph derives the synchronization.
+ *
+ * Passes are added in execution order with the images and buffers they read and write,
+ * and a usage for each (color attachment, sampled, storage, transfer...). Compile() then:
+ * - culls the passes whose writes nothing reads: a pass is kept if it has side effects,
+ *   writes an imported resource, or writes what a kept pass reads;
+ * - derives, before each pass, the `VkImageMemoryBarrier2` and `VkBufferMemoryBarrier2`
+ *   its accesses need, with the stages and accesses of the previous ones only, and
+ *   batches them into one `vkCmdPipelineBarrier2`; a read needs none once the last
+ *   write is visible to its stages;
+ * - creates the transient images (those the graph owns) and places the ones whose pass
+ *   ranges do not overlap at the same memory, in one allocation per memory type set.
+ *
+ * The graph is declared again every frame, after Reset(). Compile() hashes the
+ * declaration and keeps the previous schedule and transient images when the hash is
+ * unchanged, so a steady-state frame only re-binds the imported resources:
+ * @code
+ * graph.Reset();
+ * nyxara::renderer::RenderGraphImage color = graph.ImportImage("swapchain", swapchainImport);
+ * nyxara::renderer::RenderGraphImage depth = graph.CreateImage("depth", { vk::Format::eD32Sfloat, extent });
+ * graph.AddPass("scene", nyxara::renderer::RenderPassType::Graphics, [&](const nyxara::renderer::RenderPassContext& context)
+ * {
+ *     context.Commands.beginRendering(...);	// context.GetImageView(color), context.GetImageView(depth)
+ * })
+ *     .Write(color, nyxara::renderer::RenderGraphUsage::ColorAttachment)
+ *     .Write(depth, nyxara::renderer::RenderGraphUsage::DepthStencilAttachment);
+ * graph.Compile();
+ * graph.Execute(commands);
+ * @endcode
+ *
+ * Frames in flight share one set of transient images: record every frame with the same
+ * graph and submit them in order to one queue. The first barrier of a transient image in
+ * a frame then waits for every stage that uses its memory in the schedule, so it also
+ * orders the frame after the previous frames' uses of that memory and of the images
+ * aliased with it, which the GPU may still be running.
+ *
+ * DumpSchedule() describes the compiled schedule: kept and culled passes, each barrier
+ * batch, and the placement of the transient images.
+ */
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "nyxara/renderer/vulkan/device_allocator.h"
+#include "vulkan/vulkan_raii.hpp"
+
+namespace nyxara::renderer
+{
+	class VulkanDevice;
+	class RenderGraph;
+
+	/**
+	 * @brief Image of a render graph, valid until the next RenderGraph::Reset().
+	 */
+	struct RenderGraphImage
+	{
+		uint32_t Index = ~0u;
+
+		explicit operator bool() const noexcept { return Index != ~0u; }
+	};
+
+	/**
+	 * @brief Buffer of a render graph, valid until the next RenderGraph::Reset().
+	 */
+	struct RenderGraphBuffer
+	{
+		uint32_t Index = ~0u;
+
+		explicit operator bool() const noexcept { return Index != ~0u; }
+	};
+
+	/**
+	 * @brief Queue work a pass records; selects the shader stages of its shader usages.
+	 */
+	enum class RenderPassType : uint8_t
+	{
+		Graphics,	///< Vertex and fragment shaders.
+		Compute,
+		Transfer,	///< No shader usages.
+	};
+
+	/**
+	 * @brief How a pass uses a resource; with the read or write side, gives its stages, accesses and image layout.
+	 */
+	enum class RenderGraphUsage : uint8_t
+	{
+		ColorAttachment,
+		DepthStencilAttachment,	///< Read only: depth testing without depth writes.
+		ShaderSampled,			///< Read only.
+		ShaderStorage,			///< Images in the general layout.
+		UniformBuffer,			///< Read only.
+		VertexBuffer,			///< Read only.
+		IndexBuffer,			///< Read only.
+		IndirectBuffer,			///< Read only.
+		TransferSource,			///< Read only.
+		TransferDestination,	///< Write only.
+	};
+
+	/**
+	 * @brief Description of a transient image; its usage flags come from the passes using it.
+	 */
+	struct RenderGraphImageInfo
+	{
+		vk::Format Format = vk::Format::eUndefined;
+		vk::Extent2D Extent;
+		uint32_t MipLevels = 1;
+		uint32_t ArrayLayers = 1;
+		vk::SampleCountFlagBits Samples = vk::SampleCountFlagBits::e1;
+	};
+
+	/**
+	 * @brief Image owned outside the graph, e.g. a swapchain image.
+	 *
+	 * Only the handles may change between frames without a recompilation.
+	 */
+	struct ImportedImage
+	{
+		vk::Image Image;
+		vk::ImageView View;
+		vk::Format Format = vk::Format::eUndefined;
+		vk::Extent2D Extent;
+		vk::ImageSubresourceRange Range{ vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1 };
+
+		/**
+		 * @brief Layout before the graph runs; undefined discards the contents.
+		 */
+		vk::ImageLayout InitialLayout = vk::ImageLayout::eUndefined;
+
+		/**
+		 * @brief Layout after the graph ran, e.g. `ePresentSrcKHR`; undefined leaves the last pass's.
+		 */
+		vk::ImageLayout FinalLayout = vk::ImageLayout::eUndefined;
+
+		/**
+		 * @brief Stages and accesses of the work before the graph the first use waits for.
+		 *
+		 * For a swapchain image, the stage its acquire semaphore wait is on.
+		 */
+		vk::PipelineStageFlags2 InitialStages = vk::PipelineStageFlagBits2::eAllCommands;
+		vk::AccessFlags2 InitialAccess = vk::AccessFlagBits2::eMemoryWrite;
+	};
+
+	/**
+	 * @brief Buffer owned outside the graph.
+	 */
+	struct ImportedBuffer
+	{
+		vk::Buffer Buffer;
+		vk::DeviceSize Offset = 0;
+		vk::DeviceSize Size = VK_WHOLE_SIZE;
+
+		vk::PipelineStageFlags2 InitialStages = vk::PipelineStageFlagBits2::eAllCommands;
+		vk::AccessFlags2 InitialAccess = vk::AccessFlagBits2::eMemoryWrite;
+	};
+
+	/**
+	 * @brief What a pass sees of the graph while recording.
+	 */
+	class RenderPassContext
+	{
+	public:
+		RenderPassContext(const RenderGraph& graph, const vk::raii::CommandBuffer& commands) noexcept
+			: Commands(commands), Graph(graph)
+		{}
+
+		vk::Image GetImage(RenderGraphImage image) const;
+		vk::ImageView GetImageView(RenderGraphImage image) const;
+		vk::Extent2D GetExtent(RenderGraphImage image) const;
+		vk::Buffer GetBuffer(RenderGraphBuffer buffer) const;
+
+		const vk::raii::CommandBuffer& Commands;
+
+	private:
+		const RenderGraph& Graph;
+	};
+
+	/**
+	 * @brief Declares the resources of a pass just added.
+	 *
+	 * @throws std::runtime_error If a usage does not exist on that side or for that resource kind.
+	 */
+	class RenderPassBuilder
+	{
+	public:
+		RenderPassBuilder(RenderGraph& graph, uint32_t pass) noexcept : Graph(graph), Pass(pass) {}
+
+		RenderPassBuilder& Read(RenderGraphImage image, RenderGraphUsage usage);
+		RenderPassBuilder& Write(RenderGraphImage image, RenderGraphUsage usage);
+
+		/**
+		 * @brief Reads and writes, e.g. blending into an attachment, which keeps its previous writers.
+		 */
+		RenderPassBuilder& ReadWrite(RenderGraphImage image, RenderGraphUsage usage);
+
+		RenderPassBuilder& Read(RenderGraphBuffer buffer, RenderGraphUsage usage);
+		RenderPassBuilder& Write(RenderGraphBuffer buffer, RenderGraphUsage usage);
+		RenderPassBuilder& ReadWrite(RenderGraphBuffer buffer, RenderGraphUsage usage);
+
+		/**
+		 * @brief Keeps the pass even if nothing reads what it writes, e.g. a readback or a query.
+		 */
+		RenderPassBuilder& SetSideEffects();
+
+	private:
+		RenderGraph& Graph;
+		uint32_t Pass;
+	};
+
+	/**
+	 * @brief State of a RenderGraph.
+	 */
+	struct RenderGraphStats
+	{
+		uint32_t PassCount = 0;
+		uint32_t CulledPassCount = 0;
+		uint32_t BarrierBatchCount = 0;			///< `vkCmdPipelineBarrier2` calls per execution.
+		uint32_t ImageBarrierCount = 0;
+		uint32_t BufferBarrierCount = 0;
+		uint32_t TransientImageCount = 0;
+		vk::DeviceSize TransientBytes = 0;		///< Memory of the transient images, were each one separate.
+		vk::DeviceSize AliasedBytes = 0;		///< Memory of the transient images as placed.
+		uint64_t CompileCount = 0;
+		uint64_t ReuseCount = 0;				///< Compile() calls that kept the previous schedule.
+	};
+
+	/**
+	 * @brief Schedules the passes of a frame and the barriers and transient images between them.
+	 *
+	 * Not thread-safe.
+	 */
+	class RenderGraph
+	{
+	public:
+		using ExecuteFunction = std::function<void(const RenderPassContext&)>;
+
+		RenderGraph(const VulkanDevice& device, DeviceAllocator& allocator);
+
+		/**
+		 * @brief Frees the transient images; the GPU must be done with them.
+		 */
+		~RenderGraph();
+
+		RenderGraph(const RenderGraph&) = delete;
+		RenderGraph& operator=(const RenderGraph&) = delete;
+
+		/**
+		 * @brief Clears the declared passes and resources; the compiled schedule stays until the next Compile().
+		 */
+		void Reset();
+
+		/**
+		 * @brief Declares an image owned by the graph, alive from its first to its last use.
+		 */
+		RenderGraphImage CreateImage(std::string name, const RenderGraphImageInfo& info);
+
+		RenderGraphImage ImportImage(std::string name, const ImportedImage& image);
+		RenderGraphBuffer ImportBuffer(std::string name, const ImportedBuffer& buffer);
+
+		/**
+		 * @brief Adds a pass, run after the ones added before it.
+		 *
+		 * @param execute Records the pass; not called if the pass is culled.
+		 */
+		RenderPassBuilder AddPass(std::string name, RenderPassType type, ExecuteFunction execute);
+
+		/**
+		 * @brief Schedules the declared passes, unless they match the compiled schedule.
+		 *
+		 * A new schedule replaces the transient images: the GPU must be done with the
+		 * frames recorded with the previous one.
+		 *
+		 * @return True if the schedule was compiled, false if the previous one was kept.
+		 * @throws std::runtime_error If a pass uses an image in two layouts.
+		 * @throws std::runtime_error If transient memory cannot be allocated.
+		 */
+		bool Compile();
+
+		/**
+		 * @brief Records the kept passes and their barriers into @p commands.
+		 *
+		 * @throws std::runtime_error If the declaration changed since the last Compile().
+		 */
+		void Execute(const vk::raii::CommandBuffer& commands);
+
+		/**
+		 * @brief Describes the compiled schedule, one line per pass, barrier and transient image.
+		 */
+		std::string DumpSchedule() const;
+
+		const RenderGraphStats& GetStats() const noexcept { return Stats; }
+
+	private:
+		friend class RenderPassBuilder;
+		friend class RenderPassContext;
+
+		struct ResourceNode;
+		struct PassNode;
+		struct CompiledPass;
+		struct TransientImage;
+
+		/**
+		 * @brief Barriers recorded with one `vkCmdPipelineBarrier2`.
+		 */
+		struct BarrierBatch
+		{
+			// Resource of each barrier, whose handle is set when the batch is recorded.
+			std::vector<vk::ImageMemoryBarrier2> ImageBarriers;
+			std::vector<uint32_t> ImageResources;
+			std::vector<vk::BufferMemoryBarrier2> BufferBarriers;
+			std::vector<uint32_t> BufferResources;
+
+			bool IsEmpty() const noexcept { return ImageBarriers.empty() && BufferBarriers.empty(); }
+		};
+
+		void AddAccess(uint32_t pass, uint32_t resource, bool bIsImage, RenderGraphUsage usage, bool bRead, bool bWrite);
+
+		uint64_t HashDeclaration() const noexcept;
+
+		/**
+		 * @brief Marks the passes to keep, walking back from the imported resources and the side effects.
+		 */
+		std::vector<bool> CullPasses() const;
+
+		void CreateTransientImages();
+
+		/**
+		 * @brief Sets the handles of the transient images in the declaration of the current frame.
+		 */
+		void BindTransientImages();
+		void DestroyTransientImages();
+		void ComputeBarriers();
+
+		/**
+		 * @brief Sets the handles of the compiled barriers to the resources declared this frame and records them.
+		 */
+		void RecordBarriers(const vk::raii::CommandBuffer& commands, BarrierBatch& batch);
+
+		const vk::raii::Device& Device;
+		DeviceAllocator& Allocator;
+
+		// Declaration of the current frame.
+		std::vector<ResourceNode> Resources;
+		std::vector<PassNode> Passes;
+
+		// The declaration did not change since Compile().
+		bool bIsReady = false;
+
+		// Compiled schedule, kept while the declaration hashes the same.
+		bool bIsCompiled = false;
+		uint64_t CompiledHash = 0;
+		std::vector<CompiledPass> Schedule;
+		BarrierBatch FinalBarriers;
+		std::vector<std::string> CulledPassNames;
+		std::vector<std::string> CompiledResourceNames;
+		std::vector<TransientImage> TransientImages;
+		std::vector<DeviceAllocation> TransientMemory;
+
+		RenderGraphStats Stats;
+	};
+} // namespace nyxara::renderer
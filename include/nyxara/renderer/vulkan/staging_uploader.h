@@ -0,0 +1,240 @@
+#pragma once
+
+/**
+ * @file staging_uploader.h
+ * @brief Asynchronous uploads to device memory through a persistently mapped staging ring.
+ *
+ * ::nyxara::renderer::StagingUploader copies the data of buffer and image uploads into a
+ * host-visible ring buffer and batches the matching copy commands. Batches are submitted
+ * to the device's transfer queue, a queue of a transfer-only family when the device has
+ * one, and signal a timeline semaphore; the value a batch signals is the UploadToken of
+ * the uploads it holds, which can be polled or waited on.
+ *
+ * Uploads may come from any number of threads: the ring space of an upload is reserved
+ * under a lock, but its data is copied outside of it.
+ *
+ * With a dedicated transfer queue, the resources written change queue family. The
+ * uploader releases them from the transfer family when the batch is submitted; the
+ * graphics side acquires them with AcquireUploads(), which records the matching
+ * barriers and returns the semaphore wait its submission must include, if anything was
+ * uploaded:
+ * @code
+ * nyxara::renderer::UploadToken token = uploader.UploadBuffer(vertexBuffer, 0, std::as_bytes(std::span(vertices)));
+ * ...
+ * vk::SemaphoreSubmitInfo wait = uploader.AcquireUploads(commands);	// On the render thread, each frame.
+ *
+ * if (wait.semaphore)
+ * {
+ *     submitInfo.setWaitSemaphoreInfos(wait);
+ * }
+ * @endcode
+ *
+ * An image upload replaces the whole subresource: it is transitioned from an undefined
+ * layout. Destination resources use exclusive sharing and belong to the graphics queue
+ * family once acquired; with a dedicated transfer queue, partial updates of a buffer the
+ * graphics queue already used leave the rest of it undefined, so update such buffers
+ * whole, or give them concurrent sharing.
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+#include "nyxara/renderer/vulkan/device_allocator.h"
+#include "nyxara/renderer/vulkan/sub_allocator.h"
+#include "vulkan/vulkan_raii.hpp"
+
+namespace nyxara::renderer
+{
+	class VulkanDevice;
+
+	/**
+	 * @brief Options of a StagingUploader.
+	 */
+	struct StagingUploaderOptions
+	{
+		/**
+		 * @brief Size of the staging ring; larger buffer uploads are split, larger image uploads rejected.
+		 */
+		vk::DeviceSize RingSize = vk::DeviceSize(64) << 20;
+
+		/**
+		 * @brief Batches submitted and not known complete before producers wait for the oldest.
+		 */
+		uint32_t MaxBatchesInFlight = 4;
+
+		/**
+		 * @brief Queue family acquires that may wait for AcquireUploads() before uploads are rejected.
+		 *
+		 * Only used with a dedicated transfer queue; catches a render loop that never acquires.
+		 */
+		uint32_t MaxPendingAcquires = 65536;
+	};
+
+	/**
+	 * @brief Completion of a set of uploads: the timeline semaphore value their batch signals.
+	 */
+	struct UploadToken
+	{
+		uint64_t Value = 0;		///< 0 when there is nothing to wait for.
+	};
+
+	/**
+	 * @brief Counters of a StagingUploader.
+	 */
+	struct StagingUploaderStats
+	{
+		uint64_t UploadCount = 0;
+		uint64_t UploadedBytes = 0;
+		uint64_t SubmitCount = 0;
+		uint64_t StallCount = 0;	///< Times the ring was full and a producer waited for the GPU.
+		uint64_t PeakRingBytes = 0;
+	};
+
+	/**
+	 * @brief Image region to upload, from tightly packed texels.
+	 */
+	struct ImageUpload
+	{
+		vk::Image Image;
+		vk::ImageSubresourceLayers Subresource{ vk::ImageAspectFlagBits::eColor, 0, 0, 1 };
+		vk::Offset3D Offset;
+		vk::Extent3D Extent;
+
+		/**
+		 * @brief Layout of the subresource once acquired.
+		 */
+		vk::ImageLayout FinalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+	};
+
+	/**
+	 * @brief Uploads data to buffers and images from a staging ring, on the transfer queue.
+	 *
+	 * Thread-safe.
+	 */
+	class StagingUploader
+	{
+	public:
+		/**
+		 * @throws std::runtime_error If the ring cannot be allocated.
+		 */
+		StagingUploader(const VulkanDevice& device, DeviceAllocator& allocator, const StagingUploaderOptions& options = {});
+
+		/**
+		 * @brief Submits the pending uploads and waits for all of them.
+		 */
+		~StagingUploader();
+
+		StagingUploader(const StagingUploader&) = delete;
+		StagingUploader& operator=(const StagingUploader&) = delete;
+
+		/**
+		 * @brief Copies @p data to @p buffer at @p offset once the batch holding it runs.
+		 *
+		 * @throws std::runtime_error If StagingUploaderOptions::MaxPendingAcquires uploads await AcquireUploads().
+		 */
+		UploadToken UploadBuffer(vk::Buffer buffer, vk::DeviceSize offset, std::span<const std::byte> data);
+
+		/**
+		 * @brief Copies @p data, tightly packed texels of a format with a power of two texel block size, to an image region.
+		 *
+		 * @throws std::runtime_error If @p data does not fit in the ring, or too many uploads await AcquireUploads().
+		 */
+		UploadToken UploadImage(const ImageUpload& upload, std::span<const std::byte> data);
+
+		/**
+		 * @brief Submits the uploads not submitted yet.
+		 *
+		 * @return Token of the last batch submitted.
+		 */
+		UploadToken Flush();
+
+		/**
+		 * @brief Checks if the uploads of @p token completed, without blocking.
+		 */
+		bool IsComplete(UploadToken token) const;
+
+		/**
+		 * @brief Waits for the uploads of @p token to complete, submitting them first if needed.
+		 */
+		void Wait(UploadToken token);
+
+		/**
+		 * @brief Submits pending uploads and makes every submitted upload usable by a graphics queue submission.
+		 *
+		 * Records into @p commands, a command buffer for the graphics queue, the queue family
+		 * acquire barriers of the uploads not acquired yet.
+		 *
+		 * @return Semaphore wait to include in the submission of @p commands; its semaphore is null if there is none.
+		 */
+		vk::SemaphoreSubmitInfo AcquireUploads(const vk::raii::CommandBuffer& commands);
+
+		const vk::raii::Semaphore& GetTimeline() const noexcept { return Timeline; }
+
+		StagingUploaderStats GetStats() const;
+
+	private:
+		struct Batch;
+
+		struct Reservation
+		{
+			Batch* Target;
+			std::byte* Data;
+			vk::DeviceSize Offset;
+		};
+
+		/**
+		 * @brief Reserves ring space in the open batch, submitting batches and waiting for old ones to free space.
+		 */
+		Reservation Reserve(std::unique_lock<std::mutex>& lock, vk::DeviceSize size);
+
+		/**
+		 * @brief Marks the data of a reservation as written.
+		 */
+		void Commit(const Reservation& reservation);
+
+		/**
+		 * @brief Checks if the open batch holds uploads not submitted yet.
+		 */
+		bool HasOpenUploads() const noexcept;
+
+		/**
+		 * @brief Submits the open batch if it holds uploads, then opens the next one.
+		 *
+		 * Waits for the GPU to free the next batch without the lock; until it is open,
+		 * Reserve() and SubmitBatch() wait, while the render thread's AcquireUploads() does not.
+		 */
+		void SubmitBatch(std::unique_lock<std::mutex>& lock);
+
+		void RecordBatch(Batch& batch);
+
+		const VulkanDevice& Device;
+		DeviceAllocator& Allocator;
+		const bool bHasTransferQueue;
+		const uint32_t MaxPendingAcquires;
+		vk::DeviceSize CopyAlignment;
+
+		DeviceAllocation StagingAllocation;
+		vk::raii::Buffer StagingBuffer{ nullptr };
+		vk::raii::Semaphore Timeline{ nullptr };
+
+		mutable std::mutex Mutex;
+		std::condition_variable WritesDone;
+		RingAllocator Ring;
+
+		// One batch per ring region; the open batch is the one being filled.
+		std::vector<std::unique_ptr<Batch>> Batches;
+		uint32_t OpenBatch = 0;
+		uint64_t SubmittedValue = 0;
+		bool bIsOpeningBatch = false;	///< A thread waits for the GPU to free the open batch.
+
+		// Acquire halves of the ownership transfers released by submitted batches.
+		std::vector<vk::BufferMemoryBarrier2> PendingBufferAcquires;
+		std::vector<vk::ImageMemoryBarrier2> PendingImageAcquires;
+
+		StagingUploaderStats Stats;
+	};
+} // namespace nyxara::renderer
@@ -0,0 +1,230 @@
+#pragma once
+
+/**
+ * @file sub_allocator.h
+ * @brief Offset allocators carving device memory blocks, independent of Vulkan.
+ *
+ * These classes only hand out offsets into a range of a given size; they never touch
+ * memory, so their logic can be exercised without a GPU. ::nyxara::renderer::DeviceAllocator
+ * uses them to sub-allocate `VkDeviceMemory` blocks:
+ *
+ * - ::nyxara::renderer::TlsfAllocator, a two-level segregated fit allocator for resources
+ *   of arbitrary lifetime: allocation and freeing are O(1) and free neighbours are merged
+ *   immediately.
+ * - ::nyxara::renderer::RingAllocator, a ring of per-frame regions for data rewritten
+ *   every frame, such as uniforms: allocation is a pointer bump and a frame's allocations
+ *   are released all at once.
+ *
+ * @code
+ * nyxara::renderer::TlsfAllocator allocator(64 << 20, properties.limits.bufferImageGranularity);
+ * nyxara::renderer::TlsfAllocator::Allocation allocation = allocator.Allocate(requirements.size,
+ *     requirements.alignment, nyxara::renderer::ResourceTiling::Optimal);
+ * allocator.Free(allocation.Handle);
+ * @endcode
+ */
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace nyxara::renderer
+{
+	/**
+	 * @brief Memory layout of a resource, for `bufferImageGranularity`.
+	 */
+	enum class ResourceTiling : uint8_t
+	{
+		Linear,		///< Buffers and linear images.
+		Optimal,	///< Images with optimal tiling.
+	};
+
+	/**
+	 * @brief Usage and fragmentation of a TlsfAllocator.
+	 */
+	struct TlsfAllocatorStats
+	{
+		uint64_t Size = 0;				///< Size of the managed range.
+		uint64_t UsedBytes = 0;			///< Bytes covered by allocations, alignment padding excluded.
+		uint32_t AllocationCount = 0;
+		uint32_t FreeRangeCount = 0;	///< Free ranges between allocations.
+		uint64_t LargestFreeRange = 0;	///< Largest allocation that could still succeed, alignment aside.
+
+		/**
+		 * @brief Gets the share of free memory outside the largest free range: 0 when all free memory is contiguous.
+		 */
+		double GetFragmentation() const noexcept
+		{
+			const uint64_t freeBytes = Size - UsedBytes;
+			return freeBytes > 0 ? 1.0 - static_cast<double>(LargestFreeRange) / static_cast<double>(freeBytes) : 0.0;
+		}
+	};
+
+	/**
+	 * @brief Two-level segregated fit allocator of offsets in [0, size).
+	 *
+	 * Free ranges are kept in lists indexed by size class: the first level is the power of
+	 * two of the size, the second splits it linearly in SecondLevelCount classes. Bitmaps
+	 * of the non-empty lists find a large enough range with two bit scans.
+	 *
+	 * Optimal-tiling allocations are aligned, and their size rounded, to the granularity
+	 * given at construction, so they never share a `bufferImageGranularity` page with a
+	 * linear allocation.
+	 *
+	 * Not thread-safe.
+	 */
+	class TlsfAllocator
+	{
+	public:
+		static constexpr uint32_t InvalidHandle = ~0u;
+
+		/**
+		 * @brief Alignment of every offset and size.
+		 */
+		static constexpr uint64_t MinAlignment = 16;
+
+		/**
+		 * @brief An allocated range, identified by its handle.
+		 */
+		struct Allocation
+		{
+			uint64_t Offset = 0;
+			uint64_t Size = 0;
+			uint32_t Handle = InvalidHandle;
+
+			explicit operator bool() const noexcept { return Handle != InvalidHandle; }
+		};
+
+		/**
+		 * @param size Size of the range, rounded down to MinAlignment.
+		 * @param granularity Page size optimal-tiling allocations are isolated to, e.g. `bufferImageGranularity`.
+		 */
+		explicit TlsfAllocator(uint64_t size, uint64_t granularity = 1);
+
+		/**
+		 * @brief Allocates a range.
+		 *
+		 * @param alignment Alignment of the offset, a power of two.
+		 * @return The range, or an allocation with InvalidHandle if no free range is large enough.
+		 */
+		Allocation Allocate(uint64_t size, uint64_t alignment, ResourceTiling tiling = ResourceTiling::Linear);
+
+		/**
+		 * @brief Frees a range and merges it with its free neighbours.
+		 */
+		void Free(uint32_t handle);
+
+		uint64_t GetSize() const noexcept { return Size; }
+		bool IsEmpty() const noexcept { return AllocationCount == 0; }
+
+		TlsfAllocatorStats GetStats() const noexcept;
+
+	private:
+		static constexpr uint32_t SecondLevelBits = 5;
+		static constexpr uint32_t SecondLevelCount = 1u << SecondLevelBits;
+
+		// Sizes below this are classed linearly in the first list of first level 0.
+		static constexpr uint64_t SmallRangeSize = 256;
+		static constexpr uint32_t FirstLevelShift = 7;
+		static constexpr uint32_t FirstLevelCount = 64 - FirstLevelShift;
+
+		static constexpr uint32_t NoNode = ~0u;
+
+		/**
+		 * @brief Range of the managed space, free or allocated; ranges tile the space in offset order.
+		 */
+		struct Node
+		{
+			uint64_t Offset = 0;
+			uint64_t Size = 0;
+			uint32_t PreviousPhysical = NoNode;
+			uint32_t NextPhysical = NoNode;
+			uint32_t PreviousFree = NoNode;
+			uint32_t NextFree = NoNode;		///< Also links unused nodes.
+			bool bIsFree = false;
+		};
+
+		static void GetSizeClass(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel) noexcept;
+
+		uint32_t FindFreeNode(uint64_t size) const noexcept;
+		void InsertFree(uint32_t node) noexcept;
+		void RemoveFree(uint32_t node) noexcept;
+
+		/**
+		 * @brief Splits the range of @p node at @p size; the remainder becomes a free range after it.
+		 */
+		void Split(uint32_t node, uint64_t size);
+
+		uint32_t CreateNode();
+		void ReleaseNode(uint32_t node) noexcept;
+
+		uint64_t Size;
+		uint64_t Granularity;
+
+		std::vector<Node> Nodes;
+		uint32_t UnusedNodes = NoNode;
+
+		uint64_t FirstLevelBitmap = 0;
+		std::array<uint32_t, FirstLevelCount> SecondLevelBitmaps{};
+		std::array<uint32_t, FirstLevelCount * SecondLevelCount> FreeLists;
+
+		uint64_t UsedBytes = 0;
+		uint32_t AllocationCount = 0;
+		uint32_t FreeRangeCount = 0;
+	};
+
+	/**
+	 * @brief Ring of offsets in [0, size) released a frame at a time.
+	 *
+	 * Allocations made between two BeginFrame() calls belong to one frame. BeginFrame()
+	 * releases those of the frame @p framesInFlight frames back, so it must be called only
+	 * once the GPU is done with that frame. Allocation never splits a range across the end
+	 * of the ring: it skips to offset zero instead.
+	 *
+	 * Not thread-safe.
+	 */
+	class RingAllocator
+	{
+	public:
+		static constexpr uint64_t InvalidOffset = ~0ull;
+
+		/**
+		 * @param framesInFlight Frames whose allocations are alive at once, e.g. the frame pipeline depth.
+		 */
+		RingAllocator(uint64_t size, uint32_t framesInFlight);
+
+		/**
+		 * @brief Starts a new frame, releasing the allocations of the frame that last used its slot.
+		 */
+		void BeginFrame() noexcept;
+
+		/**
+		 * @brief Allocates a range for the current frame.
+		 *
+		 * @param alignment Alignment of the offset, a power of two.
+		 * @return Offset of the range, or InvalidOffset if the ring is full.
+		 */
+		uint64_t Allocate(uint64_t size, uint64_t alignment) noexcept;
+
+		uint64_t GetSize() const noexcept { return Size; }
+
+		/**
+		 * @brief Gets the bytes held by the frames in flight, alignment padding and skipped ends included.
+		 */
+		uint64_t GetUsedBytes() const noexcept { return UsedBytes; }
+
+		/**
+		 * @brief Gets the highest GetUsedBytes() seen, to size the ring.
+		 */
+		uint64_t GetPeakBytes() const noexcept { return PeakBytes; }
+
+	private:
+		uint64_t Size;
+		uint64_t Head = 0;
+		uint64_t UsedBytes = 0;
+		uint64_t PeakBytes = 0;
+
+		// Bytes consumed by each frame slot; the oldest frame is the one after the current slot.
+		std::vector<uint64_t> FrameBytes;
+		uint32_t CurrentFrame = 0;
+	};
+} // namespace nyxara::renderer
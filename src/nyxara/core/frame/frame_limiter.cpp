@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <thread>
+#include "nyxara/core/frame/frame_limiter.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace nyxara::frame
+{
+    namespace
+    {
+        void SleepUntil(FrameLimiter::Clock::time_point deadline) noexcept
+        {
+#if defined(_WIN32)
+            // Sleep() has the resolution of the system timer, 15.6 ms by default; high-resolution
+            // waitable timers (Windows 10 1803+) wake up within about half a millisecond.
+            static thread_local HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr,
+                CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+            if (timer)
+            {
+                const auto remaining = deadline - FrameLimiter::Clock::now();
+
+                if (remaining > std::chrono::nanoseconds::zero())
+                {
+                    // Negative due times are relative, in 100 ns units.
+                    LARGE_INTEGER dueTime;
+                    dueTime.QuadPart = -static_cast<LONGLONG>(remaining.count() / 100);
+
+                    if (SetWaitableTimer(timer, &dueTime, 0, nullptr, nullptr, FALSE))
+                    {
+                        WaitForSingleObject(timer, INFINITE);
+                    }
+                }
+
+                return;
+            }
+#endif
+            std::this_thread::sleep_until(deadline);
+        }
+
+        void SpinUntil(FrameLimiter::Clock::time_point deadline) noexcept
+        {
+            while (FrameLimiter::Clock::now() < deadline)
+            {
+                std::this_thread::yield();
+            }
+        }
+    } // namespace
+
+    FrameLimiter::FrameLimiter(const FrameLimiterOptions& options)
+        : SpinThreshold(options.SpinThreshold),
+          FrameStart(Clock::now())
+    {
+        SetTargetFps(options.TargetFps);
+    }
+
+    void FrameLimiter::SetTargetFps(double fps) noexcept
+    {
+        TargetFps = std::max(fps, 0.0);
+        Period = TargetFps > 0.0
+            ? std::chrono::nanoseconds(static_cast<int64_t>(1'000'000'000.0 / TargetFps))
+            : std::chrono::nanoseconds::zero();
+    }
+
+    std::chrono::nanoseconds FrameLimiter::GetTimeUntilDeadline() const noexcept
+    {
+        if (Period == std::chrono::nanoseconds::zero())
+        {
+            return std::chrono::nanoseconds::zero();
+        }
+
+        return std::max(FrameStart + Period - Clock::now(), Clock::duration::zero());
+    }
+
+    void FrameLimiter::Wait() noexcept
+    {
+        const Clock::time_point now = Clock::now();
+
+        if (Period == std::chrono::nanoseconds::zero())
+        {
+            FrameStart = now;
+            return;
+        }
+
+        const Clock::time_point deadline = FrameStart + Period;
+        ++FrameCount;
+
+        if (now >= deadline)
+        {
+            ++MissedCount;
+
+            // Overran by a whole period: restart the schedule rather than rushing the next frames.
+            FrameStart = now - deadline >= Period ? now : deadline;
+            return;
+        }
+
+        if (deadline - now > SpinThreshold)
+        {
+            SleepUntil(deadline - SpinThreshold);
+        }
+
+        const Clock::time_point spinStart = Clock::now();
+        SpinUntil(deadline);
+        const Clock::time_point end = Clock::now();
+
+        SleepTime += spinStart - now;
+        SpinTime += end - spinStart;
+
+        const std::chrono::nanoseconds error = end - deadline;
+        TotalError += error;
+        MaxError = std::max(MaxError, error);
+
+        FrameStart = deadline;
+    }
+
+    FramePacingStats FrameLimiter::GetStats() const noexcept
+    {
+        FramePacingStats stats;
+        stats.FrameCount = FrameCount;
+        stats.MissedCount = MissedCount;
+        stats.MaxError = MaxError;
+        stats.SleepTime = SleepTime;
+        stats.SpinTime = SpinTime;
+
+        if (const uint64_t metCount = FrameCount - MissedCount)
+        {
+            stats.MeanError = TotalError / static_cast<int64_t>(metCount);
+        }
+
+        return stats;
+    }
+
+    void FrameLimiter::ResetStats() noexcept
+    {
+        FrameCount = 0;
+        MissedCount = 0;
+        TotalError = {};
+        MaxError = {};
+        SleepTime = {};
+        SpinTime = {};
+    }
+
+    void FrameLimiter::WaitUntil(Clock::time_point deadline, std::chrono::nanoseconds spinThreshold) noexcept
+    {
+        if (deadline - Clock::now() > spinThreshold)
+        {
+            SleepUntil(deadline - spinThreshold);
+        }
+
+        SpinUntil(deadline);
+    }
+} // namespace nyxara::frame
@@ -0,0 +1,181 @@
+#include <stdexcept>
+#include <utility>
+#include "nyxara/core/frame/frame_pipeline.h"
+#include "nyxara/core/jobs/job_system.h"
+#include "nyxara/core/logging/call_depth_manager.h"
+#include "nyxara/core/logging/categories.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+namespace nyxara::frame
+{
+    FrameScheduler::FrameScheduler(const FramePipelineOptions& options, RenderCallback render)
+        : Depth(options.Depth),
+          Render(std::move(render))
+    {
+        if (Depth == 0)
+        {
+            throw std::runtime_error("Frame pipeline depth must be at least 1");
+        }
+
+        if (options.bUseRenderThread)
+        {
+            // The render thread logs with the call depth settings of the thread that created the pipeline.
+            RenderThread = std::thread([this, callDepth = logging::CallDepthManager::GetState()]()
+            {
+                logging::CallDepthManager::ExchangeState(callDepth);
+
+                // Jobs spawned while rendering, e.g. parallel command recording, then go to this
+                // thread's own deque rather than the shared queue.
+                jobs::JobSystem::AttachThread();
+                RenderThreadMain();
+                jobs::JobSystem::DetachThread();
+            });
+        }
+
+        NYX_LOG_DEBUG(Core, "Frame pipeline started: depth {}, {}", Depth,
+            options.bUseRenderThread ? "render thread" : "rendering on the update thread");
+    }
+
+    FrameScheduler::~FrameScheduler()
+    {
+        if (!RenderThread.joinable())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard lock(Mutex);
+            bIsStopping = true;
+        }
+
+        FrameSubmitted.notify_one();
+        RenderThread.join();
+    }
+
+    uint32_t FrameScheduler::AcquireUpdateSlot()
+    {
+        if (RenderThread.joinable())
+        {
+            std::unique_lock lock(Mutex);
+
+            if (SubmittedCount - RenderedCount >= Depth)
+            {
+                auto start = std::chrono::steady_clock::now();
+                FrameRendered.wait(lock, [this] { return SubmittedCount - RenderedCount < Depth; });
+                Stats.UpdateStallTime += std::chrono::steady_clock::now() - start;
+            }
+        }
+
+        RethrowRenderError();
+
+        return static_cast<uint32_t>(SubmittedCount % Depth);
+    }
+
+    void FrameScheduler::SubmitUpdateSlot()
+    {
+        if (!RenderThread.joinable())
+        {
+            RenderFrame(SubmittedCount++);
+            return;
+        }
+
+        {
+            std::lock_guard lock(Mutex);
+            ++SubmittedCount;
+        }
+
+        FrameSubmitted.notify_one();
+    }
+
+    void FrameScheduler::Flush()
+    {
+        if (RenderThread.joinable())
+        {
+            std::unique_lock lock(Mutex);
+            FrameRendered.wait(lock, [this] { return RenderedCount == SubmittedCount; });
+        }
+
+        RethrowRenderError();
+    }
+
+    FramePipelineStats FrameScheduler::GetStats() const
+    {
+        std::lock_guard lock(Mutex);
+        return Stats;
+    }
+
+    void FrameScheduler::RenderThreadMain()
+    {
+#if defined(__linux__)
+        pthread_setname_np(pthread_self(), "nyx-render");
+#endif
+
+        std::unique_lock lock(Mutex);
+
+        for (;;)
+        {
+            if (RenderedCount == SubmittedCount)
+            {
+                if (bIsStopping)
+                {
+                    break;
+                }
+
+                auto start = std::chrono::steady_clock::now();
+                FrameSubmitted.wait(lock, [this] { return RenderedCount != SubmittedCount || bIsStopping; });
+                Stats.RenderIdleTime += std::chrono::steady_clock::now() - start;
+                continue;
+            }
+
+            const uint64_t frameIndex = RenderedCount;
+
+            // The slot belongs to this thread until RenderedCount moves past it.
+            lock.unlock();
+            RenderFrame(frameIndex);
+            lock.lock();
+
+            ++RenderedCount;
+            FrameRendered.notify_one();
+        }
+    }
+
+    void FrameScheduler::RenderFrame(uint64_t frameIndex)
+    {
+        try
+        {
+            Render(static_cast<uint32_t>(frameIndex % Depth), frameIndex);
+        }
+        catch (...)
+        {
+            NYX_LOG_ERROR(Core, "Frame {} failed to render", frameIndex);
+
+            std::lock_guard lock(Mutex);
+
+            if (!RenderError)
+            {
+                RenderError = std::current_exception();
+            }
+        }
+
+        std::lock_guard lock(Mutex);
+        ++Stats.RenderedFrameCount;
+    }
+
+    void FrameScheduler::RethrowRenderError()
+    {
+        std::exception_ptr error;
+
+        {
+            std::lock_guard lock(Mutex);
+            error = std::exchange(RenderError, nullptr);
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+} // namespace nyxara::frame
@@ -0,0 +1,302 @@
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include "nyxara/core/frame/frame_stats.h"
+#include "nyxara/core/logging/categories.h"
+
+namespace nyxara::frame
+{
+    namespace
+    {
+        double ToMilliseconds(int64_t nanoseconds) noexcept
+        {
+            return static_cast<double>(nanoseconds) / 1'000'000.0;
+        }
+
+        /**
+         * @brief Computes the distribution of @p samples; sorts them in place.
+         */
+        FrameTimeDistribution Distribute(std::vector<int64_t>& samples)
+        {
+            FrameTimeDistribution distribution;
+
+            if (samples.empty())
+            {
+                return distribution;
+            }
+
+            std::sort(samples.begin(), samples.end());
+
+            // Nearest-rank percentile
+            auto percentile = [&](double p)
+            {
+                size_t rank = static_cast<size_t>(p * static_cast<double>(samples.size()) + 0.999999);
+                return ToMilliseconds(samples[std::clamp<size_t>(rank, 1, samples.size()) - 1]);
+            };
+
+            int64_t total = 0;
+            for (int64_t sample : samples)
+            {
+                total += sample;
+            }
+
+            distribution.Average = ToMilliseconds(total) / static_cast<double>(samples.size());
+            distribution.P50 = percentile(0.50);
+            distribution.P95 = percentile(0.95);
+            distribution.P99 = percentile(0.99);
+            distribution.Max = ToMilliseconds(samples.back());
+            return distribution;
+        }
+
+        std::string MakeCsvHeader()
+        {
+            std::string header = "elapsed_s,frames,hitches,frame_avg_ms,frame_p50_ms,frame_p95_ms,frame_p99_ms,frame_max_ms";
+
+            for (size_t i = 0; i < FramePhaseCount; ++i)
+            {
+                const std::string name = GetFramePhaseName(static_cast<FramePhase>(i));
+                header += ',' + name + "_avg_ms," + name + "_p95_ms," + name + "_max_ms";
+            }
+
+            return header + ",interval_avg_ms,interval_p50_ms,interval_p95_ms,interval_p99_ms,interval_max_ms";
+        }
+    } // namespace
+
+    const char* GetFramePhaseName(FramePhase phase) noexcept
+    {
+        switch (phase)
+        {
+        case FramePhase::Events: return "events";
+        case FramePhase::Update: return "update";
+        case FramePhase::Record: return "record";
+        case FramePhase::Submit: return "submit";
+        case FramePhase::Present: return "present";
+        default: return "unknown";
+        }
+    }
+
+    FrameStats::FrameStats(const FrameStatsOptions& options)
+        : Options(options),
+          History(std::max<size_t>(options.HistorySize, 1)),
+          CreationTime(Clock::now()),
+          LastSummaryTime(CreationTime)
+    {
+        SortScratch.reserve(History.size());
+
+        if (Options.CsvPath.empty())
+        {
+            return;
+        }
+
+        const std::string header = MakeCsvHeader();
+
+        std::error_code error;
+        bool bNeedsHeader = !std::filesystem::exists(Options.CsvPath, error)
+            || std::filesystem::file_size(Options.CsvPath, error) == 0;
+
+        // Rows are only appended under the same columns; a file written with other ones is moved aside.
+        if (!bNeedsHeader)
+        {
+            std::string existingHeader;
+            std::getline(std::ifstream(Options.CsvPath), existingHeader);
+
+            if (existingHeader != header)
+            {
+                std::filesystem::path oldPath = Options.CsvPath;
+                oldPath += ".old";
+                std::filesystem::rename(Options.CsvPath, oldPath, error);
+
+                if (error)
+                {
+                    throw std::runtime_error("Failed to move aside frame statistics file with other columns: "
+                        + Options.CsvPath.string());
+                }
+
+                NYX_LOG_INFO(Core, "Frame statistics file '{}' had other columns; moved to '{}'",
+                    Options.CsvPath.string(), oldPath.string());
+                bNeedsHeader = true;
+            }
+        }
+
+        Csv.open(Options.CsvPath, std::ios::out | std::ios::app);
+
+        if (!Csv)
+        {
+            throw std::runtime_error("Failed to open frame statistics file: " + Options.CsvPath.string());
+        }
+
+        if (bNeedsHeader)
+        {
+            Csv << header << '\n';
+        }
+    }
+
+    void FrameStats::BeginFrame() noexcept
+    {
+        const Clock::time_point now = Clock::now();
+
+        Current = FrameRecord{};
+
+        if (FrameCount > 0)
+        {
+            Current.FrameInterval = std::chrono::duration_cast<std::chrono::nanoseconds>(now - FrameStart).count();
+            Current.IdleTime = PendingIdleTime;
+        }
+
+        PendingIdleTime = 0;
+
+        FrameStart = now;
+    }
+
+    void FrameStats::EndFrame()
+    {
+        Clock::time_point now = Clock::now();
+
+        Current.FrameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - FrameStart).count();
+        History[FrameCount % History.size()] = Current;
+        ++FrameCount;
+        ++FramesSinceSummary;
+
+        if (IsHitch(Current))
+        {
+            ++TotalHitchCount;
+            NYX_LOG_EVERY_MS(Core, ::nyxara::logging::Verbosity::Warn, 1000,
+                "Frame {} hitch: {:.2f} ms since the previous frame ({:.2f} ms idle), {:.2f} ms of work "
+                "(threshold {:.2f} ms)", FrameCount - 1, ToMilliseconds(Current.FrameInterval),
+                ToMilliseconds(Current.IdleTime), ToMilliseconds(Current.FrameTime),
+                std::chrono::duration<double, std::milli>(Options.HitchThreshold).count());
+        }
+
+        if (Options.SummaryInterval.count() > 0 && now - LastSummaryTime >= Options.SummaryInterval)
+        {
+            EmitSummary(now);
+        }
+    }
+
+    void FrameStats::BeginPhase(FramePhase phase) noexcept
+    {
+        PhaseStarts[static_cast<size_t>(phase)] = Clock::now();
+    }
+
+    void FrameStats::EndPhase(FramePhase phase) noexcept
+    {
+        size_t index = static_cast<size_t>(phase);
+        Current.PhaseTimes[index] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - PhaseStarts[index]).count();
+    }
+
+    void FrameStats::BeginIdle() noexcept
+    {
+        IdleStart = Clock::now();
+    }
+
+    void FrameStats::EndIdle() noexcept
+    {
+        PendingIdleTime += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - IdleStart).count();
+    }
+
+    bool FrameStats::IsHitch(const FrameRecord& record) const noexcept
+    {
+        // Waits the loop chose, such as throttling in the background, are not stutter.
+        const int64_t threshold = std::chrono::duration_cast<std::chrono::nanoseconds>(Options.HitchThreshold).count();
+        return std::max(record.FrameInterval - record.IdleTime, record.FrameTime) > threshold;
+    }
+
+    FrameStatsSummary FrameStats::GetSummary() const
+    {
+        return Summarize(static_cast<size_t>(std::min<uint64_t>(FrameCount, History.size())));
+    }
+
+    FrameStatsSummary FrameStats::Summarize(size_t count) const
+    {
+        FrameStatsSummary summary;
+        summary.FrameCount = count;
+
+        // The most recent frames, oldest first
+        auto forEachFrame = [&](auto&& callback)
+        {
+            for (uint64_t i = FrameCount - count; i < FrameCount; ++i)
+            {
+                callback(History[i % History.size()]);
+            }
+        };
+
+        SortScratch.clear();
+        forEachFrame([&](const FrameRecord& record)
+        {
+            SortScratch.push_back(record.FrameTime);
+            summary.HitchCount += IsHitch(record) ? 1 : 0;
+        });
+        summary.FrameTime = Distribute(SortScratch);
+
+        // The first frame has no previous one to measure from.
+        SortScratch.clear();
+        forEachFrame([&](const FrameRecord& record)
+        {
+            if (record.FrameInterval > 0)
+            {
+                SortScratch.push_back(record.FrameInterval);
+            }
+        });
+        summary.FrameInterval = Distribute(SortScratch);
+
+        for (size_t phase = 0; phase < FramePhaseCount; ++phase)
+        {
+            SortScratch.clear();
+            forEachFrame([&](const FrameRecord& record) { SortScratch.push_back(record.PhaseTimes[phase]); });
+            summary.PhaseTimes[phase] = Distribute(SortScratch);
+        }
+
+        return summary;
+    }
+
+    void FrameStats::EmitSummary(Clock::time_point now)
+    {
+        FrameStatsSummary summary = Summarize(static_cast<size_t>(std::min<uint64_t>(FramesSinceSummary, History.size())));
+        FramesSinceSummary = 0;
+        LastSummaryTime = now;
+
+        if (Options.bLogSummary)
+        {
+            const FrameTimeDistribution& interval = summary.FrameInterval;
+            const FrameTimeDistribution& frame = summary.FrameTime;
+
+            // Only mention the phases the loop actually times.
+            fmt::memory_buffer phases;
+            for (size_t i = 0; i < FramePhaseCount; ++i)
+            {
+                const FrameTimeDistribution& phase = summary.PhaseTimes[i];
+                if (phase.Max > 0.0)
+                {
+                    fmt::format_to(std::back_inserter(phases), "; {} avg {:.2f} p95 {:.2f} max {:.2f}",
+                        GetFramePhaseName(static_cast<FramePhase>(i)), phase.Average, phase.P95, phase.Max);
+                }
+            }
+
+            NYX_LOG_INFO(Core, "Frame stats over {} frames: interval avg {:.2f} ms ({:.1f} fps), p50 {:.2f}, "
+                "p95 {:.2f}, p99 {:.2f}, max {:.2f} ms; work avg {:.2f} p95 {:.2f} max {:.2f} ms; {} hitch(es){}",
+                summary.FrameCount, interval.Average, interval.Average > 0.0 ? 1000.0 / interval.Average : 0.0,
+                interval.P50, interval.P95, interval.P99, interval.Max, frame.Average, frame.P95, frame.Max,
+                summary.HitchCount, fmt::to_string(phases));
+        }
+
+        if (Csv.is_open())
+        {
+            const FrameTimeDistribution& frame = summary.FrameTime;
+
+            Csv << std::chrono::duration<double>(now - CreationTime).count() << ',' << summary.FrameCount << ','
+                << summary.HitchCount << ',' << frame.Average << ',' << frame.P50 << ',' << frame.P95 << ','
+                << frame.P99 << ',' << frame.Max;
+            for (const FrameTimeDistribution& phase : summary.PhaseTimes)
+            {
+                Csv << ',' << phase.Average << ',' << phase.P95 << ',' << phase.Max;
+            }
+
+            const FrameTimeDistribution& interval = summary.FrameInterval;
+            Csv << ',' << interval.Average << ',' << interval.P50 << ',' << interval.P95 << ',' << interval.P99 << ','
+                << interval.Max << '\n';
+            Csv.flush();
+        }
+    }
+} // namespace nyxara::frame
@@ -0,0 +1,504 @@
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "nyxara/core/jobs/job_system.h"
+#include "nyxara/core/logging/categories.h"
+#include "work_stealing_deque.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace nyxara::jobs
+{
+    /**
+     * @brief Deque and job slots of one participant of the job system.
+     */
+    struct WorkerState
+    {
+        explicit WorkerState(uint32_t index)
+            : Index(index),
+              Deque(JobSystem::MaxJobsPerThread),
+              Jobs(new JobSystem::Job[JobSystem::MaxJobsPerThread])
+        {}
+
+        const uint32_t Index;
+        WorkStealingDeque<JobSystem::Job> Deque;
+
+        // Ring of job slots; slots whose job is still in flight are skipped.
+        std::unique_ptr<JobSystem::Job[]> Jobs;
+        uint32_t NextJob = 0;
+
+        // Attachable slots only: taken by a thread between AttachThread() and DetachThread().
+        std::atomic<bool> bIsAttached{ false };
+    };
+
+    class JobSystemImpl
+    {
+    public:
+        static JobSystemImpl& GetInstance()
+        {
+            static JobSystemImpl instance;
+            return instance;
+        }
+
+        /**
+         * @brief Finds a job for @p self: its own newest job, then the shared queue, then other participants' oldest.
+         *
+         * @param self The calling participant, or null for external threads.
+         */
+        JobSystem::Job* FindJob(WorkerState* self) noexcept
+        {
+            if (self)
+            {
+                if (JobSystem::Job* job = self->Deque.Pop())
+                {
+                    return job;
+                }
+            }
+
+            if (ExternalJobCount.load(std::memory_order_acquire) > 0)
+            {
+                std::lock_guard lock(ExternalMutex);
+
+                if (!ExternalJobs.empty())
+                {
+                    JobSystem::Job* job = ExternalJobs.front();
+                    ExternalJobs.pop_front();
+                    ExternalJobCount.fetch_sub(1, std::memory_order_relaxed);
+                    return job;
+                }
+            }
+
+            const size_t count = Participants.size();
+            const size_t first = self ? self->Index + 1 : 0;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                WorkerState& victim = *Participants[(first + i) % count];
+
+                if (&victim == self)
+                {
+                    continue;
+                }
+
+                // A failed steal may only mean another thief won; retry while items remain.
+                while (!victim.Deque.IsEmpty())
+                {
+                    if (JobSystem::Job* job = victim.Deque.Steal())
+                    {
+                        return job;
+                    }
+                }
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * @brief Wakes one sleeping worker, if any, after a job was published.
+         */
+        void Wake() noexcept
+        {
+            WorkEpoch.fetch_add(1, std::memory_order_seq_cst);
+
+            if (SleepingCount.load(std::memory_order_seq_cst) > 0)
+            {
+                WorkEpoch.notify_one();
+            }
+        }
+
+        void WorkerMain(WorkerState& self, bool bPin);
+
+        // Index 0 is the thread that called Init(), then the workers, then the attachable slots;
+        // only resized while no worker runs.
+        std::vector<std::unique_ptr<WorkerState>> Participants;
+        std::vector<std::thread> Threads;
+        uint32_t WorkerCount = 0;
+
+        // Jobs submitted by threads outside the job system.
+        std::mutex ExternalMutex;
+        std::deque<JobSystem::Job*> ExternalJobs;
+        std::atomic<uint32_t> ExternalJobCount{ 0 };
+
+        // Bumped on every submission; idle workers sleep until it changes.
+        std::atomic<uint32_t> WorkEpoch{ 0 };
+        std::atomic<uint32_t> SleepingCount{ 0 };
+        std::atomic<bool> bIsStopping{ false };
+
+    private:
+        JobSystemImpl() = default;
+    };
+
+    namespace
+    {
+        constexpr int IdleSpinCount = 64;
+
+        thread_local WorkerState* CurrentWorker = nullptr;
+
+        void ConfigureWorkerThread(uint32_t index, bool bPin)
+        {
+            const uint32_t cores = std::max(1u, std::thread::hardware_concurrency());
+
+#if defined(_WIN32)
+            SetThreadDescription(GetCurrentThread(), L"Nyxara Worker");
+
+            if (bPin && SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << (index % std::min(cores, 64u))) == 0)
+            {
+                NYX_LOG_WARN(Core, "Failed to pin job worker {} to core {}", index, index % cores);
+            }
+#elif defined(__linux__)
+            char name[16];
+            std::snprintf(name, sizeof(name), "nyx-worker-%u", index);
+            pthread_setname_np(pthread_self(), name);
+
+            if (bPin)
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(index % cores, &set);
+
+                if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+                {
+                    NYX_LOG_WARN(Core, "Failed to pin job worker {} to core {}", index, index % cores);
+                }
+            }
+#else
+            (void)index;
+            (void)bPin;
+            (void)cores;
+#endif
+        }
+    } // namespace
+
+    void JobSystemImpl::WorkerMain(WorkerState& self, bool bPin)
+    {
+        CurrentWorker = &self;
+        ConfigureWorkerThread(self.Index, bPin);
+
+        NYX_LOG_DEBUG(Core, "Job worker {} started", self.Index);
+
+        for (;;)
+        {
+            if (JobSystem::Job* job = FindJob(&self))
+            {
+                JobSystem::ExecuteJob(*job);
+                continue;
+            }
+
+            // Jobs often come in bursts: look again for a while before paying for a sleep and a wake-up.
+            JobSystem::Job* job = nullptr;
+
+            for (int spin = 0; spin < IdleSpinCount && !job; ++spin)
+            {
+                std::this_thread::yield();
+                job = FindJob(&self);
+            }
+
+            if (job)
+            {
+                JobSystem::ExecuteJob(*job);
+                continue;
+            }
+
+            // Read the epoch before the last look, so a job published after it changes the epoch and cancels the wait.
+            const uint32_t epoch = WorkEpoch.load(std::memory_order_seq_cst);
+
+            if ((job = FindJob(&self)))
+            {
+                JobSystem::ExecuteJob(*job);
+                continue;
+            }
+
+            if (bIsStopping.load(std::memory_order_acquire))
+            {
+                break;
+            }
+
+            SleepingCount.fetch_add(1, std::memory_order_seq_cst);
+            WorkEpoch.wait(epoch, std::memory_order_seq_cst);
+            SleepingCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        NYX_LOG_DEBUG(Core, "Job worker {} stopped", self.Index);
+        CurrentWorker = nullptr;
+    }
+
+    void JobSystem::Init(const JobSystemOptions& options)
+    {
+        auto& impl = JobSystemImpl::GetInstance();
+
+        if (IsRunning())
+        {
+            throw std::runtime_error("Job system already running");
+        }
+
+        uint32_t workerCount = options.WorkerCount;
+
+        if (workerCount == 0)
+        {
+            workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+            workerCount = std::max(1u, workerCount);
+        }
+
+        impl.bIsStopping.store(false, std::memory_order_relaxed);
+        impl.WorkerCount = workerCount;
+
+        for (uint32_t i = 0; i <= workerCount + options.AttachableThreadCount; ++i)
+        {
+            impl.Participants.push_back(std::make_unique<WorkerState>(i));
+        }
+
+        CurrentWorker = impl.Participants[0].get();
+        bIsRunning.store(true, std::memory_order_release);
+
+        impl.Threads.reserve(workerCount);
+
+        for (uint32_t i = 1; i <= workerCount; ++i)
+        {
+            impl.Threads.emplace_back(&JobSystemImpl::WorkerMain, &impl, std::ref(*impl.Participants[i]), options.bPinWorkers);
+        }
+
+        NYX_LOG_INFO(Core, "Job system started with {} worker thread(s){}", workerCount,
+            options.bPinWorkers ? ", pinned to cores" : "");
+    }
+
+    void JobSystem::Shutdown()
+    {
+        auto& impl = JobSystemImpl::GetInstance();
+
+        if (!IsRunning())
+        {
+            return;
+        }
+
+        // From now on Run() executes inline; workers drain the deques before leaving.
+        bIsRunning.store(false, std::memory_order_release);
+        impl.bIsStopping.store(true, std::memory_order_release);
+        impl.WorkEpoch.fetch_add(1, std::memory_order_seq_cst);
+        impl.WorkEpoch.notify_all();
+
+        for (std::thread& thread : impl.Threads)
+        {
+            thread.join();
+        }
+
+        // Jobs of this thread's deque that no worker stole.
+        while (Job* job = impl.FindJob(CurrentWorker))
+        {
+            ExecuteJob(*job);
+        }
+
+        for (uint32_t i = impl.WorkerCount + 1; i < impl.Participants.size(); ++i)
+        {
+            if (impl.Participants[i]->bIsAttached.load(std::memory_order_acquire))
+            {
+                NYX_LOG_ERROR(Core, "Job system stopped while participant {} is still attached", i);
+            }
+        }
+
+        impl.Threads.clear();
+        impl.Participants.clear();
+        impl.WorkerCount = 0;
+        CurrentWorker = nullptr;
+
+        NYX_LOG_INFO(Core, "Job system stopped");
+    }
+
+    uint32_t JobSystem::GetWorkerCount() noexcept
+    {
+        return JobSystemImpl::GetInstance().WorkerCount;
+    }
+
+    uint32_t JobSystem::GetParticipantCount() noexcept
+    {
+        return static_cast<uint32_t>(JobSystemImpl::GetInstance().Participants.size());
+    }
+
+    uint32_t JobSystem::GetThreadIndex() noexcept
+    {
+        const WorkerState* worker = CurrentWorker;
+        return worker ? worker->Index : ExternalThreadIndex;
+    }
+
+    bool JobSystem::AttachThread()
+    {
+        auto& impl = JobSystemImpl::GetInstance();
+
+        if (CurrentWorker)
+        {
+            return true;
+        }
+
+        if (!IsRunning())
+        {
+            return false;
+        }
+
+        for (size_t i = impl.WorkerCount + 1; i < impl.Participants.size(); ++i)
+        {
+            WorkerState& slot = *impl.Participants[i];
+
+            if (!slot.bIsAttached.exchange(true, std::memory_order_acquire))
+            {
+                CurrentWorker = &slot;
+                NYX_LOG_DEBUG(Core, "Thread attached to the job system as participant {}", slot.Index);
+                return true;
+            }
+        }
+
+        NYX_LOG_WARN(Core, "No attachable job system slot left; the thread submits jobs through the shared queue");
+        return false;
+    }
+
+    void JobSystem::DetachThread()
+    {
+        auto& impl = JobSystemImpl::GetInstance();
+        WorkerState* self = CurrentWorker;
+
+        if (!self || self->Index <= impl.WorkerCount)
+        {
+            return;
+        }
+
+        // The next thread to take the slot becomes the deque's owner: leave it empty.
+        while (Job* job = self->Deque.Pop())
+        {
+            ExecuteJob(*job);
+        }
+
+        NYX_LOG_DEBUG(Core, "Thread detached from job system participant {}", self->Index);
+        CurrentWorker = nullptr;
+        self->bIsAttached.store(false, std::memory_order_release);
+    }
+
+    void JobSystem::Wait(const JobCounter& counter)
+    {
+        auto& impl = JobSystemImpl::GetInstance();
+        WorkerState* self = CurrentWorker;
+
+        while (!counter.IsDone())
+        {
+            if (Job* job = impl.FindJob(self))
+            {
+                ExecuteJob(*job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    JobSystem::Job& JobSystem::AllocateJob()
+    {
+        WorkerState* self = CurrentWorker;
+
+        if (!self)
+        {
+            Job* job = new Job;
+            job->bIsHeapAllocated = true;
+            return *job;
+        }
+
+        // Skip slots still in flight rather than waiting for them: the pending job may be
+        // running further up this very thread's stack, from a Wait() inside a job.
+        for (uint32_t attempt = 0; attempt < MaxJobsPerThread; ++attempt)
+        {
+            Job& job = self->Jobs[self->NextJob++ & (MaxJobsPerThread - 1)];
+
+            if (!job.bIsPending.load(std::memory_order_acquire))
+            {
+                return job;
+            }
+        }
+
+        NYX_LOG_EVERY_MS(Core, ::nyxara::logging::Verbosity::Warn, 5000,
+            "Job thread {} has more than {} jobs in flight; allocating jobs from the heap", self->Index, MaxJobsPerThread);
+
+        Job* job = new Job;
+        job->bIsHeapAllocated = true;
+        return *job;
+    }
+
+    void JobSystem::Submit(Job& job, JobCounter* counter)
+    {
+        auto& impl = JobSystemImpl::GetInstance();
+
+        job.Counter = counter;
+        job.CallDepth = logging::CallDepthManager::GetState();
+        job.bIsPending.store(true, std::memory_order_relaxed);
+
+        if (counter)
+        {
+            counter->Value.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (WorkerState* self = CurrentWorker)
+        {
+            // Only fails with more than MaxJobsPerThread jobs in flight.
+            if (!self->Deque.Push(&job))
+            {
+                ExecuteJob(job);
+                return;
+            }
+        }
+        else
+        {
+            std::lock_guard lock(impl.ExternalMutex);
+            impl.ExternalJobs.push_back(&job);
+            impl.ExternalJobCount.fetch_add(1, std::memory_order_release);
+        }
+
+        impl.Wake();
+    }
+
+    void JobSystem::ExecuteJob(Job& job) noexcept
+    {
+        logging::CallDepthManager::State previous = logging::CallDepthManager::ExchangeState(job.CallDepth);
+        job.Execute(job);
+        logging::CallDepthManager::ExchangeState(previous);
+
+        // The slot may be reused as soon as it is released: read everything needed first.
+        JobCounter* counter = job.Counter;
+
+        if (job.bIsHeapAllocated)
+        {
+            delete &job;
+        }
+        else
+        {
+            job.bIsPending.store(false, std::memory_order_release);
+        }
+
+        if (counter)
+        {
+            counter->Value.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    uint32_t JobSystem::GetBatchSize(uint32_t count, uint32_t minBatchSize) noexcept
+    {
+        // A few batches per participant, so threads that finish early can steal the rest.
+        constexpr uint32_t BatchesPerThread = 4;
+
+        const uint32_t batchCount = (GetWorkerCount() + 1) * BatchesPerThread;
+        const uint32_t batchSize = (count + batchCount - 1) / batchCount;
+
+        return std::max({ batchSize, minBatchSize, 1u });
+    }
+} // namespace nyxara::jobs
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace nyxara::jobs
+{
+    /**
+     * @brief Fixed-capacity Chase-Lev work-stealing deque of pointers.
+     *
+     * The owner thread pushes and pops at the bottom; any thread steals from the top.
+     * Memory orderings follow Lê et al., "Correct and Efficient Work-Stealing for Weak
+     * Memory Models" (PPoPP 2013), with the push fence folded into a release store so
+     * the item's contents are published to thieves that acquire Bottom.
+     *
+     * @tparam T Pointee type.
+     */
+    template<typename T>
+    class WorkStealingDeque
+    {
+    public:
+        /**
+         * @param capacity Maximum number of items, a power of two.
+         */
+        explicit WorkStealingDeque(size_t capacity)
+            : Items(new std::atomic<T*>[capacity]),
+              Mask(static_cast<int64_t>(capacity) - 1)
+        {}
+
+        /**
+         * @brief Adds an item at the bottom. Owner thread only.
+         *
+         * @return False if the deque is full.
+         */
+        bool Push(T* item) noexcept
+        {
+            const int64_t bottom = Bottom.load(std::memory_order_relaxed);
+            const int64_t top = Top.load(std::memory_order_acquire);
+
+            if (bottom - top > Mask)
+            {
+                return false;
+            }
+
+            Items[bottom & Mask].store(item, std::memory_order_relaxed);
+            Bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Removes the most recently pushed item. Owner thread only.
+         *
+         * @return The item, or null if the deque is empty or a thief took the last item.
+         */
+        T* Pop() noexcept
+        {
+            const int64_t bottom = Bottom.load(std::memory_order_relaxed) - 1;
+            Bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = Top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* item = Items[bottom & Mask].load(std::memory_order_relaxed);
+
+            // Last item: race the thieves for it.
+            if (top == bottom)
+            {
+                if (!Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+
+                Bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return item;
+        }
+
+        /**
+         * @brief Removes the oldest item. Any thread.
+         *
+         * @return The item, or null if the deque is empty or another thread won the race.
+         */
+        T* Steal() noexcept
+        {
+            int64_t top = Top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = Bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+            {
+                return nullptr;
+            }
+
+            T* item = Items[top & Mask].load(std::memory_order_relaxed);
+
+            if (!Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+
+            return item;
+        }
+
+        /**
+         * @brief Checks if the deque looks empty; only a hint when other threads are active.
+         */
+        bool IsEmpty() const noexcept
+        {
+            return Bottom.load(std::memory_order_relaxed) <= Top.load(std::memory_order_relaxed);
+        }
+
+    private:
+        // Top is written by thieves and Bottom by the owner: keep them on separate cache lines.
+        alignas(64) std::atomic<int64_t> Top{ 0 };
+        alignas(64) std::atomic<int64_t> Bottom{ 0 };
+        alignas(64) std::unique_ptr<std::atomic<T*>[]> Items;
+        const int64_t Mask;
+    };
+} // namespace nyxara::jobs
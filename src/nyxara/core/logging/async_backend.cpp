@@ -0,0 +1,395 @@
+#include <algorithm>
+#include "async_backend.h"
+#include "logger_impl.h"
+
+namespace nyxara::logging
+{
+    namespace
+    {
+        /**
+         * @brief The calling thread's queue; marked orphaned when the thread exits.
+         */
+        struct ProducerSlot
+        {
+            std::shared_ptr<SpscByteRing> Ring;
+            uint64_t Generation = 0;
+
+            ~ProducerSlot()
+            {
+                if (Ring)
+                {
+                    Ring->bIsOrphaned.store(true, std::memory_order_release);
+                }
+            }
+        };
+
+        thread_local ProducerSlot ThreadSlot;
+    } // namespace
+
+    AsyncBackend::AsyncBackend(const CategoryLoggerArray& categoryLoggers, BinaryLogWriter& binaryLog)
+        : CategoryLoggers(categoryLoggers),
+          BinaryLog(binaryLog)
+    {}
+
+    AsyncBackend::~AsyncBackend()
+    {
+        Stop();
+    }
+
+    void AsyncBackend::Start(const AsyncOptions& options)
+    {
+        std::lock_guard lifecycleLock(LifecycleMutex);
+
+        if (IsRunning())
+        {
+            return;
+        }
+
+        QueueCapacity.store(options.QueueCapacity, std::memory_order_relaxed);
+        Overflow.store(options.Overflow, std::memory_order_relaxed);
+        MaxIdleWait = options.MaxIdleWait;
+        MaxArgsSize.store(SpscByteRing::GetMaxRecordSize(options.QueueCapacity) - sizeof(RecordHeader),
+            std::memory_order_relaxed);
+
+        // Rings of the previous run stay registered: they may hold records committed after Stop(), which the
+        // new worker drains. Their producers move to rings of the new capacity, and the old ones are dropped
+        // once orphaned and empty.
+
+        {
+            std::lock_guard wakeLock(WakeMutex);
+            bStopRequested.store(false, std::memory_order_relaxed);
+            bWorkerExited = false;
+        }
+
+        Generation.fetch_add(1, std::memory_order_release);
+        bIsRunning.store(true, std::memory_order_release);
+        Worker = std::thread(&AsyncBackend::Run, this);
+    }
+
+    void AsyncBackend::Stop()
+    {
+        std::lock_guard lifecycleLock(LifecycleMutex);
+
+        if (!IsRunning())
+        {
+            return;
+        }
+
+        bIsRunning.store(false, std::memory_order_release);
+
+        {
+            std::lock_guard wakeLock(WakeMutex);
+            bStopRequested.store(true, std::memory_order_release);
+        }
+        WakeCondition.notify_all();
+
+        Worker.join();
+    }
+
+    void AsyncBackend::Flush()
+    {
+        if (!IsRunning())
+        {
+            FlushSinks();
+            return;
+        }
+
+        uint64_t ticket = FlushRequested.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+        std::unique_lock wakeLock(WakeMutex);
+        WakeCondition.notify_all();
+        FlushCondition.wait(wakeLock, [&]() { return FlushCompleted >= ticket || bWorkerExited; });
+    }
+
+    std::byte* AsyncBackend::Reserve(const Category& category, const CallSite* site, Verbosity level,
+        std::string_view format, uint16_t flags, uint32_t argCount, size_t argsSize) noexcept
+    {
+        SpscByteRing* ring = AcquireThreadRing();
+
+        if (!ring)
+        {
+            return nullptr;
+        }
+
+        size_t size = sizeof(RecordHeader) + argsSize;
+
+        if (size > ring->GetMaxRecordSize())
+        {
+            return nullptr;
+        }
+
+        std::byte* dst = ring->Reserve(size);
+
+        if (!dst)
+        {
+            switch (Overflow.load(std::memory_order_relaxed))
+            {
+            case OverflowPolicy::Block:
+                while (!(dst = ring->Reserve(size)))
+                {
+                    if (!IsRunning())
+                    {
+                        return nullptr;
+                    }
+                    std::this_thread::yield();
+                }
+                break;
+            case OverflowPolicy::DropAndCount:
+                ring->DroppedCount.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            case OverflowPolicy::Drop:
+            default:
+                return nullptr;
+            }
+        }
+
+        RecordHeader header = RecordCodec::MakeHeader(category.GetId(), site, level, format, flags, argCount, argsSize);
+        std::memcpy(dst, &header, sizeof(header));
+        return dst + sizeof(header);
+    }
+
+    void AsyncBackend::Commit() noexcept
+    {
+        ThreadSlot.Ring->Commit();
+    }
+
+    size_t AsyncBackend::GetMaxArgsSize() const noexcept
+    {
+        return MaxArgsSize.load(std::memory_order_relaxed);
+    }
+
+    SpscByteRing* AsyncBackend::AcquireThreadRing() noexcept
+    {
+        uint64_t generation = Generation.load(std::memory_order_acquire);
+
+        if (ThreadSlot.Ring && ThreadSlot.Generation == generation)
+        {
+            return ThreadSlot.Ring.get();
+        }
+
+        try
+        {
+            auto ring = std::make_shared<SpscByteRing>(QueueCapacity.load(std::memory_order_relaxed));
+
+            {
+                std::lock_guard ringsLock(RingsMutex);
+                Rings.push_back(ring);
+            }
+            RingsVersion.fetch_add(1, std::memory_order_release);
+
+            if (ThreadSlot.Ring)
+            {
+                ThreadSlot.Ring->bIsOrphaned.store(true, std::memory_order_release);
+            }
+
+            ThreadSlot.Ring = std::move(ring);
+            ThreadSlot.Generation = generation;
+            return ThreadSlot.Ring.get();
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    void AsyncBackend::Run()
+    {
+        const auto minIdleWait = std::chrono::microseconds(10);
+        auto idleWait = minIdleWait;
+
+        for (;;)
+        {
+            bool bIsStopping = bStopRequested.load(std::memory_order_acquire);
+            uint64_t flushTicket = FlushRequested.load(std::memory_order_acquire);
+
+            size_t processed = 0;
+            bool bHasFlushed = false;
+
+            if (flushTicket != FlushCompleted || bIsStopping)
+            {
+                DrainFully();
+                FlushSinks();
+
+                std::lock_guard wakeLock(WakeMutex);
+                FlushCompleted = bIsStopping ? FlushRequested.load(std::memory_order_acquire) : flushTicket;
+                bWorkerExited = bIsStopping;
+                bHasFlushed = true;
+            }
+            else
+            {
+                Drain(DrainBatchSize, processed);
+            }
+
+            if (bHasFlushed)
+            {
+                FlushCondition.notify_all();
+            }
+
+            if (bIsStopping)
+            {
+                return;
+            }
+
+            if (processed > 0)
+            {
+                idleWait = minIdleWait;
+                continue;
+            }
+
+            std::unique_lock wakeLock(WakeMutex);
+            WakeCondition.wait_for(wakeLock, idleWait, [&]()
+            {
+                return bStopRequested.load(std::memory_order_acquire)
+                    || FlushRequested.load(std::memory_order_acquire) != FlushCompleted;
+            });
+            idleWait = std::min(idleWait * 2, std::max(MaxIdleWait, minIdleWait));
+        }
+    }
+
+    bool AsyncBackend::Drain(size_t maxRecords, size_t& processed)
+    {
+        bool bIsEmpty = false;
+
+        while (processed < maxRecords)
+        {
+            // Pick up threads that started logging since the last record.
+            RefreshRings();
+
+            SpscByteRing* oldestRing = nullptr;
+            const RecordHeader* oldest = nullptr;
+
+            // Merge the per-thread queues by timestamp so output stays chronological.
+            for (auto& ring : WorkerRings)
+            {
+                const std::byte* data = ring->Peek();
+
+                if (!data)
+                {
+                    continue;
+                }
+
+                auto header = reinterpret_cast<const RecordHeader*>(data);
+
+                if (!oldest || header->Timestamp < oldest->Timestamp)
+                {
+                    oldest = header;
+                    oldestRing = ring.get();
+                }
+            }
+
+            if (!oldest)
+            {
+                bIsEmpty = true;
+                break;
+            }
+
+            Process(*oldest);
+            oldestRing->Pop();
+            ++processed;
+        }
+
+        bool bHasOrphans = false;
+
+        for (auto& ring : WorkerRings)
+        {
+            ReportDrops(*ring);
+            bHasOrphans |= ring->bIsOrphaned.load(std::memory_order_acquire) && ring->IsEmpty();
+        }
+
+        if (bHasOrphans)
+        {
+            {
+                std::lock_guard ringsLock(RingsMutex);
+                std::erase_if(Rings, [](const std::shared_ptr<SpscByteRing>& ring)
+                {
+                    return ring->bIsOrphaned.load(std::memory_order_acquire) && ring->IsEmpty();
+                });
+            }
+            RingsVersion.fetch_add(1, std::memory_order_release);
+        }
+
+        return bIsEmpty;
+    }
+
+    void AsyncBackend::DrainFully()
+    {
+        size_t processed = 0;
+
+        while (!Drain(DrainBatchSize, processed))
+        {
+            processed = 0;
+        }
+    }
+
+    void AsyncBackend::Process(const RecordHeader& header)
+    {
+        if (Logger::IsBinaryLogEnabled())
+        {
+            BinaryLog.Write(header, reinterpret_cast<const std::byte*>(&header) + sizeof(RecordHeader));
+        }
+
+        const std::shared_ptr<spdlog::logger>& logger = CategoryLoggers[header.CategoryId];
+
+        if (!logger || !Logger::IsConsoleEnabled(static_cast<Verbosity>(header.Level)))
+        {
+            return;
+        }
+
+        FormatBuffer.clear();
+        RecordCodec::FormatRecord(header, FormatBuffer);
+
+        auto time = spdlog::log_clock::time_point(std::chrono::duration_cast<spdlog::log_clock::duration>(
+            std::chrono::nanoseconds(header.Timestamp)));
+
+        logger->log(time, spdlog::source_loc{}, to_spdlog_level(static_cast<Verbosity>(header.Level)),
+            spdlog::string_view_t(FormatBuffer.data(), FormatBuffer.size()));
+    }
+
+    void AsyncBackend::ReportDrops(SpscByteRing& ring)
+    {
+        uint64_t dropped = ring.DroppedCount.exchange(0, std::memory_order_relaxed);
+
+        if (dropped == 0)
+        {
+            return;
+        }
+
+        TotalDropped.fetch_add(dropped, std::memory_order_relaxed);
+        spdlog::default_logger_raw()->warn("Asynchronous logging dropped {} message(s): queue full", dropped);
+    }
+
+    void AsyncBackend::RefreshRings()
+    {
+        uint64_t version = RingsVersion.load(std::memory_order_acquire);
+
+        if (version == WorkerRingsVersion)
+        {
+            return;
+        }
+
+        std::lock_guard ringsLock(RingsMutex);
+        WorkerRings = Rings;
+        WorkerRingsVersion = version;
+    }
+
+    void AsyncBackend::FlushSinks()
+    {
+        spdlog::apply_all([](const std::shared_ptr<spdlog::logger>& logger) { logger->flush(); });
+    }
+
+    std::byte* AsyncQueue::Reserve(const Category& category, const CallSite* site, Verbosity level,
+        std::string_view format, uint16_t flags, uint32_t argCount, size_t argsSize) noexcept
+    {
+        return LoggerImpl::GetInstance().Async.Reserve(category, site, level, format, flags, argCount, argsSize);
+    }
+
+    void AsyncQueue::Commit() noexcept
+    {
+        LoggerImpl::GetInstance().Async.Commit();
+    }
+
+    size_t AsyncQueue::GetMaxArgsSize() noexcept
+    {
+        return LoggerImpl::GetInstance().Async.GetMaxArgsSize();
+    }
+} // namespace nyxara::logging
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "nyxara/core/logging/async.h"
+#include "nyxara/core/logging/logger.h"
+#include "nyxara/core/logging/record.h"
+#include "binary_log_writer.h"
+#include "spsc_byte_ring.h"
+
+namespace nyxara::logging
+{
+    /**
+     * @brief Owns the per-thread queues and the background thread of asynchronous logging.
+     *
+     * The instance is owned by LoggerImpl and lives for the whole program so that
+     * producers never observe a destroyed backend; Start() and Stop() only control
+     * the background thread.
+     */
+    class AsyncBackend
+    {
+    public:
+        using CategoryLoggerArray = std::array<std::shared_ptr<spdlog::logger>, Logger::MaxCategories>;
+
+        AsyncBackend(const CategoryLoggerArray& categoryLoggers, BinaryLogWriter& binaryLog);
+        ~AsyncBackend();
+
+        AsyncBackend(const AsyncBackend&) = delete;
+        AsyncBackend& operator=(const AsyncBackend&) = delete;
+
+        void Start(const AsyncOptions& options);
+        void Stop();
+        void Flush();
+
+        bool IsRunning() const noexcept { return bIsRunning.load(std::memory_order_acquire); }
+        uint64_t GetDroppedCount() const noexcept { return TotalDropped.load(std::memory_order_relaxed); }
+
+        std::byte* Reserve(const Category& category, const CallSite* site, Verbosity level,
+            std::string_view format, uint16_t flags, uint32_t argCount, size_t argsSize) noexcept;
+        void Commit() noexcept;
+        size_t GetMaxArgsSize() const noexcept;
+
+    private:
+        static constexpr size_t DrainBatchSize = 4096;
+
+        SpscByteRing* AcquireThreadRing() noexcept;
+        void Run();
+        bool Drain(size_t maxRecords, size_t& processed);
+        void DrainFully();
+        void Process(const RecordHeader& header);
+        void ReportDrops(SpscByteRing& ring);
+        void RefreshRings();
+        void FlushSinks();
+
+        const CategoryLoggerArray& CategoryLoggers;
+        BinaryLogWriter& BinaryLog;
+
+        // Options, published before Generation and bIsRunning as producers may still read them while Start()
+        // runs; the idle wait is only read by the worker.
+        std::atomic<size_t> QueueCapacity{ AsyncOptions{}.QueueCapacity };
+        std::atomic<OverflowPolicy> Overflow{ AsyncOptions{}.Overflow };
+        std::chrono::microseconds MaxIdleWait{ AsyncOptions{}.MaxIdleWait };
+        std::atomic<size_t> MaxArgsSize{ 0 };
+        std::atomic<bool> bIsRunning{ false };
+        std::atomic<bool> bStopRequested{ false };
+        std::atomic<uint64_t> Generation{ 0 };
+        std::atomic<uint64_t> TotalDropped{ 0 };
+        std::thread Worker;
+        std::mutex LifecycleMutex;
+
+        // Registered rings, guarded by RingsMutex; the worker keeps its own copy.
+        std::mutex RingsMutex;
+        std::vector<std::shared_ptr<SpscByteRing>> Rings;
+        std::atomic<uint64_t> RingsVersion{ 0 };
+        std::vector<std::shared_ptr<SpscByteRing>> WorkerRings;
+        uint64_t WorkerRingsVersion = ~uint64_t{ 0 };
+
+        // Flush handshake between producers and the worker.
+        std::mutex WakeMutex;
+        std::condition_variable WakeCondition;
+        std::condition_variable FlushCondition;
+        std::atomic<uint64_t> FlushRequested{ 0 };
+        uint64_t FlushCompleted = 0;
+        bool bWorkerExited = true;
+
+        spdlog::memory_buf_t FormatBuffer;
+    };
+} // namespace nyxara::logging
@@ -0,0 +1,180 @@
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "nyxara/core/logging/binary_log.h"
+#include "nyxara/core/logging/record.h"
+#include "logger_impl.h"
+
+namespace nyxara::logging
+{
+    std::byte* BinaryLogQueue::Reserve(const Category& category, const CallSite* site, Verbosity level,
+        std::string_view format, uint16_t flags, uint32_t argCount, size_t argsSize) noexcept
+    {
+        RecordHeader header = RecordCodec::MakeHeader(category.GetId(), site, level, format, flags, argCount, argsSize);
+        return LoggerImpl::GetInstance().Binary.Reserve(header);
+    }
+
+    void BinaryLogQueue::Commit() noexcept
+    {
+        LoggerImpl::GetInstance().Binary.Commit();
+    }
+
+    size_t BinaryLogQueue::GetMaxArgsSize() noexcept
+    {
+        return LoggerImpl::GetInstance().Binary.GetMaxArgsSize();
+    }
+
+    void BinaryLogEntry::FormatMessage(spdlog::memory_buf_t& out) const
+    {
+        if (Flags & RecordFlagCallDepth)
+        {
+            fmt::format_to(fmt::appender(out), "[depth: {}] ", CallDepth);
+        }
+
+        // Preformatted records hold the message text; the call site keeps the original format string.
+        std::string_view format = (Flags & RecordFlagPreformatted) ? RecordCodec::PreformattedFormat : Format;
+        RecordCodec::FormatArgs(format, Args, ArgsSize, ArgCount, out);
+    }
+
+    BinaryLogReader::BinaryLogReader(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+        if (!file)
+        {
+            throw std::runtime_error("Failed to open binary log file: " + path.string());
+        }
+
+        Data.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(Data.data()), static_cast<std::streamsize>(Data.size()));
+
+        if (!file || Data.size() < sizeof(BinaryFileHeader))
+        {
+            throw std::runtime_error("Failed to read binary log file: " + path.string());
+        }
+
+        std::memcpy(&Header, Data.data(), sizeof(Header));
+
+        if (std::memcmp(Header.Magic, BinaryFileHeader::ExpectedMagic, sizeof(Header.Magic)) != 0)
+        {
+            throw std::runtime_error("Not a Nyxara binary log file: " + path.string());
+        }
+
+        if (Header.Version != BinaryFileHeader::CurrentVersion)
+        {
+            throw std::runtime_error("Unsupported binary log version " + std::to_string(Header.Version)
+                + ": " + path.string());
+        }
+
+        Offset = Header.HeaderSize;
+    }
+
+    bool BinaryLogReader::Next(BinaryLogEntry& entry)
+    {
+        while (Offset + sizeof(BinaryChunkHeader) <= Data.size())
+        {
+            BinaryChunkHeader chunk;
+            std::memcpy(&chunk, Data.data() + Offset, sizeof(chunk));
+
+            // A zero size marks the end of the data; an oversized chunk means the file was cut short.
+            if (chunk.Size < sizeof(chunk) || chunk.Size > Data.size() - Offset)
+            {
+                return false;
+            }
+
+            const std::byte* payload = Data.data() + Offset + sizeof(chunk);
+            const size_t payloadSize = chunk.Size - sizeof(chunk);
+            Offset += chunk.Size;
+
+            switch (chunk.Type)
+            {
+            case BinaryChunkType::Category:
+            {
+                BinaryCategoryDefinition definition;
+                if (payloadSize >= sizeof(definition))
+                {
+                    std::memcpy(&definition, payload, sizeof(definition));
+                    if (definition.NameSize <= payloadSize - sizeof(definition))
+                    {
+                        Categories[definition.Id] = std::string_view(
+                            reinterpret_cast<const char*>(payload + sizeof(definition)), definition.NameSize);
+                    }
+                }
+                break;
+            }
+            case BinaryChunkType::CallSite:
+            {
+                BinaryCallSiteDefinition definition;
+                if (payloadSize >= sizeof(definition))
+                {
+                    std::memcpy(&definition, payload, sizeof(definition));
+                    uint64_t stringsSize = uint64_t{ definition.FormatSize } + definition.FileSize
+                        + definition.FunctionSize;
+                    if (stringsSize <= payloadSize - sizeof(definition))
+                    {
+                        const char* format = reinterpret_cast<const char*>(payload + sizeof(definition));
+                        const char* file = format + definition.FormatSize;
+                        const char* function = file + definition.FileSize;
+                        CallSites[definition.Id] = CallSiteInfo{
+                            std::string_view(format, definition.FormatSize),
+                            std::string_view(file, definition.FileSize),
+                            definition.Line,
+                            std::string_view(function, definition.FunctionSize) };
+                    }
+                }
+                break;
+            }
+            case BinaryChunkType::Record:
+            {
+                BinaryRecord record;
+                if (payloadSize < sizeof(record))
+                {
+                    break;
+                }
+
+                std::memcpy(&record, payload, sizeof(record));
+                if (record.ArgsSize > payloadSize - sizeof(record))
+                {
+                    break;
+                }
+
+                auto category = Categories.find(record.CategoryId);
+                auto callSite = CallSites.find(record.CallSiteId);
+
+                entry.Timestamp = record.Timestamp;
+                entry.ThreadId = record.ThreadId;
+                entry.CategoryId = record.CategoryId;
+                entry.CallSiteId = record.CallSiteId;
+                entry.Category = category != Categories.end() ? category->second : std::string_view("<unknown>");
+                if (callSite != CallSites.end())
+                {
+                    entry.Format = callSite->second.Format;
+                    entry.File = callSite->second.File;
+                    entry.Line = callSite->second.Line;
+                    entry.Function = callSite->second.Function;
+                }
+                else
+                {
+                    entry.Format = "<unknown call site>";
+                    entry.File = {};
+                    entry.Line = 0;
+                    entry.Function = {};
+                }
+                entry.Level = static_cast<Verbosity>(record.Level);
+                entry.CallDepth = record.CallDepth;
+                entry.Flags = record.Flags;
+                entry.ArgCount = record.ArgCount;
+                entry.Args = payload + sizeof(record);
+                entry.ArgsSize = record.ArgsSize;
+                return true;
+            }
+            default:
+                // Skip chunks written by newer versions.
+                break;
+            }
+        }
+
+        return false;
+    }
+} // namespace nyxara::logging
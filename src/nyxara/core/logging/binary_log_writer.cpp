@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include "binary_log_writer.h"
+
+namespace nyxara::logging
+{
+    namespace
+    {
+        constexpr uint64_t MinFileSize = 64 * 1024;
+        constexpr size_t MaxArgsSizeLimit = size_t{ 1 } << 30;
+
+        /**
+         * @brief Checks whether a file name belongs to the rotation sequence of a capture.
+         */
+        bool IsCaptureFile(const std::string& name, const std::string& stem, const std::string& extension)
+        {
+            if (name.size() <= stem.size() + 1 + extension.size()
+                || name.compare(0, stem.size(), stem) != 0
+                || name[stem.size()] != '.'
+                || name.compare(name.size() - extension.size(), extension.size(), extension) != 0)
+            {
+                return false;
+            }
+
+            const char* first = name.data() + stem.size() + 1;
+            const char* last = name.data() + name.size() - extension.size();
+            uint64_t index = 0;
+            auto [end, error] = std::from_chars(first, last, index);
+
+            return error == std::errc() && end == last;
+        }
+    } // namespace
+
+    BinaryLogWriter::BinaryLogWriter(const CategoryLoggerArray& categoryLoggers)
+        : CategoryLoggers(categoryLoggers)
+    {}
+
+    BinaryLogWriter::~BinaryLogWriter()
+    {
+        Close();
+    }
+
+    void BinaryLogWriter::Open(const BinaryLogOptions& options)
+    {
+        std::lock_guard lock(Mutex);
+
+        if (File.IsOpen())
+        {
+            return;
+        }
+
+        Options = options;
+        Options.FileSize = std::max(Options.FileSize, MinFileSize);
+        Options.MaxFiles = std::max(Options.MaxFiles, 1u);
+
+        // Start a fresh capture: files left over from a previous run would interleave with this one.
+        std::error_code error;
+        std::filesystem::path directory = Options.Path.parent_path();
+        std::string stem = Options.Path.stem().string();
+        std::string extension = Options.Path.extension().string();
+
+        if (!directory.empty())
+        {
+            std::filesystem::create_directories(directory, error);
+        }
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory.empty() ? "." : directory, error))
+        {
+            if (entry.is_regular_file(error) && IsCaptureFile(entry.path().filename().string(), stem, extension))
+            {
+                std::filesystem::remove(entry.path(), error);
+            }
+        }
+
+        CategoryDefinedIn.fill(0);
+        CallSiteDefinedIn.clear();
+
+        if (!OpenFile(0))
+        {
+            throw std::runtime_error("Failed to create binary log file: " + GetFilePath(0).string());
+        }
+
+        MaxArgsSize.store(std::min<size_t>(Options.FileSize / 4, MaxArgsSizeLimit), std::memory_order_relaxed);
+    }
+
+    void BinaryLogWriter::Close()
+    {
+        std::lock_guard lock(Mutex);
+        CloseFile();
+    }
+
+    void BinaryLogWriter::Flush()
+    {
+        std::lock_guard lock(Mutex);
+        File.Flush(true);
+    }
+
+    std::byte* BinaryLogWriter::Reserve(const RecordHeader& header) noexcept
+    {
+        Mutex.lock();
+
+        std::byte* dst = ReserveLocked(header);
+
+        if (!dst)
+        {
+            Mutex.unlock();
+        }
+
+        return dst;
+    }
+
+    void BinaryLogWriter::Commit() noexcept
+    {
+        EndChunk();
+        Mutex.unlock();
+    }
+
+    void BinaryLogWriter::Write(const RecordHeader& header, const std::byte* args) noexcept
+    {
+        std::lock_guard lock(Mutex);
+
+        std::byte* dst = ReserveLocked(header);
+
+        if (dst)
+        {
+            std::memcpy(dst, args, header.ArgsSize);
+            EndChunk();
+        }
+    }
+
+    std::byte* BinaryLogWriter::ReserveLocked(const RecordHeader& header) noexcept
+    {
+        if (!File.IsOpen() || header.ArgsSize > GetMaxArgsSize())
+        {
+            return nullptr;
+        }
+
+        uint64_t callSiteId;
+        uint64_t* callSiteDefinedIn;
+
+        try
+        {
+            callSiteId = GetCallSiteId(header);
+            callSiteDefinedIn = &CallSiteDefinedIn[callSiteId];
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+
+        const CallSite* site = header.Site;
+        std::string_view format = site ? std::string_view(site->GetFormat())
+            : std::string_view(header.Format, header.FormatSize);
+        std::string_view file = site ? std::string_view(site->GetFile()) : std::string_view();
+        std::string_view function = site ? std::string_view(site->GetFunction()) : std::string_view();
+
+        const std::shared_ptr<spdlog::logger>& logger = CategoryLoggers[header.CategoryId];
+        std::string_view categoryName = logger ? std::string_view(logger->name()) : std::string_view();
+
+        const uint32_t categorySize = AlignChunk(sizeof(BinaryChunkHeader) + sizeof(BinaryCategoryDefinition)
+            + categoryName.size());
+        const uint32_t callSiteSize = AlignChunk(sizeof(BinaryChunkHeader) + sizeof(BinaryCallSiteDefinition)
+            + format.size() + file.size() + function.size());
+        const uint32_t recordSize = AlignChunk(sizeof(BinaryChunkHeader) + sizeof(BinaryRecord) + header.ArgsSize);
+
+        auto requiredSize = [&]()
+        {
+            uint64_t size = recordSize;
+            size += CategoryDefinedIn[header.CategoryId] != FileIndex + 1 ? categorySize : 0;
+            size += *callSiteDefinedIn != FileIndex + 1 ? callSiteSize : 0;
+            return size;
+        };
+
+        if (Offset + requiredSize() > File.GetSize())
+        {
+            CloseFile();
+
+            if (!OpenFile(FileIndex + 1) || Offset + requiredSize() > File.GetSize())
+            {
+                return nullptr;
+            }
+        }
+
+        // Every file carries the definitions it uses so it can be decoded on its own.
+        if (CategoryDefinedIn[header.CategoryId] != FileIndex + 1)
+        {
+            BinaryCategoryDefinition definition{ header.CategoryId, static_cast<uint32_t>(categoryName.size()) };
+            std::byte* dst = BeginChunk(BinaryChunkType::Category, categorySize);
+            std::memcpy(dst, &definition, sizeof(definition));
+            std::memcpy(dst + sizeof(definition), categoryName.data(), categoryName.size());
+            EndChunk();
+
+            CategoryDefinedIn[header.CategoryId] = FileIndex + 1;
+        }
+
+        if (*callSiteDefinedIn != FileIndex + 1)
+        {
+            BinaryCallSiteDefinition definition{};
+            definition.Id = callSiteId;
+            definition.Line = site ? site->GetLine() : 0;
+            definition.FormatSize = static_cast<uint32_t>(format.size());
+            definition.FileSize = static_cast<uint32_t>(file.size());
+            definition.FunctionSize = static_cast<uint32_t>(function.size());
+
+            std::byte* dst = BeginChunk(BinaryChunkType::CallSite, callSiteSize);
+            std::memcpy(dst, &definition, sizeof(definition));
+            dst += sizeof(definition);
+            std::memcpy(dst, format.data(), format.size());
+            std::memcpy(dst + format.size(), file.data(), file.size());
+            std::memcpy(dst + format.size() + file.size(), function.data(), function.size());
+            EndChunk();
+
+            *callSiteDefinedIn = FileIndex + 1;
+        }
+
+        BinaryRecord record{};
+        record.Timestamp = header.Timestamp;
+        record.ThreadId = header.ThreadId;
+        record.CategoryId = header.CategoryId;
+        record.CallSiteId = callSiteId;
+        record.CallDepth = header.CallDepth;
+        record.ArgsSize = header.ArgsSize;
+        record.Level = header.Level;
+        record.ArgCount = header.ArgCount;
+        record.Flags = header.Flags;
+
+        std::byte* dst = BeginChunk(BinaryChunkType::Record, recordSize);
+        std::memcpy(dst, &record, sizeof(record));
+        return dst + sizeof(record);
+    }
+
+    bool BinaryLogWriter::OpenFile(uint64_t index) noexcept
+    {
+        try
+        {
+            if (!File.Open(GetFilePath(index), Options.FileSize))
+            {
+                return false;
+            }
+
+            BinaryFileHeader header{};
+            std::memcpy(header.Magic, BinaryFileHeader::ExpectedMagic, sizeof(header.Magic));
+            header.Version = BinaryFileHeader::CurrentVersion;
+            header.HeaderSize = AlignChunk(sizeof(header));
+            header.CreatedAt = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                spdlog::log_clock::now().time_since_epoch()).count();
+            header.FileIndex = index;
+
+            std::memcpy(File.GetData(), &header, sizeof(header));
+            FileIndex = index;
+            Offset = header.HeaderSize;
+
+            // Keep only the most recent files of the capture.
+            if (index >= Options.MaxFiles)
+            {
+                std::error_code error;
+                std::filesystem::remove(GetFilePath(index - Options.MaxFiles), error);
+            }
+
+            return true;
+        }
+        catch (...)
+        {
+            File.Close(0);
+            return false;
+        }
+    }
+
+    void BinaryLogWriter::CloseFile() noexcept
+    {
+        File.Close(Offset);
+        Offset = 0;
+    }
+
+    uint64_t BinaryLogWriter::GetCallSiteId(const RecordHeader& header)
+    {
+        if (header.Site)
+        {
+            return header.Site->GetId();
+        }
+
+        auto it = AnonymousCallSiteIds.find(header.Format);
+
+        if (it != AnonymousCallSiteIds.end())
+        {
+            return it->second;
+        }
+
+        // The high bit keeps these apart from the hashed identifiers of CallSite descriptors.
+        uint64_t id = (uint64_t{ 1 } << 63) | AnonymousCallSiteIds.size();
+        AnonymousCallSiteIds.emplace(header.Format, id);
+
+        return id;
+    }
+
+    std::byte* BinaryLogWriter::BeginChunk(BinaryChunkType type, uint32_t size) noexcept
+    {
+        PendingChunk = File.GetData() + Offset;
+        PendingHeader = BinaryChunkHeader{ size, type, 0 };
+        Offset += size;
+
+        return PendingChunk + sizeof(BinaryChunkHeader);
+    }
+
+    void BinaryLogWriter::EndChunk() noexcept
+    {
+        // The size is written last: a reader never sees a chunk whose payload is incomplete.
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(PendingChunk, &PendingHeader, sizeof(PendingHeader));
+    }
+
+    std::filesystem::path BinaryLogWriter::GetFilePath(uint64_t index) const
+    {
+        return Options.Path.parent_path() / fmt::format("{}.{:06}{}",
+            Options.Path.stem().string(), index, Options.Path.extension().string());
+    }
+} // namespace nyxara::logging
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "nyxara/core/logging/binary_log.h"
+#include "nyxara/core/logging/logger.h"
+#include "nyxara/core/logging/record.h"
+#include "mapped_file.h"
+
+namespace nyxara::logging
+{
+    /**
+     * @brief Appends records to rotating memory-mapped binary log files.
+     *
+     * Owned by LoggerImpl. Writers are serialized by a mutex: synchronous log calls
+     * hold it between Reserve() and Commit(), while the asynchronous backend writes
+     * whole records with Write() from its background thread.
+     */
+    class BinaryLogWriter
+    {
+    public:
+        using CategoryLoggerArray = std::array<std::shared_ptr<spdlog::logger>, Logger::MaxCategories>;
+
+        explicit BinaryLogWriter(const CategoryLoggerArray& categoryLoggers);
+        ~BinaryLogWriter();
+
+        BinaryLogWriter(const BinaryLogWriter&) = delete;
+        BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+        /**
+         * @throws std::runtime_error If the first file cannot be created.
+         */
+        void Open(const BinaryLogOptions& options);
+        void Close();
+        void Flush();
+
+        std::byte* Reserve(const RecordHeader& header) noexcept;
+        void Commit() noexcept;
+        void Write(const RecordHeader& header, const std::byte* args) noexcept;
+
+        size_t GetMaxArgsSize() const noexcept { return MaxArgsSize.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr uint32_t ChunkAlignment = 8;
+
+        static constexpr uint32_t AlignChunk(size_t size) noexcept
+        {
+            return static_cast<uint32_t>((size + ChunkAlignment - 1) & ~size_t{ ChunkAlignment - 1 });
+        }
+
+        std::byte* ReserveLocked(const RecordHeader& header) noexcept;
+        bool OpenFile(uint64_t index) noexcept;
+        void CloseFile() noexcept;
+        uint64_t GetCallSiteId(const RecordHeader& header);
+        std::byte* BeginChunk(BinaryChunkType type, uint32_t size) noexcept;
+        void EndChunk() noexcept;
+        std::filesystem::path GetFilePath(uint64_t index) const;
+
+        const CategoryLoggerArray& CategoryLoggers;
+        BinaryLogOptions Options;
+        std::atomic<size_t> MaxArgsSize{ 0 };
+
+        std::mutex Mutex;
+        MappedFile File;
+        uint64_t FileIndex = 0;
+        uint64_t Offset = 0;
+
+        // Chunk being written, published by EndChunk().
+        std::byte* PendingChunk = nullptr;
+        BinaryChunkHeader PendingHeader{};
+
+        // Messages logged without a CallSite are keyed by their format string, which has static storage duration.
+        std::unordered_map<const char*, uint64_t> AnonymousCallSiteIds;
+
+        // One past the index of the last file each definition was written to; 0 if never.
+        std::array<uint64_t, Logger::MaxCategories> CategoryDefinedIn{};
+        std::unordered_map<uint64_t, uint64_t> CallSiteDefinedIn;
+    };
+} // namespace nyxara::logging
@@ -0,0 +1,185 @@
+#include <mutex>
+#include <vector>
+#include "nyxara/core/logging/call_site.h"
+
+namespace nyxara::logging
+{
+    namespace
+    {
+        bool Matches(const CallSiteRule& rule, const CallSite& site) noexcept
+        {
+            return (rule.Line == 0 || rule.Line == site.GetLine())
+                && CallSiteRegistry::MatchesGlob(rule.File, site.GetFile())
+                && CallSiteRegistry::MatchesGlob(rule.Function, site.GetFunction());
+        }
+
+        class CallSiteRegistryImpl
+        {
+        public:
+            static CallSiteRegistryImpl& GetInstance()
+            {
+                static CallSiteRegistryImpl instance;
+                return instance;
+            }
+
+            /**
+             * @brief Computes the override of a site from the rules, the last matching rule winning.
+             */
+            CallSiteOverride Evaluate(const CallSite& site) const noexcept
+            {
+                CallSiteOverride value = CallSiteOverride::Default;
+
+                for (const CallSiteRule& rule : Rules)
+                {
+                    if (Matches(rule, site))
+                    {
+                        value = rule.Override;
+                    }
+                }
+
+                return value;
+            }
+
+            std::mutex Mutex;
+            std::vector<CallSiteRule> Rules;
+
+            // Intrusive list of registered sites, linked through CallSite::Next in registration order.
+            CallSite* Head = nullptr;
+            CallSite* Tail = nullptr;
+
+        private:
+            CallSiteRegistryImpl() = default;
+        };
+    } // namespace
+
+    void CallSiteRegistry::Register(CallSite& site, const Category& category) noexcept
+    {
+        auto& impl = CallSiteRegistryImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+
+        // Another thread may have registered the site while this one waited for the lock.
+        if (site.State.load(std::memory_order_relaxed) != CallSite::StateUnregistered)
+        {
+            return;
+        }
+
+        site.LogCategory = &category;
+
+        if (impl.Tail)
+        {
+            impl.Tail->Next = &site;
+        }
+        else
+        {
+            impl.Head = &site;
+        }
+        impl.Tail = &site;
+
+        site.State.store(CallSite::ToState(impl.Evaluate(site)), std::memory_order_relaxed);
+    }
+
+    void CallSiteRegistry::ForEach(const std::function<void(const CallSite&)>& callback)
+    {
+        auto& impl = CallSiteRegistryImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+
+        for (const CallSite* site = impl.Head; site; site = site->Next)
+        {
+            callback(*site);
+        }
+    }
+
+    bool CallSiteRegistry::SetOverride(uint64_t id, CallSiteOverride value)
+    {
+        auto& impl = CallSiteRegistryImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+
+        bool bIsFound = false;
+
+        // Identifiers may collide between unrelated statements; update every match.
+        for (CallSite* site = impl.Head; site; site = site->Next)
+        {
+            if (site->Id == id)
+            {
+                site->State.store(CallSite::ToState(value), std::memory_order_relaxed);
+                bIsFound = true;
+            }
+        }
+
+        return bIsFound;
+    }
+
+    void CallSiteRegistry::AddRule(const CallSiteRule& rule)
+    {
+        auto& impl = CallSiteRegistryImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+
+        impl.Rules.push_back(rule);
+
+        // Only touch matching sites so overrides set by identifier elsewhere are kept.
+        for (CallSite* site = impl.Head; site; site = site->Next)
+        {
+            if (Matches(rule, *site))
+            {
+                site->State.store(CallSite::ToState(rule.Override), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void CallSiteRegistry::ClearRules()
+    {
+        auto& impl = CallSiteRegistryImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+
+        impl.Rules.clear();
+
+        for (CallSite* site = impl.Head; site; site = site->Next)
+        {
+            site->State.store(CallSite::StateDefault, std::memory_order_relaxed);
+        }
+    }
+
+    bool CallSiteRegistry::MatchesGlob(std::string_view pattern, std::string_view text) noexcept
+    {
+        // Iterative matcher: on mismatch, let the last '*' absorb one more character.
+        size_t p = 0;
+        size_t t = 0;
+        size_t starPattern = std::string_view::npos;
+        size_t starText = 0;
+
+        while (t < text.size())
+        {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t]))
+            {
+                ++p;
+                ++t;
+            }
+            else if (p < pattern.size() && pattern[p] == '*')
+            {
+                starPattern = p++;
+                starText = t;
+            }
+            else if (starPattern != std::string_view::npos)
+            {
+                p = starPattern + 1;
+                t = ++starText;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        while (p < pattern.size() && pattern[p] == '*')
+        {
+            ++p;
+        }
+
+        return p == pattern.size();
+    }
+} // namespace nyxara::logging
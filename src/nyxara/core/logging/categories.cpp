@@ -2,3 +2,4 @@
 
 NYX_DEFINE_LOG_CATEGORY(Core);
 NYX_DEFINE_LOG_CATEGORY(Platform);
+NYX_DEFINE_LOG_CATEGORY(Renderer);
@@ -3,11 +3,10 @@
 
 namespace nyxara::logging 
 {
-    Category::Category(const std::string& name)
-        : Name(name), Logger(Logger::GetOrCreateLogger(Name))
-    {}
-
-    Category::Category(std::string&& name)
-        : Name(std::move(name)), Logger(Logger::GetOrCreateLogger(Name))
+    Category::Category(std::string_view name)
+        : Id(Logger::RegisterCategory(name)),
+          Name(Logger::GetCategoryName(Id)),
+          LevelSlot(&Logger::GetLevelSlot(Id)),
+          Logger(Logger::GetOrCreateLogger(std::string(Name)))
     {}
 } // namespace nyxara::logging
\ No newline at end of file
@@ -0,0 +1,1040 @@
+#include <algorithm>
+#include <array>
+#include <csignal>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include "nyxara/core/logging/flight_recorder.h"
+#include "nyxara/core/logging/record.h"
+#include "logger_impl.h"
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+namespace nyxara::logging
+{
+    namespace
+    {
+        constexpr size_t SlotSize = 256;
+        constexpr size_t SlotArgsCapacity = SlotSize - sizeof(std::atomic<uint64_t>) - sizeof(RecordHeader);
+
+        /**
+         * @brief One recorded message, guarded by a sequence number.
+         *
+         * The owning thread makes Sequence odd while it writes the slot and even once done;
+         * readers discard copies during which the sequence changed.
+         */
+        struct FlightRecorderSlot
+        {
+            std::atomic<uint64_t> Sequence{ 0 };
+            RecordHeader Header{};
+            std::byte Args[SlotArgsCapacity];
+        };
+
+        static_assert(sizeof(FlightRecorderSlot) == SlotSize);
+
+        /**
+         * @brief Fixed-size ring of one thread, overwriting its oldest messages.
+         */
+        struct FlightRecorderRing
+        {
+            explicit FlightRecorderRing(size_t capacity)
+                : Slots(new FlightRecorderSlot[capacity]), Capacity(capacity)
+            {}
+
+            std::unique_ptr<FlightRecorderSlot[]> Slots;
+            const size_t Capacity;
+            std::atomic<uint64_t> WriteCount{ 0 };  ///< Number of messages committed.
+            std::atomic<bool> bIsInUse{ true };     ///< Cleared when the owning thread exits.
+        };
+
+        /**
+         * @brief A consistent copy of a slot taken for a dump.
+         */
+        struct DumpEntry
+        {
+            RecordHeader Header;
+            std::byte Args[SlotArgsCapacity];
+        };
+
+        constexpr size_t CategoryNameCapacity = 64;
+
+        enum CategoryNameState : uint8_t
+        {
+            CategoryNameEmpty,
+            CategoryNameWriting,
+            CategoryNameReady,
+        };
+
+        /**
+         * @brief Copy of a category name for dumps, which cannot reach the logger's strings from a signal handler.
+         *
+         * Filled by the first message of the category the recorder records; longer names are truncated.
+         */
+        struct CategoryNameSlot
+        {
+            std::atomic<uint8_t> State{ CategoryNameEmpty };
+            uint8_t Size = 0;
+            char Name[CategoryNameCapacity];
+        };
+
+        constexpr int FatalSignals[] = {
+            SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+#if defined(SIGBUS)
+            SIGBUS,
+#endif
+        };
+
+        constexpr size_t FatalSignalCount = std::size(FatalSignals);
+
+        /**
+         * @brief State shared by the recording threads, dumps and crash handlers.
+         *
+         * Everything a dump reads is preallocated so crash handlers never allocate or lock.
+         */
+        class FlightRecorderImpl
+        {
+        public:
+            static FlightRecorderImpl& GetInstance()
+            {
+                // Never destroyed: crash handlers and exiting threads may use it during static destruction.
+                static FlightRecorderImpl* instance = new FlightRecorderImpl();
+                return *instance;
+            }
+
+            // Append-only; entries past RingCount may still be null while being published.
+            std::array<std::atomic<FlightRecorderRing*>, FlightRecorder::MaxThreads> Rings{};
+            std::atomic<size_t> RingCount{ 0 };
+            std::atomic<size_t> EntriesPerThread{ FlightRecorderOptions{}.EntriesPerThread };
+
+            // Indexed by category id.
+            std::array<CategoryNameSlot, Logger::MaxCategories> CategoryNames{};
+
+            // Serializes Enable() and Disable().
+            std::mutex ConfigMutex;
+
+            // Held by the dump in progress; crash handlers give up instead of waiting.
+            std::atomic_flag DumpLock;
+            std::unique_ptr<DumpEntry[]> DumpEntries;
+            size_t DumpCapacity = 0;
+            int DumpFile = -1;
+            std::array<uint64_t, FlightRecorder::MaxThreads> DumpCursors{};
+
+            // Set by the first crash handler so a terminate followed by SIGABRT dumps once.
+            std::atomic<bool> bHasCrashed{ false };
+
+            bool bHasCrashHandlers = false;
+            std::terminate_handler PreviousTerminate = nullptr;
+#if defined(_WIN32)
+            std::array<void (*)(int), FatalSignalCount> PreviousHandlers{};
+#else
+            std::array<struct sigaction, FatalSignalCount> PreviousActions{};
+            std::unique_ptr<std::byte[]> AlternateStack;
+#endif
+
+        private:
+            FlightRecorderImpl() = default;
+        };
+
+        /**
+         * @brief Copies the name of @p category for dumps, once.
+         */
+        void CacheCategoryName(FlightRecorderImpl& impl, const Category& category) noexcept
+        {
+            CategoryNameSlot& slot = impl.CategoryNames[category.GetId()];
+            uint8_t state = slot.State.load(std::memory_order_acquire);
+
+            if (state != CategoryNameEmpty
+                || !slot.State.compare_exchange_strong(state, CategoryNameWriting, std::memory_order_acquire))
+            {
+                return;
+            }
+
+            std::string_view name = category.GetName();
+            slot.Size = static_cast<uint8_t>(std::min(name.size(), CategoryNameCapacity));
+            std::memcpy(slot.Name, name.data(), slot.Size);
+            slot.State.store(CategoryNameReady, std::memory_order_release);
+        }
+
+        /**
+         * @brief The calling thread's ring; released for reuse when the thread exits.
+         */
+        struct RecorderSlot
+        {
+            FlightRecorderRing* Ring = nullptr;
+            FlightRecorderSlot* Pending = nullptr;
+            uint64_t PendingSequence = 0;
+            bool bHasFailed = false;
+
+            ~RecorderSlot()
+            {
+                if (Ring)
+                {
+                    Ring->bIsInUse.store(false, std::memory_order_release);
+                }
+            }
+        };
+
+        thread_local RecorderSlot ThreadRecorder;
+
+        FlightRecorderRing* AcquireRing(FlightRecorderImpl& impl) noexcept
+        {
+            size_t count = std::min(impl.RingCount.load(std::memory_order_acquire), FlightRecorder::MaxThreads);
+
+            // Reuse the ring of an exited thread; its old messages are overwritten progressively.
+            for (size_t i = 0; i < count; ++i)
+            {
+                FlightRecorderRing* ring = impl.Rings[i].load(std::memory_order_acquire);
+                bool bIsInUse = false;
+
+                if (ring && ring->bIsInUse.compare_exchange_strong(bIsInUse, true, std::memory_order_acquire))
+                {
+                    return ring;
+                }
+            }
+
+            FlightRecorderRing* ring = nullptr;
+
+            try
+            {
+                ring = new FlightRecorderRing(std::max<size_t>(impl.EntriesPerThread.load(std::memory_order_relaxed), 1));
+            }
+            catch (...)
+            {
+                return nullptr;
+            }
+
+            size_t index = impl.RingCount.fetch_add(1, std::memory_order_acq_rel);
+
+            if (index >= FlightRecorder::MaxThreads)
+            {
+                delete ring;
+                return nullptr;
+            }
+
+            impl.Rings[index].store(ring, std::memory_order_release);
+            return ring;
+        }
+
+        /**
+         * @brief Copies a slot, failing if its owner wrote it during the copy.
+         */
+        bool ReadSlot(const FlightRecorderSlot& slot, DumpEntry& entry) noexcept
+        {
+            uint64_t sequence = slot.Sequence.load(std::memory_order_acquire);
+
+            if (sequence == 0 || (sequence & 1) != 0)
+            {
+                return false;
+            }
+
+            std::memcpy(&entry.Header, &slot.Header, sizeof(entry.Header));
+
+            if (entry.Header.ArgsSize > SlotArgsCapacity)
+            {
+                return false;
+            }
+
+            std::memcpy(entry.Args, slot.Args, entry.Header.ArgsSize);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            return slot.Sequence.load(std::memory_order_relaxed) == sequence;
+        }
+
+        /**
+         * @brief Copies the most recent messages of all rings, newest first.
+         *
+         * Repeatedly takes the newest message not yet copied among the rings, so the
+         * result is the last @p maxEntries messages of the process.
+         */
+        size_t CollectRecent(FlightRecorderImpl& impl, DumpEntry* entries, size_t maxEntries) noexcept
+        {
+            const size_t ringCount = std::min(impl.RingCount.load(std::memory_order_acquire), FlightRecorder::MaxThreads);
+
+            for (size_t i = 0; i < ringCount; ++i)
+            {
+                FlightRecorderRing* ring = impl.Rings[i].load(std::memory_order_acquire);
+                impl.DumpCursors[i] = ring ? ring->WriteCount.load(std::memory_order_acquire) : 0;
+            }
+
+            auto oldestIndex = [&](size_t i)
+            {
+                FlightRecorderRing* ring = impl.Rings[i].load(std::memory_order_relaxed);
+                uint64_t written = ring ? ring->WriteCount.load(std::memory_order_relaxed) : 0;
+                return written > ring->Capacity ? written - ring->Capacity : 0;
+            };
+
+            size_t count = 0;
+
+            while (count < maxEntries)
+            {
+                size_t best = ringCount;
+                int64_t bestTimestamp = 0;
+
+                for (size_t i = 0; i < ringCount; ++i)
+                {
+                    if (impl.DumpCursors[i] == 0 || impl.DumpCursors[i] <= oldestIndex(i))
+                    {
+                        continue;
+                    }
+
+                    // Racy read, only used to pick the next ring; the copy below is validated.
+                    FlightRecorderRing* ring = impl.Rings[i].load(std::memory_order_relaxed);
+                    int64_t timestamp = ring->Slots[(impl.DumpCursors[i] - 1) % ring->Capacity].Header.Timestamp;
+
+                    if (best == ringCount || timestamp > bestTimestamp)
+                    {
+                        best = i;
+                        bestTimestamp = timestamp;
+                    }
+                }
+
+                if (best == ringCount)
+                {
+                    break;
+                }
+
+                FlightRecorderRing* ring = impl.Rings[best].load(std::memory_order_relaxed);
+                const FlightRecorderSlot& slot = ring->Slots[(--impl.DumpCursors[best]) % ring->Capacity];
+
+                if (ReadSlot(slot, entries[count]))
+                {
+                    ++count;
+                }
+            }
+
+            return count;
+        }
+
+        void WriteAll(int fd, const char* data, size_t size) noexcept
+        {
+            while (size > 0)
+            {
+#if defined(_WIN32)
+                int written = _write(fd, data, static_cast<unsigned int>(std::min<size_t>(size, 1 << 30)));
+#else
+                ssize_t written = write(fd, data, size);
+                if (written < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+#endif
+                if (written <= 0)
+                {
+                    return;
+                }
+
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+        }
+
+        /**
+         * @brief Buffered output to stderr and the dump file using only async-signal-safe calls.
+         */
+        class DumpWriter
+        {
+        public:
+            explicit DumpWriter(int file) noexcept
+                : File(file)
+            {}
+
+            ~DumpWriter()
+            {
+                Flush();
+            }
+
+            void Append(std::string_view text) noexcept
+            {
+                for (char c : text)
+                {
+                    Append(c);
+                }
+            }
+
+            void Append(char c) noexcept
+            {
+                if (Size == sizeof(Buffer))
+                {
+                    Flush();
+                }
+                Buffer[Size++] = c;
+            }
+
+            void AppendUnsigned(uint64_t value, int minDigits = 1) noexcept
+            {
+                char digits[20];
+                int count = 0;
+                do
+                {
+                    digits[count++] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                } while (value > 0 || count < minDigits);
+
+                while (count > 0)
+                {
+                    Append(digits[--count]);
+                }
+            }
+
+            void AppendSigned(int64_t value) noexcept
+            {
+                if (value < 0)
+                {
+                    Append('-');
+                    AppendUnsigned(~static_cast<uint64_t>(value) + 1);
+                    return;
+                }
+                AppendUnsigned(static_cast<uint64_t>(value));
+            }
+
+            void AppendHex(uint64_t value) noexcept
+            {
+                Append("0x");
+                bool bHasDigits = false;
+                for (int shift = 60; shift >= 0; shift -= 4)
+                {
+                    unsigned digit = static_cast<unsigned>((value >> shift) & 0xF);
+                    if (digit != 0 || bHasDigits || shift == 0)
+                    {
+                        Append("0123456789abcdef"[digit]);
+                        bHasDigits = true;
+                    }
+                }
+            }
+
+            /**
+             * @brief Writes a floating point value with six decimals, or in scientific notation when large.
+             */
+            void AppendDouble(double value) noexcept
+            {
+                if (value != value)
+                {
+                    Append("nan");
+                    return;
+                }
+                if (value < 0)
+                {
+                    Append('-');
+                    value = -value;
+                }
+                if (value > 1.7976931348623157e308)
+                {
+                    Append("inf");
+                    return;
+                }
+
+                int exponent = 0;
+                if (value >= 1e15)
+                {
+                    while (value >= 10.0)
+                    {
+                        value /= 10.0;
+                        ++exponent;
+                    }
+                }
+
+                uint64_t scaled = static_cast<uint64_t>(value * 1e6 + 0.5);
+                AppendUnsigned(scaled / 1000000);
+                Append('.');
+                AppendUnsigned(scaled % 1000000, 6);
+
+                if (exponent > 0)
+                {
+                    Append("e+");
+                    AppendUnsigned(static_cast<uint64_t>(exponent), 2);
+                }
+            }
+
+            void Flush() noexcept
+            {
+                WriteAll(2, Buffer, Size);
+                if (File >= 0)
+                {
+                    WriteAll(File, Buffer, Size);
+                }
+                Size = 0;
+            }
+
+        private:
+            int File;
+            char Buffer[1024];
+            size_t Size = 0;
+        };
+
+        /**
+         * @brief Reduced formatter for signal handlers: substitutes arguments, ignores format specifications.
+         */
+        void FormatArgsSignalSafe(DumpWriter& out, std::string_view format, const std::byte* args,
+            uint32_t argsSize, uint32_t argCount) noexcept
+        {
+            constexpr uint32_t MaxIndexedArgs = 64;
+            const std::byte* argStarts[MaxIndexedArgs];
+            uint32_t indexedCount = 0;
+
+            // Locate every argument first so positional placeholders work.
+            const std::byte* cursor = args;
+            const std::byte* end = args + argsSize;
+            for (uint32_t i = 0; i < argCount && i < MaxIndexedArgs && cursor < end; ++i)
+            {
+                argStarts[indexedCount++] = cursor;
+                auto type = static_cast<RecordArgType>(*cursor++);
+                switch (type)
+                {
+                case RecordArgType::Bool:
+                case RecordArgType::Char:
+                    cursor += 1;
+                    break;
+                case RecordArgType::Float:
+                    cursor += sizeof(float);
+                    break;
+                case RecordArgType::String:
+                {
+                    uint32_t length = 0;
+                    std::memcpy(&length, cursor, sizeof(length));
+                    cursor += sizeof(length) + length;
+                    break;
+                }
+                default:
+                    cursor += sizeof(uint64_t);
+                    break;
+                }
+            }
+
+            if (cursor > end)
+            {
+                out.Append("<corrupted log record>");
+                return;
+            }
+
+            auto appendArg = [&](uint32_t index)
+            {
+                if (index >= indexedCount)
+                {
+                    out.Append("{?}");
+                    return;
+                }
+
+                const std::byte* arg = argStarts[index];
+                auto type = static_cast<RecordArgType>(*arg++);
+                uint64_t bits = 0;
+
+                switch (type)
+                {
+                case RecordArgType::Bool:
+                    out.Append(*arg != std::byte{ 0 } ? "true" : "false");
+                    break;
+                case RecordArgType::Char:
+                    out.Append(static_cast<char>(*arg));
+                    break;
+                case RecordArgType::Int64:
+                {
+                    int64_t value;
+                    std::memcpy(&value, arg, sizeof(value));
+                    out.AppendSigned(value);
+                    break;
+                }
+                case RecordArgType::UInt64:
+                    std::memcpy(&bits, arg, sizeof(bits));
+                    out.AppendUnsigned(bits);
+                    break;
+                case RecordArgType::Float:
+                {
+                    float value;
+                    std::memcpy(&value, arg, sizeof(value));
+                    out.AppendDouble(value);
+                    break;
+                }
+                case RecordArgType::Double:
+                {
+                    double value;
+                    std::memcpy(&value, arg, sizeof(value));
+                    out.AppendDouble(value);
+                    break;
+                }
+                case RecordArgType::Pointer:
+                    std::memcpy(&bits, arg, sizeof(bits));
+                    out.AppendHex(bits);
+                    break;
+                case RecordArgType::String:
+                {
+                    uint32_t length;
+                    std::memcpy(&length, arg, sizeof(length));
+                    out.Append(std::string_view(reinterpret_cast<const char*>(arg + sizeof(length)), length));
+                    break;
+                }
+                default:
+                    out.Append("{?}");
+                    break;
+                }
+            };
+
+            uint32_t nextIndex = 0;
+
+            for (size_t i = 0; i < format.size(); ++i)
+            {
+                char c = format[i];
+
+                if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c)
+                {
+                    out.Append(c);
+                    ++i;
+                    continue;
+                }
+
+                if (c != '{')
+                {
+                    out.Append(c);
+                    continue;
+                }
+
+                size_t close = format.find('}', i);
+                if (close == std::string_view::npos)
+                {
+                    out.Append(format.substr(i));
+                    return;
+                }
+
+                // "{}", "{:spec}", "{N}" or "{N:spec}"
+                uint32_t index = nextIndex++;
+                if (i + 1 < close && format[i + 1] >= '0' && format[i + 1] <= '9')
+                {
+                    index = 0;
+                    for (size_t j = i + 1; j < close && format[j] >= '0' && format[j] <= '9'; ++j)
+                    {
+                        index = index * 10 + static_cast<uint32_t>(format[j] - '0');
+                    }
+                }
+
+                appendArg(index);
+                i = close;
+            }
+        }
+
+        char GetLevelLetter(uint8_t level) noexcept
+        {
+            switch (static_cast<Verbosity>(level))
+            {
+            case Verbosity::Critical: return 'C';
+            case Verbosity::Error: return 'E';
+            case Verbosity::Warn: return 'W';
+            case Verbosity::Info: return 'I';
+            case Verbosity::Debug: return 'D';
+            case Verbosity::Trace: return 'T';
+            default: return '?';
+            }
+        }
+
+        void WriteEntry(const FlightRecorderImpl& impl, DumpWriter& out, const DumpEntry& entry,
+            bool bIsSignalSafe) noexcept
+        {
+            const RecordHeader& header = entry.Header;
+
+            // Time of day in UTC: local time conversion is not async-signal-safe.
+            uint64_t nanoseconds = static_cast<uint64_t>(header.Timestamp);
+            uint64_t secondsOfDay = (nanoseconds / 1000000000) % 86400;
+
+            out.Append('[');
+            out.AppendUnsigned(secondsOfDay / 3600, 2);
+            out.Append(':');
+            out.AppendUnsigned(secondsOfDay / 60 % 60, 2);
+            out.Append(':');
+            out.AppendUnsigned(secondsOfDay % 60, 2);
+            out.Append('.');
+            out.AppendUnsigned(nanoseconds / 1000 % 1000000, 6);
+            out.Append(" UTC] [");
+
+            const CategoryNameSlot* name = header.CategoryId < Logger::MaxCategories
+                ? &impl.CategoryNames[header.CategoryId] : nullptr;
+            out.Append(name && name->State.load(std::memory_order_acquire) == CategoryNameReady
+                ? std::string_view(name->Name, name->Size) : std::string_view("?"));
+
+            out.Append("] [");
+            out.Append(GetLevelLetter(header.Level));
+            out.Append("] [");
+            out.AppendUnsigned(header.ThreadId);
+            out.Append("] ");
+
+            if (header.Flags & RecordFlagCallDepth)
+            {
+                out.Append("[depth: ");
+                out.AppendSigned(header.CallDepth);
+                out.Append("] ");
+            }
+
+            std::string_view format = (header.Flags & RecordFlagPreformatted)
+                ? RecordCodec::PreformattedFormat
+                : std::string_view(header.Format, header.FormatSize);
+
+            if (bIsSignalSafe)
+            {
+                FormatArgsSignalSafe(out, format, entry.Args, header.ArgsSize, header.ArgCount);
+            }
+            else
+            {
+                try
+                {
+                    spdlog::memory_buf_t message;
+                    RecordCodec::FormatArgs(format, entry.Args, header.ArgsSize, header.ArgCount, message);
+                    out.Append(std::string_view(message.data(), message.size()));
+                }
+                catch (...)
+                {
+                    FormatArgsSignalSafe(out, format, entry.Args, header.ArgsSize, header.ArgCount);
+                }
+            }
+
+            out.Append('\n');
+        }
+
+        /**
+         * @brief Writes a dump; the caller holds DumpLock.
+         */
+        void DumpLocked(FlightRecorderImpl& impl, std::string_view reason, bool bIsSignalSafe) noexcept
+        {
+            if (!impl.DumpEntries)
+            {
+                return;
+            }
+
+            size_t count = CollectRecent(impl, impl.DumpEntries.get(), impl.DumpCapacity);
+
+            DumpWriter out(impl.DumpFile);
+            out.Append("==== Flight recorder: last ");
+            out.AppendUnsigned(count);
+            out.Append(" message(s) before ");
+            out.Append(reason);
+            out.Append(" ====\n");
+
+            for (size_t i = count; i-- > 0;)
+            {
+                WriteEntry(impl, out, impl.DumpEntries[i], bIsSignalSafe);
+            }
+
+            out.Append("==== End of flight recorder dump ====\n");
+        }
+
+        void LockDump(FlightRecorderImpl& impl) noexcept
+        {
+            while (impl.DumpLock.test_and_set(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        void UnlockDump(FlightRecorderImpl& impl) noexcept
+        {
+            impl.DumpLock.clear(std::memory_order_release);
+        }
+
+        const char* GetSignalName(int signal) noexcept
+        {
+            switch (signal)
+            {
+            case SIGSEGV: return "SIGSEGV";
+            case SIGABRT: return "SIGABRT";
+            case SIGFPE: return "SIGFPE";
+            case SIGILL: return "SIGILL";
+#if defined(SIGBUS)
+            case SIGBUS: return "SIGBUS";
+#endif
+            default: return "fatal signal";
+            }
+        }
+
+        size_t GetSignalIndex(int signal) noexcept
+        {
+            for (size_t i = 0; i < FatalSignalCount; ++i)
+            {
+                if (FatalSignals[i] == signal)
+                {
+                    return i;
+                }
+            }
+            return FatalSignalCount;
+        }
+
+        void HandleFatalSignal(int signal)
+        {
+            auto& impl = FlightRecorderImpl::GetInstance();
+
+            if (!impl.bHasCrashed.exchange(true, std::memory_order_acq_rel)
+                && !impl.DumpLock.test_and_set(std::memory_order_acquire))
+            {
+                DumpLocked(impl, GetSignalName(signal), true);
+                UnlockDump(impl);
+            }
+
+            // Hand the signal back to the previous handler, or to the default action.
+            size_t index = GetSignalIndex(signal);
+#if defined(_WIN32)
+            std::signal(signal, index < FatalSignalCount ? impl.PreviousHandlers[index] : SIG_DFL);
+#else
+            if (index < FatalSignalCount)
+            {
+                sigaction(signal, &impl.PreviousActions[index], nullptr);
+            }
+            else
+            {
+                std::signal(signal, SIG_DFL);
+            }
+#endif
+            std::raise(signal);
+        }
+
+        [[noreturn]] void HandleTerminate()
+        {
+            auto& impl = FlightRecorderImpl::GetInstance();
+
+            if (!impl.bHasCrashed.exchange(true, std::memory_order_acq_rel))
+            {
+                std::string_view reason = "std::terminate";
+                spdlog::memory_buf_t buffer;
+
+                try
+                {
+                    if (std::exception_ptr exception = std::current_exception())
+                    {
+                        std::rethrow_exception(exception);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    fmt::format_to(fmt::appender(buffer), "std::terminate (uncaught exception: {})", e.what());
+                    reason = std::string_view(buffer.data(), buffer.size());
+                }
+                catch (...)
+                {
+                    reason = "std::terminate (uncaught exception)";
+                }
+
+                FlightRecorder::Dump(reason);
+            }
+
+            if (impl.PreviousTerminate)
+            {
+                impl.PreviousTerminate();
+            }
+            std::abort();
+        }
+
+        void InstallCrashHandlers(FlightRecorderImpl& impl)
+        {
+            if (impl.bHasCrashHandlers)
+            {
+                return;
+            }
+
+#if defined(_WIN32)
+            for (size_t i = 0; i < FatalSignalCount; ++i)
+            {
+                impl.PreviousHandlers[i] = std::signal(FatalSignals[i], HandleFatalSignal);
+            }
+#else
+            // Lets the handler run after a stack overflow on the thread enabling the recorder.
+            if (!impl.AlternateStack)
+            {
+                constexpr size_t AlternateStackSize = 64 * 1024;
+                impl.AlternateStack = std::make_unique<std::byte[]>(AlternateStackSize);
+
+                stack_t stack{};
+                stack.ss_sp = impl.AlternateStack.get();
+                stack.ss_size = AlternateStackSize;
+                sigaltstack(&stack, nullptr);
+            }
+
+            struct sigaction action{};
+            action.sa_handler = HandleFatalSignal;
+            action.sa_flags = SA_ONSTACK;
+            sigemptyset(&action.sa_mask);
+
+            for (size_t i = 0; i < FatalSignalCount; ++i)
+            {
+                sigaction(FatalSignals[i], &action, &impl.PreviousActions[i]);
+            }
+#endif
+
+            impl.PreviousTerminate = std::set_terminate(HandleTerminate);
+            impl.bHasCrashHandlers = true;
+        }
+
+        void RemoveCrashHandlers(FlightRecorderImpl& impl)
+        {
+            if (!impl.bHasCrashHandlers)
+            {
+                return;
+            }
+
+            for (size_t i = 0; i < FatalSignalCount; ++i)
+            {
+#if defined(_WIN32)
+                std::signal(FatalSignals[i], impl.PreviousHandlers[i]);
+#else
+                sigaction(FatalSignals[i], &impl.PreviousActions[i], nullptr);
+#endif
+            }
+
+            std::set_terminate(impl.PreviousTerminate);
+            impl.bHasCrashHandlers = false;
+        }
+
+        int OpenDumpFile(const std::filesystem::path& path) noexcept
+        {
+#if defined(_WIN32)
+            return _wopen(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+            return open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+#endif
+        }
+
+        void CloseDumpFile(int file) noexcept
+        {
+            if (file >= 0)
+            {
+#if defined(_WIN32)
+                _close(file);
+#else
+                close(file);
+#endif
+            }
+        }
+    } // namespace
+
+    void FlightRecorder::Enable(const FlightRecorderOptions& options)
+    {
+        auto& impl = FlightRecorderImpl::GetInstance();
+
+        std::lock_guard lock(impl.ConfigMutex);
+
+        int file = -1;
+        if (!options.DumpPath.empty())
+        {
+            file = OpenDumpFile(options.DumpPath);
+            if (file < 0)
+            {
+                throw std::runtime_error("Failed to open flight recorder dump file: " + options.DumpPath.string());
+            }
+        }
+
+        std::unique_ptr<DumpEntry[]> entries;
+
+        try
+        {
+            entries = std::make_unique<DumpEntry[]>(options.DumpCount);
+        }
+        catch (...)
+        {
+            CloseDumpFile(file);
+            throw;
+        }
+
+        // Swap the dump state while no dump runs.
+        LockDump(impl);
+        std::swap(impl.DumpEntries, entries);
+        std::swap(impl.DumpFile, file);
+        impl.DumpCapacity = options.DumpCount;
+        UnlockDump(impl);
+
+        CloseDumpFile(file);
+
+        impl.EntriesPerThread.store(std::max<size_t>(options.EntriesPerThread, 1), std::memory_order_relaxed);
+
+        if (options.bInstallCrashHandlers)
+        {
+            InstallCrashHandlers(impl);
+        }
+        else
+        {
+            RemoveCrashHandlers(impl);
+        }
+
+        RecordLevel.store(options.Level, std::memory_order_relaxed);
+    }
+
+    void FlightRecorder::Disable()
+    {
+        auto& impl = FlightRecorderImpl::GetInstance();
+
+        std::lock_guard lock(impl.ConfigMutex);
+
+        RecordLevel.store(Verbosity::None, std::memory_order_relaxed);
+        RemoveCrashHandlers(impl);
+    }
+
+    void FlightRecorder::Dump(std::string_view reason) noexcept
+    {
+        auto& impl = FlightRecorderImpl::GetInstance();
+
+        LockDump(impl);
+        DumpLocked(impl, reason, false);
+        UnlockDump(impl);
+    }
+
+    std::byte* FlightRecorderQueue::Reserve(const Category& category, const CallSite* site, Verbosity level,
+        std::string_view format, uint16_t flags, uint32_t argCount, size_t argsSize) noexcept
+    {
+        if (argsSize > SlotArgsCapacity)
+        {
+            return nullptr;
+        }
+
+        RecorderSlot& recorder = ThreadRecorder;
+        FlightRecorderImpl& impl = FlightRecorderImpl::GetInstance();
+
+        if (!recorder.Ring)
+        {
+            if (recorder.bHasFailed)
+            {
+                return nullptr;
+            }
+
+            recorder.Ring = AcquireRing(impl);
+
+            if (!recorder.Ring)
+            {
+                recorder.bHasFailed = true;
+                return nullptr;
+            }
+        }
+
+        CacheCategoryName(impl, category);
+
+        FlightRecorderRing& ring = *recorder.Ring;
+        FlightRecorderSlot& slot = ring.Slots[ring.WriteCount.load(std::memory_order_relaxed) % ring.Capacity];
+
+        uint64_t sequence = slot.Sequence.load(std::memory_order_relaxed) + 1;
+        slot.Sequence.store(sequence, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.Header = RecordCodec::MakeHeader(category.GetId(), site, level, format, flags, argCount, argsSize);
+        recorder.Pending = &slot;
+        recorder.PendingSequence = sequence + 1;
+
+        return slot.Args;
+    }
+
+    void FlightRecorderQueue::Commit() noexcept
+    {
+        RecorderSlot& recorder = ThreadRecorder;
+        FlightRecorderRing& ring = *recorder.Ring;
+
+        recorder.Pending->Sequence.store(recorder.PendingSequence, std::memory_order_release);
+        ring.WriteCount.store(ring.WriteCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    size_t FlightRecorderQueue::GetMaxArgsSize() noexcept
+    {
+        return SlotArgsCapacity;
+    }
+} // namespace nyxara::logging
@@ -1,28 +1,51 @@
+#include <array>
+#include <cstddef>
+#include <stdexcept>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include "nyxara/core/logging/logger.h"
+#include "logger_impl.h"
 
 namespace nyxara::logging
 {
-    class LoggerImpl
+    namespace
     {
-    public:
-        static LoggerImpl& GetInstance()
+        /**
+         * @brief Default memory resource of a thread's formatting buffers.
+         */
+        struct ThreadMessageResource
         {
-            static LoggerImpl instance;
-            return instance;
-        }
+            static constexpr size_t Size = 4096;
+
+            alignas(std::max_align_t) std::array<std::byte, Size> Storage;
+
+            // Falls back to the heap for messages that outgrow Storage; rewound after each message.
+            std::pmr::monotonic_buffer_resource Monotonic{ Storage.data(), Storage.size() };
 
-        std::unordered_map<std::string, Verbosity> CategoryLevels;
-        std::shared_mutex LevelsMutex;
+            std::pmr::memory_resource* Override = nullptr;
+            uint32_t Depth = 0;
+        };
 
-    private:
-        LoggerImpl()
+        thread_local ThreadMessageResource MessageResource;
+    } // namespace
+
+    LoggerImpl::LoggerImpl()
+    {
+        for (auto& slot : LevelSlots)
         {
-            // Initialize spdlog during first access
-            spdlog::set_level(spdlog::level::info);
-            spdlog::set_pattern("[%H:%M:%S %z] [%n] [%^%L%$] %v");
+            slot.store(Verbosity::Info, std::memory_order_relaxed); // default log level
         }
-    };
+
+        // Initialize spdlog during first access
+        spdlog::set_level(spdlog::level::info);
+        spdlog::set_pattern(Logger::DefaultPattern);
+    }
+
+    LoggerImpl::~LoggerImpl()
+    {
+        // Guarantee that queued messages reach the sinks on shutdown
+        Async.Stop();
+        Binary.Close();
+    }
 
     void Logger::Init()
     {
@@ -32,22 +55,12 @@ namespace nyxara::logging
 
     void Logger::SetCategoryLevel(const Category& category, Verbosity level)
     {
-        auto& impl = LoggerImpl::GetInstance();
-
-        std::unique_lock lock(impl.LevelsMutex);
-        impl.CategoryLevels[category.GetName()] = level;
-        
-        std::shared_ptr<spdlog::logger> loggerPtr = category.GetLogger();
-
-        if (loggerPtr)
-        {
-            loggerPtr->set_level(to_spdlog_level(level));
-        }
+        GetLevelSlot(category.GetId()).store(level, std::memory_order_relaxed);
     }
 
     std::shared_ptr<spdlog::logger> Logger::GetOrCreateLogger(const std::string& name)
     {
-        auto& impl = LoggerImpl::GetInstance();
+        LoggerImpl::GetInstance();
 
         std::shared_ptr<spdlog::logger> existingLogger = spdlog::get(name);
 
@@ -61,17 +74,121 @@ namespace nyxara::logging
         return new_logger;
     }
 
-    Verbosity Logger::GetCategoryLevel(const std::string& cat_name)
+    void Logger::EnableAsync(const AsyncOptions& options)
+    {
+        auto& impl = LoggerImpl::GetInstance();
+
+        impl.Async.Start(options);
+        bIsAsyncEnabled.store(true, std::memory_order_release);
+    }
+
+    void Logger::DisableAsync()
+    {
+        auto& impl = LoggerImpl::GetInstance();
+
+        bIsAsyncEnabled.store(false, std::memory_order_release);
+        impl.Async.Stop();
+    }
+
+    void Logger::EnableBinaryLog(const BinaryLogOptions& options)
+    {
+        auto& impl = LoggerImpl::GetInstance();
+
+        impl.Binary.Open(options);
+        bIsBinaryLogEnabled.store(true, std::memory_order_release);
+    }
+
+    void Logger::DisableBinaryLog()
+    {
+        auto& impl = LoggerImpl::GetInstance();
+
+        // Let the background thread write the records queued before the call
+        impl.Async.Flush();
+
+        bIsBinaryLogEnabled.store(false, std::memory_order_release);
+        impl.Binary.Close();
+    }
+
+    void Logger::Flush()
     {
         auto& impl = LoggerImpl::GetInstance();
-        
-        std::shared_lock lock(impl.LevelsMutex);
-        auto it = impl.CategoryLevels.find(cat_name);
-        if (it != impl.CategoryLevels.end())
+
+        impl.Async.Flush();
+        impl.Binary.Flush();
+    }
+
+    uint64_t Logger::GetDroppedMessageCount()
+    {
+        return LoggerImpl::GetInstance().Async.GetDroppedCount();
+    }
+
+    void Logger::SetThreadMessageResource(std::pmr::memory_resource* resource) noexcept
+    {
+        MessageResource.Override = resource;
+    }
+
+    std::pmr::memory_resource* Logger::GetThreadMessageResource() noexcept
+    {
+        ThreadMessageResource& resource = MessageResource;
+        return resource.Override ? resource.Override : &resource.Monotonic;
+    }
+
+    std::pmr::memory_resource* Logger::AcquireMessageResource() noexcept
+    {
+        ThreadMessageResource& resource = MessageResource;
+
+        ++resource.Depth;
+        return resource.Override ? resource.Override : &resource.Monotonic;
+    }
+
+    void Logger::ReleaseMessageResource() noexcept
+    {
+        ThreadMessageResource& resource = MessageResource;
+
+        // Returns to the start of Storage and frees any heap chunk; nothing else is allocated.
+        if (--resource.Depth == 0)
+        {
+            resource.Monotonic.release();
+        }
+    }
+
+    uint32_t Logger::RegisterCategory(std::string_view name)
+    {
+        auto& impl = LoggerImpl::GetInstance();
+
+        std::lock_guard lock(impl.CategoriesMutex);
+        auto it = impl.CategoryIds.find(std::string(name));
+        if (it != impl.CategoryIds.end())
         {
             return it->second;
         }
 
-        return Verbosity::Info; // default log level
+        if (impl.CategoryIds.size() >= MaxCategories)
+        {
+            throw std::runtime_error("Too many logging categories registered");
+        }
+
+        uint32_t id = static_cast<uint32_t>(impl.CategoryIds.size());
+        auto entry = impl.CategoryIds.emplace(name, id).first;
+        impl.CategoryNames[id] = entry->first;
+        impl.CategoryLoggers[id] = GetOrCreateLogger(entry->first);
+
+        // Filtering happens in the level slots and call sites; a forced-on call site must reach the sinks.
+        impl.CategoryLoggers[id]->set_level(spdlog::level::trace);
+
+        return id;
+    }
+
+    std::string_view Logger::GetCategoryName(uint32_t id) noexcept
+    {
+        auto& impl = LoggerImpl::GetInstance();
+
+        std::lock_guard lock(impl.CategoriesMutex);
+        return impl.CategoryNames[id];
+    }
+
+    std::atomic<Verbosity>& Logger::GetLevelSlot(uint32_t id) noexcept
+    {
+        return LoggerImpl::GetInstance().LevelSlots[id];
     }
-} // namespace nyxara::logging
\ No newline at end of file
+} // namespace nyxara::logging
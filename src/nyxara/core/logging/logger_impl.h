@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "nyxara/core/logging/logger.h"
+#include "async_backend.h"
+#include "binary_log_writer.h"
+
+namespace nyxara::logging
+{
+    class LoggerImpl
+    {
+    public:
+        static LoggerImpl& GetInstance()
+        {
+            static LoggerImpl instance;
+            return instance;
+        }
+
+        ~LoggerImpl();
+
+        std::unordered_map<std::string, uint32_t> CategoryIds;
+        std::mutex CategoriesMutex;
+
+        // Indexed by category id; views of the keys of CategoryIds, which never move.
+        std::array<std::string_view, Logger::MaxCategories> CategoryNames;
+
+        // Indexed by category id; read lock-free on every log call.
+        std::array<std::atomic<Verbosity>, Logger::MaxCategories> LevelSlots;
+
+        // Indexed by category id; written once at registration, read by asynchronous consumers.
+        std::array<std::shared_ptr<spdlog::logger>, Logger::MaxCategories> CategoryLoggers;
+
+        // Written by synchronous log calls and by the asynchronous background thread.
+        BinaryLogWriter Binary{ CategoryLoggers };
+
+        // Declared last so the background thread is joined before the other members are destroyed.
+        AsyncBackend Async{ CategoryLoggers, Binary };
+
+    private:
+        LoggerImpl();
+    };
+} // namespace nyxara::logging
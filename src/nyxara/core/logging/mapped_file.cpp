@@ -0,0 +1,170 @@
+#include "mapped_file.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace nyxara::logging
+{
+    MappedFile::~MappedFile()
+    {
+        Close(Size);
+    }
+
+#if defined(_WIN32)
+
+    bool MappedFile::Open(const std::filesystem::path& path, uint64_t size) noexcept
+    {
+        Close(Size);
+
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+            CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        // Mapping a range larger than the file extends it to the requested size.
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFFu), nullptr);
+
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, static_cast<SIZE_T>(size));
+
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        FileHandle = file;
+        MappingHandle = mapping;
+        Data = static_cast<std::byte*>(view);
+        Size = size;
+        return true;
+    }
+
+    void MappedFile::Close(uint64_t usedSize) noexcept
+    {
+        if (!IsOpen())
+        {
+            return;
+        }
+
+        UnmapViewOfFile(Data);
+        CloseHandle(static_cast<HANDLE>(MappingHandle));
+
+        LARGE_INTEGER end{};
+        end.QuadPart = static_cast<LONGLONG>(usedSize);
+        if (SetFilePointerEx(static_cast<HANDLE>(FileHandle), end, nullptr, FILE_BEGIN))
+        {
+            SetEndOfFile(static_cast<HANDLE>(FileHandle));
+        }
+        CloseHandle(static_cast<HANDLE>(FileHandle));
+
+        FileHandle = nullptr;
+        MappingHandle = nullptr;
+        Data = nullptr;
+        Size = 0;
+    }
+
+    void MappedFile::Flush(bool bWait) noexcept
+    {
+        if (!IsOpen())
+        {
+            return;
+        }
+
+        FlushViewOfFile(Data, 0);
+
+        if (bWait)
+        {
+            FlushFileBuffers(static_cast<HANDLE>(FileHandle));
+        }
+    }
+
+#else
+
+    bool MappedFile::Open(const std::filesystem::path& path, uint64_t size) noexcept
+    {
+        Close(Size);
+
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        // Reserve the blocks up front so that writing to the mapping cannot fault on a full disk.
+        bool bIsAllocated = false;
+#if defined(__linux__)
+        bIsAllocated = ::posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0;
+#endif
+        if (!bIsAllocated && ::ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* view = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        if (view == MAP_FAILED)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        ::madvise(view, static_cast<size_t>(size), MADV_SEQUENTIAL);
+
+        FileDescriptor = fd;
+        Data = static_cast<std::byte*>(view);
+        Size = size;
+        return true;
+    }
+
+    void MappedFile::Close(uint64_t usedSize) noexcept
+    {
+        if (!IsOpen())
+        {
+            return;
+        }
+
+        ::munmap(Data, static_cast<size_t>(Size));
+        [[maybe_unused]] int result = ::ftruncate(FileDescriptor, static_cast<off_t>(usedSize));
+        ::close(FileDescriptor);
+
+        FileDescriptor = -1;
+        Data = nullptr;
+        Size = 0;
+    }
+
+    void MappedFile::Flush(bool bWait) noexcept
+    {
+        if (!IsOpen())
+        {
+            return;
+        }
+
+        ::msync(Data, static_cast<size_t>(Size), bWait ? MS_SYNC : MS_ASYNC);
+    }
+
+#endif
+} // namespace nyxara::logging
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace nyxara::logging
+{
+    /**
+     * @brief A file preallocated to a fixed size and mapped read-write into memory.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Creates or truncates a file, preallocates it and maps it.
+         *
+         * @return True on success; on failure the object stays closed.
+         */
+        bool Open(const std::filesystem::path& path, uint64_t size) noexcept;
+
+        /**
+         * @brief Unmaps the file and shrinks it to the bytes actually used.
+         *
+         * @param usedSize Number of bytes to keep at the start of the file.
+         */
+        void Close(uint64_t usedSize) noexcept;
+
+        /**
+         * @brief Asks the operating system to write dirty pages back to disk.
+         *
+         * @param bWait Whether to wait for the write to complete.
+         */
+        void Flush(bool bWait) noexcept;
+
+        bool IsOpen() const noexcept { return Data != nullptr; }
+        std::byte* GetData() const noexcept { return Data; }
+        uint64_t GetSize() const noexcept { return Size; }
+
+    private:
+        std::byte* Data = nullptr;
+        uint64_t Size = 0;
+
+#if defined(_WIN32)
+        void* FileHandle = nullptr;
+        void* MappingHandle = nullptr;
+#else
+        int FileDescriptor = -1;
+#endif
+    };
+} // namespace nyxara::logging
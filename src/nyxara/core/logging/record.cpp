@@ -0,0 +1,120 @@
+#include <chrono>
+#include <fmt/args.h>
+#include <spdlog/details/os.h>
+#include "nyxara/core/logging/call_depth_manager.h"
+#include "nyxara/core/logging/record.h"
+
+namespace nyxara::logging
+{
+    namespace
+    {
+        template<typename T>
+        T ReadScalar(const std::byte*& cursor) noexcept
+        {
+            T value;
+            std::memcpy(&value, cursor, sizeof(T));
+            cursor += sizeof(T);
+            return value;
+        }
+    } // namespace
+
+    RecordHeader RecordCodec::MakeHeader(uint32_t categoryId, const CallSite* site, Verbosity level,
+        std::string_view format, uint16_t flags, uint32_t argCount, size_t argsSize) noexcept
+    {
+        if (CallDepthManager::IsEnabled())
+        {
+            flags |= RecordFlagCallDepth;
+        }
+
+        RecordHeader header{};
+        header.Size = static_cast<uint32_t>(sizeof(RecordHeader) + argsSize);
+        header.CategoryId = categoryId;
+        header.Site = site;
+        header.ArgsSize = static_cast<uint32_t>(argsSize);
+        header.Timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            spdlog::log_clock::now().time_since_epoch()).count();
+        header.ThreadId = spdlog::details::os::thread_id();
+        header.Format = format.data();
+        header.FormatSize = static_cast<uint32_t>(format.size());
+        header.CallDepth = CallDepthManager::GetDepth();
+        header.Level = static_cast<uint8_t>(level);
+        header.ArgCount = static_cast<uint8_t>(argCount);
+        header.Flags = flags;
+
+        return header;
+    }
+
+    void RecordCodec::FormatArgs(std::string_view format, const std::byte* args, uint32_t argsSize,
+        uint32_t argCount, spdlog::memory_buf_t& out)
+    {
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+        store.reserve(argCount, 0);
+
+        const std::byte* cursor = args;
+        const std::byte* end = args + argsSize;
+
+        for (uint32_t i = 0; i < argCount && cursor < end; ++i)
+        {
+            auto type = static_cast<RecordArgType>(*cursor++);
+
+            switch (type)
+            {
+            case RecordArgType::Bool:
+                store.push_back(static_cast<bool>(*cursor++));
+                break;
+            case RecordArgType::Char:
+                store.push_back(static_cast<char>(*cursor++));
+                break;
+            case RecordArgType::Int64:
+                store.push_back(ReadScalar<int64_t>(cursor));
+                break;
+            case RecordArgType::UInt64:
+                store.push_back(ReadScalar<uint64_t>(cursor));
+                break;
+            case RecordArgType::Float:
+                store.push_back(ReadScalar<float>(cursor));
+                break;
+            case RecordArgType::Double:
+                store.push_back(ReadScalar<double>(cursor));
+                break;
+            case RecordArgType::Pointer:
+                store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(ReadScalar<uint64_t>(cursor))));
+                break;
+            case RecordArgType::String:
+            {
+                uint32_t length = ReadScalar<uint32_t>(cursor);
+                store.push_back(fmt::string_view(reinterpret_cast<const char*>(cursor), length));
+                cursor += length;
+                break;
+            }
+            default:
+                fmt::format_to(fmt::appender(out), "<corrupted log record argument {}>", i);
+                return;
+            }
+        }
+
+        try
+        {
+            fmt::vformat_to(fmt::appender(out), fmt::string_view(format.data(), format.size()), store);
+        }
+        catch (const fmt::format_error& e)
+        {
+            fmt::format_to(fmt::appender(out), "<log format error: {}>", e.what());
+        }
+    }
+
+    void RecordCodec::FormatRecord(const RecordHeader& header, spdlog::memory_buf_t& out)
+    {
+        if (header.Flags & RecordFlagCallDepth)
+        {
+            fmt::format_to(fmt::appender(out), "[depth: {}] ", header.CallDepth);
+        }
+
+        const std::byte* args = reinterpret_cast<const std::byte*>(&header) + sizeof(RecordHeader);
+        std::string_view format = (header.Flags & RecordFlagPreformatted)
+            ? PreformattedFormat
+            : std::string_view(header.Format, header.FormatSize);
+
+        FormatArgs(format, args, header.ArgsSize, header.ArgCount, out);
+    }
+} // namespace nyxara::logging
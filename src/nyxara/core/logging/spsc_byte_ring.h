@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace nyxara::logging
+{
+    /**
+     * @brief Single-producer single-consumer ring buffer of variable-size records.
+     *
+     * Every record must start with its size as a non-zero `uint32_t`; a zero size
+     * marks the end of a lap and tells the consumer to wrap to the beginning of the
+     * buffer. Records are stored 8-byte aligned and never straddle the end of the buffer.
+     */
+    class SpscByteRing
+    {
+    public:
+        static constexpr size_t Alignment = 8;
+
+        static constexpr size_t MinCapacity = 4096;
+
+        explicit SpscByteRing(size_t capacity)
+            : Capacity(RoundCapacity(capacity)),
+              Mask(Capacity - 1),
+              Storage(std::make_unique<uint64_t[]>(Capacity / sizeof(uint64_t)))
+        {}
+
+        size_t GetCapacity() const noexcept { return Capacity; }
+
+        /**
+         * @brief Gets the capacity actually used for a requested capacity.
+         */
+        static constexpr size_t RoundCapacity(size_t capacity) noexcept
+        {
+            return std::bit_ceil(capacity < MinCapacity ? MinCapacity : capacity);
+        }
+
+        /**
+         * @brief Gets the largest record accepted by a ring of the requested capacity.
+         */
+        static constexpr size_t GetMaxRecordSize(size_t capacity) noexcept { return RoundCapacity(capacity) / 4; }
+
+        /**
+         * @brief Largest record accepted by Reserve().
+         */
+        size_t GetMaxRecordSize() const noexcept { return Capacity / 4; }
+
+        /**
+         * @brief Reserves contiguous space for a record (producer only).
+         *
+         * @return Pointer to the reserved bytes, or nullptr if the ring is full.
+         */
+        std::byte* Reserve(size_t size) noexcept
+        {
+            size_t aligned = AlignUp(size);
+            if (aligned > GetMaxRecordSize())
+            {
+                return nullptr;
+            }
+
+            size_t tail = Tail.load(std::memory_order_relaxed);
+            size_t offset = tail & Mask;
+            size_t contiguous = Capacity - offset;
+            size_t needed = aligned <= contiguous ? aligned : contiguous + aligned;
+
+            if (needed > Capacity - (tail - CachedHead))
+            {
+                CachedHead = Head.load(std::memory_order_acquire);
+                if (needed > Capacity - (tail - CachedHead))
+                {
+                    return nullptr;
+                }
+            }
+
+            if (aligned > contiguous)
+            {
+                uint32_t wrapMarker = 0;
+                std::memcpy(Data() + offset, &wrapMarker, sizeof(wrapMarker));
+                tail += contiguous;
+                offset = 0;
+            }
+
+            PendingTail = tail + aligned;
+            return Data() + offset;
+        }
+
+        /**
+         * @brief Publishes the record returned by the last Reserve() (producer only).
+         */
+        void Commit() noexcept
+        {
+            Tail.store(PendingTail, std::memory_order_release);
+        }
+
+        /**
+         * @brief Gets the oldest unread record (consumer only).
+         *
+         * @return Pointer to the record, or nullptr if the ring is empty.
+         */
+        const std::byte* Peek() noexcept
+        {
+            for (;;)
+            {
+                size_t head = Head.load(std::memory_order_relaxed);
+                if (head == CachedTail)
+                {
+                    CachedTail = Tail.load(std::memory_order_acquire);
+                    if (head == CachedTail)
+                    {
+                        return nullptr;
+                    }
+                }
+
+                size_t offset = head & Mask;
+                uint32_t size;
+                std::memcpy(&size, Data() + offset, sizeof(size));
+
+                if (size != 0)
+                {
+                    return Data() + offset;
+                }
+
+                Head.store(head + (Capacity - offset), std::memory_order_release);
+            }
+        }
+
+        /**
+         * @brief Releases the record returned by the last Peek() (consumer only).
+         */
+        void Pop() noexcept
+        {
+            size_t head = Head.load(std::memory_order_relaxed);
+            uint32_t size;
+            std::memcpy(&size, Data() + (head & Mask), sizeof(size));
+            Head.store(head + AlignUp(size), std::memory_order_release);
+        }
+
+        /**
+         * @brief Checks whether all published records have been consumed.
+         */
+        bool IsEmpty() const noexcept
+        {
+            return Head.load(std::memory_order_acquire) == Tail.load(std::memory_order_acquire);
+        }
+
+        std::atomic<uint64_t> DroppedCount{ 0 };    ///< Records dropped by the producer since last read.
+        std::atomic<bool> bIsOrphaned{ false };     ///< Set once the producing thread has exited.
+
+    private:
+        static constexpr size_t AlignUp(size_t size) noexcept
+        {
+            return (size + Alignment - 1) & ~(Alignment - 1);
+        }
+
+        std::byte* Data() const noexcept { return reinterpret_cast<std::byte*>(Storage.get()); }
+
+        const size_t Capacity;
+        const size_t Mask;
+        std::unique_ptr<uint64_t[]> Storage;
+
+        alignas(64) std::atomic<size_t> Tail{ 0 };  ///< Write position, owned by the producer.
+        size_t CachedHead = 0;                      ///< Producer's last observed read position.
+        size_t PendingTail = 0;                     ///< Write position after the pending reservation.
+
+        alignas(64) std::atomic<size_t> Head{ 0 };  ///< Read position, owned by the consumer.
+        size_t CachedTail = 0;                      ///< Consumer's last observed write position.
+    };
+} // namespace nyxara::logging
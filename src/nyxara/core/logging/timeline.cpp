@@ -0,0 +1,142 @@
+#include <spdlog/details/os.h>
+#include "nyxara/core/logging/call_depth_manager.h"
+#include "nyxara/core/logging/timeline.h"
+#include "timeline_impl.h"
+
+namespace nyxara::logging
+{
+    namespace
+    {
+        /**
+         * @brief The calling thread's buffer for the capture identified by Generation.
+         */
+        struct RecorderSlot
+        {
+            std::shared_ptr<TimelineThreadBuffer> Buffer;
+            uint64_t Generation = 0;
+        };
+
+        thread_local RecorderSlot ThreadSlot;
+
+        TimelineThreadBuffer* AcquireThreadBuffer(TimelineImpl& impl) noexcept
+        {
+            uint64_t generation = impl.Generation.load(std::memory_order_acquire);
+
+            if (ThreadSlot.Generation == generation)
+            {
+                return ThreadSlot.Buffer.get();
+            }
+
+            try
+            {
+                std::lock_guard lock(impl.Mutex);
+
+                // Re-read under the lock so the buffer is registered with the capture it belongs to.
+                generation = impl.Generation.load(std::memory_order_relaxed);
+                auto buffer = std::make_shared<TimelineThreadBuffer>(impl.Options.EventsPerThread,
+                    spdlog::details::os::thread_id());
+                impl.Buffers.push_back(buffer);
+
+                ThreadSlot.Buffer = std::move(buffer);
+                ThreadSlot.Generation = generation;
+                return ThreadSlot.Buffer.get();
+            }
+            catch (...)
+            {
+                // Do not retry on every scope of this capture.
+                ThreadSlot.Buffer.reset();
+                ThreadSlot.Generation = generation;
+                return nullptr;
+            }
+        }
+    } // namespace
+
+    void Timeline::StartCapture(const TimelineOptions& options)
+    {
+        auto& impl = TimelineImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+
+        bIsCapturing.store(false, std::memory_order_relaxed);
+
+        impl.Buffers.clear();
+        impl.Options = options;
+        impl.StartTicks = TimelineImpl::ReadTicks();
+        impl.StartTime = TimelineImpl::GetSteadyTime();
+        impl.StopTicks = impl.StartTicks;
+        impl.StopTime = impl.StartTime;
+        impl.Generation.fetch_add(1, std::memory_order_release);
+
+        bIsCapturing.store(true, std::memory_order_release);
+    }
+
+    void Timeline::StopCapture()
+    {
+        auto& impl = TimelineImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+
+        if (bIsCapturing.exchange(false, std::memory_order_acq_rel))
+        {
+            impl.StopTicks = TimelineImpl::ReadTicks();
+            impl.StopTime = TimelineImpl::GetSteadyTime();
+        }
+    }
+
+    uint64_t Timeline::GetDroppedEventCount()
+    {
+        auto& impl = TimelineImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+
+        uint64_t dropped = 0;
+        for (const auto& buffer : impl.Buffers)
+        {
+            dropped += buffer->DroppedCount.load(std::memory_order_relaxed);
+        }
+
+        return dropped;
+    }
+
+    void Timeline::Record(const char* name, bool bIsBegin) noexcept
+    {
+        TimelineThreadBuffer* buffer = AcquireThreadBuffer(TimelineImpl::GetInstance());
+
+        if (!buffer)
+        {
+            return;
+        }
+
+        size_t count = buffer->Count.load(std::memory_order_relaxed);
+
+        if (count == buffer->Events.size())
+        {
+            buffer->DroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer->Events[count] = TimelineEvent{ TimelineImpl::ReadTicks(), name, CallDepthManager::GetDepth(), bIsBegin };
+        buffer->Count.store(count + 1, std::memory_order_release);
+    }
+
+    TimelineSnapshot TimelineImpl::TakeSnapshot()
+    {
+        std::lock_guard lock(Mutex);
+
+        TimelineSnapshot snapshot;
+        snapshot.Buffers = Buffers;
+        snapshot.StartTicks = StartTicks;
+        snapshot.StartTime = StartTime;
+        snapshot.StopTicks = Timeline::IsCapturing() ? ReadTicks() : StopTicks;
+        snapshot.StopTime = Timeline::IsCapturing() ? GetSteadyTime() : StopTime;
+        snapshot.ProcessId = static_cast<uint64_t>(spdlog::details::os::pid());
+
+        for (const auto& buffer : snapshot.Buffers)
+        {
+            size_t count = buffer->Count.load(std::memory_order_acquire);
+            snapshot.Threads.push_back({ buffer->ThreadId, buffer->Events.data(), count });
+        }
+
+        return snapshot;
+    }
+} // namespace nyxara::logging
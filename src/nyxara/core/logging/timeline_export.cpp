@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include "nyxara/core/logging/timeline.h"
+#include "timeline_impl.h"
+
+namespace nyxara::logging
+{
+    namespace
+    {
+        /**
+         * @brief Replays the balanced scopes of a thread.
+         *
+         * Ends of scopes opened before the capture are skipped, and scopes still open
+         * at the end of the capture are closed at @p stopTicks. Timestamps are in ticks.
+         *
+         * @param onBegin Called with the scope name and timestamp of each opened scope.
+         * @param onEnd Called with the timestamp of each closed scope.
+         */
+        template<typename BeginFn, typename EndFn>
+        void ForEachScope(const TimelineSnapshot::Thread& thread, int64_t stopTicks, BeginFn&& onBegin, EndFn&& onEnd)
+        {
+            std::vector<int32_t> openDepths;
+            int64_t lastTimestamp = 0;
+
+            for (size_t i = 0; i < thread.Count; ++i)
+            {
+                const TimelineEvent& event = thread.Events[i];
+                lastTimestamp = event.Timestamp;
+
+                if (event.bIsBegin)
+                {
+                    openDepths.push_back(event.Depth);
+                    onBegin(event.Name, event.Timestamp);
+                    continue;
+                }
+
+                // A begin at the same depth is the matching scope; anything shallower started before the capture.
+                if (openDepths.empty() || openDepths.back() < event.Depth)
+                {
+                    continue;
+                }
+
+                while (!openDepths.empty() && openDepths.back() >= event.Depth)
+                {
+                    openDepths.pop_back();
+                    onEnd(event.Timestamp);
+                }
+            }
+
+            int64_t endTime = std::max(stopTicks, lastTimestamp);
+
+            while (!openDepths.empty())
+            {
+                openDepths.pop_back();
+                onEnd(endTime);
+            }
+        }
+
+        void WriteFile(const std::filesystem::path& path, const char* data, size_t size)
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(data, static_cast<std::streamsize>(size));
+
+            if (!file)
+            {
+                throw std::runtime_error("Failed to write timeline capture: " + path.string());
+            }
+        }
+
+        void AppendJsonString(spdlog::memory_buf_t& out, std::string_view text)
+        {
+            out.push_back('"');
+
+            for (char c : text)
+            {
+                switch (c)
+                {
+                case '"': out.append(std::string_view("\\\"")); break;
+                case '\\': out.append(std::string_view("\\\\")); break;
+                case '\n': out.append(std::string_view("\\n")); break;
+                case '\t': out.append(std::string_view("\\t")); break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        fmt::format_to(fmt::appender(out), "\\u{:04x}", static_cast<unsigned>(c));
+                    }
+                    else
+                    {
+                        out.push_back(c);
+                    }
+                    break;
+                }
+            }
+
+            out.push_back('"');
+        }
+
+        /**
+         * @brief Minimal protobuf encoder for the handful of Perfetto messages we emit.
+         */
+        class ProtoWriter
+        {
+        public:
+            void Varint(uint32_t field, uint64_t value)
+            {
+                Tag(field, 0);
+                RawVarint(value);
+            }
+
+            void String(uint32_t field, std::string_view value)
+            {
+                Tag(field, 2);
+                RawVarint(value.size());
+                Data.append(value);
+            }
+
+            void Message(uint32_t field, const ProtoWriter& message)
+            {
+                String(field, message.Data);
+            }
+
+            const std::string& GetData() const noexcept { return Data; }
+
+        private:
+            void Tag(uint32_t field, uint32_t wireType)
+            {
+                RawVarint((static_cast<uint64_t>(field) << 3) | wireType);
+            }
+
+            void RawVarint(uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    Data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                    value >>= 7;
+                }
+                Data.push_back(static_cast<char>(value));
+            }
+
+            std::string Data;
+        };
+
+        // Field numbers from perfetto/trace/trace_packet.proto and track_event/*.proto.
+        namespace Perfetto
+        {
+            constexpr uint32_t TracePacket = 1;
+
+            constexpr uint32_t PacketTimestamp = 8;
+            constexpr uint32_t PacketSequenceId = 10;
+            constexpr uint32_t PacketTrackEvent = 11;
+            constexpr uint32_t PacketSequenceFlags = 13;
+            constexpr uint32_t PacketTrackDescriptor = 60;
+
+            constexpr uint32_t SequenceIncrementalStateCleared = 1;
+
+            constexpr uint32_t TrackUuid = 1;
+            constexpr uint32_t TrackName = 2;
+            constexpr uint32_t TrackProcess = 3;
+            constexpr uint32_t TrackThread = 4;
+            constexpr uint32_t TrackParentUuid = 5;
+
+            constexpr uint32_t ProcessPid = 1;
+            constexpr uint32_t ThreadPid = 1;
+            constexpr uint32_t ThreadTid = 2;
+
+            constexpr uint32_t EventType = 9;
+            constexpr uint32_t EventTrackUuid = 11;
+            constexpr uint32_t EventName = 23;
+
+            constexpr uint64_t SliceBegin = 1;
+            constexpr uint64_t SliceEnd = 2;
+
+            constexpr uint32_t SequenceId = 1;
+        } // namespace Perfetto
+    } // namespace
+
+    void Timeline::WriteChromeTrace(const std::filesystem::path& path)
+    {
+        TimelineSnapshot snapshot = TimelineImpl::GetInstance().TakeSnapshot();
+
+        spdlog::memory_buf_t out;
+        out.append(std::string_view("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+
+        bool bIsFirst = true;
+        auto separator = [&]()
+        {
+            if (!bIsFirst)
+            {
+                out.append(std::string_view(",\n"));
+            }
+            bIsFirst = false;
+        };
+
+        for (const auto& thread : snapshot.Threads)
+        {
+            separator();
+            fmt::format_to(fmt::appender(out),
+                "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},\"args\":{{\"name\":\"Thread {}\"}}}}",
+                snapshot.ProcessId, thread.ThreadId, thread.ThreadId);
+
+            // Chrome expects microseconds; keep nanosecond precision as decimals.
+            auto toMicroseconds = [&](int64_t timestamp)
+            {
+                return static_cast<double>(snapshot.ToNanoseconds(timestamp) - snapshot.StartTime) / 1000.0;
+            };
+
+            ForEachScope(thread, snapshot.StopTicks,
+                [&](const char* name, int64_t timestamp)
+                {
+                    separator();
+                    out.append(std::string_view("{\"name\":"));
+                    AppendJsonString(out, name);
+                    fmt::format_to(fmt::appender(out), ",\"ph\":\"B\",\"ts\":{:.3f},\"pid\":{},\"tid\":{}}}",
+                        toMicroseconds(timestamp), snapshot.ProcessId, thread.ThreadId);
+                },
+                [&](int64_t timestamp)
+                {
+                    separator();
+                    fmt::format_to(fmt::appender(out), "{{\"ph\":\"E\",\"ts\":{:.3f},\"pid\":{},\"tid\":{}}}",
+                        toMicroseconds(timestamp), snapshot.ProcessId, thread.ThreadId);
+                });
+        }
+
+        out.append(std::string_view("]}\n"));
+
+        WriteFile(path, out.data(), out.size());
+    }
+
+    void Timeline::WritePerfettoTrace(const std::filesystem::path& path)
+    {
+        TimelineSnapshot snapshot = TimelineImpl::GetInstance().TakeSnapshot();
+
+        ProtoWriter trace;
+        const uint64_t processUuid = snapshot.ProcessId + 1;
+
+        auto writePacket = [&](const ProtoWriter& packet)
+        {
+            trace.Message(Perfetto::TracePacket, packet);
+        };
+
+        {
+            ProtoWriter process;
+            process.Varint(Perfetto::ProcessPid, snapshot.ProcessId);
+
+            ProtoWriter track;
+            track.Varint(Perfetto::TrackUuid, processUuid);
+            track.Message(Perfetto::TrackProcess, process);
+
+            ProtoWriter packet;
+            packet.Varint(Perfetto::PacketSequenceId, Perfetto::SequenceId);
+            packet.Varint(Perfetto::PacketSequenceFlags, Perfetto::SequenceIncrementalStateCleared);
+            packet.Message(Perfetto::PacketTrackDescriptor, track);
+            writePacket(packet);
+        }
+
+        for (size_t index = 0; index < snapshot.Threads.size(); ++index)
+        {
+            const auto& thread = snapshot.Threads[index];
+            const uint64_t trackUuid = (processUuid << 20) + index + 1;
+
+            {
+                ProtoWriter threadDescriptor;
+                threadDescriptor.Varint(Perfetto::ThreadPid, snapshot.ProcessId);
+                threadDescriptor.Varint(Perfetto::ThreadTid, thread.ThreadId);
+
+                ProtoWriter track;
+                track.Varint(Perfetto::TrackUuid, trackUuid);
+                track.Varint(Perfetto::TrackParentUuid, processUuid);
+                track.String(Perfetto::TrackName, fmt::format("Thread {}", thread.ThreadId));
+                track.Message(Perfetto::TrackThread, threadDescriptor);
+
+                ProtoWriter packet;
+                packet.Varint(Perfetto::PacketSequenceId, Perfetto::SequenceId);
+                packet.Message(Perfetto::PacketTrackDescriptor, track);
+                writePacket(packet);
+            }
+
+            auto writeEvent = [&](uint64_t type, const char* name, int64_t timestamp)
+            {
+                ProtoWriter event;
+                event.Varint(Perfetto::EventType, type);
+                event.Varint(Perfetto::EventTrackUuid, trackUuid);
+                if (name)
+                {
+                    event.String(Perfetto::EventName, name);
+                }
+
+                ProtoWriter packet;
+                packet.Varint(Perfetto::PacketTimestamp, static_cast<uint64_t>(snapshot.ToNanoseconds(timestamp)));
+                packet.Varint(Perfetto::PacketSequenceId, Perfetto::SequenceId);
+                packet.Message(Perfetto::PacketTrackEvent, event);
+                writePacket(packet);
+            };
+
+            ForEachScope(thread, snapshot.StopTicks,
+                [&](const char* name, int64_t timestamp) { writeEvent(Perfetto::SliceBegin, name, timestamp); },
+                [&](int64_t timestamp) { writeEvent(Perfetto::SliceEnd, nullptr, timestamp); });
+        }
+
+        WriteFile(path, trace.GetData().data(), trace.GetData().size());
+    }
+} // namespace nyxara::logging
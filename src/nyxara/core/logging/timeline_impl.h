@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "nyxara/core/logging/timeline.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace nyxara::logging
+{
+    /**
+     * @brief A scope boundary recorded by Timeline.
+     */
+    struct TimelineEvent
+    {
+        int64_t Timestamp;      ///< Raw TimelineImpl::ReadTicks() value.
+        const char* Name;       ///< Scope name for begin events, nullptr for end events.
+        int32_t Depth;          ///< Call depth of the thread outside the scope.
+        bool bIsBegin;          ///< Whether the event opens or closes a scope.
+    };
+
+    /**
+     * @brief Events of one thread for one capture.
+     *
+     * Only the owning thread writes events; Count is published with release semantics
+     * so exporters can read the first Count events while the thread keeps recording.
+     */
+    struct TimelineThreadBuffer
+    {
+        TimelineThreadBuffer(size_t capacity, uint64_t threadId)
+            : Events(capacity), ThreadId(threadId)
+        {}
+
+        // Value-initialized so every page is faulted in once, not while recording.
+        std::vector<TimelineEvent> Events;
+        std::atomic<size_t> Count{ 0 };
+        std::atomic<uint64_t> DroppedCount{ 0 };
+        const uint64_t ThreadId;
+    };
+
+    /**
+     * @brief A consistent view of a capture, taken for export.
+     */
+    struct TimelineSnapshot
+    {
+        struct Thread
+        {
+            uint64_t ThreadId;
+            const TimelineEvent* Events;
+            size_t Count;
+        };
+
+        std::vector<std::shared_ptr<TimelineThreadBuffer>> Buffers; ///< Keeps the events alive.
+        std::vector<Thread> Threads;
+        int64_t StartTicks = 0;
+        int64_t StartTime = 0;      ///< Steady clock nanoseconds at the start of the capture.
+        int64_t StopTicks = 0;
+        int64_t StopTime = 0;       ///< Steady clock nanoseconds at the end of the capture.
+        uint64_t ProcessId = 0;
+
+        /**
+         * @brief Converts an event timestamp to steady clock nanoseconds.
+         */
+        int64_t ToNanoseconds(int64_t ticks) const noexcept
+        {
+            if (StopTicks == StartTicks)
+            {
+                return StartTime;
+            }
+
+            double scale = static_cast<double>(StopTime - StartTime) / static_cast<double>(StopTicks - StartTicks);
+            return StartTime + static_cast<int64_t>(static_cast<double>(ticks - StartTicks) * scale);
+        }
+    };
+
+    class TimelineImpl
+    {
+    public:
+        static TimelineImpl& GetInstance()
+        {
+            static TimelineImpl instance;
+            return instance;
+        }
+
+        /**
+         * @brief Reads the cheapest monotonic counter available, converted to nanoseconds on export.
+         */
+        static int64_t ReadTicks() noexcept
+        {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+            return static_cast<int64_t>(__rdtsc());
+#elif defined(__aarch64__)
+            uint64_t ticks;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+            return static_cast<int64_t>(ticks);
+#else
+            return GetSteadyTime();
+#endif
+        }
+
+        static int64_t GetSteadyTime() noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        TimelineSnapshot TakeSnapshot();
+
+        std::mutex Mutex;
+        std::vector<std::shared_ptr<TimelineThreadBuffer>> Buffers;
+        TimelineOptions Options;
+
+        // Tick and steady clock readings at both ends of the capture, used to convert ticks.
+        int64_t StartTicks = 0;
+        int64_t StartTime = 0;
+        int64_t StopTicks = 0;
+        int64_t StopTime = 0;
+
+        // Incremented by every StartCapture(); threads holding an older buffer allocate a new one.
+        std::atomic<uint64_t> Generation{ 0 };
+
+    private:
+        TimelineImpl() = default;
+    };
+} // namespace nyxara::logging
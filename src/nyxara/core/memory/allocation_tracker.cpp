@@ -0,0 +1,396 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include "nyxara/core/memory/allocation_tracker.h"
+#include "nyxara/core/logging/categories.h"
+#include "allocation_tracker_impl.h"
+
+namespace nyxara::memory
+{
+    namespace
+    {
+        constexpr size_t MaxTagNameSize = 32;
+
+        /**
+         * @brief Stored in front of every block to find its size, tag and start on free.
+         */
+        struct AllocationHeader
+        {
+            uint64_t Size;
+            uint32_t Offset;    ///< Distance from the start of the malloc block to the user pointer.
+            uint16_t Tag;
+            uint16_t Reserved;
+        };
+
+        constexpr size_t HeaderSize = sizeof(AllocationHeader);
+        static_assert(HeaderSize == 16, "The header must preserve the default new alignment");
+
+        struct TagCounters
+        {
+            std::atomic<uint64_t> AllocationCount{ 0 };
+            std::atomic<uint64_t> DeallocationCount{ 0 };
+            std::atomic<uint64_t> AllocatedBytes{ 0 };
+            std::atomic<uint64_t> FreedBytes{ 0 };
+        };
+
+        /**
+         * @brief Counters owned by one thread at a time and written only by it.
+         */
+        struct alignas(64) ThreadCounters
+        {
+            std::atomic<bool> bIsInUse{ false };
+            std::array<TagCounters, AllocationTracker::MaxTags> Tags;
+        };
+
+        /**
+         * @brief Tracker state.
+         *
+         * Constant-initialized, never destroyed: operator new runs before dynamic
+         * initialization and operator delete after static destruction.
+         */
+        class AllocationTrackerImpl
+        {
+        public:
+            static AllocationTrackerImpl& GetInstance() noexcept
+            {
+                static constinit AllocationTrackerImpl instance;
+                return instance;
+            }
+
+            std::array<ThreadCounters, AllocationTracker::MaxThreads> ThreadSlots;
+            ThreadCounters SharedCounters;  ///< Threads without a slot; updated with fetch_add.
+
+            std::atomic<int64_t> LiveBytes{ 0 };
+            std::atomic<int64_t> PeakLiveBytes{ 0 };
+            std::atomic<bool> bIsActive{ false };
+
+            // Tag registration is rare; a spin lock keeps the state constant-initialized.
+            std::atomic_flag TagLock;
+            std::atomic<uint16_t> TagCount{ 1 };
+            char TagNames[AllocationTracker::MaxTags][MaxTagNameSize] = { "untagged" };
+
+            constexpr AllocationTrackerImpl() = default;
+        };
+
+        /**
+         * @brief The calling thread's counters and current tag; trivially destructible.
+         */
+        struct ThreadState
+        {
+            ThreadCounters* Counters = nullptr;
+            uint16_t Tag = 0;
+            bool bHasExited = false;
+        };
+
+        constinit thread_local ThreadState ThreadTracker;
+
+        /**
+         * @brief Releases the calling thread's counters when it exits.
+         *
+         * Later deallocations from other thread-local destructors use the shared counters.
+         */
+        struct ThreadSlotReleaser
+        {
+            void Arm() noexcept {}
+
+            ~ThreadSlotReleaser()
+            {
+                if (ThreadTracker.Counters)
+                {
+                    ThreadTracker.Counters->bIsInUse.store(false, std::memory_order_release);
+                }
+                ThreadTracker.Counters = nullptr;
+                ThreadTracker.bHasExited = true;
+            }
+        };
+
+        thread_local ThreadSlotReleaser SlotReleaser;
+
+        /**
+         * @brief Gets the calling thread's counters, claiming a slot on first use.
+         *
+         * @param bIsShared Set if the shared counters are returned.
+         */
+        ThreadCounters& GetThreadCounters(AllocationTrackerImpl& impl, bool& bIsShared) noexcept
+        {
+            ThreadState& state = ThreadTracker;
+            bIsShared = false;
+
+            if (state.Counters)
+            {
+                return *state.Counters;
+            }
+
+            if (!state.bHasExited)
+            {
+                for (ThreadCounters& slot : impl.ThreadSlots)
+                {
+                    bool bIsInUse = false;
+
+                    if (!slot.bIsInUse.load(std::memory_order_relaxed)
+                        && slot.bIsInUse.compare_exchange_strong(bIsInUse, true, std::memory_order_acquire))
+                    {
+                        state.Counters = &slot;
+                        // Registers the releaser's destructor for this thread.
+                        SlotReleaser.Arm();
+                        return slot;
+                    }
+                }
+            }
+
+            bIsShared = true;
+            return impl.SharedCounters;
+        }
+
+        void Add(std::atomic<uint64_t>& counter, uint64_t value, bool bIsShared) noexcept
+        {
+            if (bIsShared)
+            {
+                counter.fetch_add(value, std::memory_order_relaxed);
+            }
+            else
+            {
+                // Single writer: a plain load and store avoid the locked instruction.
+                counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            }
+        }
+
+        void Accumulate(AllocationStats& stats, const TagCounters& counters) noexcept
+        {
+            stats.AllocationCount += counters.AllocationCount.load(std::memory_order_relaxed);
+            stats.DeallocationCount += counters.DeallocationCount.load(std::memory_order_relaxed);
+            stats.AllocatedBytes += counters.AllocatedBytes.load(std::memory_order_relaxed);
+            stats.FreedBytes += counters.FreedBytes.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Sums the counters of a tag over all threads.
+         */
+        AllocationStats SumTagCounters(AllocationTrackerImpl& impl, uint16_t tag) noexcept
+        {
+            AllocationStats stats;
+
+            for (const ThreadCounters& slot : impl.ThreadSlots)
+            {
+                Accumulate(stats, slot.Tags[tag]);
+            }
+            Accumulate(stats, impl.SharedCounters.Tags[tag]);
+
+            return stats;
+        }
+
+        void LockTags(AllocationTrackerImpl& impl) noexcept
+        {
+            while (impl.TagLock.test_and_set(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        void UnlockTags(AllocationTrackerImpl& impl) noexcept
+        {
+            impl.TagLock.clear(std::memory_order_release);
+        }
+    } // namespace
+
+    void* TrackedAllocate(size_t size, size_t alignment) noexcept
+    {
+        alignment = std::max(alignment, HeaderSize);
+
+        // Blocks from malloc are aligned for any fundamental type; stricter alignments need slack.
+        size_t overhead = HeaderSize + (alignment > alignof(std::max_align_t) ? alignment - 1 : 0);
+
+        if (size > SIZE_MAX - overhead)
+        {
+            return nullptr;
+        }
+
+        auto raw = static_cast<std::byte*>(std::malloc(size + overhead));
+
+        if (!raw)
+        {
+            return nullptr;
+        }
+
+        uintptr_t address = (reinterpret_cast<uintptr_t>(raw) + HeaderSize + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        auto user = reinterpret_cast<std::byte*>(address);
+
+        auto& impl = AllocationTrackerImpl::GetInstance();
+        uint16_t tag = ThreadTracker.Tag;
+
+        AllocationHeader header{ size, static_cast<uint32_t>(user - raw), tag, 0 };
+        std::memcpy(user - HeaderSize, &header, HeaderSize);
+
+        bool bIsShared;
+        TagCounters& counters = GetThreadCounters(impl, bIsShared).Tags[tag];
+        Add(counters.AllocationCount, 1, bIsShared);
+        Add(counters.AllocatedBytes, size, bIsShared);
+
+        int64_t live = impl.LiveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+        int64_t peak = impl.PeakLiveBytes.load(std::memory_order_relaxed);
+        while (live > peak && !impl.PeakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+
+        if (!impl.bIsActive.load(std::memory_order_relaxed))
+        {
+            impl.bIsActive.store(true, std::memory_order_relaxed);
+        }
+
+        return user;
+    }
+
+    void TrackedFree(void* ptr) noexcept
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        auto user = static_cast<std::byte*>(ptr);
+        AllocationHeader header;
+        std::memcpy(&header, user - HeaderSize, HeaderSize);
+
+        auto& impl = AllocationTrackerImpl::GetInstance();
+
+        bool bIsShared;
+        TagCounters& counters = GetThreadCounters(impl, bIsShared).Tags[header.Tag];
+        Add(counters.DeallocationCount, 1, bIsShared);
+        Add(counters.FreedBytes, header.Size, bIsShared);
+
+        impl.LiveBytes.fetch_sub(static_cast<int64_t>(header.Size), std::memory_order_relaxed);
+
+        std::free(user - header.Offset);
+    }
+
+    AllocationTag::AllocationTag(std::string_view name)
+        : Id(AllocationTracker::RegisterTag(name))
+    {}
+
+    ScopedAllocationTag::ScopedAllocationTag(const AllocationTag& tag) noexcept
+        : PreviousTag(AllocationTracker::ExchangeThreadTag(tag.GetId()))
+    {}
+
+    ScopedAllocationTag::~ScopedAllocationTag()
+    {
+        AllocationTracker::ExchangeThreadTag(PreviousTag);
+    }
+
+    bool AllocationTracker::IsActive() noexcept
+    {
+        return AllocationTrackerImpl::GetInstance().bIsActive.load(std::memory_order_relaxed);
+    }
+
+    AllocationStats AllocationTracker::GetStats() noexcept
+    {
+        auto& impl = AllocationTrackerImpl::GetInstance();
+        AllocationStats stats;
+
+        for (uint16_t tag = 0; tag < MaxTags; ++tag)
+        {
+            AllocationStats tagStats = SumTagCounters(impl, tag);
+            stats.AllocationCount += tagStats.AllocationCount;
+            stats.DeallocationCount += tagStats.DeallocationCount;
+            stats.AllocatedBytes += tagStats.AllocatedBytes;
+            stats.FreedBytes += tagStats.FreedBytes;
+        }
+
+        return stats;
+    }
+
+    AllocationStats AllocationTracker::GetTagStats(const AllocationTag& tag) noexcept
+    {
+        return SumTagCounters(AllocationTrackerImpl::GetInstance(), tag.GetId());
+    }
+
+    AllocationStats AllocationTracker::GetThreadStats() noexcept
+    {
+        bool bIsShared;
+        const ThreadCounters& counters = GetThreadCounters(AllocationTrackerImpl::GetInstance(), bIsShared);
+        AllocationStats stats;
+
+        for (const TagCounters& tagCounters : counters.Tags)
+        {
+            Accumulate(stats, tagCounters);
+        }
+
+        return stats;
+    }
+
+    int64_t AllocationTracker::GetPeakLiveBytes() noexcept
+    {
+        return AllocationTrackerImpl::GetInstance().PeakLiveBytes.load(std::memory_order_relaxed);
+    }
+
+    void AllocationTracker::ReportLeaks()
+    {
+        auto& impl = AllocationTrackerImpl::GetInstance();
+
+        if (!IsActive())
+        {
+            NYX_LOG_INFO(Core, "Allocation tracking is inactive: nyxara_core_memory_operators is not linked");
+            return;
+        }
+
+        AllocationStats stats = GetStats();
+        NYX_LOG_INFO(Core, "Allocations at shutdown: {} live ({} bytes), peak {} bytes, {} allocation(s) in total",
+            stats.GetLiveAllocations(), stats.GetLiveBytes(), GetPeakLiveBytes(), stats.AllocationCount);
+
+        uint16_t tagCount = impl.TagCount.load(std::memory_order_acquire);
+
+        // Untagged memory includes what static objects still own; only tags are reported as leaks.
+        for (uint16_t tag = 1; tag < tagCount; ++tag)
+        {
+            AllocationStats tagStats = SumTagCounters(impl, tag);
+
+            if (tagStats.GetLiveAllocations() != 0)
+            {
+                NYX_LOG_WARN(Core, "Allocation tag '{}' leaked {} allocation(s), {} bytes",
+                    std::string(impl.TagNames[tag]), tagStats.GetLiveAllocations(), tagStats.GetLiveBytes());
+            }
+        }
+    }
+
+    uint16_t AllocationTracker::RegisterTag(std::string_view name)
+    {
+        auto& impl = AllocationTrackerImpl::GetInstance();
+        name = name.substr(0, MaxTagNameSize - 1);
+
+        LockTags(impl);
+
+        uint16_t count = impl.TagCount.load(std::memory_order_relaxed);
+
+        for (uint16_t tag = 0; tag < count; ++tag)
+        {
+            if (name == impl.TagNames[tag])
+            {
+                UnlockTags(impl);
+                return tag;
+            }
+        }
+
+        if (count >= MaxTags)
+        {
+            UnlockTags(impl);
+            throw std::runtime_error("Too many allocation tags registered");
+        }
+
+        std::memcpy(impl.TagNames[count], name.data(), name.size());
+        impl.TagNames[count][name.size()] = '\0';
+        impl.TagCount.store(count + 1, std::memory_order_release);
+
+        UnlockTags(impl);
+        return count;
+    }
+
+    uint16_t AllocationTracker::ExchangeThreadTag(uint16_t tag) noexcept
+    {
+        return std::exchange(ThreadTracker.Tag, tag);
+    }
+} // namespace nyxara::memory
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+namespace nyxara::memory
+{
+    /**
+     * @brief Allocates and counts a block; returns nullptr on failure instead of throwing.
+     *
+     * @param size Requested size in bytes.
+     * @param alignment Required alignment, a power of two.
+     */
+    void* TrackedAllocate(size_t size, size_t alignment) noexcept;
+
+    /**
+     * @brief Counts and frees a block returned by TrackedAllocate(); ignores nullptr.
+     */
+    void TrackedFree(void* ptr) noexcept;
+} // namespace nyxara::memory
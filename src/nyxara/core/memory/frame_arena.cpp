@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include "nyxara/core/memory/frame_arena.h"
+#include "nyxara/core/logging/categories.h"
+
+namespace nyxara::memory
+{
+    namespace
+    {
+        class FrameArenaImpl
+        {
+        public:
+            static FrameArenaImpl& GetInstance()
+            {
+                static FrameArenaImpl instance;
+                return instance;
+            }
+
+            std::mutex Mutex;
+            FrameArenaOptions Options;
+
+        private:
+            FrameArenaImpl() = default;
+        };
+    } // namespace
+
+    FrameArena& FrameArena::GetThreadArena()
+    {
+        thread_local std::unique_ptr<FrameArena> arena;
+
+        if (!arena)
+        {
+            auto& impl = FrameArenaImpl::GetInstance();
+            FrameArenaOptions options;
+            {
+                std::lock_guard lock(impl.Mutex);
+                options = impl.Options;
+            }
+            arena.reset(new FrameArena(options));
+        }
+
+        return *arena;
+    }
+
+    void FrameArena::Configure(const FrameArenaOptions& options)
+    {
+        auto& impl = FrameArenaImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+        impl.Options = options;
+    }
+
+    FrameArena::FrameArena(const FrameArenaOptions& options)
+        : Buffers(std::max<uint32_t>(options.BufferCount, 1)),
+          CurrentFrame(FrameIndex.load(std::memory_order_acquire)),
+          bPoison(options.bPoison),
+          bGrowOnOverflow(options.bGrowOnOverflow)
+    {
+        for (Buffer& buffer : Buffers)
+        {
+            // Left uninitialized: the buffers are large and written before being read.
+            buffer.Memory.reset(new std::byte[options.BufferSize]);
+            buffer.Capacity = options.BufferSize;
+        }
+
+        Current = &Buffers[CurrentFrame % Buffers.size()];
+    }
+
+    FrameArena::~FrameArena()
+    {
+        for (Buffer& buffer : Buffers)
+        {
+            while (OverflowBlock* block = buffer.Overflow)
+            {
+                buffer.Overflow = block->Next;
+                ::operator delete(block, block->Size, std::align_val_t(block->Alignment));
+            }
+        }
+    }
+
+    FrameArenaStats FrameArena::GetStats() const noexcept
+    {
+        FrameArenaStats stats;
+        stats.Capacity = Current->Capacity;
+        stats.UsedBytes = Current->Offset;
+        stats.PeakBytes = std::max(PeakBytes, Current->RequestedBytes);
+        stats.OverflowCount = OverflowCount;
+        stats.OverflowBytes = OverflowBytes;
+        return stats;
+    }
+
+    void FrameArena::SwitchFrame()
+    {
+        CurrentFrame = FrameIndex.load(std::memory_order_acquire);
+        Current = &Buffers[CurrentFrame % Buffers.size()];
+        Rewind(*Current);
+    }
+
+    void FrameArena::Rewind(Buffer& buffer)
+    {
+        bool bHasOverflowed = buffer.Overflow != nullptr;
+
+        while (OverflowBlock* block = buffer.Overflow)
+        {
+            buffer.Overflow = block->Next;
+            ::operator delete(block, block->Size, std::align_val_t(block->Alignment));
+        }
+
+        PeakBytes = std::max(PeakBytes, buffer.RequestedBytes);
+
+        if (bHasOverflowed && bGrowOnOverflow)
+        {
+            // Leave room for alignment padding so the peak frame fits without overflowing again.
+            size_t capacity = std::max(buffer.Capacity * 2, buffer.RequestedBytes + buffer.RequestedBytes / 4);
+
+            buffer.Memory.reset(new std::byte[capacity]);
+            buffer.Capacity = capacity;
+            buffer.Offset = 0;
+
+            NYX_LOG_DEBUG(Core, "Frame arena buffer grown to {} bytes after a {} byte frame", capacity, buffer.RequestedBytes);
+        }
+
+        if (bPoison)
+        {
+            Poison(buffer.Memory.get(), buffer.Offset, 0xDD);
+        }
+
+        buffer.Offset = 0;
+        buffer.RequestedBytes = 0;
+    }
+
+    void* FrameArena::AllocateOverflow(size_t size, size_t alignment)
+    {
+        alignment = std::max(alignment, alignof(OverflowBlock));
+        size_t headerSize = (sizeof(OverflowBlock) + alignment - 1) & ~(alignment - 1);
+
+        auto block = static_cast<OverflowBlock*>(::operator new(headerSize + size, std::align_val_t(alignment)));
+        block->Next = Current->Overflow;
+        block->Size = headerSize + size;
+        block->Alignment = alignment;
+        Current->Overflow = block;
+
+        Current->RequestedBytes += size;
+        ++OverflowCount;
+        OverflowBytes += size;
+
+        void* ptr = reinterpret_cast<std::byte*>(block) + headerSize;
+
+        if (bPoison)
+        {
+            Poison(ptr, size, 0xCD);
+        }
+
+        return ptr;
+    }
+
+    void FrameArena::Poison(void* ptr, size_t size, int value) noexcept
+    {
+        if (ptr)
+        {
+            std::memset(ptr, value, size);
+        }
+    }
+} // namespace nyxara::memory
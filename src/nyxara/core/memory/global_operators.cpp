@@ -0,0 +1,146 @@
+/**
+ * Replacement global operator new and delete counting every allocation.
+ *
+ * Built as the nyxara_core_memory_operators object library: replacement operators must be
+ * linked into the executable itself, which a static library does not guarantee.
+ */
+
+#include <new>
+#include "allocation_tracker_impl.h"
+
+namespace
+{
+    void* AllocateOrThrow(std::size_t size, std::size_t alignment)
+    {
+        for (;;)
+        {
+            if (void* ptr = nyxara::memory::TrackedAllocate(size, alignment))
+            {
+                return ptr;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+
+            if (!handler)
+            {
+                throw std::bad_alloc();
+            }
+
+            handler();
+        }
+    }
+
+    void* AllocateOrNull(std::size_t size, std::size_t alignment) noexcept
+    {
+        try
+        {
+            return AllocateOrThrow(size, alignment);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    constexpr std::size_t DefaultAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    return AllocateOrThrow(size, DefaultAlignment);
+}
+
+void* operator new[](std::size_t size)
+{
+    return AllocateOrThrow(size, DefaultAlignment);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return AllocateOrNull(size, DefaultAlignment);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return AllocateOrNull(size, DefaultAlignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return AllocateOrNull(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return AllocateOrNull(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    nyxara::memory::TrackedFree(ptr);
+}
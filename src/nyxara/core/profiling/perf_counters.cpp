@@ -0,0 +1,374 @@
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include "nyxara/core/profiling/perf_counters.h"
+#include "nyxara/core/logging/categories.h"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace nyxara::profiling
+{
+    namespace
+    {
+        constexpr size_t HardwareCounterCount = PerfCounterCount - 1;
+        constexpr uint32_t AllCountersMask = (1u << PerfCounterCount) - 1;
+
+        class PerfCountersImpl
+        {
+        public:
+            static PerfCountersImpl& GetInstance()
+            {
+                static PerfCountersImpl instance;
+                return instance;
+            }
+
+            std::mutex Mutex;
+
+            // Intrusive list of registered zones, linked through PerfZone::Next.
+            PerfZone* Head = nullptr;
+
+        private:
+            PerfCountersImpl() = default;
+        };
+
+        /**
+         * @brief The calling thread's counter group, opened on first use.
+         */
+        struct ThreadPerfCounters
+        {
+            bool bIsOpened = false;
+            uint32_t AvailableMask = 1u << static_cast<uint32_t>(PerfCounter::Time);
+            int GroupFd = -1;
+
+            // Position of each hardware counter in the group read, or -1 if not opened.
+            std::array<int, HardwareCounterCount> ReadIndex{ -1, -1, -1, -1 };
+            std::array<int, HardwareCounterCount> Fds{ -1, -1, -1, -1 };
+
+            void Open() noexcept;
+
+            ~ThreadPerfCounters()
+            {
+#if defined(__linux__)
+                for (int fd : Fds)
+                {
+                    if (fd >= 0)
+                    {
+                        close(fd);
+                    }
+                }
+#endif
+            }
+        };
+
+        thread_local ThreadPerfCounters ThreadCounters;
+
+        void ThreadPerfCounters::Open() noexcept
+        {
+            bIsOpened = true;
+
+#if defined(__linux__)
+            constexpr uint64_t Configs[HardwareCounterCount] = {
+                PERF_COUNT_HW_CPU_CYCLES,
+                PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_CACHE_MISSES,
+                PERF_COUNT_HW_BRANCH_MISSES,
+            };
+
+            int firstError = 0;
+            int opened = 0;
+
+            // The first counter that opens leads the group; the others follow it so one read() gets them all.
+            for (size_t i = 0; i < HardwareCounterCount; ++i)
+            {
+                perf_event_attr attr{};
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = Configs[i];
+                attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+
+                int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, GroupFd, PERF_FLAG_FD_CLOEXEC));
+
+                if (fd < 0)
+                {
+                    firstError = firstError ? firstError : errno;
+                    continue;
+                }
+
+                if (GroupFd < 0)
+                {
+                    GroupFd = fd;
+                }
+
+                Fds[i] = fd;
+                ReadIndex[i] = opened++;
+                AvailableMask |= 1u << (i + 1);
+            }
+
+            if (firstError != 0)
+            {
+                NYX_LOG_ONCE(Core, ::nyxara::logging::Verbosity::Warn,
+                    "Some hardware performance counters are unavailable ({}); perf zones report them as n/a",
+                    std::strerror(firstError));
+            }
+#else
+            NYX_LOG_ONCE(Core, ::nyxara::logging::Verbosity::Info,
+                "Hardware performance counters are only supported on Linux; perf zones measure time only");
+#endif
+        }
+
+        void AtomicMax(std::atomic<uint64_t>& target, uint64_t value) noexcept
+        {
+            uint64_t current = target.load(std::memory_order_relaxed);
+            while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+    } // namespace
+
+    const char* GetPerfCounterName(PerfCounter counter) noexcept
+    {
+        switch (counter)
+        {
+        case PerfCounter::Time: return "time";
+        case PerfCounter::Cycles: return "cycles";
+        case PerfCounter::Instructions: return "instructions";
+        case PerfCounter::CacheMisses: return "cache misses";
+        case PerfCounter::BranchMisses: return "branch misses";
+        default: return "unknown";
+        }
+    }
+
+    PerfZoneStats PerfZone::GetStats() const noexcept
+    {
+        PerfZoneStats stats;
+        stats.CallCount = CallCount.load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < PerfCounterCount; ++i)
+        {
+            stats.Counters[i].Total = Totals[i].load(std::memory_order_relaxed);
+            stats.Counters[i].Max = Maxima[i].load(std::memory_order_relaxed);
+            stats.Counters[i].Min = stats.CallCount > 0 ? ~InvertedMinima[i].load(std::memory_order_relaxed) : 0;
+        }
+
+        stats.AvailableMask = AllCountersMask & ~MissingMask.load(std::memory_order_relaxed);
+
+        return stats;
+    }
+
+    void PerfZone::Record(const PerfCounterValues& deltas, uint32_t availableMask) noexcept
+    {
+        if (!bIsRegistered.load(std::memory_order_acquire))
+        {
+            PerfCounters::Register(*this);
+        }
+
+        CallCount.fetch_add(1, std::memory_order_relaxed);
+
+        if ((availableMask & AllCountersMask) != AllCountersMask)
+        {
+            MissingMask.fetch_or(AllCountersMask & ~availableMask, std::memory_order_relaxed);
+        }
+
+        for (size_t i = 0; i < PerfCounterCount; ++i)
+        {
+            Totals[i].fetch_add(deltas[i], std::memory_order_relaxed);
+            AtomicMax(Maxima[i], deltas[i]);
+            AtomicMax(InvertedMinima[i], ~deltas[i]);
+        }
+    }
+
+    uint32_t PerfCounters::GetAvailableCounters() noexcept
+    {
+        ThreadPerfCounters& counters = ThreadCounters;
+
+        if (!counters.bIsOpened)
+        {
+            counters.Open();
+        }
+
+        return counters.AvailableMask;
+    }
+
+    void PerfCounters::Read(PerfCounterSample& sample) noexcept
+    {
+        ThreadPerfCounters& counters = ThreadCounters;
+
+        if (!counters.bIsOpened)
+        {
+            counters.Open();
+        }
+
+        sample.AvailableMask = counters.AvailableMask;
+        sample.Values[static_cast<size_t>(PerfCounter::Time)] = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+
+#if defined(__linux__)
+        // PERF_FORMAT_GROUP layout: number of counters, time enabled and running, then their values in opening order.
+        struct
+        {
+            uint64_t Count;
+            uint64_t TimeEnabled;
+            uint64_t TimeRunning;
+            uint64_t Values[HardwareCounterCount];
+        } group{};
+
+        bool bHasRead = counters.GroupFd >= 0 && read(counters.GroupFd, &group, sizeof(group)) > 0;
+        sample.TimeEnabled = bHasRead ? group.TimeEnabled : 0;
+        sample.TimeRunning = bHasRead ? group.TimeRunning : 0;
+
+        for (size_t i = 0; i < HardwareCounterCount; ++i)
+        {
+            int index = counters.ReadIndex[i];
+            sample.Values[i + 1] = bHasRead && index >= 0 && static_cast<uint64_t>(index) < group.Count ? group.Values[index] : 0;
+        }
+#else
+        sample.TimeEnabled = 0;
+        sample.TimeRunning = 0;
+
+        for (size_t i = 1; i < PerfCounterCount; ++i)
+        {
+            sample.Values[i] = 0;
+        }
+#endif
+    }
+
+    PerfCounterValues PerfCounters::GetDeltas(const PerfCounterSample& start, const PerfCounterSample& end) noexcept
+    {
+        PerfCounterValues deltas;
+
+        for (size_t i = 0; i < PerfCounterCount; ++i)
+        {
+            deltas[i] = end.Values[i] >= start.Values[i] ? end.Values[i] - start.Values[i] : 0;
+        }
+
+        // When more events are requested than the PMU has counters, the kernel time-slices the group and it only
+        // counts while running; extrapolate the increments over the whole time it was enabled between the reads.
+        const uint64_t enabled = end.TimeEnabled - start.TimeEnabled;
+        const uint64_t running = end.TimeRunning - start.TimeRunning;
+
+        if (running > 0 && running < enabled)
+        {
+            NYX_LOG_ONCE(Core, ::nyxara::logging::Verbosity::Warn,
+                "Hardware performance counters are multiplexed (running {:.0f}% of the time); perf zones report "
+                "scaled estimates", 100.0 * static_cast<double>(running) / static_cast<double>(enabled));
+
+            const double scale = static_cast<double>(enabled) / static_cast<double>(running);
+
+            for (size_t i = 1; i < PerfCounterCount; ++i)
+            {
+                deltas[i] = static_cast<uint64_t>(static_cast<double>(deltas[i]) * scale);
+            }
+        }
+
+        return deltas;
+    }
+
+    void PerfCounters::Register(PerfZone& zone) noexcept
+    {
+        auto& impl = PerfCountersImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+
+        // Another thread may have registered the zone while this one waited for the lock.
+        if (zone.bIsRegistered.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        zone.Next = impl.Head;
+        impl.Head = &zone;
+        zone.bIsRegistered.store(true, std::memory_order_release);
+    }
+
+    void PerfCounters::ForEachZone(const std::function<void(const PerfZone&)>& callback)
+    {
+        auto& impl = PerfCountersImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+
+        for (const PerfZone* zone = impl.Head; zone; zone = zone->Next)
+        {
+            callback(*zone);
+        }
+    }
+
+    void PerfCounters::Reset() noexcept
+    {
+        auto& impl = PerfCountersImpl::GetInstance();
+
+        std::lock_guard lock(impl.Mutex);
+
+        for (PerfZone* zone = impl.Head; zone; zone = zone->Next)
+        {
+            zone->CallCount.store(0, std::memory_order_relaxed);
+            zone->MissingMask.store(0, std::memory_order_relaxed);
+
+            for (size_t i = 0; i < PerfCounterCount; ++i)
+            {
+                zone->Totals[i].store(0, std::memory_order_relaxed);
+                zone->Maxima[i].store(0, std::memory_order_relaxed);
+                zone->InvertedMinima[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void PerfCounters::LogReport()
+    {
+        ForEachZone([](const PerfZone& zone)
+        {
+            PerfZoneStats stats = zone.GetStats();
+            const uint32_t available = stats.AvailableMask;
+
+            if (stats.CallCount == 0)
+            {
+                return;
+            }
+
+            auto average = [&](PerfCounter counter)
+            {
+                return static_cast<double>(stats.Counters[static_cast<size_t>(counter)].Total)
+                    / static_cast<double>(stats.CallCount);
+            };
+
+            const PerfCounterStats& time = stats.Counters[static_cast<size_t>(PerfCounter::Time)];
+
+            fmt::memory_buffer counters;
+            fmt::format_to(std::back_inserter(counters), "avg {:.2f} us (min {:.2f}, max {:.2f})",
+                average(PerfCounter::Time) / 1000.0, time.Min / 1000.0, time.Max / 1000.0);
+
+            for (size_t i = 1; i < PerfCounterCount; ++i)
+            {
+                auto counter = static_cast<PerfCounter>(i);
+
+                if (available & (1u << i))
+                {
+                    fmt::format_to(std::back_inserter(counters), ", {} {:.1f}", GetPerfCounterName(counter), average(counter));
+                }
+                else
+                {
+                    fmt::format_to(std::back_inserter(counters), ", {} n/a", GetPerfCounterName(counter));
+                }
+            }
+
+            constexpr uint32_t IpcMask = (1u << static_cast<uint32_t>(PerfCounter::Cycles))
+                | (1u << static_cast<uint32_t>(PerfCounter::Instructions));
+            double cycles = average(PerfCounter::Cycles);
+
+            if ((available & IpcMask) == IpcMask && cycles > 0.0)
+            {
+                fmt::format_to(std::back_inserter(counters), ", IPC {:.2f}", average(PerfCounter::Instructions) / cycles);
+            }
+
+            NYX_LOG_INFO(Core, "Perf zone '{}' ({}:{}): {} call(s), {}", zone.GetName(), zone.GetFile(), zone.GetLine(),
+                stats.CallCount, fmt::to_string(counters));
+        });
+    }
+} // namespace nyxara::profiling
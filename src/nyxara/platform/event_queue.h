@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include "nyxara/platform/window_event.h"
+
+namespace nyxara::platform
+{
+	/**
+	 * @brief Fixed-capacity single-producer single-consumer ring of window events.
+	 *
+	 * The producer is the thread pumping the window's events, the consumer whichever
+	 * thread drains them; they may be the same. Draining copies every available event
+	 * at once and publishes the new read position with a single store.
+	 */
+	class EventQueue
+	{
+	public:
+		/**
+		 * @param capacity Maximum number of queued events, rounded up to a power of two.
+		 */
+		explicit EventQueue(size_t capacity)
+			: Capacity(std::bit_ceil(std::max<size_t>(capacity, 2))),
+			  Mask(Capacity - 1),
+			  Events(std::make_unique<WindowEvent[]>(Capacity))
+		{}
+
+		/**
+		 * @brief Appends an event (producer only).
+		 *
+		 * @return False if the queue is full; the event is dropped and counted.
+		 */
+		bool Push(const WindowEvent& event) noexcept
+		{
+			const size_t tail = Tail.load(std::memory_order_relaxed);
+
+			if (tail - CachedHead == Capacity)
+			{
+				CachedHead = Head.load(std::memory_order_acquire);
+
+				if (tail - CachedHead == Capacity)
+				{
+					DroppedCount.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+			}
+
+			Events[tail & Mask] = event;
+			Tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Moves up to `events.size()` of the oldest events into @p events (consumer only).
+		 *
+		 * @return Number of events written.
+		 */
+		size_t Pop(std::span<WindowEvent> events) noexcept
+		{
+			const size_t head = Head.load(std::memory_order_relaxed);
+			const size_t count = std::min(Tail.load(std::memory_order_acquire) - head, events.size());
+
+			// At most two contiguous runs: up to the end of the buffer, then from its start.
+			const size_t first = std::min(count, Capacity - (head & Mask));
+			std::copy_n(&Events[head & Mask], first, events.begin());
+			std::copy_n(&Events[0], count - first, events.begin() + first);
+
+			Head.store(head + count, std::memory_order_release);
+			return count;
+		}
+
+		uint64_t GetDroppedCount() const noexcept { return DroppedCount.load(std::memory_order_relaxed); }
+
+	private:
+		const size_t Capacity;
+		const size_t Mask;
+		std::unique_ptr<WindowEvent[]> Events;
+		std::atomic<uint64_t> DroppedCount{ 0 };
+
+		alignas(64) std::atomic<size_t> Tail{ 0 };	///< Write position, owned by the producer.
+		size_t CachedHead = 0;						///< Producer's last observed read position.
+
+		alignas(64) std::atomic<size_t> Head{ 0 };	///< Read position, owned by the consumer.
+	};
+} // namespace nyxara::platform
@@ -5,10 +5,15 @@
 
 namespace nyxara::platform
 {
+	static_assert(static_cast<int>(InputAction::Release) == GLFW_RELEASE
+		&& static_cast<int>(InputAction::Press) == GLFW_PRESS
+		&& static_cast<int>(InputAction::Repeat) == GLFW_REPEAT, "InputAction must match the GLFW actions");
+
 	class GLFWWindow : public Window
 	{
 	public:
 		explicit GLFWWindow(const WindowCreateInfo& info)
+			: platform::Window(info)
 		{
 			NYX_TRACE_FUNCTION(Platform);
 			NYX_LOG_INFO(Platform, "Creating GLFW window: {}x{}, title: '{}', fullscreen: {}, resizable: {}",
@@ -46,6 +51,16 @@ namespace nyxara::platform
 			}
 
 			glfwMakeContextCurrent(Window);
+
+			glfwSetWindowUserPointer(Window, this);
+			glfwSetWindowCloseCallback(Window, &GLFWWindow::OnClose);
+			glfwSetFramebufferSizeCallback(Window, &GLFWWindow::OnFramebufferSize);
+			glfwSetWindowFocusCallback(Window, &GLFWWindow::OnFocus);
+			glfwSetKeyCallback(Window, &GLFWWindow::OnKey);
+			glfwSetMouseButtonCallback(Window, &GLFWWindow::OnMouseButton);
+			glfwSetCursorPosCallback(Window, &GLFWWindow::OnCursorPos);
+			glfwSetScrollCallback(Window, &GLFWWindow::OnScroll);
+
 			NYX_LOG_INFO(Platform, "GLFW window created and context initialized");
 		}
 
@@ -63,6 +78,27 @@ namespace nyxara::platform
 			glfwPollEvents();
 		}
 
+		void WaitEvents(std::chrono::nanoseconds timeout) override
+		{
+			if (timeout == std::chrono::nanoseconds::max())
+			{
+				glfwWaitEvents();
+			}
+			else if (timeout > std::chrono::nanoseconds::zero())
+			{
+				glfwWaitEventsTimeout(std::chrono::duration<double>(timeout).count());
+			}
+			else
+			{
+				glfwPollEvents();
+			}
+		}
+
+		void Wake() override
+		{
+			glfwPostEmptyEvent();
+		}
+
 		void SwapBuffers() override
 		{
 			glfwSwapBuffers(Window);
@@ -73,13 +109,70 @@ namespace nyxara::platform
 			return glfwWindowShouldClose(Window);
 		}
 
+		uint32_t GetWidth() const override
+		{
+			int width = 0;
+			glfwGetFramebufferSize(Window, &width, nullptr);
+			return static_cast<uint32_t>(width);
+		}
+
+		uint32_t GetHeight() const override
+		{
+			int height = 0;
+			glfwGetFramebufferSize(Window, nullptr, &height);
+			return static_cast<uint32_t>(height);
+		}
+
 	private:
+		static GLFWWindow& GetOwner(GLFWwindow* window)
+		{
+			return *static_cast<GLFWWindow*>(glfwGetWindowUserPointer(window));
+		}
+
+		static void OnClose(GLFWwindow* window)
+		{
+			GetOwner(window).PushEvent({ .Type = WindowEventType::Close });
+		}
+
+		static void OnFramebufferSize(GLFWwindow* window, int width, int height)
+		{
+			GetOwner(window).PushEvent({ .Type = WindowEventType::Resize,
+				.Width = static_cast<uint32_t>(width), .Height = static_cast<uint32_t>(height) });
+		}
+
+		static void OnFocus(GLFWwindow* window, int focused)
+		{
+			GetOwner(window).PushEvent({ .Type = WindowEventType::Focus, .bFocused = focused == GLFW_TRUE });
+		}
+
+		static void OnKey(GLFWwindow* window, int key, int, int action, int mods)
+		{
+			GetOwner(window).PushEvent({ .Type = WindowEventType::Key,
+				.Action = static_cast<InputAction>(action), .Code = key, .Mods = mods });
+		}
+
+		static void OnMouseButton(GLFWwindow* window, int button, int action, int mods)
+		{
+			GetOwner(window).PushEvent({ .Type = WindowEventType::MouseButton,
+				.Action = static_cast<InputAction>(action), .Code = button, .Mods = mods });
+		}
+
+		static void OnCursorPos(GLFWwindow* window, double x, double y)
+		{
+			GetOwner(window).PushEvent({ .Type = WindowEventType::MouseMove, .X = x, .Y = y });
+		}
+
+		static void OnScroll(GLFWwindow* window, double x, double y)
+		{
+			GetOwner(window).PushEvent({ .Type = WindowEventType::Scroll, .X = x, .Y = y });
+		}
+
 		GLFWwindow* Window;
 	};
 
-	Window* CreateGLFWWindow(const WindowCreateInfo& info)
+	std::unique_ptr<Window> CreateGLFWWindow(const WindowCreateInfo& info)
 	{
 		NYX_TRACE_FUNCTION(Platform);
-		return new GLFWWindow(info);
+		return std::make_unique<GLFWWindow>(info);
 	}
 }
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <vector>
+#include "window_impl.h"
+#include "nyxara/core/logging/categories.h"
+
+namespace nyxara::platform
+{
+	/**
+	 * @brief Window without a display: a virtual surface driven by a script of events.
+	 *
+	 * Every PollEvents() call is one frame. The events scripted for that frame are queued,
+	 * Resize and Close events also update the surface size and the close flag, so a run
+	 * is fully deterministic.
+	 */
+	class HeadlessWindow : public Window
+	{
+	public:
+		explicit HeadlessWindow(const WindowCreateInfo& info)
+			: Window(info),
+			  Width(info.Width),
+			  Height(info.Height),
+			  FrameCount(info.HeadlessFrameCount),
+			  Script(info.HeadlessScript.begin(), info.HeadlessScript.end())
+		{
+			NYX_TRACE_FUNCTION(Platform);
+			NYX_LOG_INFO(Platform, "Creating headless window: {}x{}, title: '{}', frames: {}, scripted events: {}",
+				Width, Height, info.Title, FrameCount, Script.size());
+
+			std::stable_sort(Script.begin(), Script.end(),
+				[](const ScriptedWindowEvent& a, const ScriptedWindowEvent& b) { return a.Frame < b.Frame; });
+		}
+
+		void PollEvents() override
+		{
+			for (; NextEvent < Script.size() && Script[NextEvent].Frame <= PolledFrameCount; ++NextEvent)
+			{
+				const WindowEvent& event = Script[NextEvent].Event;
+
+				if (event.Type == WindowEventType::Resize)
+				{
+					Width = event.Width;
+					Height = event.Height;
+				}
+				else if (event.Type == WindowEventType::Close)
+				{
+					bIsCloseRequested = true;
+				}
+
+				PushEvent(event);
+			}
+
+			++PolledFrameCount;
+		}
+
+		void WaitEvents(std::chrono::nanoseconds) override
+		{
+			PollEvents();
+		}
+
+		void Wake() override
+		{
+		}
+
+		void SwapBuffers() override
+		{
+		}
+
+		bool ShouldClose() const override
+		{
+			return bIsCloseRequested || (FrameCount > 0 && PolledFrameCount >= FrameCount);
+		}
+
+		uint32_t GetWidth() const override
+		{
+			return Width;
+		}
+
+		uint32_t GetHeight() const override
+		{
+			return Height;
+		}
+
+	private:
+		uint32_t Width;
+		uint32_t Height;
+		const uint64_t FrameCount;
+		uint64_t PolledFrameCount = 0;
+		bool bIsCloseRequested = false;
+
+		std::vector<ScriptedWindowEvent> Script;
+		size_t NextEvent = 0;
+	};
+
+	std::unique_ptr<Window> CreateHeadlessWindow(const WindowCreateInfo& info)
+	{
+		NYX_TRACE_FUNCTION(Platform);
+		return std::make_unique<HeadlessWindow>(info);
+	}
+}
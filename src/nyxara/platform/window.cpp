@@ -1,21 +1,109 @@
 #include "window_impl.h"
+#include "event_queue.h"
 #include "nyxara/core/logging/categories.h"
+#include "nyxara/core/memory/handle_pool.h"
+#include <memory>
 #include <stdexcept>
 
 namespace nyxara::platform
 {
-	Window* Window::Create(const WindowCreateInfo& info)
+	namespace
+	{
+		class WindowRegistry
+		{
+		public:
+			static WindowRegistry& GetInstance()
+			{
+				static WindowRegistry instance;
+				return instance;
+			}
+
+			// Windows are polymorphic, so the pool stores owners; the pointed-to windows never move.
+			memory::HandlePool<std::unique_ptr<Window>, Window> Windows;
+
+		private:
+			WindowRegistry() = default;
+		};
+	}
+
+	WindowHandle Window::Create(const WindowCreateInfo& info)
 	{
 		NYX_TRACE_FUNCTION(Platform);
 
+		std::unique_ptr<Window> window;
+
 		switch (info.Backend)
 		{
+#if NYXARA_HAS_GLFW
 		case WindowBackend::GLFW:
 			NYX_LOG_INFO(Platform, "Creating window with GLFW backend");
-			return CreateGLFWWindow(info);
+			window = CreateGLFWWindow(info);
+			break;
+#endif
+		case WindowBackend::Headless:
+			NYX_LOG_INFO(Platform, "Creating window with headless backend");
+			window = CreateHeadlessWindow(info);
+			break;
 		default:
 			NYX_LOG_CRITICAL(Platform, "Unsupported window backend: {}", static_cast<int>(info.Backend));
 			throw std::runtime_error("Unsupported window backend");
 		}
+
+		return WindowRegistry::GetInstance().Windows.Create(std::move(window));
+	}
+
+	void Window::Destroy(WindowHandle handle)
+	{
+		NYX_TRACE_FUNCTION(Platform);
+
+		if (!WindowRegistry::GetInstance().Windows.Destroy(handle))
+		{
+			NYX_LOG_WARN(Platform, "Ignoring destruction of a stale window handle ({:#x})", handle.GetValue());
+		}
+	}
+
+	Window::Window(const WindowCreateInfo& info)
+		: Events(std::make_unique<EventQueue>(info.EventQueueCapacity))
+	{
+	}
+
+	Window::~Window() = default;
+
+	size_t Window::DrainEvents(std::span<WindowEvent> events)
+	{
+		return Events->Pop(events);
+	}
+
+	uint64_t Window::GetDroppedEventCount() const
+	{
+		return Events->GetDroppedCount();
+	}
+
+	void Window::PushEvent(const WindowEvent& event)
+	{
+		bool bIsQueued;
+
+		if (event.Timestamp == std::chrono::steady_clock::time_point{})
+		{
+			WindowEvent stamped = event;
+			stamped.Timestamp = std::chrono::steady_clock::now();
+			bIsQueued = Events->Push(stamped);
+		}
+		else
+		{
+			bIsQueued = Events->Push(event);
+		}
+
+		if (!bIsQueued)
+		{
+			NYX_LOG_EVERY_MS(Platform, ::nyxara::logging::Verbosity::Warn, 1000,
+				"Window event queue full, {} event(s) dropped so far", Events->GetDroppedCount());
+		}
+	}
+
+	Window* Window::Get(WindowHandle handle)
+	{
+		std::unique_ptr<Window>* window = WindowRegistry::GetInstance().Windows.Get(handle);
+		return window ? window->get() : nullptr;
 	}
-}
\ No newline at end of file
+}
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <memory>
 #include "nyxara/platform/window.h"
 
 namespace nyxara::platform
 {
-	Window* CreateGLFWWindow(const WindowCreateInfo& info);
+#if NYXARA_HAS_GLFW
+	std::unique_ptr<Window> CreateGLFWWindow(const WindowCreateInfo& info);
+#endif
+
+	std::unique_ptr<Window> CreateHeadlessWindow(const WindowCreateInfo& info);
 }
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include "nyxara/renderer/vulkan/command_recorder.h"
+#include "nyxara/renderer/vulkan/device.h"
+#include "nyxara/core/logging/categories.h"
+
+namespace nyxara::renderer
+{
+    /**
+     * @brief Command pool of one thread for one frame slot, with the secondary command buffers allocated from it.
+     */
+    struct alignas(64) CommandRecorder::ThreadPool
+    {
+        vk::raii::CommandPool Pool{ nullptr };
+
+        // Reused every frame after the pool is reset; only grows.
+        std::vector<vk::raii::CommandBuffer> Buffers;
+        size_t UsedCount = 0;
+    };
+
+    struct CommandRecorder::FrameResources
+    {
+        vk::raii::CommandPool PrimaryPool{ nullptr };
+        vk::raii::CommandBuffer Primary{ nullptr };
+        std::vector<ThreadPool> ThreadPools;
+
+        // Set while a thread outside the job system records into the matching external pool.
+        std::array<std::atomic<bool>, ExternalPoolCount> bIsExternalPoolTaken{};
+    };
+
+    CommandRecorder::CommandRecorder(const VulkanDevice& device, uint32_t framesInFlight)
+        : Device(device.GetDevice()),
+          QueueFamily(device.GetGraphicsQueueFamily()),
+          ParticipantCount(std::max(jobs::JobSystem::GetParticipantCount(), 1u)),
+          ThreadPoolCount(ParticipantCount + ExternalPoolCount)
+    {
+        NYX_TRACE_FUNCTION(Renderer);
+
+        vk::CommandPoolCreateInfo poolInfo;
+        poolInfo.flags = vk::CommandPoolCreateFlagBits::eTransient;
+        poolInfo.queueFamilyIndex = QueueFamily;
+
+        for (uint32_t slot = 0; slot < std::max(framesInFlight, 1u); ++slot)
+        {
+            auto frame = std::make_unique<FrameResources>();
+            frame->PrimaryPool = vk::raii::CommandPool(Device, poolInfo);
+
+            vk::CommandBufferAllocateInfo allocateInfo;
+            allocateInfo.commandPool = *frame->PrimaryPool;
+            allocateInfo.level = vk::CommandBufferLevel::ePrimary;
+            allocateInfo.commandBufferCount = 1;
+            frame->Primary = std::move(vk::raii::CommandBuffers(Device, allocateInfo).front());
+
+            frame->ThreadPools.resize(ThreadPoolCount);
+
+            for (ThreadPool& pool : frame->ThreadPools)
+            {
+                pool.Pool = vk::raii::CommandPool(Device, poolInfo);
+            }
+
+            Frames.push_back(std::move(frame));
+        }
+
+        NYX_LOG_DEBUG(Renderer, "Command recorder created: {} frame slot(s), {} command pool(s) per slot",
+            Frames.size(), ThreadPoolCount);
+    }
+
+    CommandRecorder::~CommandRecorder() = default;
+
+    vk::raii::CommandBuffer& CommandRecorder::BeginFrame(uint32_t frameSlot)
+    {
+        CurrentFrame = Frames[frameSlot % Frames.size()].get();
+
+        // One reset per pool returns every command buffer of the slot to the initial state.
+        CurrentFrame->PrimaryPool.reset();
+
+        for (ThreadPool& pool : CurrentFrame->ThreadPools)
+        {
+            if (pool.UsedCount > 0)
+            {
+                pool.Pool.reset();
+                pool.UsedCount = 0;
+            }
+        }
+
+        vk::CommandBufferBeginInfo beginInfo;
+        beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+        CurrentFrame->Primary.begin(beginInfo);
+
+        return CurrentFrame->Primary;
+    }
+
+    vk::raii::CommandBuffer& CommandRecorder::EndFrame()
+    {
+        CurrentFrame->Primary.end();
+        return CurrentFrame->Primary;
+    }
+
+    uint32_t CommandRecorder::BeginBatches(uint32_t count, uint32_t minBatchSize)
+    {
+        // Jobs submitted from other threads are heap allocated and queued under a lock.
+        if (jobs::JobSystem::IsRunning() && jobs::JobSystem::GetThreadIndex() >= ParticipantCount)
+        {
+            throw std::runtime_error("CommandRecorder::RecordParallel() called outside the job system; attach the thread first");
+        }
+
+        // Depends only on the item and thread counts, so the split is the same every frame.
+        const uint32_t maxBatchCount = ParticipantCount * BatchesPerThread;
+        const uint32_t batchCount = count > 0 ? std::clamp(count / std::max(minBatchSize, 1u), 1u, maxBatchCount) : 0;
+
+        BatchBuffers.assign(batchCount, nullptr);
+        return batchCount;
+    }
+
+    CommandRecorder::ThreadPool& CommandRecorder::AcquirePool() noexcept
+    {
+        const uint32_t threadIndex = jobs::JobSystem::GetThreadIndex();
+
+        if (threadIndex < ParticipantCount)
+        {
+            return CurrentFrame->ThreadPools[threadIndex];
+        }
+
+        // A thread outside the job system that picked up a batch from JobSystem::Wait(): rare,
+        // and a pool is never recorded into by two threads, so take one of its own.
+        for (;;)
+        {
+            for (uint32_t i = 0; i < ExternalPoolCount; ++i)
+            {
+                if (!CurrentFrame->bIsExternalPoolTaken[i].exchange(true, std::memory_order_acquire))
+                {
+                    return CurrentFrame->ThreadPools[ParticipantCount + i];
+                }
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    void CommandRecorder::ReleasePool(ThreadPool& pool) noexcept
+    {
+        const size_t index = static_cast<size_t>(&pool - CurrentFrame->ThreadPools.data());
+
+        if (index >= ParticipantCount)
+        {
+            CurrentFrame->bIsExternalPoolTaken[index - ParticipantCount].store(false, std::memory_order_release);
+        }
+    }
+
+    vk::raii::CommandBuffer& CommandRecorder::BeginSecondary(ThreadPool& pool,
+        const vk::CommandBufferInheritanceRenderingInfo& rendering)
+    {
+        if (pool.UsedCount == pool.Buffers.size())
+        {
+            vk::CommandBufferAllocateInfo allocateInfo;
+            allocateInfo.commandPool = *pool.Pool;
+            allocateInfo.level = vk::CommandBufferLevel::eSecondary;
+            allocateInfo.commandBufferCount = static_cast<uint32_t>(std::max<size_t>(pool.Buffers.size(), BatchesPerThread));
+
+            for (vk::raii::CommandBuffer& buffer : vk::raii::CommandBuffers(Device, allocateInfo))
+            {
+                pool.Buffers.push_back(std::move(buffer));
+            }
+        }
+
+        vk::raii::CommandBuffer& commands = pool.Buffers[pool.UsedCount++];
+
+        vk::CommandBufferInheritanceInfo inheritance;
+        inheritance.pNext = &rendering;
+
+        vk::CommandBufferBeginInfo beginInfo;
+        beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+        beginInfo.pInheritanceInfo = &inheritance;
+        commands.begin(beginInfo);
+
+        return commands;
+    }
+
+    void CommandRecorder::ExecuteBatches()
+    {
+        if (!BatchBuffers.empty())
+        {
+            CurrentFrame->Primary.executeCommands(BatchBuffers);
+        }
+    }
+} // namespace nyxara::renderer
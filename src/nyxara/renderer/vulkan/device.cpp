@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "nyxara/renderer/vulkan/device.h"
+#include "nyxara/core/logging/categories.h"
+
+namespace nyxara::renderer
+{
+    namespace
+    {
+        constexpr const char* ValidationLayerName = "VK_LAYER_KHRONOS_validation";
+
+        VKAPI_ATTR VkBool32 VKAPI_CALL OnDebugMessage(VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+            VkDebugUtilsMessageTypeFlagsEXT, const VkDebugUtilsMessengerCallbackDataEXT* data, void*)
+        {
+            if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
+            {
+                NYX_LOG_ERROR(Renderer, "{}", data->pMessage);
+            }
+            else
+            {
+                NYX_LOG_WARN(Renderer, "{}", data->pMessage);
+            }
+
+            return VK_FALSE;
+        }
+
+        template<typename Properties>
+        bool Contains(const std::vector<Properties>& properties, const char* name)
+        {
+            return std::any_of(properties.begin(), properties.end(), [name](const Properties& property)
+            {
+                if constexpr (std::is_same_v<Properties, vk::LayerProperties>)
+                {
+                    return std::strcmp(property.layerName.data(), name) == 0;
+                }
+                else
+                {
+                    return std::strcmp(property.extensionName.data(), name) == 0;
+                }
+            });
+        }
+
+        /**
+         * @brief Finds a family supporting graphics and compute; the spec guarantees one if any supports graphics.
+         */
+        bool FindGraphicsQueueFamily(const std::vector<vk::QueueFamilyProperties>& families, uint32_t& family)
+        {
+            const vk::QueueFlags required = vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute;
+
+            for (uint32_t i = 0; i < families.size(); ++i)
+            {
+                if ((families[i].queueFlags & required) == required && families[i].queueCount > 0)
+                {
+                    family = i;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Finds a transfer-only family, usually backed by a copy engine, or falls back to @p graphicsFamily.
+         */
+        uint32_t FindTransferQueueFamily(const std::vector<vk::QueueFamilyProperties>& families, uint32_t graphicsFamily)
+        {
+            for (uint32_t i = 0; i < families.size(); ++i)
+            {
+                const vk::QueueFlags flags = families[i].queueFlags;
+
+                if ((flags & vk::QueueFlagBits::eTransfer)
+                    && !(flags & (vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute))
+                    && families[i].queueCount > 0)
+                {
+                    return i;
+                }
+            }
+
+            return graphicsFamily;
+        }
+
+        int GetDeviceTypeScore(vk::PhysicalDeviceType type)
+        {
+            switch (type)
+            {
+            case vk::PhysicalDeviceType::eDiscreteGpu: return 4;
+            case vk::PhysicalDeviceType::eIntegratedGpu: return 3;
+            case vk::PhysicalDeviceType::eVirtualGpu: return 2;
+            case vk::PhysicalDeviceType::eCpu: return 1;
+            default: return 0;
+            }
+        }
+
+        /**
+         * @brief Checks a physical device against the engine's requirements.
+         *
+         * @return Why the device cannot be used, or null if it can.
+         */
+        const char* GetUnsuitableReason(const vk::raii::PhysicalDevice& device, const vk::PhysicalDeviceProperties& properties,
+            const VulkanDeviceCreateInfo& info)
+        {
+            if (properties.apiVersion < VulkanDevice::ApiVersion)
+            {
+                return "Vulkan 1.3 not supported";
+            }
+
+            uint32_t graphicsFamily;
+
+            if (!FindGraphicsQueueFamily(device.getQueueFamilyProperties(), graphicsFamily))
+            {
+                return "no graphics queue";
+            }
+
+            const auto features = device.getFeatures2<vk::PhysicalDeviceFeatures2,
+                vk::PhysicalDeviceVulkan12Features, vk::PhysicalDeviceVulkan13Features>();
+            const auto& features12 = features.get<vk::PhysicalDeviceVulkan12Features>();
+            const auto& features13 = features.get<vk::PhysicalDeviceVulkan13Features>();
+
+            if (!features12.timelineSemaphore || !features13.synchronization2 || !features13.dynamicRendering)
+            {
+                return "missing timeline semaphores, synchronization2 or dynamic rendering";
+            }
+
+            const std::vector<vk::ExtensionProperties> extensions = device.enumerateDeviceExtensionProperties();
+
+            for (const char* extension : info.DeviceExtensions)
+            {
+                if (!Contains(extensions, extension))
+                {
+                    return "missing a required device extension";
+                }
+            }
+
+            return nullptr;
+        }
+    } // namespace
+
+    VulkanDevice::VulkanDevice(const VulkanDeviceCreateInfo& info)
+    {
+        NYX_TRACE_FUNCTION(Renderer);
+
+        CreateInstance(info);
+        SelectPhysicalDevice(info);
+        CreateDevice(info);
+    }
+
+    void VulkanDevice::CreateInstance(const VulkanDeviceCreateInfo& info)
+    {
+        const uint32_t loaderVersion = Context.enumerateInstanceVersion();
+
+        if (loaderVersion < ApiVersion)
+        {
+            NYX_LOG_CRITICAL(Renderer, "Vulkan loader supports {}.{}, 1.3 is required",
+                VK_API_VERSION_MAJOR(loaderVersion), VK_API_VERSION_MINOR(loaderVersion));
+            throw std::runtime_error("Vulkan 1.3 loader required");
+        }
+
+        const std::vector<vk::ExtensionProperties> availableExtensions = Context.enumerateInstanceExtensionProperties();
+        std::vector<const char*> extensions(info.InstanceExtensions.begin(), info.InstanceExtensions.end());
+        std::vector<const char*> layers;
+        vk::InstanceCreateFlags flags;
+
+        // Lets the loader report non-conformant implementations such as MoltenVK.
+        if (Contains(availableExtensions, VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME))
+        {
+            extensions.push_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
+            flags |= vk::InstanceCreateFlagBits::eEnumeratePortabilityKHR;
+        }
+
+        bool bUseDebugMessenger = false;
+
+        if (info.bEnableValidation)
+        {
+            if (Contains(Context.enumerateInstanceLayerProperties(), ValidationLayerName))
+            {
+                layers.push_back(ValidationLayerName);
+            }
+            else
+            {
+                NYX_LOG_WARN(Renderer, "Validation requested but {} is not installed", ValidationLayerName);
+            }
+
+            if (Contains(availableExtensions, VK_EXT_DEBUG_UTILS_EXTENSION_NAME))
+            {
+                extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+                bUseDebugMessenger = true;
+            }
+        }
+
+        vk::ApplicationInfo applicationInfo;
+        applicationInfo.pApplicationName = info.ApplicationName;
+        applicationInfo.applicationVersion = info.ApplicationVersion;
+        applicationInfo.pEngineName = "Nyxara";
+        applicationInfo.engineVersion = VK_MAKE_API_VERSION(0, 0, 1, 0);
+        applicationInfo.apiVersion = ApiVersion;
+
+        vk::InstanceCreateInfo createInfo;
+        createInfo.flags = flags;
+        createInfo.pApplicationInfo = &applicationInfo;
+        createInfo.enabledLayerCount = static_cast<uint32_t>(layers.size());
+        createInfo.ppEnabledLayerNames = layers.data();
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        createInfo.ppEnabledExtensionNames = extensions.data();
+
+        Instance = vk::raii::Instance(Context, createInfo);
+
+        NYX_LOG_INFO(Renderer, "Vulkan instance created: loader {}.{}.{}, {} layer(s), {} extension(s)",
+            VK_API_VERSION_MAJOR(loaderVersion), VK_API_VERSION_MINOR(loaderVersion), VK_API_VERSION_PATCH(loaderVersion),
+            layers.size(), extensions.size());
+
+        if (bUseDebugMessenger)
+        {
+            vk::DebugUtilsMessengerCreateInfoEXT messengerInfo;
+            messengerInfo.messageSeverity = vk::DebugUtilsMessageSeverityFlagBitsEXT::eWarning
+                | vk::DebugUtilsMessageSeverityFlagBitsEXT::eError;
+            messengerInfo.messageType = vk::DebugUtilsMessageTypeFlagBitsEXT::eGeneral
+                | vk::DebugUtilsMessageTypeFlagBitsEXT::eValidation
+                | vk::DebugUtilsMessageTypeFlagBitsEXT::ePerformance;
+            // Newer Vulkan-Hpp versions declare the callback with C++ types of the same layout.
+            messengerInfo.pfnUserCallback = reinterpret_cast<decltype(messengerInfo.pfnUserCallback)>(&OnDebugMessage);
+
+            DebugMessenger = vk::raii::DebugUtilsMessengerEXT(Instance, messengerInfo);
+        }
+    }
+
+    void VulkanDevice::SelectPhysicalDevice(const VulkanDeviceCreateInfo& info)
+    {
+        std::vector<vk::raii::PhysicalDevice> devices = Instance.enumeratePhysicalDevices();
+        size_t best = devices.size();
+        int bestScore = 0;
+
+        for (size_t i = 0; i < devices.size(); ++i)
+        {
+            const vk::PhysicalDeviceProperties properties = devices[i].getProperties();
+            const char* name = properties.deviceName.data();
+
+            if (const char* reason = GetUnsuitableReason(devices[i], properties, info))
+            {
+                NYX_LOG_DEBUG(Renderer, "Skipping Vulkan device {}: {}", name, reason);
+                continue;
+            }
+
+            int score = GetDeviceTypeScore(properties.deviceType);
+
+            if (info.PreferredDevice && std::strstr(name, info.PreferredDevice))
+            {
+                score += 100;
+            }
+
+            NYX_LOG_DEBUG(Renderer, "Suitable Vulkan device {} ({}), score {}", name,
+                vk::to_string(properties.deviceType), score);
+
+            if (best == devices.size() || score > bestScore)
+            {
+                best = i;
+                bestScore = score;
+            }
+        }
+
+        if (best == devices.size())
+        {
+            NYX_LOG_CRITICAL(Renderer, "None of the {} Vulkan device(s) supports Vulkan 1.3 with the required features",
+                devices.size());
+            throw std::runtime_error("No suitable Vulkan device");
+        }
+
+        PhysicalDevice = std::move(devices[best]);
+        Properties = PhysicalDevice.getProperties();
+
+        if (info.PreferredDevice && !std::strstr(Properties.deviceName.data(), info.PreferredDevice))
+        {
+            NYX_LOG_WARN(Renderer, "No suitable Vulkan device matches '{}'", info.PreferredDevice);
+        }
+
+        NYX_LOG_INFO(Renderer, "Using Vulkan device {} ({}), Vulkan {}.{}.{}, driver version {:#x}",
+            Properties.deviceName.data(), vk::to_string(Properties.deviceType), VK_API_VERSION_MAJOR(Properties.apiVersion),
+            VK_API_VERSION_MINOR(Properties.apiVersion), VK_API_VERSION_PATCH(Properties.apiVersion), Properties.driverVersion);
+    }
+
+    void VulkanDevice::CreateDevice(const VulkanDeviceCreateInfo& info)
+    {
+        const std::vector<vk::QueueFamilyProperties> families = PhysicalDevice.getQueueFamilyProperties();
+        FindGraphicsQueueFamily(families, GraphicsQueueFamily);
+        TransferQueueFamily = FindTransferQueueFamily(families, GraphicsQueueFamily);
+
+        const float priority = 1.0f;
+        std::vector<vk::DeviceQueueCreateInfo> queues;
+
+        for (uint32_t family : { GraphicsQueueFamily, TransferQueueFamily })
+        {
+            if (queues.empty() || queues.front().queueFamilyIndex != family)
+            {
+                vk::DeviceQueueCreateInfo queueInfo;
+                queueInfo.queueFamilyIndex = family;
+                queueInfo.queueCount = 1;
+                queueInfo.pQueuePriorities = &priority;
+                queues.push_back(queueInfo);
+            }
+        }
+
+        std::vector<const char*> extensions(info.DeviceExtensions.begin(), info.DeviceExtensions.end());
+
+        // Optional: lets the memory allocator report the budget granted to the process instead of guessing it.
+        bHasMemoryBudget = Contains(PhysicalDevice.enumerateDeviceExtensionProperties(), VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+        if (bHasMemoryBudget && std::none_of(extensions.begin(), extensions.end(),
+            [](const char* name) { return std::strcmp(name, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0; }))
+        {
+            extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        }
+
+        vk::StructureChain<vk::DeviceCreateInfo, vk::PhysicalDeviceFeatures2,
+            vk::PhysicalDeviceVulkan12Features, vk::PhysicalDeviceVulkan13Features> chain;
+
+        vk::DeviceCreateInfo& createInfo = chain.get<vk::DeviceCreateInfo>();
+        createInfo.queueCreateInfoCount = static_cast<uint32_t>(queues.size());
+        createInfo.pQueueCreateInfos = queues.data();
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        createInfo.ppEnabledExtensionNames = extensions.data();
+
+        chain.get<vk::PhysicalDeviceVulkan12Features>().timelineSemaphore = VK_TRUE;
+        chain.get<vk::PhysicalDeviceVulkan13Features>().synchronization2 = VK_TRUE;
+        chain.get<vk::PhysicalDeviceVulkan13Features>().dynamicRendering = VK_TRUE;
+
+        Device = vk::raii::Device(PhysicalDevice, createInfo);
+        GraphicsQueue = vk::raii::Queue(Device, GraphicsQueueFamily, 0);
+        TransferQueue = vk::raii::Queue(Device, TransferQueueFamily, 0);
+
+        NYX_LOG_INFO(Renderer, "Vulkan device created: graphics queue family {}, transfer queue family {}{}",
+            GraphicsQueueFamily, TransferQueueFamily, HasDedicatedTransferQueue() ? " (dedicated)" : "");
+    }
+
+    void VulkanDevice::SubmitGraphics(const vk::SubmitInfo2& submitInfo, vk::Fence fence) const
+    {
+        std::lock_guard lock(GraphicsQueueMutex);
+        GraphicsQueue.submit2(submitInfo, fence);
+    }
+
+    void VulkanDevice::SubmitTransfer(const vk::SubmitInfo2& submitInfo, vk::Fence fence) const
+    {
+        std::lock_guard lock(HasDedicatedTransferQueue() ? TransferQueueMutex : GraphicsQueueMutex);
+        TransferQueue.submit2(submitInfo, fence);
+    }
+} // namespace nyxara::renderer
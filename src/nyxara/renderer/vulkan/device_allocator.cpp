@@ -0,0 +1,451 @@
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include "nyxara/renderer/vulkan/device_allocator.h"
+#include "nyxara/renderer/vulkan/device.h"
+#include "nyxara/core/logging/categories.h"
+
+namespace nyxara::renderer
+{
+    namespace
+    {
+        constexpr uint32_t NoBlock = ~0u;
+
+        constexpr vk::DeviceSize AlignUp(vk::DeviceSize value, vk::DeviceSize alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        int CountFlags(vk::MemoryPropertyFlags flags) noexcept
+        {
+            return std::popcount(static_cast<VkMemoryPropertyFlags>(flags));
+        }
+
+        double ToMebibytes(vk::DeviceSize bytes) noexcept
+        {
+            return static_cast<double>(bytes) / (1024.0 * 1024.0);
+        }
+    } // namespace
+
+    DeviceAllocator::DeviceAllocator(const VulkanDevice& device, const DeviceAllocatorOptions& options)
+        : Device(device.GetDevice()),
+          PhysicalDevice(device.GetPhysicalDevice()),
+          bHasMemoryBudget(device.HasMemoryBudget()),
+          Options(options),
+          MemoryProperties(PhysicalDevice.getMemoryProperties()),
+          BufferImageGranularity(device.GetProperties().limits.bufferImageGranularity),
+          NonCoherentAtomSize(device.GetProperties().limits.nonCoherentAtomSize),
+          MaxDeviceMemoryCount(device.GetProperties().limits.maxMemoryAllocationCount)
+    {
+        for (uint32_t type = 0; type < MemoryProperties.memoryTypeCount; ++type)
+        {
+            // Small heaps, such as the 256 MiB device-local host-visible one without resizable BAR, get smaller blocks.
+            const vk::DeviceSize heapSize = MemoryProperties.memoryHeaps[MemoryProperties.memoryTypes[type].heapIndex].size;
+            BlockSizes[type] = std::min(Options.BlockSize, heapSize / 8);
+        }
+
+        NYX_LOG_DEBUG(Renderer, "Device allocator created: {} memory type(s) in {} heap(s), {:.0f} MiB blocks, "
+            "buffer/image granularity {}, budget {}", MemoryProperties.memoryTypeCount, MemoryProperties.memoryHeapCount,
+            ToMebibytes(Options.BlockSize), BufferImageGranularity, bHasMemoryBudget ? "queried" : "estimated");
+    }
+
+    DeviceAllocator::~DeviceAllocator()
+    {
+        const DeviceAllocatorStats stats = GetStats();
+
+        if (stats.AllocationCount > 0 || stats.SeparateCount > 0)
+        {
+            NYX_LOG_ERROR(Renderer, "Device allocator destroyed with {} allocation(s) ({:.1f} MiB) and {} separate "
+                "allocation(s) ({:.1f} MiB) alive", stats.AllocationCount, ToMebibytes(stats.UsedBytes), stats.SeparateCount,
+                ToMebibytes(stats.SeparateBytes));
+        }
+    }
+
+    DeviceAllocation DeviceAllocator::Allocate(const vk::MemoryRequirements& requirements, vk::MemoryPropertyFlags required,
+        vk::MemoryPropertyFlags preferred, ResourceTiling tiling)
+    {
+        const std::vector<uint32_t> memoryTypes = GetMemoryTypes(requirements.memoryTypeBits, required, preferred);
+
+        if (memoryTypes.empty())
+        {
+            NYX_LOG_ERROR(Renderer, "No memory type has flags {} among types {:#x}", vk::to_string(required),
+                requirements.memoryTypeBits);
+            throw std::runtime_error("No suitable memory type");
+        }
+
+        std::lock_guard lock(Mutex);
+        DeviceAllocation allocation;
+
+        for (uint32_t memoryType : memoryTypes)
+        {
+            if (AllocateFromType(memoryType, requirements, tiling, allocation))
+            {
+                return allocation;
+            }
+        }
+
+        NYX_LOG_ERROR(Renderer, "Out of device memory allocating {} bytes with flags {}", requirements.size,
+            vk::to_string(required));
+        throw std::runtime_error("Out of device memory");
+    }
+
+    void DeviceAllocator::Free(DeviceAllocation& allocation)
+    {
+        if (!allocation)
+        {
+            return;
+        }
+
+        std::lock_guard lock(Mutex);
+        MemoryBlock& block = *Blocks[allocation.BlockIndex];
+
+        if (!block.Ranges)
+        {
+            DestroyBlock(allocation.BlockIndex);
+        }
+        else
+        {
+            block.Ranges->Free(allocation.RangeHandle);
+
+            // Keep one empty block per memory type, so allocations going up and down do not thrash device memory.
+            std::vector<uint32_t>& typeBlocks = TypeBlocks[block.MemoryTypeIndex];
+
+            if (block.Ranges->IsEmpty() && std::any_of(typeBlocks.begin(), typeBlocks.end(), [&](uint32_t index)
+            {
+                return index != allocation.BlockIndex && Blocks[index]->Ranges->IsEmpty();
+            }))
+            {
+                typeBlocks.erase(std::find(typeBlocks.begin(), typeBlocks.end(), allocation.BlockIndex));
+                DestroyBlock(allocation.BlockIndex);
+            }
+        }
+
+        allocation = {};
+    }
+
+    vk::raii::Buffer DeviceAllocator::CreateBuffer(const vk::BufferCreateInfo& createInfo, vk::MemoryPropertyFlags required,
+        vk::MemoryPropertyFlags preferred, DeviceAllocation& allocation)
+    {
+        vk::raii::Buffer buffer(Device, createInfo);
+        allocation = Allocate(buffer.getMemoryRequirements(), required, preferred, ResourceTiling::Linear);
+
+        try
+        {
+            buffer.bindMemory(allocation.Memory, allocation.Offset);
+        }
+        catch (...)
+        {
+            Free(allocation);
+            throw;
+        }
+
+        return buffer;
+    }
+
+    vk::raii::Image DeviceAllocator::CreateImage(const vk::ImageCreateInfo& createInfo, vk::MemoryPropertyFlags required,
+        vk::MemoryPropertyFlags preferred, DeviceAllocation& allocation)
+    {
+        const ResourceTiling tiling = createInfo.tiling == vk::ImageTiling::eOptimal
+            ? ResourceTiling::Optimal : ResourceTiling::Linear;
+
+        vk::raii::Image image(Device, createInfo);
+        allocation = Allocate(image.getMemoryRequirements(), required, preferred, tiling);
+
+        try
+        {
+            image.bindMemory(allocation.Memory, allocation.Offset);
+        }
+        catch (...)
+        {
+            Free(allocation);
+            throw;
+        }
+
+        return image;
+    }
+
+    void DeviceAllocator::Flush(const DeviceAllocation& allocation) const
+    {
+        // Ranges of non-coherent memory are aligned to nonCoherentAtomSize, as flushes require.
+        if (allocation && IsNonCoherent(allocation.MemoryTypeIndex))
+        {
+            Device.flushMappedMemoryRanges(vk::MappedMemoryRange(allocation.Memory, allocation.Offset, allocation.Size));
+        }
+    }
+
+    DeviceAllocatorStats DeviceAllocator::GetStats() const
+    {
+        DeviceAllocatorStats stats;
+        stats.MaxDeviceMemoryCount = MaxDeviceMemoryCount;
+        stats.bHasMemoryBudget = bHasMemoryBudget;
+        stats.Heaps.resize(MemoryProperties.memoryHeapCount);
+
+        vk::DeviceSize freeBytes = 0;
+        vk::DeviceSize largestRangeBytes = 0;
+
+        {
+            std::lock_guard lock(Mutex);
+            stats.DeviceMemoryCount = DeviceMemoryCount;
+
+            for (const std::unique_ptr<MemoryBlock>& block : Blocks)
+            {
+                if (!block)
+                {
+                    continue;
+                }
+
+                stats.Heaps[MemoryProperties.memoryTypes[block->MemoryTypeIndex].heapIndex].AllocatedBytes += block->Size;
+
+                if (!block->Ranges)
+                {
+                    ++stats.SeparateCount;
+                    stats.SeparateBytes += block->Size;
+                    continue;
+                }
+
+                const TlsfAllocatorStats rangeStats = block->Ranges->GetStats();
+
+                ++stats.BlockCount;
+                stats.BlockBytes += block->Size;
+                stats.UsedBytes += rangeStats.UsedBytes;
+                stats.AllocationCount += rangeStats.AllocationCount;
+                stats.FreeRangeCount += rangeStats.FreeRangeCount;
+                stats.LargestFreeRange = std::max(stats.LargestFreeRange, rangeStats.LargestFreeRange);
+
+                freeBytes += rangeStats.Size - rangeStats.UsedBytes;
+                largestRangeBytes += rangeStats.LargestFreeRange;
+            }
+        }
+
+        stats.Fragmentation = freeBytes > 0
+            ? 1.0 - static_cast<double>(largestRangeBytes) / static_cast<double>(freeBytes) : 0.0;
+
+        if (bHasMemoryBudget)
+        {
+            const auto properties = PhysicalDevice.getMemoryProperties2<vk::PhysicalDeviceMemoryProperties2,
+                vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+            const auto& budget = properties.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+
+            for (uint32_t heap = 0; heap < MemoryProperties.memoryHeapCount; ++heap)
+            {
+                stats.Heaps[heap].Budget = budget.heapBudget[heap];
+                stats.Heaps[heap].Usage = budget.heapUsage[heap];
+            }
+        }
+        else
+        {
+            // Without the extension, assume 80% of a heap is usable and only this allocator uses it.
+            for (uint32_t heap = 0; heap < MemoryProperties.memoryHeapCount; ++heap)
+            {
+                stats.Heaps[heap].Budget = MemoryProperties.memoryHeaps[heap].size / 10 * 8;
+                stats.Heaps[heap].Usage = stats.Heaps[heap].AllocatedBytes;
+            }
+        }
+
+        for (uint32_t heap = 0; heap < MemoryProperties.memoryHeapCount; ++heap)
+        {
+            stats.Heaps[heap].Size = MemoryProperties.memoryHeaps[heap].size;
+        }
+
+        return stats;
+    }
+
+    std::vector<uint32_t> DeviceAllocator::GetMemoryTypes(uint32_t typeBits, vk::MemoryPropertyFlags required,
+        vk::MemoryPropertyFlags preferred) const
+    {
+        std::vector<uint32_t> types;
+
+        for (uint32_t type = 0; type < MemoryProperties.memoryTypeCount; ++type)
+        {
+            if ((typeBits & (1u << type)) && (MemoryProperties.memoryTypes[type].propertyFlags & required) == required)
+            {
+                types.push_back(type);
+            }
+        }
+
+        // Flags nobody asked for count against a type: host-visible device-local memory is scarce, for one.
+        const auto getScore = [&](uint32_t type)
+        {
+            const vk::MemoryPropertyFlags flags = MemoryProperties.memoryTypes[type].propertyFlags;
+            return 2 * CountFlags(flags & preferred) - CountFlags(flags & ~(required | preferred));
+        };
+
+        std::stable_sort(types.begin(), types.end(), [&](uint32_t a, uint32_t b) { return getScore(a) > getScore(b); });
+        return types;
+    }
+
+    bool DeviceAllocator::AllocateFromType(uint32_t memoryType, const vk::MemoryRequirements& requirements,
+        ResourceTiling tiling, DeviceAllocation& allocation)
+    {
+        vk::DeviceSize size = requirements.size;
+        vk::DeviceSize alignment = requirements.alignment;
+
+        // Whole atoms, so that flushing an allocation never touches its neighbours.
+        if (IsNonCoherent(memoryType))
+        {
+            size = AlignUp(size, NonCoherentAtomSize);
+            alignment = std::max(alignment, NonCoherentAtomSize);
+        }
+
+        if (size >= Options.SeparateAllocationSize || size > BlockSizes[memoryType] / 2)
+        {
+            const uint32_t blockIndex = CreateBlock(memoryType, size, true);
+
+            if (blockIndex == NoBlock)
+            {
+                return false;
+            }
+
+            const MemoryBlock& block = *Blocks[blockIndex];
+            allocation = { *block.Memory, 0, size, block.MappedData, memoryType, blockIndex, TlsfAllocator::InvalidHandle };
+            return true;
+        }
+
+        const auto allocateFrom = [&](uint32_t blockIndex)
+        {
+            MemoryBlock& block = *Blocks[blockIndex];
+            const TlsfAllocator::Allocation range = block.Ranges->Allocate(size, alignment, tiling);
+
+            if (range)
+            {
+                allocation = { *block.Memory, range.Offset, range.Size,
+                    block.MappedData ? block.MappedData + range.Offset : nullptr, memoryType, blockIndex, range.Handle };
+            }
+
+            return static_cast<bool>(range);
+        };
+
+        for (uint32_t blockIndex : TypeBlocks[memoryType])
+        {
+            if (allocateFrom(blockIndex))
+            {
+                return true;
+            }
+        }
+
+        // Retry with smaller blocks when the heap is nearly full.
+        uint32_t blockIndex = NoBlock;
+
+        for (vk::DeviceSize blockSize = BlockSizes[memoryType]; blockIndex == NoBlock && blockSize >= size + alignment;
+            blockSize /= 2)
+        {
+            blockIndex = CreateBlock(memoryType, blockSize, false);
+        }
+
+        if (blockIndex == NoBlock)
+        {
+            return false;
+        }
+
+        TypeBlocks[memoryType].push_back(blockIndex);
+        return allocateFrom(blockIndex);
+    }
+
+    uint32_t DeviceAllocator::CreateBlock(uint32_t memoryType, vk::DeviceSize size, bool bIsSeparate)
+    {
+        if (DeviceMemoryCount >= MaxDeviceMemoryCount)
+        {
+            NYX_LOG_ERROR(Renderer, "maxMemoryAllocationCount ({}) reached", MaxDeviceMemoryCount);
+            return NoBlock;
+        }
+
+        auto block = std::make_unique<MemoryBlock>();
+        block->Size = size;
+        block->MemoryTypeIndex = memoryType;
+
+        try
+        {
+            block->Memory = vk::raii::DeviceMemory(Device, vk::MemoryAllocateInfo(size, memoryType));
+
+            if (MemoryProperties.memoryTypes[memoryType].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible)
+            {
+                block->MappedData = static_cast<std::byte*>(block->Memory.mapMemory(0, VK_WHOLE_SIZE));
+            }
+        }
+        catch (const vk::SystemError& e)
+        {
+            NYX_LOG_WARN(Renderer, "Failed to allocate {:.1f} MiB of memory type {}: {}", ToMebibytes(size), memoryType,
+                e.what());
+            return NoBlock;
+        }
+
+        if (!bIsSeparate)
+        {
+            block->Ranges.emplace(size, BufferImageGranularity);
+
+            NYX_LOG_DEBUG(Renderer, "Device memory block allocated: {:.1f} MiB of memory type {} ({})", ToMebibytes(size),
+                memoryType, vk::to_string(MemoryProperties.memoryTypes[memoryType].propertyFlags));
+        }
+
+        ++DeviceMemoryCount;
+
+        if (!UnusedBlockIndices.empty())
+        {
+            const uint32_t blockIndex = UnusedBlockIndices.back();
+            UnusedBlockIndices.pop_back();
+            Blocks[blockIndex] = std::move(block);
+            return blockIndex;
+        }
+
+        Blocks.push_back(std::move(block));
+        return static_cast<uint32_t>(Blocks.size() - 1);
+    }
+
+    void DeviceAllocator::DestroyBlock(uint32_t blockIndex)
+    {
+        Blocks[blockIndex].reset();
+        UnusedBlockIndices.push_back(blockIndex);
+        --DeviceMemoryCount;
+    }
+
+    bool DeviceAllocator::IsNonCoherent(uint32_t memoryType) const noexcept
+    {
+        const vk::MemoryPropertyFlags flags = MemoryProperties.memoryTypes[memoryType].propertyFlags;
+        return (flags & vk::MemoryPropertyFlagBits::eHostVisible) && !(flags & vk::MemoryPropertyFlagBits::eHostCoherent);
+    }
+
+    FrameRingBuffer::FrameRingBuffer(DeviceAllocator& allocator, const VulkanDevice& device, vk::DeviceSize size,
+        vk::BufferUsageFlags usage, uint32_t framesInFlight)
+        : Allocator(allocator),
+          Ring(size, framesInFlight)
+    {
+        const vk::PhysicalDeviceLimits& limits = device.GetProperties().limits;
+
+        if (usage & vk::BufferUsageFlagBits::eUniformBuffer)
+        {
+            Alignment = std::max(Alignment, limits.minUniformBufferOffsetAlignment);
+        }
+
+        if (usage & vk::BufferUsageFlagBits::eStorageBuffer)
+        {
+            Alignment = std::max(Alignment, limits.minStorageBufferOffsetAlignment);
+        }
+
+        vk::BufferCreateInfo createInfo;
+        createInfo.size = size;
+        createInfo.usage = usage;
+
+        // Device-local when the device exposes host-visible video memory, so shaders do not read across the bus.
+        Buffer = Allocator.CreateBuffer(createInfo,
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+            vk::MemoryPropertyFlagBits::eDeviceLocal, Allocation);
+    }
+
+    FrameRingBuffer::~FrameRingBuffer()
+    {
+        Buffer.clear();
+        Allocator.Free(Allocation);
+    }
+
+    FrameRingBuffer::Range FrameRingBuffer::Allocate(vk::DeviceSize size, vk::DeviceSize alignment) noexcept
+    {
+        const uint64_t offset = Ring.Allocate(size, std::max(Alignment, alignment));
+
+        if (offset == RingAllocator::InvalidOffset)
+        {
+            return {};
+        }
+
+        return { *Buffer, offset, size, Allocation.MappedData + offset };
+    }
+} // namespace nyxara::renderer
@@ -0,0 +1,319 @@
+#include <cstring>
+#include <fstream>
+#include <system_error>
+#include "nyxara/renderer/vulkan/pipeline_cache.h"
+#include "nyxara/renderer/vulkan/device.h"
+#include "nyxara/core/logging/categories.h"
+
+namespace nyxara::renderer
+{
+    namespace
+    {
+        constexpr uint32_t FileMagic = 0x5058594E; // "NYXP"
+
+        /**
+         * @brief Header of a pipeline cache file, followed by DataSize bytes of `vkGetPipelineCacheData` output.
+         */
+        struct FileHeader
+        {
+            uint32_t Magic;
+            uint32_t Version;
+            uint32_t VendorId;
+            uint32_t DeviceId;
+            uint32_t DriverVersion;
+            uint32_t Reserved;
+            uint8_t PipelineCacheUuid[VK_UUID_SIZE];
+            uint64_t DataSize;
+            uint64_t DataHash;
+        };
+
+        static_assert(sizeof(FileHeader) == 56, "Pipeline cache file header must not contain padding");
+
+        uint64_t HashData(const std::vector<uint8_t>& data) noexcept
+        {
+            // 64-bit FNV-1a: detects truncation and corruption, not tampering.
+            uint64_t hash = 14695981039346656037ull;
+
+            for (uint8_t byte : data)
+            {
+                hash ^= byte;
+                hash *= 1099511628211ull;
+            }
+
+            return hash;
+        }
+
+        std::chrono::duration<double, std::milli> ToMilliseconds(std::chrono::nanoseconds duration) noexcept
+        {
+            return duration;
+        }
+    } // namespace
+
+    PipelineCache::PipelineCache(const VulkanDevice& device, const PipelineCacheOptions& options)
+        : Device(device.GetDevice()),
+          Properties(device.GetProperties()),
+          Path(options.Path)
+    {
+        NYX_TRACE_FUNCTION(Renderer);
+
+        std::vector<uint8_t> data;
+        const bool bIsWarm = !Path.empty() && Load(data);
+
+        if (!bIsWarm)
+        {
+            data.clear();
+        }
+
+        vk::PipelineCacheCreateInfo createInfo;
+        createInfo.initialDataSize = data.size();
+        createInfo.pInitialData = data.data();
+
+        Cache = vk::raii::PipelineCache(Device, createInfo);
+
+        Stats.bIsWarm = bIsWarm;
+        Stats.LoadedBytes = data.size();
+
+        if (bIsWarm)
+        {
+            NYX_LOG_INFO(Renderer, "Pipeline cache warm: {} bytes loaded from {}", data.size(), Path.string());
+        }
+        else
+        {
+            NYX_LOG_INFO(Renderer, "Pipeline cache cold");
+        }
+
+        if (!Path.empty() && options.SaveInterval > std::chrono::seconds::zero())
+        {
+            SaveThread = std::thread(&PipelineCache::SaveThreadMain, this, options.SaveInterval);
+        }
+    }
+
+    PipelineCache::~PipelineCache()
+    {
+        if (SaveThread.joinable())
+        {
+            {
+                std::lock_guard lock(StopMutex);
+                bIsStopping = true;
+            }
+
+            StopCondition.notify_one();
+            SaveThread.join();
+        }
+
+        Save();
+
+        const PipelineCacheStats stats = GetStats();
+        NYX_LOG_INFO(Renderer, "Pipeline cache ({} start): {} pipeline(s) created in {:.2f} ms, {} cache hit(s), {} save(s)",
+            stats.bIsWarm ? "warm" : "cold", stats.PipelineCount, ToMilliseconds(stats.CreationTime).count(),
+            stats.CacheHitCount, stats.SaveCount);
+    }
+
+    vk::raii::Pipeline PipelineCache::CreateGraphicsPipeline(vk::GraphicsPipelineCreateInfo createInfo)
+    {
+        return CreatePipeline(createInfo);
+    }
+
+    vk::raii::Pipeline PipelineCache::CreateComputePipeline(vk::ComputePipelineCreateInfo createInfo)
+    {
+        return CreatePipeline(createInfo);
+    }
+
+    template<typename CreateInfo>
+    vk::raii::Pipeline PipelineCache::CreatePipeline(CreateInfo& createInfo)
+    {
+        vk::PipelineCreationFeedback feedback;
+        vk::PipelineCreationFeedbackCreateInfo feedbackInfo;
+        feedbackInfo.pPipelineCreationFeedback = &feedback;
+        feedbackInfo.pNext = createInfo.pNext;
+        createInfo.pNext = &feedbackInfo;
+
+        const auto start = std::chrono::steady_clock::now();
+        vk::raii::Pipeline pipeline(Device, Cache, createInfo);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        const bool bIsCacheHit = (feedback.flags & vk::PipelineCreationFeedbackFlagBits::eValid)
+            && (feedback.flags & vk::PipelineCreationFeedbackFlagBits::eApplicationPipelineCacheHit);
+
+        std::lock_guard lock(StatsMutex);
+        ++Stats.PipelineCount;
+        Stats.CacheHitCount += bIsCacheHit ? 1 : 0;
+        Stats.CreationTime += elapsed;
+
+        return pipeline;
+    }
+
+    bool PipelineCache::Save()
+    {
+        if (Path.empty())
+        {
+            return false;
+        }
+
+        std::lock_guard lock(SaveMutex);
+        const uint64_t pipelineCount = GetStats().PipelineCount;
+
+        try
+        {
+            const std::vector<uint8_t> data = Cache.getData();
+
+            FileHeader header{};
+            header.Magic = FileMagic;
+            header.Version = FileVersion;
+            header.VendorId = Properties.vendorID;
+            header.DeviceId = Properties.deviceID;
+            header.DriverVersion = Properties.driverVersion;
+            std::memcpy(header.PipelineCacheUuid, Properties.pipelineCacheUUID.data(), VK_UUID_SIZE);
+            header.DataSize = data.size();
+            header.DataHash = HashData(data);
+
+            std::error_code error;
+
+            if (Path.has_parent_path())
+            {
+                std::filesystem::create_directories(Path.parent_path(), error);
+            }
+
+            // Written aside then renamed over the file, so a crash never leaves a truncated cache behind.
+            std::filesystem::path temporaryPath = Path;
+            temporaryPath += ".tmp";
+
+            {
+                std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+                if (!file)
+                {
+                    NYX_LOG_WARN(Renderer, "Failed to write pipeline cache to {}", temporaryPath.string());
+                    return false;
+                }
+            }
+
+            std::filesystem::rename(temporaryPath, Path, error);
+
+            if (error)
+            {
+                NYX_LOG_WARN(Renderer, "Failed to replace pipeline cache {}: {}", Path.string(), error.message());
+                std::filesystem::remove(temporaryPath, error);
+                return false;
+            }
+
+            NYX_LOG_DEBUG(Renderer, "Pipeline cache saved: {} bytes to {}", data.size(), Path.string());
+        }
+        catch (const std::exception& e)
+        {
+            NYX_LOG_WARN(Renderer, "Failed to save pipeline cache: {}", e.what());
+            return false;
+        }
+
+        SavedPipelineCount.store(pipelineCount, std::memory_order_relaxed);
+
+        std::lock_guard statsLock(StatsMutex);
+        ++Stats.SaveCount;
+        return true;
+    }
+
+    PipelineCacheStats PipelineCache::GetStats() const
+    {
+        std::lock_guard lock(StatsMutex);
+        return Stats;
+    }
+
+    bool PipelineCache::Load(std::vector<uint8_t>& data) const
+    {
+        std::ifstream file(Path, std::ios::binary);
+
+        if (!file)
+        {
+            NYX_LOG_INFO(Renderer, "No pipeline cache at {}", Path.string());
+            return false;
+        }
+
+        FileHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (!file || header.Magic != FileMagic)
+        {
+            NYX_LOG_WARN(Renderer, "Ignoring pipeline cache {}: not a pipeline cache file", Path.string());
+            return false;
+        }
+
+        if (header.Version != FileVersion)
+        {
+            NYX_LOG_INFO(Renderer, "Ignoring pipeline cache {}: format version {}, expected {}", Path.string(),
+                header.Version, FileVersion);
+            return false;
+        }
+
+        if (header.VendorId != Properties.vendorID || header.DeviceId != Properties.deviceID
+            || header.DriverVersion != Properties.driverVersion
+            || std::memcmp(header.PipelineCacheUuid, Properties.pipelineCacheUUID.data(), VK_UUID_SIZE) != 0)
+        {
+            NYX_LOG_INFO(Renderer, "Ignoring pipeline cache {}: written by another device or driver "
+                "({:#x}:{:#x} driver {:#x})", Path.string(), header.VendorId, header.DeviceId, header.DriverVersion);
+            return false;
+        }
+
+        // Never size the buffer from the header alone: a corrupted size could ask for any amount of memory.
+        const std::streamoff dataStart = file.tellg();
+        file.seekg(0, std::ios::end);
+        const std::streamoff dataEnd = file.tellg();
+        file.seekg(dataStart);
+
+        if (!file || dataStart < 0 || dataEnd < dataStart || header.DataSize > static_cast<uint64_t>(dataEnd - dataStart))
+        {
+            NYX_LOG_WARN(Renderer, "Ignoring pipeline cache {}: header claims {} bytes of data, the file holds {}",
+                Path.string(), header.DataSize, dataEnd > dataStart ? dataEnd - dataStart : 0);
+            return false;
+        }
+
+        data.resize(header.DataSize);
+        file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+        if (!file || HashData(data) != header.DataHash)
+        {
+            NYX_LOG_WARN(Renderer, "Ignoring pipeline cache {}: truncated or corrupted", Path.string());
+            return false;
+        }
+
+        // The data starts with the driver's own header; check it too rather than trust the driver to.
+        VkPipelineCacheHeaderVersionOne driverHeader{};
+
+        if (data.size() < sizeof(driverHeader))
+        {
+            NYX_LOG_WARN(Renderer, "Ignoring pipeline cache {}: no driver header", Path.string());
+            return false;
+        }
+
+        std::memcpy(&driverHeader, data.data(), sizeof(driverHeader));
+
+        if (driverHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+            || driverHeader.vendorID != Properties.vendorID || driverHeader.deviceID != Properties.deviceID
+            || std::memcmp(driverHeader.pipelineCacheUUID, Properties.pipelineCacheUUID.data(), VK_UUID_SIZE) != 0)
+        {
+            NYX_LOG_WARN(Renderer, "Ignoring pipeline cache {}: driver header does not match the device", Path.string());
+            return false;
+        }
+
+        return true;
+    }
+
+    void PipelineCache::SaveThreadMain(std::chrono::seconds interval)
+    {
+        std::unique_lock lock(StopMutex);
+
+        while (!StopCondition.wait_for(lock, interval, [this] { return bIsStopping; }))
+        {
+            lock.unlock();
+
+            // Incremental: only rewrite the file once new pipelines may have added to the cache.
+            if (GetStats().PipelineCount != SavedPipelineCount.load(std::memory_order_relaxed))
+            {
+                Save();
+            }
+
+            lock.lock();
+        }
+    }
+} // namespace nyxara::renderer
@@ -0,0 +1,1051 @@
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include "nyxara/renderer/vulkan/render_graph.h"
+#include "nyxara/renderer/vulkan/device.h"
+#include "nyxara/renderer/vulkan/resource_state.h"
+#include "nyxara/core/logging/categories.h"
+
+namespace nyxara::renderer
+{
+    namespace
+    {
+        /**
+         * @brief What a usage implies, on its read and write sides.
+         */
+        struct UsageInfo
+        {
+            // Empty for shader usages, whose stages come from the pass type.
+            vk::PipelineStageFlags2 Stages;
+            vk::AccessFlags2 ReadAccess;		// Empty if the usage cannot read.
+            vk::AccessFlags2 WriteAccess;		// Empty if the usage cannot write.
+            vk::ImageLayout ReadLayout = vk::ImageLayout::eUndefined;
+            vk::ImageLayout WriteLayout = vk::ImageLayout::eUndefined;
+            vk::ImageUsageFlags ImageUsage;		// Empty if the usage does not apply to images.
+            bool bAppliesToBuffers = false;
+        };
+
+        UsageInfo GetUsageInfo(RenderGraphUsage usage) noexcept
+        {
+            using Stage = vk::PipelineStageFlagBits2;
+            using Access = vk::AccessFlagBits2;
+            using Layout = vk::ImageLayout;
+            using ImageUsage = vk::ImageUsageFlagBits;
+
+            switch (usage)
+            {
+            case RenderGraphUsage::ColorAttachment:
+                return { Stage::eColorAttachmentOutput, Access::eColorAttachmentRead, Access::eColorAttachmentWrite,
+                    Layout::eColorAttachmentOptimal, Layout::eColorAttachmentOptimal, ImageUsage::eColorAttachment, false };
+            case RenderGraphUsage::DepthStencilAttachment:
+                // The read-only layout also allows sampling, so a pass can test against depth it samples.
+                return { Stage::eEarlyFragmentTests | Stage::eLateFragmentTests, Access::eDepthStencilAttachmentRead,
+                    Access::eDepthStencilAttachmentWrite, Layout::eReadOnlyOptimal, Layout::eDepthStencilAttachmentOptimal,
+                    ImageUsage::eDepthStencilAttachment, false };
+            case RenderGraphUsage::ShaderSampled:
+                return { {}, Access::eShaderSampledRead, {}, Layout::eReadOnlyOptimal, Layout::eUndefined,
+                    ImageUsage::eSampled, false };
+            case RenderGraphUsage::ShaderStorage:
+                return { {}, Access::eShaderStorageRead, Access::eShaderStorageWrite, Layout::eGeneral, Layout::eGeneral,
+                    ImageUsage::eStorage, true };
+            case RenderGraphUsage::UniformBuffer:
+                return { {}, Access::eUniformRead, {}, Layout::eUndefined, Layout::eUndefined, {}, true };
+            case RenderGraphUsage::VertexBuffer:
+                return { Stage::eVertexAttributeInput, Access::eVertexAttributeRead, {}, Layout::eUndefined,
+                    Layout::eUndefined, {}, true };
+            case RenderGraphUsage::IndexBuffer:
+                return { Stage::eIndexInput, Access::eIndexRead, {}, Layout::eUndefined, Layout::eUndefined, {}, true };
+            case RenderGraphUsage::IndirectBuffer:
+                return { Stage::eDrawIndirect, Access::eIndirectCommandRead, {}, Layout::eUndefined, Layout::eUndefined,
+                    {}, true };
+            case RenderGraphUsage::TransferSource:
+                return { Stage::eAllTransfer, Access::eTransferRead, {}, Layout::eTransferSrcOptimal, Layout::eUndefined,
+                    ImageUsage::eTransferSrc, true };
+            case RenderGraphUsage::TransferDestination:
+                return { Stage::eAllTransfer, {}, Access::eTransferWrite, Layout::eUndefined, Layout::eTransferDstOptimal,
+                    ImageUsage::eTransferDst, true };
+            default: return {};
+            }
+        }
+
+        const char* GetUsageName(RenderGraphUsage usage) noexcept
+        {
+            switch (usage)
+            {
+            case RenderGraphUsage::ColorAttachment: return "color attachment";
+            case RenderGraphUsage::DepthStencilAttachment: return "depth/stencil attachment";
+            case RenderGraphUsage::ShaderSampled: return "sampled";
+            case RenderGraphUsage::ShaderStorage: return "storage";
+            case RenderGraphUsage::UniformBuffer: return "uniform buffer";
+            case RenderGraphUsage::VertexBuffer: return "vertex buffer";
+            case RenderGraphUsage::IndexBuffer: return "index buffer";
+            case RenderGraphUsage::IndirectBuffer: return "indirect buffer";
+            case RenderGraphUsage::TransferSource: return "transfer source";
+            case RenderGraphUsage::TransferDestination: return "transfer destination";
+            default: return "unknown";
+            }
+        }
+
+        const char* GetPassTypeName(RenderPassType type) noexcept
+        {
+            switch (type)
+            {
+            case RenderPassType::Graphics: return "graphics";
+            case RenderPassType::Compute: return "compute";
+            case RenderPassType::Transfer: return "transfer";
+            default: return "unknown";
+            }
+        }
+
+        vk::PipelineStageFlags2 GetShaderStages(RenderPassType type) noexcept
+        {
+            switch (type)
+            {
+            case RenderPassType::Graphics:
+                return vk::PipelineStageFlagBits2::eVertexShader | vk::PipelineStageFlagBits2::eFragmentShader;
+            case RenderPassType::Compute: return vk::PipelineStageFlagBits2::eComputeShader;
+            default: return {};
+            }
+        }
+
+        vk::ImageAspectFlags GetAspectMask(vk::Format format) noexcept
+        {
+            switch (format)
+            {
+            case vk::Format::eD16Unorm:
+            case vk::Format::eX8D24UnormPack32:
+            case vk::Format::eD32Sfloat: return vk::ImageAspectFlagBits::eDepth;
+            case vk::Format::eS8Uint: return vk::ImageAspectFlagBits::eStencil;
+            case vk::Format::eD16UnormS8Uint:
+            case vk::Format::eD24UnormS8Uint:
+            case vk::Format::eD32SfloatS8Uint: return vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
+            default: return vk::ImageAspectFlagBits::eColor;
+            }
+        }
+
+        vk::DeviceSize AlignUp(vk::DeviceSize value, vk::DeviceSize alignment) noexcept
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        double ToMebibytes(uint64_t bytes) noexcept
+        {
+            return static_cast<double>(bytes) / (1024.0 * 1024.0);
+        }
+
+        /**
+         * @brief FNV-1a over the fields of a declaration.
+         */
+        class DeclarationHasher
+        {
+        public:
+            void Add(uint64_t value) noexcept
+            {
+                for (uint32_t byte = 0; byte < 8; ++byte)
+                {
+                    Hash ^= (value >> (byte * 8)) & 0xff;
+                    Hash *= 1099511628211ull;
+                }
+            }
+
+            void Add(std::string_view text) noexcept
+            {
+                Add(text.size());
+
+                for (char c : text)
+                {
+                    Hash ^= static_cast<uint8_t>(c);
+                    Hash *= 1099511628211ull;
+                }
+            }
+
+            template<typename Bits>
+            void Add(vk::Flags<Bits> flags) noexcept
+            {
+                Add(static_cast<uint64_t>(static_cast<typename vk::Flags<Bits>::MaskType>(flags)));
+            }
+
+            uint64_t Hash = 14695981039346656037ull;
+        };
+
+        /**
+         * @brief Accesses of one pass to one resource, merged over its usages.
+         */
+        struct MergedAccess
+        {
+            uint32_t Resource;
+            ResourceAccess Access;
+        };
+    } // namespace
+
+    struct RenderGraph::ResourceNode
+    {
+        std::string Name;
+        bool bIsImage = true;
+        bool bIsImported = false;
+
+        // Images; the handles of transient images are set once they are created.
+        ImportedImage ImageDesc;
+        RenderGraphImageInfo TransientInfo;
+        vk::ImageUsageFlags ImageUsage;
+
+        ImportedBuffer BufferDesc;
+    };
+
+    struct RenderGraph::PassNode
+    {
+        struct Access
+        {
+            uint32_t Resource;
+            RenderGraphUsage Usage;
+            bool bRead;
+            bool bWrite;
+        };
+
+        std::string Name;
+        RenderPassType Type;
+        ExecuteFunction Execute;
+        std::vector<Access> Accesses;
+        bool bHasSideEffects = false;
+    };
+
+    struct RenderGraph::CompiledPass
+    {
+        // Index in the declaration; the order of the passes is part of the hash, so it holds across frames.
+        uint32_t Pass;
+        std::string Name;
+        RenderPassType Type;
+        BarrierBatch Barriers;
+    };
+
+    struct RenderGraph::TransientImage
+    {
+        uint32_t Resource;
+        vk::raii::Image Image{ nullptr };
+        vk::raii::ImageView View{ nullptr };
+        vk::MemoryRequirements Requirements;
+
+        // Schedule steps of the first and last use.
+        uint32_t FirstUse;
+        uint32_t LastUse;
+
+        // Placement in TransientMemory.
+        uint32_t MemoryIndex = 0;
+        vk::DeviceSize Offset = 0;
+
+        bool IsAliveWith(const TransientImage& other) const noexcept
+        {
+            return FirstUse <= other.LastUse && other.FirstUse <= LastUse;
+        }
+
+        bool SharesMemoryWith(const TransientImage& other) const noexcept
+        {
+            return MemoryIndex == other.MemoryIndex && Offset < other.Offset + other.Requirements.size
+                && other.Offset < Offset + Requirements.size;
+        }
+    };
+
+    vk::Image RenderPassContext::GetImage(RenderGraphImage image) const
+    {
+        return Graph.Resources[image.Index].ImageDesc.Image;
+    }
+
+    vk::ImageView RenderPassContext::GetImageView(RenderGraphImage image) const
+    {
+        return Graph.Resources[image.Index].ImageDesc.View;
+    }
+
+    vk::Extent2D RenderPassContext::GetExtent(RenderGraphImage image) const
+    {
+        return Graph.Resources[image.Index].ImageDesc.Extent;
+    }
+
+    vk::Buffer RenderPassContext::GetBuffer(RenderGraphBuffer buffer) const
+    {
+        return Graph.Resources[buffer.Index].BufferDesc.Buffer;
+    }
+
+    RenderPassBuilder& RenderPassBuilder::Read(RenderGraphImage image, RenderGraphUsage usage)
+    {
+        Graph.AddAccess(Pass, image.Index, true, usage, true, false);
+        return *this;
+    }
+
+    RenderPassBuilder& RenderPassBuilder::Write(RenderGraphImage image, RenderGraphUsage usage)
+    {
+        Graph.AddAccess(Pass, image.Index, true, usage, false, true);
+        return *this;
+    }
+
+    RenderPassBuilder& RenderPassBuilder::ReadWrite(RenderGraphImage image, RenderGraphUsage usage)
+    {
+        Graph.AddAccess(Pass, image.Index, true, usage, true, true);
+        return *this;
+    }
+
+    RenderPassBuilder& RenderPassBuilder::Read(RenderGraphBuffer buffer, RenderGraphUsage usage)
+    {
+        Graph.AddAccess(Pass, buffer.Index, false, usage, true, false);
+        return *this;
+    }
+
+    RenderPassBuilder& RenderPassBuilder::Write(RenderGraphBuffer buffer, RenderGraphUsage usage)
+    {
+        Graph.AddAccess(Pass, buffer.Index, false, usage, false, true);
+        return *this;
+    }
+
+    RenderPassBuilder& RenderPassBuilder::ReadWrite(RenderGraphBuffer buffer, RenderGraphUsage usage)
+    {
+        Graph.AddAccess(Pass, buffer.Index, false, usage, true, true);
+        return *this;
+    }
+
+    RenderPassBuilder& RenderPassBuilder::SetSideEffects()
+    {
+        Graph.Passes[Pass].bHasSideEffects = true;
+        return *this;
+    }
+
+    RenderGraph::RenderGraph(const VulkanDevice& device, DeviceAllocator& allocator)
+        : Device(device.GetDevice()),
+          Allocator(allocator)
+    {}
+
+    RenderGraph::~RenderGraph()
+    {
+        DestroyTransientImages();
+    }
+
+    void RenderGraph::Reset()
+    {
+        Resources.clear();
+        Passes.clear();
+        bIsReady = false;
+    }
+
+    RenderGraphImage RenderGraph::CreateImage(std::string name, const RenderGraphImageInfo& info)
+    {
+        if (info.Format == vk::Format::eUndefined || info.Extent.width == 0 || info.Extent.height == 0)
+        {
+            NYX_LOG_ERROR(Renderer, "Render graph image '{}' has no format or an empty extent", name);
+            throw std::runtime_error("Invalid render graph image");
+        }
+
+        ResourceNode& resource = Resources.emplace_back();
+        resource.Name = std::move(name);
+        resource.TransientInfo = info;
+        resource.ImageDesc.Format = info.Format;
+        resource.ImageDesc.Extent = info.Extent;
+        resource.ImageDesc.Range = vk::ImageSubresourceRange(GetAspectMask(info.Format), 0, info.MipLevels, 0,
+            info.ArrayLayers);
+
+        // Seeded by ComputeBarriers() from the uses of the image's memory in the schedule.
+        resource.ImageDesc.InitialStages = {};
+        resource.ImageDesc.InitialAccess = {};
+
+        bIsReady = false;
+        return { static_cast<uint32_t>(Resources.size() - 1) };
+    }
+
+    RenderGraphImage RenderGraph::ImportImage(std::string name, const ImportedImage& image)
+    {
+        ResourceNode& resource = Resources.emplace_back();
+        resource.Name = std::move(name);
+        resource.bIsImported = true;
+        resource.ImageDesc = image;
+
+        bIsReady = false;
+        return { static_cast<uint32_t>(Resources.size() - 1) };
+    }
+
+    RenderGraphBuffer RenderGraph::ImportBuffer(std::string name, const ImportedBuffer& buffer)
+    {
+        ResourceNode& resource = Resources.emplace_back();
+        resource.Name = std::move(name);
+        resource.bIsImage = false;
+        resource.bIsImported = true;
+        resource.BufferDesc = buffer;
+
+        bIsReady = false;
+        return { static_cast<uint32_t>(Resources.size() - 1) };
+    }
+
+    RenderPassBuilder RenderGraph::AddPass(std::string name, RenderPassType type, ExecuteFunction execute)
+    {
+        PassNode& pass = Passes.emplace_back();
+        pass.Name = std::move(name);
+        pass.Type = type;
+        pass.Execute = std::move(execute);
+
+        bIsReady = false;
+        return RenderPassBuilder(*this, static_cast<uint32_t>(Passes.size() - 1));
+    }
+
+    void RenderGraph::AddAccess(uint32_t pass, uint32_t resource, bool bIsImage, RenderGraphUsage usage, bool bRead,
+        bool bWrite)
+    {
+        PassNode& node = Passes[pass];
+
+        if (resource >= Resources.size() || Resources[resource].bIsImage != bIsImage)
+        {
+            NYX_LOG_ERROR(Renderer, "Pass '{}' uses a resource not declared since the last reset", node.Name);
+            throw std::runtime_error("Unknown render graph resource");
+        }
+
+        const UsageInfo info = GetUsageInfo(usage);
+        const char* error = nullptr;
+
+        if (bRead && !info.ReadAccess)
+        {
+            error = "cannot read";
+        }
+        else if (bWrite && !info.WriteAccess)
+        {
+            error = "cannot write";
+        }
+        else if (bIsImage ? !info.ImageUsage : !info.bAppliesToBuffers)
+        {
+            error = bIsImage ? "does not apply to images" : "does not apply to buffers";
+        }
+        else if (!info.Stages && node.Type == RenderPassType::Transfer)
+        {
+            error = "needs shaders, which transfer passes have none of";
+        }
+
+        if (error)
+        {
+            NYX_LOG_ERROR(Renderer, "Pass '{}' uses '{}' as {}, which {}", node.Name, Resources[resource].Name,
+                GetUsageName(usage), error);
+            throw std::runtime_error("Invalid render graph resource usage");
+        }
+
+        node.Accesses.push_back({ resource, usage, bRead, bWrite });
+        Resources[resource].ImageUsage |= info.ImageUsage;
+        bIsReady = false;
+    }
+
+    bool RenderGraph::Compile()
+    {
+        NYX_TRACE_FUNCTION(Renderer);
+
+        const uint64_t hash = HashDeclaration();
+
+        if (bIsCompiled && hash == CompiledHash)
+        {
+            BindTransientImages();
+            ++Stats.ReuseCount;
+            bIsReady = true;
+            return false;
+        }
+
+        DestroyTransientImages();
+        Schedule.clear();
+        FinalBarriers = {};
+        CulledPassNames.clear();
+        CompiledResourceNames.clear();
+        bIsCompiled = false;
+
+        const std::vector<bool> kept = CullPasses();
+
+        for (uint32_t pass = 0; pass < Passes.size(); ++pass)
+        {
+            if (kept[pass])
+            {
+                Schedule.push_back({ pass, Passes[pass].Name, Passes[pass].Type, {} });
+            }
+            else
+            {
+                CulledPassNames.push_back(Passes[pass].Name);
+            }
+        }
+
+        for (const ResourceNode& resource : Resources)
+        {
+            CompiledResourceNames.push_back(resource.Name);
+        }
+
+        CreateTransientImages();
+        ComputeBarriers();
+
+        bIsCompiled = true;
+        bIsReady = true;
+        CompiledHash = hash;
+
+        Stats.PassCount = static_cast<uint32_t>(Schedule.size());
+        Stats.CulledPassCount = static_cast<uint32_t>(CulledPassNames.size());
+        Stats.BarrierBatchCount = FinalBarriers.IsEmpty() ? 0 : 1;
+        Stats.ImageBarrierCount = static_cast<uint32_t>(FinalBarriers.ImageBarriers.size());
+        Stats.BufferBarrierCount = static_cast<uint32_t>(FinalBarriers.BufferBarriers.size());
+
+        for (const CompiledPass& compiled : Schedule)
+        {
+            Stats.BarrierBatchCount += compiled.Barriers.IsEmpty() ? 0 : 1;
+            Stats.ImageBarrierCount += static_cast<uint32_t>(compiled.Barriers.ImageBarriers.size());
+            Stats.BufferBarrierCount += static_cast<uint32_t>(compiled.Barriers.BufferBarriers.size());
+        }
+
+        ++Stats.CompileCount;
+
+        NYX_LOG_DEBUG(Renderer, "Render graph compiled: {} pass(es), {} culled, {} barrier batch(es), "
+            "{} transient image(s) in {:.1f} MiB instead of {:.1f} MiB", Stats.PassCount, Stats.CulledPassCount,
+            Stats.BarrierBatchCount, Stats.TransientImageCount, ToMebibytes(Stats.AliasedBytes),
+            ToMebibytes(Stats.TransientBytes));
+        return true;
+    }
+
+    void RenderGraph::Execute(const vk::raii::CommandBuffer& commands)
+    {
+        NYX_TRACE_FUNCTION(Renderer);
+
+        if (!bIsReady)
+        {
+            NYX_LOG_ERROR(Renderer, "Render graph executed without compiling its declaration");
+            throw std::runtime_error("Render graph not compiled");
+        }
+
+        const RenderPassContext context(*this, commands);
+
+        for (CompiledPass& compiled : Schedule)
+        {
+            RecordBarriers(commands, compiled.Barriers);
+
+            if (const ExecuteFunction& execute = Passes[compiled.Pass].Execute)
+            {
+                execute(context);
+            }
+        }
+
+        RecordBarriers(commands, FinalBarriers);
+    }
+
+    std::string RenderGraph::DumpSchedule() const
+    {
+        fmt::memory_buffer out;
+
+        if (!bIsCompiled)
+        {
+            return "Render graph not compiled\n";
+        }
+
+        fmt::format_to(std::back_inserter(out),
+            "Render graph: {} pass(es), {} culled, {} barrier batch(es) of {} image and {} buffer barrier(s)\n",
+            Stats.PassCount, Stats.CulledPassCount, Stats.BarrierBatchCount, Stats.ImageBarrierCount,
+            Stats.BufferBarrierCount);
+
+        const auto appendBarriers = [&](const BarrierBatch& batch)
+        {
+            for (size_t i = 0; i < batch.ImageBarriers.size(); ++i)
+            {
+                const vk::ImageMemoryBarrier2& barrier = batch.ImageBarriers[i];
+                fmt::format_to(std::back_inserter(out), "    barrier '{}': {} -> {}, {} {} -> {} {}\n",
+                    CompiledResourceNames[batch.ImageResources[i]], vk::to_string(barrier.oldLayout),
+                    vk::to_string(barrier.newLayout), vk::to_string(barrier.srcStageMask),
+                    vk::to_string(barrier.srcAccessMask), vk::to_string(barrier.dstStageMask),
+                    vk::to_string(barrier.dstAccessMask));
+            }
+
+            for (size_t i = 0; i < batch.BufferBarriers.size(); ++i)
+            {
+                const vk::BufferMemoryBarrier2& barrier = batch.BufferBarriers[i];
+                fmt::format_to(std::back_inserter(out), "    barrier '{}': {} {} -> {} {}\n",
+                    CompiledResourceNames[batch.BufferResources[i]], vk::to_string(barrier.srcStageMask),
+                    vk::to_string(barrier.srcAccessMask), vk::to_string(barrier.dstStageMask),
+                    vk::to_string(barrier.dstAccessMask));
+            }
+        };
+
+        for (size_t step = 0; step < Schedule.size(); ++step)
+        {
+            const CompiledPass& compiled = Schedule[step];
+            fmt::format_to(std::back_inserter(out), "pass {} '{}' ({})\n", step, compiled.Name,
+                GetPassTypeName(compiled.Type));
+            appendBarriers(compiled.Barriers);
+        }
+
+        if (!FinalBarriers.IsEmpty())
+        {
+            fmt::format_to(std::back_inserter(out), "end\n");
+            appendBarriers(FinalBarriers);
+        }
+
+        for (const std::string& name : CulledPassNames)
+        {
+            fmt::format_to(std::back_inserter(out), "culled '{}'\n", name);
+        }
+
+        fmt::format_to(std::back_inserter(out), "Transient images: {} in {:.1f} MiB, {:.1f} MiB without aliasing\n",
+            Stats.TransientImageCount, ToMebibytes(Stats.AliasedBytes), ToMebibytes(Stats.TransientBytes));
+
+        for (const TransientImage& image : TransientImages)
+        {
+            fmt::format_to(std::back_inserter(out), "    '{}': passes {} to {}, memory {} at {:#x}, {:.2f} MiB\n",
+                CompiledResourceNames[image.Resource], image.FirstUse, image.LastUse, image.MemoryIndex, image.Offset,
+                ToMebibytes(image.Requirements.size));
+        }
+
+        return fmt::to_string(out);
+    }
+
+    uint64_t RenderGraph::HashDeclaration() const noexcept
+    {
+        DeclarationHasher hasher;
+        hasher.Add(Resources.size());
+
+        // Everything the schedule depends on; the handles of imported resources are set again each frame.
+        for (const ResourceNode& resource : Resources)
+        {
+            hasher.Add(resource.Name);
+            hasher.Add((resource.bIsImage ? 1u : 0u) | (resource.bIsImported ? 2u : 0u));
+
+            if (resource.bIsImage)
+            {
+                const ImportedImage& image = resource.ImageDesc;
+                hasher.Add(static_cast<uint64_t>(image.Format));
+                hasher.Add((uint64_t{ image.Extent.width } << 32) | image.Extent.height);
+                hasher.Add(image.Range.aspectMask);
+                hasher.Add((uint64_t{ image.Range.baseMipLevel } << 32) | image.Range.levelCount);
+                hasher.Add((uint64_t{ image.Range.baseArrayLayer } << 32) | image.Range.layerCount);
+                hasher.Add((static_cast<uint64_t>(image.InitialLayout) << 32) | static_cast<uint64_t>(image.FinalLayout));
+                hasher.Add(image.InitialStages);
+                hasher.Add(image.InitialAccess);
+                hasher.Add(static_cast<uint64_t>(resource.TransientInfo.Samples));
+            }
+            else
+            {
+                const ImportedBuffer& buffer = resource.BufferDesc;
+                hasher.Add(buffer.Offset);
+                hasher.Add(buffer.Size);
+                hasher.Add(buffer.InitialStages);
+                hasher.Add(buffer.InitialAccess);
+            }
+        }
+
+        hasher.Add(Passes.size());
+
+        for (const PassNode& pass : Passes)
+        {
+            hasher.Add(pass.Name);
+            hasher.Add((static_cast<uint64_t>(pass.Type) << 1) | (pass.bHasSideEffects ? 1u : 0u));
+            hasher.Add(pass.Accesses.size());
+
+            for (const PassNode::Access& access : pass.Accesses)
+            {
+                hasher.Add((uint64_t{ access.Resource } << 32) | (static_cast<uint64_t>(access.Usage) << 2)
+                    | (access.bRead ? 1u : 0u) | (access.bWrite ? 2u : 0u));
+            }
+        }
+
+        return hasher.Hash;
+    }
+
+    std::vector<bool> RenderGraph::CullPasses() const
+    {
+        // Contents still needed at this point of the walk back; imported resources outlive the graph.
+        std::vector<bool> bIsNeeded(Resources.size());
+
+        for (size_t resource = 0; resource < Resources.size(); ++resource)
+        {
+            bIsNeeded[resource] = Resources[resource].bIsImported;
+        }
+
+        std::vector<bool> kept(Passes.size());
+
+        for (size_t pass = Passes.size(); pass-- > 0;)
+        {
+            const PassNode& node = Passes[pass];
+            bool bKeep = node.bHasSideEffects;
+
+            for (const PassNode::Access& access : node.Accesses)
+            {
+                bKeep = bKeep || (access.bWrite && bIsNeeded[access.Resource]);
+            }
+
+            if (!bKeep)
+            {
+                continue;
+            }
+
+            kept[pass] = true;
+
+            // What the pass writes, earlier passes need not produce, unless the pass also reads it.
+            for (const PassNode::Access& access : node.Accesses)
+            {
+                if (access.bWrite)
+                {
+                    bIsNeeded[access.Resource] = false;
+                }
+            }
+
+            for (const PassNode::Access& access : node.Accesses)
+            {
+                if (access.bRead)
+                {
+                    bIsNeeded[access.Resource] = true;
+                }
+            }
+        }
+
+        return kept;
+    }
+
+    void RenderGraph::CreateTransientImages()
+    {
+        std::vector<uint32_t> transientIndices(Resources.size(), ~0u);
+
+        for (uint32_t step = 0; step < Schedule.size(); ++step)
+        {
+            for (const PassNode::Access& access : Passes[Schedule[step].Pass].Accesses)
+            {
+                if (Resources[access.Resource].bIsImported)
+                {
+                    continue;
+                }
+
+                uint32_t& index = transientIndices[access.Resource];
+
+                if (index == ~0u)
+                {
+                    index = static_cast<uint32_t>(TransientImages.size());
+
+                    TransientImage& image = TransientImages.emplace_back();
+                    image.Resource = access.Resource;
+                    image.FirstUse = step;
+                }
+
+                TransientImages[index].LastUse = step;
+            }
+        }
+
+        Stats.TransientImageCount = static_cast<uint32_t>(TransientImages.size());
+        Stats.TransientBytes = 0;
+        Stats.AliasedBytes = 0;
+
+        for (TransientImage& image : TransientImages)
+        {
+            const ResourceNode& resource = Resources[image.Resource];
+
+            vk::ImageCreateInfo createInfo;
+            createInfo.imageType = vk::ImageType::e2D;
+            createInfo.format = resource.TransientInfo.Format;
+            createInfo.extent = vk::Extent3D(resource.TransientInfo.Extent, 1);
+            createInfo.mipLevels = resource.TransientInfo.MipLevels;
+            createInfo.arrayLayers = resource.TransientInfo.ArrayLayers;
+            createInfo.samples = resource.TransientInfo.Samples;
+            createInfo.tiling = vk::ImageTiling::eOptimal;
+            createInfo.usage = resource.ImageUsage;
+            createInfo.sharingMode = vk::SharingMode::eExclusive;
+            createInfo.initialLayout = vk::ImageLayout::eUndefined;
+
+            image.Image = vk::raii::Image(Device, createInfo);
+            image.Requirements = image.Image.getMemoryRequirements();
+            Stats.TransientBytes += image.Requirements.size;
+        }
+
+        // Largest first, each at the lowest offset clear of the images alive at the same time and
+        // allowed in the same memory types.
+        struct MemoryGroup
+        {
+            uint32_t MemoryTypeBits;
+            vk::DeviceSize Size = 0;
+            vk::DeviceSize Alignment = 1;
+            std::vector<uint32_t> Images;
+        };
+
+        std::vector<MemoryGroup> groups;
+        std::vector<uint32_t> order(TransientImages.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+        {
+            return TransientImages[a].Requirements.size > TransientImages[b].Requirements.size;
+        });
+
+        std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>> taken;
+
+        for (uint32_t index : order)
+        {
+            TransientImage& image = TransientImages[index];
+            const vk::MemoryRequirements& requirements = image.Requirements;
+
+            auto group = std::find_if(groups.begin(), groups.end(), [&](const MemoryGroup& candidate)
+            {
+                return candidate.MemoryTypeBits == requirements.memoryTypeBits;
+            });
+
+            if (group == groups.end())
+            {
+                groups.emplace_back().MemoryTypeBits = requirements.memoryTypeBits;
+                group = groups.end() - 1;
+            }
+
+            taken.clear();
+
+            for (uint32_t other : group->Images)
+            {
+                if (image.IsAliveWith(TransientImages[other]))
+                {
+                    taken.emplace_back(TransientImages[other].Offset,
+                        TransientImages[other].Offset + TransientImages[other].Requirements.size);
+                }
+            }
+
+            std::sort(taken.begin(), taken.end());
+            vk::DeviceSize offset = 0;
+
+            for (const auto& [begin, end] : taken)
+            {
+                if (AlignUp(offset, requirements.alignment) + requirements.size <= begin)
+                {
+                    break;
+                }
+
+                offset = std::max(offset, end);
+            }
+
+            image.MemoryIndex = static_cast<uint32_t>(group - groups.begin());
+            image.Offset = AlignUp(offset, requirements.alignment);
+
+            group->Size = std::max(group->Size, image.Offset + requirements.size);
+            group->Alignment = std::max(group->Alignment, requirements.alignment);
+            group->Images.push_back(index);
+        }
+
+        for (const MemoryGroup& group : groups)
+        {
+            const vk::MemoryRequirements requirements(group.Size, group.Alignment, group.MemoryTypeBits);
+            TransientMemory.push_back(Allocator.Allocate(requirements, vk::MemoryPropertyFlagBits::eDeviceLocal, {},
+                ResourceTiling::Optimal));
+            Stats.AliasedBytes += group.Size;
+        }
+
+        for (TransientImage& image : TransientImages)
+        {
+            const DeviceAllocation& memory = TransientMemory[image.MemoryIndex];
+            image.Image.bindMemory(memory.Memory, memory.Offset + image.Offset);
+
+            const ResourceNode& resource = Resources[image.Resource];
+
+            vk::ImageViewCreateInfo viewInfo;
+            viewInfo.image = *image.Image;
+            viewInfo.viewType = resource.TransientInfo.ArrayLayers > 1 ? vk::ImageViewType::e2DArray : vk::ImageViewType::e2D;
+            viewInfo.format = resource.TransientInfo.Format;
+            viewInfo.subresourceRange = resource.ImageDesc.Range;
+
+            image.View = vk::raii::ImageView(Device, viewInfo);
+        }
+
+        BindTransientImages();
+    }
+
+    void RenderGraph::BindTransientImages()
+    {
+        for (const TransientImage& image : TransientImages)
+        {
+            Resources[image.Resource].ImageDesc.Image = *image.Image;
+            Resources[image.Resource].ImageDesc.View = *image.View;
+        }
+    }
+
+    void RenderGraph::DestroyTransientImages()
+    {
+        // Views before images, images before their memory.
+        TransientImages.clear();
+
+        for (DeviceAllocation& memory : TransientMemory)
+        {
+            Allocator.Free(memory);
+        }
+
+        TransientMemory.clear();
+    }
+
+    void RenderGraph::ComputeBarriers()
+    {
+        std::vector<ResourceState> states(Resources.size());
+        std::vector<uint32_t> transientIndices(Resources.size(), ~0u);
+
+        for (uint32_t index = 0; index < TransientImages.size(); ++index)
+        {
+            transientIndices[TransientImages[index].Resource] = index;
+        }
+
+        // Stages and writes of every use of each transient image in the schedule.
+        std::vector<vk::PipelineStageFlags2> transientStages(TransientImages.size());
+        std::vector<vk::AccessFlags2> transientWrites(TransientImages.size());
+
+        for (const CompiledPass& compiled : Schedule)
+        {
+            const PassNode& pass = Passes[compiled.Pass];
+
+            for (const PassNode::Access& access : pass.Accesses)
+            {
+                const uint32_t index = transientIndices[access.Resource];
+
+                if (index != ~0u)
+                {
+                    const UsageInfo info = GetUsageInfo(access.Usage);
+                    transientStages[index] |= info.Stages ? info.Stages : GetShaderStages(pass.Type);
+                    transientWrites[index] |= access.bWrite ? info.WriteAccess : vk::AccessFlags2();
+                }
+            }
+        }
+
+        for (size_t resource = 0; resource < Resources.size(); ++resource)
+        {
+            const ResourceNode& node = Resources[resource];
+            ResourceState& state = states[resource];
+
+            state.Layout = node.bIsImage ? node.ImageDesc.InitialLayout : vk::ImageLayout::eUndefined;
+            state.WriteStages = node.bIsImage ? node.ImageDesc.InitialStages : node.BufferDesc.InitialStages;
+            state.WriteAccess = node.bIsImage ? node.ImageDesc.InitialAccess : node.BufferDesc.InitialAccess;
+
+            if (transientIndices[resource] == ~0u)
+            {
+                continue;
+            }
+
+            // The memory of a transient image is used by the images placed before it in this frame, and
+            // by every image placed on it, itself included, in the previous frames, which the GPU may
+            // still be running: its first use waits for every stage that touches that memory.
+            const TransientImage& image = TransientImages[transientIndices[resource]];
+
+            for (uint32_t other = 0; other < TransientImages.size(); ++other)
+            {
+                if (&TransientImages[other] == &image || TransientImages[other].SharesMemoryWith(image))
+                {
+                    state.WriteStages |= transientStages[other];
+                    state.WriteAccess |= transientWrites[other];
+                }
+            }
+        }
+
+        const auto addBarrier = [&](BarrierBatch& batch, uint32_t resource, const ResourceBarrier& source)
+        {
+            const ResourceNode& node = Resources[resource];
+
+            if (node.bIsImage)
+            {
+                vk::ImageMemoryBarrier2& barrier = batch.ImageBarriers.emplace_back();
+                barrier.srcStageMask = source.SrcStages;
+                barrier.srcAccessMask = source.SrcAccess;
+                barrier.dstStageMask = source.DstStages;
+                barrier.dstAccessMask = source.DstAccess;
+                barrier.oldLayout = source.OldLayout;
+                barrier.newLayout = source.NewLayout;
+                barrier.subresourceRange = node.ImageDesc.Range;
+                batch.ImageResources.push_back(resource);
+            }
+            else
+            {
+                vk::BufferMemoryBarrier2& barrier = batch.BufferBarriers.emplace_back();
+                barrier.srcStageMask = source.SrcStages;
+                barrier.srcAccessMask = source.SrcAccess;
+                barrier.dstStageMask = source.DstStages;
+                barrier.dstAccessMask = source.DstAccess;
+                barrier.offset = node.BufferDesc.Offset;
+                barrier.size = node.BufferDesc.Size;
+                batch.BufferResources.push_back(resource);
+            }
+        };
+
+        std::vector<MergedAccess> merged;
+
+        for (CompiledPass& compiled : Schedule)
+        {
+            const PassNode& pass = Passes[compiled.Pass];
+            merged.clear();
+
+            // One barrier per resource, whatever the number of usages the pass declares for it.
+            for (const PassNode::Access& access : pass.Accesses)
+            {
+                const UsageInfo info = GetUsageInfo(access.Usage);
+                const vk::PipelineStageFlags2 stages = info.Stages ? info.Stages : GetShaderStages(pass.Type);
+                const vk::AccessFlags2 writeAccess = access.bWrite ? info.WriteAccess : vk::AccessFlags2();
+                const vk::AccessFlags2 accessFlags = (access.bRead ? info.ReadAccess : vk::AccessFlags2()) | writeAccess;
+                const vk::ImageLayout layout = Resources[access.Resource].bIsImage
+                    ? (access.bWrite ? info.WriteLayout : info.ReadLayout) : vk::ImageLayout::eUndefined;
+
+                auto existing = std::find_if(merged.begin(), merged.end(), [&](const MergedAccess& candidate)
+                {
+                    return candidate.Resource == access.Resource;
+                });
+
+                if (existing == merged.end())
+                {
+                    merged.push_back({ access.Resource, { stages, accessFlags, writeAccess, layout, access.bWrite } });
+                    continue;
+                }
+
+                ResourceAccess& mergedAccess = existing->Access;
+
+                if (mergedAccess.Layout != layout)
+                {
+                    NYX_LOG_ERROR(Renderer, "Pass '{}' uses '{}' in layouts {} and {} at once", pass.Name,
+                        Resources[access.Resource].Name, vk::to_string(mergedAccess.Layout), vk::to_string(layout));
+                    throw std::runtime_error("Render graph image used in two layouts by one pass");
+                }
+
+                mergedAccess.Stages |= stages;
+                mergedAccess.Access |= accessFlags;
+                mergedAccess.WriteAccess |= writeAccess;
+                mergedAccess.bWrite = mergedAccess.bWrite || access.bWrite;
+            }
+
+            for (const MergedAccess& access : merged)
+            {
+                const ResourceNode& node = Resources[access.Resource];
+                ResourceState& state = states[access.Resource];
+
+                if (!state.bIsUsed && !node.bIsImported && !access.Access.bWrite)
+                {
+                    NYX_LOG_WARN(Renderer, "Pass '{}' reads transient image '{}' before any pass writes it",
+                        pass.Name, node.Name);
+                }
+
+                if (const std::optional<ResourceBarrier> barrier = ApplyAccess(state, access.Access))
+                {
+                    addBarrier(compiled.Barriers, access.Resource, *barrier);
+                }
+            }
+        }
+
+        // Imported images end in the layout their next user expects; it synchronizes with the graph itself.
+        for (uint32_t resource = 0; resource < Resources.size(); ++resource)
+        {
+            const ResourceNode& node = Resources[resource];
+
+            if (node.bIsImage && node.bIsImported && node.ImageDesc.FinalLayout != vk::ImageLayout::eUndefined
+                && states[resource].Layout != node.ImageDesc.FinalLayout)
+            {
+                addBarrier(FinalBarriers, resource, MakeBarrier(states[resource], {}, {}, node.ImageDesc.FinalLayout));
+            }
+        }
+    }
+
+    void RenderGraph::RecordBarriers(const vk::raii::CommandBuffer& commands, BarrierBatch& batch)
+    {
+        if (batch.IsEmpty())
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < batch.ImageBarriers.size(); ++i)
+        {
+            batch.ImageBarriers[i].image = Resources[batch.ImageResources[i]].ImageDesc.Image;
+        }
+
+        for (size_t i = 0; i < batch.BufferBarriers.size(); ++i)
+        {
+            batch.BufferBarriers[i].buffer = Resources[batch.BufferResources[i]].BufferDesc.Buffer;
+        }
+
+        vk::DependencyInfo dependency;
+        dependency.setImageMemoryBarriers(batch.ImageBarriers);
+        dependency.setBufferMemoryBarriers(batch.BufferBarriers);
+        commands.pipelineBarrier2(dependency);
+    }
+} // namespace nyxara::renderer
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <optional>
+#include <vulkan/vulkan.hpp>
+
+namespace nyxara::renderer
+{
+    /**
+     * @brief Synchronization state of a resource while barriers are derived.
+     */
+    struct ResourceState
+    {
+        vk::ImageLayout Layout = vk::ImageLayout::eUndefined;
+
+        // Last write, or layout transition, and the reads since.
+        vk::PipelineStageFlags2 WriteStages;
+        vk::AccessFlags2 WriteAccess;
+        vk::PipelineStageFlags2 ReadStages;
+
+        // Stages and accesses a barrier already made the last write visible to.
+        vk::PipelineStageFlags2 VisibleStages;
+        vk::AccessFlags2 VisibleAccess;
+
+        bool bIsUsed = false;
+    };
+
+    /**
+     * @brief Accesses of one pass to one resource, merged over its usages.
+     */
+    struct ResourceAccess
+    {
+        vk::PipelineStageFlags2 Stages;
+        vk::AccessFlags2 Access;
+        vk::AccessFlags2 WriteAccess;
+        vk::ImageLayout Layout = vk::ImageLayout::eUndefined;	// Undefined for buffers.
+        bool bWrite = false;
+    };
+
+    /**
+     * @brief A barrier an access needs before it, without the resource it applies to.
+     */
+    struct ResourceBarrier
+    {
+        vk::PipelineStageFlags2 SrcStages;
+        vk::AccessFlags2 SrcAccess;
+        vk::PipelineStageFlags2 DstStages;
+        vk::AccessFlags2 DstAccess;
+        vk::ImageLayout OldLayout = vk::ImageLayout::eUndefined;
+        vk::ImageLayout NewLayout = vk::ImageLayout::eUndefined;
+    };
+
+    /**
+     * @brief Gets the barrier that moves a resource from @p state to @p layout for the given stages and accesses.
+     */
+    inline ResourceBarrier MakeBarrier(const ResourceState& state, vk::PipelineStageFlags2 dstStages,
+        vk::AccessFlags2 dstAccess, vk::ImageLayout layout) noexcept
+    {
+        return { state.WriteStages | state.ReadStages, state.WriteAccess, dstStages, dstAccess, state.Layout, layout };
+    }
+
+    /**
+     * @brief Applies the next access of a pass to a resource.
+     *
+     * Writes and layout transitions wait for the last write and every read since. Reads only
+     * wait for the last write, and not again once a barrier made it visible to their stages
+     * and accesses; a write is visible to nothing until a barrier follows it.
+     *
+     * @return The barrier the access needs first, if any.
+     */
+    inline std::optional<ResourceBarrier> ApplyAccess(ResourceState& state, const ResourceAccess& access) noexcept
+    {
+        std::optional<ResourceBarrier> barrier;
+        state.bIsUsed = true;
+        const bool bTransition = state.Layout != access.Layout;
+
+        if (bTransition || access.bWrite)
+        {
+            if (bTransition || state.WriteStages || state.ReadStages)
+            {
+                barrier = MakeBarrier(state, access.Stages, access.Access, access.Layout);
+            }
+
+            state.Layout = access.Layout;
+            state.WriteStages = access.Stages;
+            state.WriteAccess = access.WriteAccess;
+
+            // A transition for reads is visible to them once its barrier is done; a write is not.
+            state.ReadStages = access.bWrite ? vk::PipelineStageFlags2() : access.Stages;
+            state.VisibleStages = access.bWrite ? vk::PipelineStageFlags2() : access.Stages;
+            state.VisibleAccess = access.bWrite ? vk::AccessFlags2() : access.Access;
+            return barrier;
+        }
+
+        const bool bIsVisible = !(access.Stages & ~state.VisibleStages) && !(access.Access & ~state.VisibleAccess);
+
+        if (state.WriteStages && !bIsVisible)
+        {
+            ResourceState writeState = state;
+            writeState.ReadStages = {};
+            barrier = MakeBarrier(writeState, access.Stages, access.Access, access.Layout);
+
+            state.VisibleStages |= access.Stages;
+            state.VisibleAccess |= access.Access;
+        }
+
+        state.ReadStages |= access.Stages;
+        return barrier;
+    }
+} // namespace nyxara::renderer
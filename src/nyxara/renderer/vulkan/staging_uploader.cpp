@@ -0,0 +1,496 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "nyxara/renderer/vulkan/staging_uploader.h"
+#include "nyxara/renderer/vulkan/device.h"
+#include "nyxara/core/logging/categories.h"
+
+namespace nyxara::renderer
+{
+    namespace
+    {
+        struct PendingBufferCopy
+        {
+            vk::Buffer Buffer;
+            vk::BufferCopy Region;
+        };
+
+        struct PendingImageCopy
+        {
+            ImageUpload Upload;
+            vk::DeviceSize BufferOffset;
+        };
+
+        vk::ImageSubresourceRange GetSubresourceRange(const vk::ImageSubresourceLayers& layers) noexcept
+        {
+            return vk::ImageSubresourceRange(layers.aspectMask, layers.mipLevel, 1, layers.baseArrayLayer, layers.layerCount);
+        }
+
+        void WaitTimeline(const vk::raii::Device& device, const vk::raii::Semaphore& timeline, uint64_t value)
+        {
+            const vk::Semaphore semaphore = *timeline;
+
+            vk::SemaphoreWaitInfo waitInfo;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &semaphore;
+            waitInfo.pValues = &value;
+
+            (void)device.waitSemaphores(waitInfo, std::numeric_limits<uint64_t>::max());
+        }
+
+        double ToMebibytes(uint64_t bytes) noexcept
+        {
+            return static_cast<double>(bytes) / (1024.0 * 1024.0);
+        }
+    } // namespace
+
+    /**
+     * @brief Uploads sharing a region of the ring and a command buffer, submitted together.
+     */
+    struct StagingUploader::Batch
+    {
+        vk::raii::CommandPool Pool{ nullptr };
+        vk::raii::CommandBuffer Commands{ nullptr };
+
+        std::vector<PendingBufferCopy> BufferCopies;
+        std::vector<PendingImageCopy> ImageCopies;
+
+        // Timeline value signaled by the last submission of this batch, 0 if none.
+        uint64_t Value = 0;
+
+        // Reservations whose data is still being copied into the ring.
+        uint32_t PendingWrites = 0;
+
+        bool IsEmpty() const noexcept { return BufferCopies.empty() && ImageCopies.empty(); }
+    };
+
+    StagingUploader::StagingUploader(const VulkanDevice& device, DeviceAllocator& allocator,
+        const StagingUploaderOptions& options)
+        : Device(device),
+          Allocator(allocator),
+          bHasTransferQueue(device.HasDedicatedTransferQueue()),
+          MaxPendingAcquires(std::max(options.MaxPendingAcquires, 1u)),
+          CopyAlignment(std::max<vk::DeviceSize>(16, device.GetProperties().limits.optimalBufferCopyOffsetAlignment)),
+          Ring(options.RingSize, std::max(options.MaxBatchesInFlight, 1u))
+    {
+        NYX_TRACE_FUNCTION(Renderer);
+
+        vk::BufferCreateInfo bufferInfo;
+        bufferInfo.size = options.RingSize;
+        bufferInfo.usage = vk::BufferUsageFlagBits::eTransferSrc;
+
+        // Only ever written by the CPU and read once by copies: plain write-combined host memory is the best fit.
+        StagingBuffer = Allocator.CreateBuffer(bufferInfo,
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, {}, StagingAllocation);
+
+        vk::SemaphoreTypeCreateInfo timelineInfo(vk::SemaphoreType::eTimeline, 0);
+        vk::SemaphoreCreateInfo semaphoreInfo;
+        semaphoreInfo.pNext = &timelineInfo;
+        Timeline = vk::raii::Semaphore(Device.GetDevice(), semaphoreInfo);
+
+        vk::CommandPoolCreateInfo poolInfo;
+        poolInfo.flags = vk::CommandPoolCreateFlagBits::eTransient;
+        poolInfo.queueFamilyIndex = Device.GetTransferQueueFamily();
+
+        for (uint32_t i = 0; i < std::max(options.MaxBatchesInFlight, 1u); ++i)
+        {
+            auto batch = std::make_unique<Batch>();
+            batch->Pool = vk::raii::CommandPool(Device.GetDevice(), poolInfo);
+
+            vk::CommandBufferAllocateInfo allocateInfo;
+            allocateInfo.commandPool = *batch->Pool;
+            allocateInfo.level = vk::CommandBufferLevel::ePrimary;
+            allocateInfo.commandBufferCount = 1;
+            batch->Commands = std::move(vk::raii::CommandBuffers(Device.GetDevice(), allocateInfo).front());
+
+            Batches.push_back(std::move(batch));
+        }
+
+        NYX_LOG_INFO(Renderer, "Staging uploader created: {:.0f} MiB ring, {} batch(es) in flight, on the {} queue",
+            ToMebibytes(options.RingSize), Batches.size(), bHasTransferQueue ? "transfer" : "graphics");
+    }
+
+    StagingUploader::~StagingUploader()
+    {
+        Wait(Flush());
+
+        StagingBuffer.clear();
+        Allocator.Free(StagingAllocation);
+
+        const StagingUploaderStats stats = GetStats();
+        NYX_LOG_INFO(Renderer, "Staging uploader: {} upload(s), {:.1f} MiB in {} batch(es), {} stall(s), ring peak {:.1f} MiB",
+            stats.UploadCount, ToMebibytes(stats.UploadedBytes), stats.SubmitCount, stats.StallCount,
+            ToMebibytes(stats.PeakRingBytes));
+    }
+
+    UploadToken StagingUploader::UploadBuffer(vk::Buffer buffer, vk::DeviceSize offset, std::span<const std::byte> data)
+    {
+        // Chunks no larger than a batch's share of the ring keep several batches in flight during large uploads.
+        const vk::DeviceSize maxChunkSize = std::max<vk::DeviceSize>(Ring.GetSize() / Batches.size(), 1);
+        UploadToken token;
+
+        for (size_t copied = 0; copied < data.size();)
+        {
+            const vk::DeviceSize chunkSize = std::min<vk::DeviceSize>(data.size() - copied, maxChunkSize);
+            Reservation reservation;
+
+            {
+                std::unique_lock lock(Mutex);
+                reservation = Reserve(lock, chunkSize);
+                reservation.Target->BufferCopies.push_back({ buffer, vk::BufferCopy(reservation.Offset, offset + copied, chunkSize) });
+
+                token.Value = SubmittedValue + 1;
+                Stats.UploadCount += copied == 0 ? 1 : 0;
+                Stats.UploadedBytes += chunkSize;
+            }
+
+            std::memcpy(reservation.Data, data.data() + copied, chunkSize);
+            Commit(reservation);
+
+            copied += chunkSize;
+        }
+
+        return token;
+    }
+
+    UploadToken StagingUploader::UploadImage(const ImageUpload& upload, std::span<const std::byte> data)
+    {
+        if (data.size() > Ring.GetSize())
+        {
+            NYX_LOG_ERROR(Renderer, "Image upload of {:.1f} MiB does not fit in the {:.1f} MiB staging ring",
+                ToMebibytes(data.size()), ToMebibytes(Ring.GetSize()));
+            throw std::runtime_error("Image upload larger than the staging ring");
+        }
+
+        Reservation reservation;
+        UploadToken token;
+
+        {
+            std::unique_lock lock(Mutex);
+            reservation = Reserve(lock, data.size());
+            reservation.Target->ImageCopies.push_back({ upload, reservation.Offset });
+
+            token.Value = SubmittedValue + 1;
+            ++Stats.UploadCount;
+            Stats.UploadedBytes += data.size();
+        }
+
+        std::memcpy(reservation.Data, data.data(), data.size());
+        Commit(reservation);
+
+        return token;
+    }
+
+    UploadToken StagingUploader::Flush()
+    {
+        std::unique_lock lock(Mutex);
+
+        if (HasOpenUploads())
+        {
+            SubmitBatch(lock);
+        }
+
+        return { SubmittedValue };
+    }
+
+    bool StagingUploader::IsComplete(UploadToken token) const
+    {
+        return token.Value <= Timeline.getCounterValue();
+    }
+
+    void StagingUploader::Wait(UploadToken token)
+    {
+        {
+            std::unique_lock lock(Mutex);
+
+            if (token.Value > SubmittedValue)
+            {
+                SubmitBatch(lock);
+            }
+        }
+
+        if (token.Value > 0)
+        {
+            WaitTimeline(Device.GetDevice(), Timeline, token.Value);
+        }
+    }
+
+    vk::SemaphoreSubmitInfo StagingUploader::AcquireUploads(const vk::raii::CommandBuffer& commands)
+    {
+        std::unique_lock lock(Mutex);
+
+        if (HasOpenUploads())
+        {
+            SubmitBatch(lock);
+        }
+
+        if (!PendingBufferAcquires.empty() || !PendingImageAcquires.empty())
+        {
+            vk::DependencyInfo dependency;
+            dependency.setBufferMemoryBarriers(PendingBufferAcquires);
+            dependency.setImageMemoryBarriers(PendingImageAcquires);
+            commands.pipelineBarrier2(dependency);
+
+            PendingBufferAcquires.clear();
+            PendingImageAcquires.clear();
+        }
+
+        // Waiting for a value already reached costs nothing, so always wait for everything submitted.
+        vk::SemaphoreSubmitInfo wait;
+
+        if (SubmittedValue > 0)
+        {
+            wait.semaphore = *Timeline;
+            wait.value = SubmittedValue;
+            wait.stageMask = vk::PipelineStageFlagBits2::eAllCommands;
+        }
+
+        return wait;
+    }
+
+    StagingUploaderStats StagingUploader::GetStats() const
+    {
+        std::lock_guard lock(Mutex);
+
+        StagingUploaderStats stats = Stats;
+        stats.PeakRingBytes = Ring.GetPeakBytes();
+        return stats;
+    }
+
+    bool StagingUploader::HasOpenUploads() const noexcept
+    {
+        // While a batch is being opened, it still holds the uploads of its previous, submitted use.
+        return !bIsOpeningBatch && !Batches[OpenBatch]->IsEmpty();
+    }
+
+    StagingUploader::Reservation StagingUploader::Reserve(std::unique_lock<std::mutex>& lock, vk::DeviceSize size)
+    {
+        // Each upload adds one acquire at most, so this bounds what a missing AcquireUploads() piles up.
+        if (bHasTransferQueue && PendingBufferAcquires.size() + PendingImageAcquires.size() >= MaxPendingAcquires)
+        {
+            NYX_LOG_ERROR(Renderer, "{} uploads are waiting for AcquireUploads(); is the render loop calling it?",
+                PendingBufferAcquires.size() + PendingImageAcquires.size());
+            throw std::runtime_error("Too many uploads waiting for AcquireUploads()");
+        }
+
+        uint64_t offset = RingAllocator::InvalidOffset;
+
+        for (;;)
+        {
+            WritesDone.wait(lock, [&] { return !bIsOpeningBatch; });
+            offset = Ring.Allocate(size, CopyAlignment);
+
+            if (offset != RingAllocator::InvalidOffset)
+            {
+                break;
+            }
+
+            // The ring is full: submit the open batch and take back the region of the oldest one.
+            SubmitBatch(lock);
+        }
+
+        Batch& batch = *Batches[OpenBatch];
+        ++batch.PendingWrites;
+
+        return { &batch, StagingAllocation.MappedData + offset, offset };
+    }
+
+    void StagingUploader::Commit(const Reservation& reservation)
+    {
+        std::lock_guard lock(Mutex);
+
+        if (--reservation.Target->PendingWrites == 0)
+        {
+            WritesDone.notify_all();
+        }
+    }
+
+    void StagingUploader::SubmitBatch(std::unique_lock<std::mutex>& lock)
+    {
+        // Another thread opens the next batch; the caller's uploads go to it once it is open.
+        WritesDone.wait(lock, [&] { return !bIsOpeningBatch; });
+
+        Batch& batch = *Batches[OpenBatch];
+
+        if (!batch.IsEmpty())
+        {
+            const uint64_t value = SubmittedValue + 1;
+
+            // Producers copy their data outside the lock; the batch can only go once they are done.
+            WritesDone.wait(lock, [&] { return batch.PendingWrites == 0 || SubmittedValue >= value; });
+
+            if (SubmittedValue >= value)
+            {
+                // Another thread submitted it while this one waited.
+                return;
+            }
+
+            RecordBatch(batch);
+
+            vk::CommandBufferSubmitInfo commandInfo;
+            commandInfo.commandBuffer = *batch.Commands;
+
+            vk::SemaphoreSubmitInfo signalInfo;
+            signalInfo.semaphore = *Timeline;
+            signalInfo.value = value;
+            signalInfo.stageMask = vk::PipelineStageFlagBits2::eAllCommands;
+
+            vk::SubmitInfo2 submitInfo;
+            submitInfo.setCommandBufferInfos(commandInfo);
+            submitInfo.setSignalSemaphoreInfos(signalInfo);
+
+            Device.SubmitTransfer(submitInfo);
+
+            batch.Value = value;
+            SubmittedValue = value;
+            ++Stats.SubmitCount;
+            WritesDone.notify_all();
+        }
+
+        // The next batch reuses a ring region and a command buffer: the GPU must be done with them.
+        OpenBatch = (OpenBatch + 1) % static_cast<uint32_t>(Batches.size());
+        Batch& next = *Batches[OpenBatch];
+
+        if (next.Value > Timeline.getCounterValue())
+        {
+            ++Stats.StallCount;
+
+            // Wait without the lock, so other producers finish their copies and the render thread acquires.
+            bIsOpeningBatch = true;
+            lock.unlock();
+
+            try
+            {
+                WaitTimeline(Device.GetDevice(), Timeline, next.Value);
+            }
+            catch (...)
+            {
+                lock.lock();
+                bIsOpeningBatch = false;
+                WritesDone.notify_all();
+                throw;
+            }
+
+            lock.lock();
+        }
+
+        next.Pool.reset();
+        next.BufferCopies.clear();
+        next.ImageCopies.clear();
+        next.Value = 0;
+
+        Ring.BeginFrame();
+
+        if (bIsOpeningBatch)
+        {
+            bIsOpeningBatch = false;
+            WritesDone.notify_all();
+        }
+    }
+
+    void StagingUploader::RecordBatch(Batch& batch)
+    {
+        const vk::raii::CommandBuffer& commands = batch.Commands;
+        commands.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+
+        std::vector<vk::BufferMemoryBarrier2> bufferBarriers;
+        std::vector<vk::ImageMemoryBarrier2> imageBarriers;
+
+        for (const PendingImageCopy& copy : batch.ImageCopies)
+        {
+            vk::ImageMemoryBarrier2& barrier = imageBarriers.emplace_back();
+            barrier.dstStageMask = vk::PipelineStageFlagBits2::eCopy;
+            barrier.dstAccessMask = vk::AccessFlagBits2::eTransferWrite;
+            barrier.oldLayout = vk::ImageLayout::eUndefined;
+            barrier.newLayout = vk::ImageLayout::eTransferDstOptimal;
+            barrier.image = copy.Upload.Image;
+            barrier.subresourceRange = GetSubresourceRange(copy.Upload.Subresource);
+        }
+
+        if (!imageBarriers.empty())
+        {
+            vk::DependencyInfo dependency;
+            dependency.setImageMemoryBarriers(imageBarriers);
+            commands.pipelineBarrier2(dependency);
+        }
+
+        for (const PendingBufferCopy& copy : batch.BufferCopies)
+        {
+            commands.copyBuffer(*StagingBuffer, copy.Buffer, copy.Region);
+        }
+
+        for (const PendingImageCopy& copy : batch.ImageCopies)
+        {
+            const vk::BufferImageCopy region(copy.BufferOffset, 0, 0, copy.Upload.Subresource, copy.Upload.Offset,
+                copy.Upload.Extent);
+            commands.copyBufferToImage(*StagingBuffer, copy.Upload.Image, vk::ImageLayout::eTransferDstOptimal, region);
+        }
+
+        // Hand the resources to the graphics queue: released from the transfer family, whose acquire
+        // AcquireUploads() records, or made visible to graphics work waiting on the timeline.
+        const uint32_t transferFamily = Device.GetTransferQueueFamily();
+        const uint32_t graphicsFamily = Device.GetGraphicsQueueFamily();
+        imageBarriers.clear();
+
+        // Without a transfer queue, the semaphore signal and wait already make buffer writes visible.
+        if (bHasTransferQueue)
+        {
+            for (const PendingBufferCopy& copy : batch.BufferCopies)
+            {
+                vk::BufferMemoryBarrier2& release = bufferBarriers.emplace_back();
+                release.srcStageMask = vk::PipelineStageFlagBits2::eCopy;
+                release.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+                release.srcQueueFamilyIndex = transferFamily;
+                release.dstQueueFamilyIndex = graphicsFamily;
+                release.buffer = copy.Buffer;
+                release.offset = copy.Region.dstOffset;
+                release.size = copy.Region.size;
+
+                vk::BufferMemoryBarrier2& acquire = PendingBufferAcquires.emplace_back(release);
+                acquire.srcStageMask = vk::PipelineStageFlagBits2::eNone;
+                acquire.srcAccessMask = vk::AccessFlagBits2::eNone;
+                acquire.dstStageMask = vk::PipelineStageFlagBits2::eAllCommands;
+                acquire.dstAccessMask = vk::AccessFlagBits2::eMemoryRead | vk::AccessFlagBits2::eMemoryWrite;
+            }
+        }
+
+        for (const PendingImageCopy& copy : batch.ImageCopies)
+        {
+            vk::ImageMemoryBarrier2& barrier = imageBarriers.emplace_back();
+            barrier.srcStageMask = vk::PipelineStageFlagBits2::eCopy;
+            barrier.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+            barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+            barrier.newLayout = copy.Upload.FinalLayout;
+            barrier.image = copy.Upload.Image;
+            barrier.subresourceRange = GetSubresourceRange(copy.Upload.Subresource);
+
+            if (bHasTransferQueue)
+            {
+                barrier.srcQueueFamilyIndex = transferFamily;
+                barrier.dstQueueFamilyIndex = graphicsFamily;
+
+                vk::ImageMemoryBarrier2& acquire = PendingImageAcquires.emplace_back(barrier);
+                acquire.srcStageMask = vk::PipelineStageFlagBits2::eNone;
+                acquire.srcAccessMask = vk::AccessFlagBits2::eNone;
+                acquire.dstStageMask = vk::PipelineStageFlagBits2::eAllCommands;
+                acquire.dstAccessMask = vk::AccessFlagBits2::eMemoryRead | vk::AccessFlagBits2::eMemoryWrite;
+            }
+            else
+            {
+                barrier.dstStageMask = vk::PipelineStageFlagBits2::eAllCommands;
+                barrier.dstAccessMask = vk::AccessFlagBits2::eMemoryRead | vk::AccessFlagBits2::eMemoryWrite;
+            }
+        }
+
+        if (!bufferBarriers.empty() || !imageBarriers.empty())
+        {
+            vk::DependencyInfo dependency;
+            dependency.setBufferMemoryBarriers(bufferBarriers);
+            dependency.setImageMemoryBarriers(imageBarriers);
+            commands.pipelineBarrier2(dependency);
+        }
+
+        commands.end();
+    }
+} // namespace nyxara::renderer
@@ -0,0 +1,359 @@
+#include <algorithm>
+#include <bit>
+#include "nyxara/renderer/vulkan/sub_allocator.h"
+
+namespace nyxara::renderer
+{
+    namespace
+    {
+        constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    } // namespace
+
+    TlsfAllocator::TlsfAllocator(uint64_t size, uint64_t granularity)
+        : Size(size & ~(MinAlignment - 1)),
+          Granularity(std::max<uint64_t>(granularity, 1))
+    {
+        FreeLists.fill(NoNode);
+
+        if (Size > 0)
+        {
+            const uint32_t node = CreateNode();
+            Nodes[node].Size = Size;
+            InsertFree(node);
+        }
+    }
+
+    TlsfAllocator::Allocation TlsfAllocator::Allocate(uint64_t size, uint64_t alignment, ResourceTiling tiling)
+    {
+        if (tiling == ResourceTiling::Optimal && Granularity > 1)
+        {
+            alignment = std::max(alignment, Granularity);
+            size = AlignUp(size, Granularity);
+        }
+
+        alignment = std::max(alignment, MinAlignment);
+        size = AlignUp(std::max<uint64_t>(size, 1), MinAlignment);
+
+        // Every offset is MinAlignment-aligned, so larger alignments may need that much padding.
+        const uint64_t searchSize = size + (alignment - MinAlignment);
+
+        if (size > Size || searchSize > Size)
+        {
+            return {};
+        }
+
+        uint32_t node = FindFreeNode(searchSize);
+
+        if (node == NoNode)
+        {
+            return {};
+        }
+
+        RemoveFree(node);
+
+        const uint64_t padding = AlignUp(Nodes[node].Offset, alignment) - Nodes[node].Offset;
+
+        if (padding > 0)
+        {
+            // The padding stays a free range of its own; the previous range is allocated, or it would have been merged.
+            Split(node, padding);
+            InsertFree(node);
+            node = Nodes[node].NextPhysical;
+            RemoveFree(node);
+        }
+
+        if (Nodes[node].Size - size >= MinAlignment)
+        {
+            Split(node, size);
+        }
+
+        Nodes[node].bIsFree = false;
+        UsedBytes += Nodes[node].Size;
+        ++AllocationCount;
+
+        return { Nodes[node].Offset, Nodes[node].Size, node };
+    }
+
+    void TlsfAllocator::Free(uint32_t handle)
+    {
+        uint32_t node = handle;
+
+        UsedBytes -= Nodes[node].Size;
+        --AllocationCount;
+        Nodes[node].bIsFree = true;
+
+        const uint32_t previous = Nodes[node].PreviousPhysical;
+
+        if (previous != NoNode && Nodes[previous].bIsFree)
+        {
+            RemoveFree(previous);
+            Nodes[previous].Size += Nodes[node].Size;
+            Nodes[previous].NextPhysical = Nodes[node].NextPhysical;
+
+            if (Nodes[node].NextPhysical != NoNode)
+            {
+                Nodes[Nodes[node].NextPhysical].PreviousPhysical = previous;
+            }
+
+            ReleaseNode(node);
+            node = previous;
+        }
+
+        const uint32_t next = Nodes[node].NextPhysical;
+
+        if (next != NoNode && Nodes[next].bIsFree)
+        {
+            RemoveFree(next);
+            Nodes[node].Size += Nodes[next].Size;
+            Nodes[node].NextPhysical = Nodes[next].NextPhysical;
+
+            if (Nodes[next].NextPhysical != NoNode)
+            {
+                Nodes[Nodes[next].NextPhysical].PreviousPhysical = node;
+            }
+
+            ReleaseNode(next);
+        }
+
+        InsertFree(node);
+    }
+
+    TlsfAllocatorStats TlsfAllocator::GetStats() const noexcept
+    {
+        TlsfAllocatorStats stats;
+        stats.Size = Size;
+        stats.UsedBytes = UsedBytes;
+        stats.AllocationCount = AllocationCount;
+        stats.FreeRangeCount = FreeRangeCount;
+
+        if (FirstLevelBitmap != 0)
+        {
+            // The largest range is in the highest non-empty list, which spans one size class.
+            const uint32_t firstLevel = 63 - static_cast<uint32_t>(std::countl_zero(FirstLevelBitmap));
+            const uint32_t secondLevel = 31 - static_cast<uint32_t>(std::countl_zero(SecondLevelBitmaps[firstLevel]));
+
+            for (uint32_t node = FreeLists[firstLevel * SecondLevelCount + secondLevel]; node != NoNode;
+                node = Nodes[node].NextFree)
+            {
+                stats.LargestFreeRange = std::max(stats.LargestFreeRange, Nodes[node].Size);
+            }
+        }
+
+        return stats;
+    }
+
+    void TlsfAllocator::GetSizeClass(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel) noexcept
+    {
+        if (size < SmallRangeSize)
+        {
+            firstLevel = 0;
+            secondLevel = static_cast<uint32_t>(size / (SmallRangeSize / SecondLevelCount));
+        }
+        else
+        {
+            const uint32_t log2 = static_cast<uint32_t>(std::bit_width(size)) - 1;
+            firstLevel = log2 - FirstLevelShift;
+            secondLevel = static_cast<uint32_t>(size >> (log2 - SecondLevelBits)) ^ SecondLevelCount;
+        }
+    }
+
+    uint32_t TlsfAllocator::FindFreeNode(uint64_t size) const noexcept
+    {
+        // Round up to the next class boundary, so that every range of the class found is large enough.
+        uint64_t classSize = size;
+
+        if (classSize >= SmallRangeSize)
+        {
+            classSize += (uint64_t(1) << (std::bit_width(classSize) - 1 - SecondLevelBits)) - 1;
+        }
+        else
+        {
+            classSize = AlignUp(classSize, SmallRangeSize / SecondLevelCount);
+        }
+
+        uint32_t firstLevel;
+        uint32_t secondLevel;
+        GetSizeClass(classSize, firstLevel, secondLevel);
+
+        uint32_t secondLevelMap = SecondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+
+        if (secondLevelMap == 0)
+        {
+            const uint64_t firstLevelMap = firstLevel + 1 < FirstLevelCount
+                ? FirstLevelBitmap & (~uint64_t(0) << (firstLevel + 1)) : 0;
+
+            if (firstLevelMap != 0)
+            {
+                firstLevel = static_cast<uint32_t>(std::countr_zero(firstLevelMap));
+                secondLevelMap = SecondLevelBitmaps[firstLevel];
+            }
+        }
+
+        if (secondLevelMap != 0)
+        {
+            secondLevel = static_cast<uint32_t>(std::countr_zero(secondLevelMap));
+            return FreeLists[firstLevel * SecondLevelCount + secondLevel];
+        }
+
+        // Nothing is certain to fit: a nearly full allocator may still have a large enough range in the size's own class.
+        GetSizeClass(size, firstLevel, secondLevel);
+
+        for (uint32_t node = FreeLists[firstLevel * SecondLevelCount + secondLevel]; node != NoNode; node = Nodes[node].NextFree)
+        {
+            if (Nodes[node].Size >= size)
+            {
+                return node;
+            }
+        }
+
+        return NoNode;
+    }
+
+    void TlsfAllocator::InsertFree(uint32_t node) noexcept
+    {
+        uint32_t firstLevel;
+        uint32_t secondLevel;
+        GetSizeClass(Nodes[node].Size, firstLevel, secondLevel);
+
+        uint32_t& head = FreeLists[firstLevel * SecondLevelCount + secondLevel];
+
+        Nodes[node].bIsFree = true;
+        Nodes[node].PreviousFree = NoNode;
+        Nodes[node].NextFree = head;
+
+        if (head != NoNode)
+        {
+            Nodes[head].PreviousFree = node;
+        }
+
+        head = node;
+        FirstLevelBitmap |= uint64_t(1) << firstLevel;
+        SecondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+        ++FreeRangeCount;
+    }
+
+    void TlsfAllocator::RemoveFree(uint32_t node) noexcept
+    {
+        const Node& removed = Nodes[node];
+
+        if (removed.PreviousFree != NoNode)
+        {
+            Nodes[removed.PreviousFree].NextFree = removed.NextFree;
+        }
+        else
+        {
+            uint32_t firstLevel;
+            uint32_t secondLevel;
+            GetSizeClass(removed.Size, firstLevel, secondLevel);
+
+            FreeLists[firstLevel * SecondLevelCount + secondLevel] = removed.NextFree;
+
+            if (removed.NextFree == NoNode)
+            {
+                SecondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+
+                if (SecondLevelBitmaps[firstLevel] == 0)
+                {
+                    FirstLevelBitmap &= ~(uint64_t(1) << firstLevel);
+                }
+            }
+        }
+
+        if (removed.NextFree != NoNode)
+        {
+            Nodes[removed.NextFree].PreviousFree = removed.PreviousFree;
+        }
+
+        --FreeRangeCount;
+    }
+
+    void TlsfAllocator::Split(uint32_t node, uint64_t size)
+    {
+        // Creating a node may reallocate Nodes: index, never hold references across it.
+        const uint32_t remainder = CreateNode();
+
+        Nodes[remainder].Offset = Nodes[node].Offset + size;
+        Nodes[remainder].Size = Nodes[node].Size - size;
+        Nodes[remainder].PreviousPhysical = node;
+        Nodes[remainder].NextPhysical = Nodes[node].NextPhysical;
+
+        if (Nodes[node].NextPhysical != NoNode)
+        {
+            Nodes[Nodes[node].NextPhysical].PreviousPhysical = remainder;
+        }
+
+        Nodes[node].Size = size;
+        Nodes[node].NextPhysical = remainder;
+
+        InsertFree(remainder);
+    }
+
+    uint32_t TlsfAllocator::CreateNode()
+    {
+        if (UnusedNodes != NoNode)
+        {
+            const uint32_t node = UnusedNodes;
+            UnusedNodes = Nodes[node].NextFree;
+            Nodes[node] = Node{};
+            return node;
+        }
+
+        Nodes.emplace_back();
+        return static_cast<uint32_t>(Nodes.size() - 1);
+    }
+
+    void TlsfAllocator::ReleaseNode(uint32_t node) noexcept
+    {
+        Nodes[node].bIsFree = false;
+        Nodes[node].NextFree = UnusedNodes;
+        UnusedNodes = node;
+    }
+
+    RingAllocator::RingAllocator(uint64_t size, uint32_t framesInFlight)
+        : Size(size),
+          FrameBytes(std::max<uint32_t>(framesInFlight, 1), 0)
+    {}
+
+    void RingAllocator::BeginFrame() noexcept
+    {
+        CurrentFrame = (CurrentFrame + 1) % static_cast<uint32_t>(FrameBytes.size());
+
+        UsedBytes -= FrameBytes[CurrentFrame];
+        FrameBytes[CurrentFrame] = 0;
+    }
+
+    uint64_t RingAllocator::Allocate(uint64_t size, uint64_t alignment) noexcept
+    {
+        // Nothing alive: start over, so that any size up to the ring's fits.
+        if (UsedBytes == 0)
+        {
+            Head = 0;
+        }
+
+        uint64_t offset = AlignUp(Head, std::max<uint64_t>(alignment, 1));
+        uint64_t consumed = offset - Head + size;
+
+        if (offset + size > Size)
+        {
+            // Skip the end of the ring; the skipped bytes are released with this frame.
+            offset = 0;
+            consumed = Size - Head + size;
+        }
+
+        // The free bytes always start at Head, wrapping around the end.
+        if (consumed > Size - UsedBytes)
+        {
+            return InvalidOffset;
+        }
+
+        Head = offset + size;
+        UsedBytes += consumed;
+        PeakBytes = std::max(PeakBytes, UsedBytes);
+        FrameBytes[CurrentFrame] += consumed;
+
+        return offset;
+    }
+} // namespace nyxara::renderer
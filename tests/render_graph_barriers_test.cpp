@@ -0,0 +1,180 @@
+/**
+ * @file render_graph_barriers_test.cpp
+ * @brief Barriers the render graph derives from a sequence of accesses to one resource.
+ *
+ * Runs the per-resource state machine of ::nyxara::renderer::RenderGraph without a device:
+ * write then read, read-write then read, write after read, and layout transitions.
+ */
+
+#include <cstdio>
+#include <optional>
+#include "nyxara/renderer/vulkan/resource_state.h"
+
+namespace
+{
+	using Stage = vk::PipelineStageFlagBits2;
+	using Access = vk::AccessFlagBits2;
+	using Layout = vk::ImageLayout;
+	using nyxara::renderer::ApplyAccess;
+	using nyxara::renderer::ResourceAccess;
+	using nyxara::renderer::ResourceBarrier;
+	using nyxara::renderer::ResourceState;
+
+	int FailureCount = 0;
+
+	void Check(bool bCondition, const char* test, const char* what)
+	{
+		if (!bCondition)
+		{
+			std::fprintf(stderr, "%s: %s\n", test, what);
+			++FailureCount;
+		}
+	}
+
+	ResourceAccess StorageRead(vk::PipelineStageFlags2 stages = Stage::eComputeShader)
+	{
+		return { stages, Access::eShaderStorageRead, {}, Layout::eGeneral, false };
+	}
+
+	ResourceAccess StorageWrite(vk::PipelineStageFlags2 stages = Stage::eComputeShader)
+	{
+		return { stages, Access::eShaderStorageWrite, Access::eShaderStorageWrite, Layout::eGeneral, true };
+	}
+
+	ResourceAccess StorageReadWrite(vk::PipelineStageFlags2 stages = Stage::eComputeShader)
+	{
+		return { stages, Access::eShaderStorageRead | Access::eShaderStorageWrite, Access::eShaderStorageWrite,
+			Layout::eGeneral, true };
+	}
+
+	ResourceAccess ColorWrite(bool bRead)
+	{
+		const vk::AccessFlags2 read = bRead ? Access::eColorAttachmentRead : vk::AccessFlags2();
+		return { Stage::eColorAttachmentOutput, read | Access::eColorAttachmentWrite, Access::eColorAttachmentWrite,
+			Layout::eColorAttachmentOptimal, true };
+	}
+
+	ResourceAccess ColorRead()
+	{
+		return { Stage::eColorAttachmentOutput, Access::eColorAttachmentRead, {}, Layout::eColorAttachmentOptimal, false };
+	}
+
+	ResourceAccess Sampled()
+	{
+		return { Stage::eFragmentShader, Access::eShaderSampledRead, {}, Layout::eReadOnlyOptimal, false };
+	}
+
+	ResourceState StateIn(Layout layout)
+	{
+		ResourceState state;
+		state.Layout = layout;
+		return state;
+	}
+
+	void TestWriteThenRead()
+	{
+		const char* test = "write then read";
+		ResourceState state = StateIn(Layout::eGeneral);
+
+		Check(!ApplyAccess(state, StorageWrite()), test, "first write waits for nothing");
+
+		const std::optional<ResourceBarrier> barrier = ApplyAccess(state, StorageRead());
+		Check(barrier.has_value(), test, "read after write has no barrier");
+
+		if (barrier)
+		{
+			Check(barrier->SrcStages == Stage::eComputeShader, test, "wrong source stages");
+			Check(barrier->SrcAccess == Access::eShaderStorageWrite, test, "wrong source access");
+			Check(barrier->DstAccess == Access::eShaderStorageRead, test, "wrong destination access");
+			Check(barrier->OldLayout == barrier->NewLayout, test, "unexpected layout transition");
+		}
+
+		Check(!ApplyAccess(state, StorageRead()), test, "second read of a visible write has a barrier");
+		Check(ApplyAccess(state, StorageRead(Stage::eFragmentShader)).has_value(), test,
+			"read from another stage has no barrier");
+	}
+
+	void TestReadWriteThenRead()
+	{
+		const char* test = "read-write then read";
+		ResourceState state = StateIn(Layout::eGeneral);
+
+		ApplyAccess(state, StorageWrite());
+		Check(ApplyAccess(state, StorageReadWrite()).has_value(), test, "read-write after write has no barrier");
+		Check(ApplyAccess(state, StorageRead()).has_value(), test, "read after read-write has no barrier");
+
+		state = StateIn(Layout::eColorAttachmentOptimal);
+		ApplyAccess(state, ColorWrite(false));
+		Check(ApplyAccess(state, ColorWrite(true)).has_value(), test, "attachment blend after write has no barrier");
+		Check(ApplyAccess(state, ColorRead()).has_value(), test, "attachment read after blend has no barrier");
+	}
+
+	void TestWriteAfterRead()
+	{
+		const char* test = "write after read";
+		ResourceState state = StateIn(Layout::eGeneral);
+
+		ApplyAccess(state, StorageWrite());
+		ApplyAccess(state, StorageRead(Stage::eFragmentShader));
+		ApplyAccess(state, StorageRead(Stage::eVertexShader));
+
+		const std::optional<ResourceBarrier> barrier = ApplyAccess(state, StorageWrite());
+		Check(barrier.has_value(), test, "write after reads has no barrier");
+
+		if (barrier)
+		{
+			Check(barrier->SrcStages == (Stage::eComputeShader | Stage::eFragmentShader | Stage::eVertexShader), test,
+				"write does not wait for the last write and every read");
+		}
+
+		Check(ApplyAccess(state, StorageRead()).has_value(), test, "read after the second write has no barrier");
+	}
+
+	void TestLayoutTransitions()
+	{
+		const char* test = "layout transitions";
+		ResourceState state;
+
+		std::optional<ResourceBarrier> barrier = ApplyAccess(state, ColorWrite(false));
+		Check(barrier && barrier->OldLayout == Layout::eUndefined
+			&& barrier->NewLayout == Layout::eColorAttachmentOptimal, test, "first use does not transition");
+
+		barrier = ApplyAccess(state, Sampled());
+		Check(barrier && barrier->OldLayout == Layout::eColorAttachmentOptimal
+			&& barrier->NewLayout == Layout::eReadOnlyOptimal, test, "sampling does not transition");
+
+		if (barrier)
+		{
+			Check(barrier->SrcAccess == Access::eColorAttachmentWrite, test, "transition does not wait for the write");
+		}
+
+		Check(!ApplyAccess(state, Sampled()), test, "second sample of a transitioned image has a barrier");
+
+		barrier = ApplyAccess(state, ColorWrite(false));
+		Check(barrier && barrier->OldLayout == Layout::eReadOnlyOptimal
+			&& barrier->NewLayout == Layout::eColorAttachmentOptimal, test, "writing again does not transition back");
+
+		if (barrier)
+		{
+			Check(static_cast<bool>(barrier->SrcStages & Stage::eFragmentShader), test,
+				"transition does not wait for the sampling");
+		}
+	}
+} // namespace
+
+int main()
+{
+	TestWriteThenRead();
+	TestReadWriteThenRead();
+	TestWriteAfterRead();
+	TestLayoutTransitions();
+
+	if (FailureCount > 0)
+	{
+		std::fprintf(stderr, "%d check(s) failed\n", FailureCount);
+		return 1;
+	}
+
+	std::printf("All checks passed\n");
+	return 0;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file sub_allocator_test.cpp
+ * @brief Randomized checks of the offset allocators behind ::nyxara::renderer::DeviceAllocator.
+ *
+ * Drives ::nyxara::renderer::TlsfAllocator and ::nyxara::renderer::RingAllocator with random
+ * sizes, alignments and tilings, and checks every live range against the others: no overlap,
+ * requested alignment, `bufferImageGranularity` pages never shared between linear and optimal
+ * ranges, full coalescing once everything is freed, and ring ranges never spanning the end.
+ *
+ * The seed is fixed so that failures reproduce; pass another one as the first argument.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "nyxara/renderer/vulkan/sub_allocator.h"
+
+namespace
+{
+	using nyxara::renderer::ResourceTiling;
+	using nyxara::renderer::RingAllocator;
+	using nyxara::renderer::TlsfAllocator;
+
+	int FailureCount = 0;
+
+	void Check(bool bCondition, const char* test, const char* what)
+	{
+		if (!bCondition)
+		{
+			std::fprintf(stderr, "%s: %s\n", test, what);
+			++FailureCount;
+		}
+	}
+
+	struct Range
+	{
+		uint64_t Offset = 0;
+		uint64_t Size = 0;
+		ResourceTiling Tiling = ResourceTiling::Linear;
+	};
+
+	bool Overlaps(const Range& a, const Range& b)
+	{
+		return a.Offset < b.Offset + b.Size && b.Offset < a.Offset + a.Size;
+	}
+
+	bool SharesPage(const Range& a, const Range& b, uint64_t granularity)
+	{
+		const uint64_t aFirst = a.Offset / granularity;
+		const uint64_t aLast = (a.Offset + a.Size - 1) / granularity;
+		const uint64_t bFirst = b.Offset / granularity;
+		const uint64_t bLast = (b.Offset + b.Size - 1) / granularity;
+		return aFirst <= bLast && bFirst <= aLast;
+	}
+
+	void TestTlsf(std::mt19937_64& random)
+	{
+		const char* test = "tlsf";
+		constexpr int TrialCount = 100;
+		constexpr int OperationCount = 4000;
+
+		for (int trial = 0; trial < TrialCount && FailureCount == 0; ++trial)
+		{
+			const uint64_t size = random() % (uint64_t(4) << 20) + TlsfAllocator::MinAlignment;
+			const uint64_t granularity = uint64_t(1) << (random() % 13);
+			TlsfAllocator allocator(size, granularity);
+
+			std::unordered_map<uint32_t, Range> live;
+			std::vector<uint32_t> handles;
+
+			for (int operation = 0; operation < OperationCount && FailureCount == 0; ++operation)
+			{
+				if (handles.empty() || random() % 3 != 0)
+				{
+					// Mostly small ranges, with some large enough to exhaust the allocator.
+					const uint64_t requested = random() % (random() % 2 ? 512 : 128 << 10) + 1;
+					const uint64_t alignment = uint64_t(1) << (random() % 11);
+					const ResourceTiling tiling = random() % 2 ? ResourceTiling::Optimal : ResourceTiling::Linear;
+
+					const TlsfAllocator::Allocation allocation = allocator.Allocate(requested, alignment, tiling);
+
+					if (!allocation)
+					{
+						continue;
+					}
+
+					const Range range{ allocation.Offset, allocation.Size, tiling };
+					Check(range.Offset % alignment == 0, test, "offset is not aligned");
+					Check(range.Size >= requested, test, "range is smaller than requested");
+					Check(range.Offset + range.Size <= allocator.GetSize(), test, "range ends past the allocator");
+
+					if (tiling == ResourceTiling::Optimal)
+					{
+						Check(range.Offset % granularity == 0 && range.Size % granularity == 0, test,
+							"optimal range is not isolated to granularity pages");
+					}
+
+					for (const auto& [handle, other] : live)
+					{
+						Check(!Overlaps(range, other), test, "ranges overlap");
+
+						if (granularity > 1 && other.Tiling != range.Tiling)
+						{
+							Check(!SharesPage(range, other, granularity), test,
+								"linear and optimal ranges share a granularity page");
+						}
+					}
+
+					live.emplace(allocation.Handle, range);
+					handles.push_back(allocation.Handle);
+				}
+				else
+				{
+					const size_t index = random() % handles.size();
+					allocator.Free(handles[index]);
+					live.erase(handles[index]);
+					handles[index] = handles.back();
+					handles.pop_back();
+				}
+			}
+
+			for (const uint32_t handle : handles)
+			{
+				allocator.Free(handle);
+			}
+
+			const nyxara::renderer::TlsfAllocatorStats stats = allocator.GetStats();
+			Check(allocator.IsEmpty() && stats.UsedBytes == 0, test, "allocations left after freeing all");
+			Check(stats.FreeRangeCount == 1 && stats.LargestFreeRange == allocator.GetSize(), test,
+				"free ranges not merged back into one");
+		}
+	}
+
+	void TestRing(std::mt19937_64& random)
+	{
+		const char* test = "ring";
+		constexpr int FrameCount = 20000;
+
+		for (uint32_t framesInFlight = 1; framesInFlight <= 3 && FailureCount == 0; ++framesInFlight)
+		{
+			const uint64_t size = random() % 4096 + 256;
+			RingAllocator ring(size, framesInFlight);
+
+			// Ranges of the frames in flight, the current one last.
+			std::deque<std::vector<Range>> frames;
+			uint64_t previousOffset = 0;
+			bool bHasWrapped = false;
+
+			for (int frame = 0; frame < FrameCount && FailureCount == 0; ++frame)
+			{
+				ring.BeginFrame();
+				frames.emplace_back();
+
+				if (frames.size() > framesInFlight)
+				{
+					frames.pop_front();
+				}
+
+				const int allocationCount = static_cast<int>(random() % 4);
+
+				for (int index = 0; index < allocationCount; ++index)
+				{
+					const uint64_t requested = random() % (size / 4) + 1;
+					const uint64_t alignment = uint64_t(1) << (random() % 9);
+					const uint64_t offset = ring.Allocate(requested, alignment);
+
+					if (offset == RingAllocator::InvalidOffset)
+					{
+						continue;
+					}
+
+					const Range range{ offset, requested };
+					Check(offset % alignment == 0, test, "offset is not aligned");
+					Check(offset + requested <= ring.GetSize(), test, "range spans the end of the ring");
+
+					for (const std::vector<Range>& ranges : frames)
+					{
+						for (const Range& other : ranges)
+						{
+							Check(!Overlaps(range, other), test, "range overlaps one of a frame in flight");
+						}
+					}
+
+					bHasWrapped |= offset < previousOffset;
+					previousOffset = offset;
+					frames.back().push_back(range);
+				}
+
+				Check(ring.GetUsedBytes() <= ring.GetSize(), test, "used bytes exceed the ring");
+			}
+
+			Check(bHasWrapped, test, "ring never wrapped around");
+
+			// Once every frame in flight is released, the whole ring is available again.
+			for (uint32_t frame = 0; frame < framesInFlight; ++frame)
+			{
+				ring.BeginFrame();
+			}
+
+			Check(ring.GetUsedBytes() == 0, test, "bytes left after releasing every frame");
+			Check(ring.Allocate(ring.GetSize(), 1) == 0, test, "empty ring cannot hold its whole size");
+		}
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	const uint64_t seed = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 0x6e797861;
+	std::mt19937_64 random(seed);
+
+	TestTlsf(random);
+	TestRing(random);
+
+	if (FailureCount > 0)
+	{
+		std::fprintf(stderr, "%d check(s) failed with seed %llu\n", FailureCount, static_cast<unsigned long long>(seed));
+		return 1;
+	}
+
+	std::printf("All checks passed\n");
+	return 0;
+}